@@ -0,0 +1,62 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Feature detection and description (argument: image width, 4:3 aspect ratio)
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/features/akaze/image_describer_akaze.hpp"
+#include "openMVG/features/sift/SIFT_Anatomy_Image_Describer.hpp"
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::features;
+
+namespace {
+
+void Describe
+(
+  State & state,
+  Image_describer & image_describer
+)
+{
+  const int width = state.range(0);
+  const image::Image<unsigned char> image = Synthetic_Image(width, width * 3 / 4);
+
+  std::size_t feature_count = 0;
+  while (state.KeepRunning())
+  {
+    const std::unique_ptr<Regions> regions = image_describer.Describe(image);
+    feature_count = regions->RegionCount();
+    DoNotOptimize(regions->DescriptorRawData());
+  }
+  state.counters["features"] = feature_count;
+  state.SetItemsProcessed(state.iterations() * image.Width() * image.Height());
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(SIFT_Anatomy_Describe, 640, 1280)
+{
+  SIFT_Anatomy_Image_describer image_describer;
+  Describe(state, image_describer);
+}
+
+OPENMVG_BENCHMARK_ARGS(AKAZE_MSURF_Describe, 640, 1280)
+{
+  AKAZE_Image_describer_SURF image_describer;
+  Describe(state, image_describer);
+}
+
+OPENMVG_BENCHMARK_ARGS(AKAZE_MLDB_Describe, 640, 1280)
+{
+  AKAZE_Image_describer_MLDB image_describer(
+    AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MLDB));
+  Describe(state, image_describer);
+}
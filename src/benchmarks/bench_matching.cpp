@@ -0,0 +1,103 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Nearest neighbor matching of two descriptor sets (argument: descriptor count).
+// An iteration builds the matcher on the database and searches the 2 nearest
+//  neighbors of each query (as done by the pairwise image matching).
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/matching/matcher_brute_force.hpp"
+#include "openMVG/matching/matcher_cascade_hashing.hpp"
+#include "openMVG/matching/matcher_hnsw.hpp"
+#include "openMVG/matching/matcher_kdtree_flann.hpp"
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::matching;
+
+namespace {
+
+template <typename Matcher, typename Scalar>
+void Match
+(
+  State & state,
+  const Descriptor_Dataset<Scalar> & dataset
+)
+{
+  IndMatches matches;
+  std::vector<typename Matcher::DistanceType> distances;
+  while (state.KeepRunning())
+  {
+    Matcher matcher;
+    if (!matcher.Build(dataset.database.data(), dataset.database_count, dataset.dimension) ||
+        !matcher.SearchNeighbours(dataset.query.data(), dataset.query_count,
+                                  &matches, &distances, 2))
+    {
+      state.SkipWithError("the matcher failed");
+      return;
+    }
+    DoNotOptimize(matches.data());
+  }
+
+  // Ratio of the queries whose nearest neighbor is the ground truth
+  std::size_t correct_count = 0;
+  for (int i = 0; i < dataset.query_count; ++i)
+  {
+    if (static_cast<int>(matches[2 * i].j_) == dataset.query_ground_truth[i])
+      ++correct_count;
+  }
+  state.counters["recall"] = correct_count / static_cast<double>(dataset.query_count);
+  state.SetItemsProcessed(state.iterations() * dataset.query_count);
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(Matching_BruteForce_L2_float, 1000, 4000)
+{
+  const int count = state.range(0);
+  Match<ArrayMatcherBruteForce<float>>(state, Synthetic_Float_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_BruteForce_L2_uint8, 1000, 4000)
+{
+  const int count = state.range(0);
+  Match<ArrayMatcherBruteForce<uint8_t>>(state, Synthetic_Byte_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_BruteForce_Hamming, 1000, 4000)
+{
+  const int count = state.range(0);
+  Match<ArrayMatcherBruteForce<uint8_t, Hamming<uint8_t>>>(
+    state, Synthetic_Binary_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_CascadeHashing_float, 1000, 4000, 16000)
+{
+  const int count = state.range(0);
+  Match<ArrayMatcherCascadeHashing<float>>(state, Synthetic_Float_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_HNSW_L2_float, 1000, 4000)
+{
+  const int count = state.range(0);
+  Match<HNSWMatcher<float>>(state, Synthetic_Float_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_HNSW_L2_uint8, 1000, 4000)
+{
+  const int count = state.range(0);
+  Match<HNSWMatcher<uint8_t>>(state, Synthetic_Byte_Descriptors(count, count));
+}
+
+OPENMVG_BENCHMARK_ARGS(Matching_Kdtree_Flann_float, 1000, 4000, 16000)
+{
+  const int count = state.range(0);
+  Match<ArrayMatcher_Kdtree_Flann<float>>(state, Synthetic_Float_Descriptors(count, count));
+}
@@ -0,0 +1,98 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Descriptor distances (an iteration computes the distances of 1024 descriptor pairs)
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/matching/metric.hpp"
+#include "openMVG/matching/metric_avx2.hpp"
+#include "openMVG/matching/metric_hamming.hpp"
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::matching;
+
+namespace {
+
+const int kPair_Count = 1024;
+
+template <typename Metric, typename Scalar>
+void Distances
+(
+  State & state,
+  const Descriptor_Dataset<Scalar> & dataset
+)
+{
+  const Metric metric;
+  const int dimension = dataset.dimension;
+  while (state.KeepRunning())
+  {
+    typename Metric::ResultType sum = 0;
+    for (int i = 0; i < kPair_Count; ++i)
+    {
+      sum += metric(&dataset.database[i * dimension], &dataset.query[i * dimension], dimension);
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kPair_Count);
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(Metric_L2_float, 64, 128)
+{
+  Distances<L2<float>>(state,
+    Synthetic_Float_Descriptors(kPair_Count, kPair_Count, state.range(0)));
+}
+
+OPENMVG_BENCHMARK_ARGS(Metric_L2_uint8, 64, 128)
+{
+  Distances<L2<uint8_t>>(state,
+    Synthetic_Byte_Descriptors(kPair_Count, kPair_Count, state.range(0)));
+}
+
+// Binary descriptors (argument: byte count, 32 for BRIEF/ORB, 64 for AKAZE MLDB)
+OPENMVG_BENCHMARK_ARGS(Metric_Hamming, 32, 64)
+{
+  Distances<Hamming<uint8_t>>(state,
+    Synthetic_Binary_Descriptors(kPair_Count, kPair_Count, state.range(0)));
+}
+
+#ifdef OPENMVG_USE_AVX2
+
+namespace {
+
+// Direct call to the AVX2 kernels (the uint8_t kernel handles 128 bytes descriptors only)
+template <typename Scalar>
+struct L2_AVX2_Metric
+{
+  using ResultType = decltype(L2_AVX2(static_cast<const Scalar *>(nullptr),
+    static_cast<const Scalar *>(nullptr), 0));
+  ResultType operator()(const Scalar * a, const Scalar * b, size_t size) const
+  {
+    return L2_AVX2(a, b, size);
+  }
+};
+
+} // namespace
+
+OPENMVG_BENCHMARK(Metric_L2_AVX2_float)
+{
+  Distances<L2_AVX2_Metric<float>>(state,
+    Synthetic_Float_Descriptors(kPair_Count, kPair_Count, 128));
+}
+
+OPENMVG_BENCHMARK(Metric_L2_AVX2_uint8)
+{
+  Distances<L2_AVX2_Metric<uint8_t>>(state,
+    Synthetic_Byte_Descriptors(kPair_Count, kPair_Count, 128));
+}
+
+#endif // OPENMVG_USE_AVX2
@@ -0,0 +1,218 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Minimal solvers and triangulation (an iteration solves 1000 random problems)
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/solver_resection_p3p_ke.hpp"
+#include "openMVG/multiview/solver_resection_p3p_kneip.hpp"
+#include "openMVG/multiview/solver_resection_p3p_nordberg.hpp"
+#include "openMVG/multiview/triangulation.hpp"
+#include "openMVG/multiview/triangulation_nview.hpp"
+#include "openMVG/numeric/numeric.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+
+namespace {
+
+const int kProblem_Count = 1000;
+
+// Random camera looking at the world origin (from a distance of 5 units)
+void Random_Camera
+(
+  std::mt19937 & random_generator,
+  Mat3 & R,
+  Vec3 & t
+)
+{
+  std::uniform_real_distribution<double> angle_distribution(-M_PI, M_PI);
+  R = RotationAroundZ(angle_distribution(random_generator) / 8.0)
+    * RotationAroundY(angle_distribution(random_generator) / 4.0)
+    * RotationAroundX(angle_distribution(random_generator) / 4.0);
+  t = Vec3(0.0, 0.0, 5.0);
+}
+
+Vec3 Random_Point(std::mt19937 & random_generator)
+{
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  return {distribution(random_generator), distribution(random_generator),
+          distribution(random_generator)};
+}
+
+// Bearing vector of X seen by the camera [R|t]
+Vec3 Bearing(const Mat3 & R, const Vec3 & t, const Vec3 & X)
+{
+  return (R * X + t).normalized();
+}
+
+struct P3P_Problem
+{
+  Mat bearing_vectors, X;
+};
+
+std::vector<P3P_Problem> Synthetic_P3P_Problems()
+{
+  std::mt19937 random_generator(kDefault_Seed);
+  std::vector<P3P_Problem> problems(kProblem_Count);
+  for (P3P_Problem & problem : problems)
+  {
+    Mat3 R;
+    Vec3 t;
+    Random_Camera(random_generator, R, t);
+    problem.bearing_vectors.resize(3, 3);
+    problem.X.resize(3, 3);
+    for (int i = 0; i < 3; ++i)
+    {
+      problem.X.col(i) = Random_Point(random_generator);
+      problem.bearing_vectors.col(i) = Bearing(R, t, problem.X.col(i));
+    }
+  }
+  return problems;
+}
+
+template <typename Solver>
+void Solve_P3P(State & state)
+{
+  const std::vector<P3P_Problem> problems = Synthetic_P3P_Problems();
+  std::vector<Mat34> models;
+  std::size_t model_count = 0;
+  while (state.KeepRunning())
+  {
+    model_count = 0;
+    for (const P3P_Problem & problem : problems)
+    {
+      models.clear();
+      Solver::Solve(problem.bearing_vectors, problem.X, &models);
+      model_count += models.size();
+    }
+    DoNotOptimize(model_count);
+  }
+  state.counters["models_per_problem"] = model_count / static_cast<double>(kProblem_Count);
+  state.SetItemsProcessed(state.iterations() * kProblem_Count);
+}
+
+struct Two_View_Observation
+{
+  Vec3 bearing0, bearing1;
+};
+
+void Triangulate_Two_View
+(
+  State & state,
+  ETriangulationMethod method
+)
+{
+  std::mt19937 random_generator(kDefault_Seed);
+  std::normal_distribution<double> noise_distribution(0.0, 1e-3);
+  Mat3 R0, R1;
+  Vec3 t0, t1;
+  Random_Camera(random_generator, R0, t0);
+  Random_Camera(random_generator, R1, t1);
+  std::vector<Two_View_Observation> observations(kProblem_Count);
+  for (Two_View_Observation & observation : observations)
+  {
+    const Vec3 X = Random_Point(random_generator);
+    const Vec3 noise(noise_distribution(random_generator),
+                     noise_distribution(random_generator),
+                     noise_distribution(random_generator));
+    observation.bearing0 = Bearing(R0, t0, X);
+    observation.bearing1 = (Bearing(R1, t1, X) + noise).normalized();
+  }
+
+  std::size_t valid_count = 0;
+  while (state.KeepRunning())
+  {
+    valid_count = 0;
+    for (const Two_View_Observation & observation : observations)
+    {
+      Vec3 X;
+      if (Triangulate2View(R0, t0, observation.bearing0,
+                           R1, t1, observation.bearing1, X, method))
+        ++valid_count;
+      DoNotOptimize(X);
+    }
+  }
+  state.counters["valid_ratio"] = valid_count / static_cast<double>(kProblem_Count);
+  state.SetItemsProcessed(state.iterations() * kProblem_Count);
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK(P3P_Kneip)
+{
+  Solve_P3P<euclidean_resection::P3PSolver_Kneip>(state);
+}
+
+OPENMVG_BENCHMARK(P3P_Ke)
+{
+  Solve_P3P<euclidean_resection::P3PSolver_Ke>(state);
+}
+
+OPENMVG_BENCHMARK(P3P_Nordberg)
+{
+  Solve_P3P<euclidean_resection::P3PSolver_Nordberg>(state);
+}
+
+OPENMVG_BENCHMARK(Triangulate2View_DLT)
+{
+  Triangulate_Two_View(state, ETriangulationMethod::DIRECT_LINEAR_TRANSFORM);
+}
+
+OPENMVG_BENCHMARK(Triangulate2View_L1_Angular)
+{
+  Triangulate_Two_View(state, ETriangulationMethod::L1_ANGULAR);
+}
+
+OPENMVG_BENCHMARK(Triangulate2View_LInfinity_Angular)
+{
+  Triangulate_Two_View(state, ETriangulationMethod::LINFINITY_ANGULAR);
+}
+
+OPENMVG_BENCHMARK(Triangulate2View_IDW_Midpoint)
+{
+  Triangulate_Two_View(state, ETriangulationMethod::INVERSE_DEPTH_WEIGHTED_MIDPOINT);
+}
+
+// N-view DLT triangulation (argument: view count)
+OPENMVG_BENCHMARK_ARGS(TriangulateNView, 4, 16)
+{
+  const int view_count = state.range(0);
+  std::mt19937 random_generator(kDefault_Seed);
+  std::vector<Mat34> Ps(view_count);
+  std::vector<Mat3> Rs(view_count);
+  std::vector<Vec3> ts(view_count);
+  for (int i = 0; i < view_count; ++i)
+  {
+    Random_Camera(random_generator, Rs[i], ts[i]);
+    P_From_KRt(Mat3::Identity(), Rs[i], ts[i], &Ps[i]);
+  }
+  std::vector<Mat3X> observations(kProblem_Count, Mat3X(3, view_count));
+  for (Mat3X & bearings : observations)
+  {
+    const Vec3 X = Random_Point(random_generator);
+    for (int i = 0; i < view_count; ++i)
+      bearings.col(i) = Bearing(Rs[i], ts[i], X);
+  }
+
+  while (state.KeepRunning())
+  {
+    for (const Mat3X & bearings : observations)
+    {
+      Vec4 X;
+      TriangulateNView(bearings, Ps, &X);
+      DoNotOptimize(X);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kProblem_Count);
+}
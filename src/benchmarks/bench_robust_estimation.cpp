@@ -0,0 +1,127 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// AContrario RANSAC on the two view kernels used by the SfM pipelines
+//  (argument: correspondence count, 30% of outliers, 1024 iterations at most).
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/multiview/solver_essential_kernel.hpp"
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::robust;
+
+namespace {
+
+const double kOutlier_Ratio = 0.3;
+
+template <typename Kernel>
+void Estimate
+(
+  State & state,
+  const Kernel & kernel,
+  const Two_View_Dataset & dataset
+)
+{
+  std::vector<uint32_t> vec_inliers;
+  while (state.KeepRunning())
+  {
+    Mat3 model;
+    ACRANSAC(kernel, vec_inliers, 1024, &model);
+    DoNotOptimize(model);
+  }
+  state.counters["inliers"] = vec_inliers.size();
+  state.counters["inlier_ratio"] =
+    vec_inliers.size() / static_cast<double>(dataset.inlier_count);
+  state.SetItemsProcessed(state.iterations() * dataset.x1.cols());
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(ACRansac_Fundamental_7pt, 200, 1000, 5000)
+{
+  const Two_View_Dataset dataset = Synthetic_Two_View(state.range(0), kOutlier_Ratio, false);
+  using KernelType =
+    ACKernelAdaptor<
+      fundamental::kernel::SevenPointSolver,
+      fundamental::kernel::EpipolarDistanceError,
+      UnnormalizerT,
+      Mat3>;
+  const KernelType kernel(
+    dataset.x1, dataset.width, dataset.height,
+    dataset.x2, dataset.width, dataset.height, true);
+  Estimate(state, kernel, dataset);
+}
+
+OPENMVG_BENCHMARK_ARGS(ACRansac_Essential_5pt, 200, 1000, 5000)
+{
+  const Two_View_Dataset dataset = Synthetic_Two_View(state.range(0), kOutlier_Ratio, false);
+  using KernelType =
+    ACKernelAdaptorEssential<
+      essential::kernel::FivePointSolver,
+      fundamental::kernel::EpipolarDistanceError,
+      Mat3>;
+  const KernelType kernel(
+    dataset.x1, dataset.bearing1, dataset.width, dataset.height,
+    dataset.x2, dataset.bearing2, dataset.width, dataset.height,
+    dataset.K, dataset.K);
+  Estimate(state, kernel, dataset);
+}
+
+OPENMVG_BENCHMARK_ARGS(ACRansac_Homography_4pt, 200, 1000, 5000)
+{
+  const Two_View_Dataset dataset = Synthetic_Two_View(state.range(0), kOutlier_Ratio, true);
+  using KernelType =
+    ACKernelAdaptor<
+      homography::kernel::FourPointSolver,
+      homography::kernel::AsymmetricError,
+      UnnormalizerI,
+      Mat3>;
+  const KernelType kernel(
+    dataset.x1, dataset.width, dataset.height,
+    dataset.x2, dataset.width, dataset.height, false);
+  Estimate(state, kernel, dataset);
+}
+
+// Residual evaluation of a model on all the correspondences:
+//  per correspondence evaluation vs. batched (SIMD) evaluation
+OPENMVG_BENCHMARK_ARGS(Residuals_Sampson_PerSample, 1000, 10000)
+{
+  const Two_View_Dataset dataset = Synthetic_Two_View(state.range(0), kOutlier_Ratio, false);
+  const Mat3 F = Mat3::Random();
+  std::vector<double> errors(dataset.x1.cols());
+  while (state.KeepRunning())
+  {
+    for (Mat::Index i = 0; i < dataset.x1.cols(); ++i)
+      errors[i] = fundamental::kernel::SampsonError::Error(
+        F, dataset.x1.col(i), dataset.x2.col(i));
+    DoNotOptimize(errors.data());
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.x1.cols());
+}
+
+OPENMVG_BENCHMARK_ARGS(Residuals_Sampson_Batched, 1000, 10000)
+{
+  const Two_View_Dataset dataset = Synthetic_Two_View(state.range(0), kOutlier_Ratio, false);
+  const Mat3 F = Mat3::Random();
+  const Mat2X_SoA x1 = dataset.x1, x2 = dataset.x2;
+  std::vector<double> errors(dataset.x1.cols());
+  while (state.KeepRunning())
+  {
+    fundamental::kernel::SampsonError::Errors(F, x1, x2, errors.data());
+    DoNotOptimize(errors.data());
+  }
+  state.counters["avx2"] = batched_residuals::UseAVX2();
+  state.SetItemsProcessed(state.iterations() * dataset.x1.cols());
+}
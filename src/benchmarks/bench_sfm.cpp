@@ -0,0 +1,159 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Ceres bundle adjustment of a synthetic ring scene with 1000 landmarks seen by
+//  all the views (argument: view count).
+// Ceres runs on a single thread in order to get comparable timings across machines.
+// Residual + Jacobians evaluation of the AutoDiff and analytic reprojection
+//  cost functions (argument: camera model, see Create_Cost_Function).
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_camera_functor.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_camera_functor_analytic.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::sfm;
+
+namespace {
+
+void Adjust_Scene
+(
+  State & state,
+  bool b_analytic_derivatives
+)
+{
+  const SfM_Data scene = Synthetic_SfM_Scene(state.range(0), 1000);
+
+  Bundle_Adjustment_Ceres::BA_Ceres_options ceres_options(false, false);
+  ceres_options.bUse_analytic_derivatives_ = b_analytic_derivatives;
+  Bundle_Adjustment_Ceres bundle_adjustment(ceres_options);
+  const Optimize_Options optimize_options(
+    cameras::Intrinsic_Parameter_Type::ADJUST_ALL,
+    Extrinsic_Parameter_Type::ADJUST_ALL,
+    Structure_Parameter_Type::ADJUST_ALL);
+
+  std::size_t observation_count = 0;
+  for (const auto & landmark : scene.GetLandmarks())
+    observation_count += landmark.second.obs.size();
+
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    SfM_Data sfm_data = scene;
+    state.ResumeTiming();
+    if (!bundle_adjustment.Adjust(sfm_data, optimize_options))
+    {
+      state.SkipWithError("the bundle adjustment failed");
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * observation_count);
+}
+
+/// Reprojection cost function of a pinhole camera model
+///  (0: Pinhole, 1: Radial_K1, 2: Radial_K3, 3: Brown_T2, 4: Fisheye)
+ceres::CostFunction * Create_Cost_Function
+(
+  const int64_t camera_model,
+  const bool b_analytic_derivatives,
+  const Vec2 & observation
+)
+{
+  switch (camera_model)
+  {
+    case 0:
+      return b_analytic_derivatives ?
+        ResidualErrorAnalytic_Pinhole_Intrinsic::Create(observation) :
+        ResidualErrorFunctor_Pinhole_Intrinsic::Create(observation);
+    case 1:
+      return b_analytic_derivatives ?
+        ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K1::Create(observation) :
+        ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K1::Create(observation);
+    case 2:
+      return b_analytic_derivatives ?
+        ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3::Create(observation) :
+        ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K3::Create(observation);
+    case 3:
+      return b_analytic_derivatives ?
+        ResidualErrorAnalytic_Pinhole_Intrinsic_Brown_T2::Create(observation) :
+        ResidualErrorFunctor_Pinhole_Intrinsic_Brown_T2::Create(observation);
+    case 4:
+      return b_analytic_derivatives ?
+        ResidualErrorAnalytic_Pinhole_Intrinsic_Fisheye::Create(observation) :
+        ResidualErrorFunctor_Pinhole_Intrinsic_Fisheye::Create(observation);
+    default:
+      return nullptr;
+  }
+}
+
+void Evaluate_Cost_Function
+(
+  State & state,
+  bool b_analytic_derivatives
+)
+{
+  std::unique_ptr<ceres::CostFunction> cost_function(
+    Create_Cost_Function(state.range(0), b_analytic_derivatives, Vec2(512.0, 384.0)));
+  if (!cost_function)
+  {
+    state.SkipWithError("unknown camera model");
+    return;
+  }
+
+  // [focal, ppx, ppy, distortion...], [R;t], X (in front of the camera)
+  std::vector<double> intrinsics = {1000.0, 500.0, 400.0};
+  intrinsics.resize(cost_function->parameter_block_sizes()[0], 0.001);
+  std::vector<double> extrinsics = {0.1, -0.2, 0.05, 0.3, -0.1, 0.2};
+  std::vector<double> point = {0.2, -0.1, 5.0};
+  double * parameter_blocks[] = {intrinsics.data(), extrinsics.data(), point.data()};
+
+  std::vector<std::vector<double>> jacobians_values;
+  std::vector<double *> jacobians;
+  for (const int32_t block_size : cost_function->parameter_block_sizes())
+    jacobians_values.emplace_back(cost_function->num_residuals() * block_size);
+  for (auto & jacobian : jacobians_values)
+    jacobians.push_back(jacobian.data());
+  std::vector<double> residuals(cost_function->num_residuals());
+
+  while (state.KeepRunning())
+  {
+    cost_function->Evaluate(parameter_blocks, residuals.data(), jacobians.data());
+    DoNotOptimize(residuals[0]);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(Cost_Function_AutoDiff, 0, 1, 2, 3, 4)
+{
+  Evaluate_Cost_Function(state, false);
+}
+
+OPENMVG_BENCHMARK_ARGS(Cost_Function_Analytic, 0, 1, 2, 3, 4)
+{
+  Evaluate_Cost_Function(state, true);
+}
+
+OPENMVG_BENCHMARK_ARGS(BA_Ceres_AutoDiff, 8, 32)
+{
+  Adjust_Scene(state, false);
+}
+
+OPENMVG_BENCHMARK_ARGS(BA_Ceres_Analytic, 8, 32)
+{
+  Adjust_Scene(state, true);
+}
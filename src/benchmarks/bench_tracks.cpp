@@ -0,0 +1,174 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Track building from the pairwise matches of a synthetic sequence of 200 views
+//  (argument: track count, 1% of random matches), compared to the serial
+//  reference implementation (std::set node enumeration and sequential union-find)
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/tracks/tracks.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::matching;
+using namespace openMVG::tracks;
+
+namespace {
+
+/// Serial track builder (reference implementation)
+struct ReferenceTracksBuilder
+{
+  using indexedFeaturePair = std::pair<uint32_t, uint32_t>;
+
+  flat_pair_map<indexedFeaturePair, uint32_t> map_node_to_index;
+  UnionFind uf_tree;
+
+  void Build(const PairWiseMatches & map_pair_wise_matches)
+  {
+    std::set<indexedFeaturePair> allFeatures;
+    for (const auto & iter : map_pair_wise_matches)
+    {
+      for (const auto & match : iter.second)
+      {
+        allFeatures.emplace(iter.first.first, match.i_);
+        allFeatures.emplace(iter.first.second, match.j_);
+      }
+    }
+    map_node_to_index.reserve(allFeatures.size());
+    uint32_t cpt = 0;
+    for (const auto & feat : allFeatures)
+    {
+      map_node_to_index.emplace_back(feat, cpt);
+      ++cpt;
+    }
+    map_node_to_index.sort();
+    allFeatures.clear();
+
+    uf_tree.InitSets(map_node_to_index.size());
+    for (const auto & iter : map_pair_wise_matches)
+    {
+      for (const IndMatch & match : iter.second)
+      {
+        uf_tree.Union(
+          map_node_to_index[{iter.first.first, match.i_}],
+          map_node_to_index[{iter.first.second, match.j_}]);
+      }
+    }
+  }
+
+  void Filter(size_t nLengthSupTo = 2)
+  {
+    std::map<uint32_t, std::set<uint32_t>> tracks;
+    std::set<uint32_t> problematic_track_id;
+    for (uint32_t k = 0; k < map_node_to_index.size(); ++k)
+    {
+      const uint32_t track_id = uf_tree.Find(k);
+      if (tracks[track_id].insert(map_node_to_index[k].first.first).second == false)
+      {
+        problematic_track_id.insert(track_id);
+      }
+    }
+    for (const auto & val : tracks)
+    {
+      if (val.second.size() < nLengthSupTo)
+        problematic_track_id.insert(val.first);
+    }
+    for (uint32_t & root_index : uf_tree.m_cc_parent)
+    {
+      if (problematic_track_id.count(root_index) > 0)
+      {
+        uf_tree.m_cc_size[root_index] = 1;
+        root_index = std::numeric_limits<uint32_t>::max();
+      }
+    }
+  }
+
+  void ExportToSTL(STLMAPTracks & map_tracks)
+  {
+    map_tracks.clear();
+    for (uint32_t k = 0; k < map_node_to_index.size(); ++k)
+    {
+      const uint32_t track_id = uf_tree.m_cc_parent[k];
+      if (track_id != std::numeric_limits<uint32_t>::max()
+          && uf_tree.m_cc_size[track_id] > 1)
+      {
+        map_tracks[track_id].insert(map_node_to_index[k].first);
+      }
+    }
+  }
+};
+
+/// Return the tracks content without their ids (ids depend of the union-find implementation)
+std::vector<submapTrack> TracksContent(const STLMAPTracks & map_tracks)
+{
+  std::vector<submapTrack> tracks;
+  tracks.reserve(map_tracks.size());
+  for (const auto & track : map_tracks)
+    tracks.push_back(track.second);
+  std::sort(tracks.begin(), tracks.end());
+  return tracks;
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK_ARGS(Tracks_Build_Filter_Export, 10000, 100000)
+{
+  const PairWiseMatches map_pairwise_matches =
+    Synthetic_Pairwise_Matches(200, state.range(0), 8, 0.01);
+
+  STLMAPTracks map_tracks;
+  while (state.KeepRunning())
+  {
+    TracksBuilder tracks_builder;
+    tracks_builder.Build(map_pairwise_matches);
+    tracks_builder.Filter();
+    tracks_builder.ExportToSTL(map_tracks);
+    DoNotOptimize(map_tracks);
+  }
+
+  // The tracks must be the reference ones (not timed)
+  ReferenceTracksBuilder reference_builder;
+  reference_builder.Build(map_pairwise_matches);
+  reference_builder.Filter();
+  STLMAPTracks reference_tracks;
+  reference_builder.ExportToSTL(reference_tracks);
+  if (TracksContent(reference_tracks) != TracksContent(map_tracks))
+  {
+    state.SkipWithError("the tracks differ from the reference tracks");
+    return;
+  }
+
+  state.counters["tracks"] = map_tracks.size();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+OPENMVG_BENCHMARK_ARGS(Tracks_Reference_Build_Filter_Export, 10000, 100000)
+{
+  const PairWiseMatches map_pairwise_matches =
+    Synthetic_Pairwise_Matches(200, state.range(0), 8, 0.01);
+
+  STLMAPTracks map_tracks;
+  while (state.KeepRunning())
+  {
+    ReferenceTracksBuilder tracks_builder;
+    tracks_builder.Build(map_pairwise_matches);
+    tracks_builder.Filter();
+    tracks_builder.ExportToSTL(map_tracks);
+    DoNotOptimize(map_tracks);
+  }
+  state.counters["tracks"] = map_tracks.size();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
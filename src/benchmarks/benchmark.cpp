@@ -0,0 +1,364 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "openMVG/version.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace openMVG {
+namespace benchmark {
+
+State::State
+(
+  std::size_t max_iterations,
+  const std::vector<int64_t> & args
+):
+  max_iterations_(max_iterations),
+  args_(args)
+{
+}
+
+bool State::KeepRunning()
+{
+  if (iteration_ == 0 && !running_ && error_message_.empty())
+    ResumeTiming();
+
+  if (iteration_ < max_iterations_ && error_message_.empty())
+  {
+    ++iteration_;
+    return true;
+  }
+  if (running_)
+    PauseTiming();
+  return false;
+}
+
+void State::PauseTiming()
+{
+  if (!running_)
+    return;
+  real_time_ += std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - real_start_).count();
+  cpu_time_ += static_cast<double>(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+  running_ = false;
+}
+
+void State::ResumeTiming()
+{
+  if (running_)
+    return;
+  running_ = true;
+  cpu_start_ = std::clock();
+  real_start_ = std::chrono::steady_clock::now();
+}
+
+void State::SkipWithError(const std::string & message)
+{
+  error_message_ = message;
+  running_ = false;
+  iteration_ = max_iterations_;
+}
+
+namespace {
+
+struct Benchmark_Run
+{
+  std::string name;
+  Benchmark_Function function;
+  std::vector<int64_t> args;
+};
+
+std::vector<Benchmark_Run> & Registry()
+{
+  static std::vector<Benchmark_Run> registry;
+  return registry;
+}
+
+// Run the benchmark once with the given iteration count
+State Run_Once
+(
+  const Benchmark_Run & run,
+  std::size_t iterations
+)
+{
+  State state(iterations, run.args);
+  run.function(state);
+  return state;
+}
+
+// Grow the iteration count until a run lasts at least min_time
+std::size_t Calibrate
+(
+  const Benchmark_Run & run,
+  double min_time,
+  std::string & error_message
+)
+{
+  const std::size_t max_iterations = 1000000000;
+  std::size_t iterations = 1;
+  while (true)
+  {
+    const State state = Run_Once(run, iterations);
+    if (state.HasError())
+    {
+      error_message = state.ErrorMessage();
+      return 0;
+    }
+    const double elapsed = state.RealTime();
+    if (elapsed >= min_time || iterations >= max_iterations)
+      return iterations;
+
+    // Predict the iteration count needed to reach min_time (with a 40% margin)
+    //  but do not grow by more than a factor 10 in a single step.
+    const double multiplier =
+      (elapsed <= min_time / 10.0) ? 10.0 : min_time * 1.4 / elapsed;
+    iterations = std::min(max_iterations,
+      std::max(iterations + 1,
+               static_cast<std::size_t>(std::ceil(iterations * multiplier))));
+  }
+}
+
+// Choose a human readable time unit
+std::string Format_Time(double nanoseconds)
+{
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(nanoseconds < 10.0 ? 2 : 0);
+  if (nanoseconds < 1e4)
+    os << nanoseconds << " ns";
+  else if (nanoseconds < 1e7)
+    os << nanoseconds / 1e3 << " us";
+  else if (nanoseconds < 1e10)
+    os << nanoseconds / 1e6 << " ms";
+  else
+    os << std::setprecision(2) << nanoseconds / 1e9 << " s";
+  return os.str();
+}
+
+std::string JSON_Escape(const std::string & value)
+{
+  std::ostringstream os;
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"': os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c);
+        else
+          os << c;
+    }
+  }
+  return os.str();
+}
+
+std::string JSON_Number(double value)
+{
+  if (!std::isfinite(value))
+    return "null";
+  std::ostringstream os;
+  os << std::setprecision(12) << value;
+  return os.str();
+}
+
+} // namespace
+
+bool Register
+(
+  const std::string & name,
+  Benchmark_Function function,
+  const std::vector<int64_t> & args
+)
+{
+  if (args.empty())
+  {
+    Registry().push_back({name, function, {}});
+  }
+  for (const int64_t arg : args)
+  {
+    Registry().push_back({name + "/" + std::to_string(arg), function, {arg}});
+  }
+  return true;
+}
+
+std::vector<std::string> Registered_Benchmarks()
+{
+  std::vector<std::string> names;
+  for (const Benchmark_Run & run : Registry())
+    names.push_back(run.name);
+  return names;
+}
+
+std::vector<Run_Report> Run_Benchmarks
+(
+  const Run_Options & options,
+  std::ostream & os
+)
+{
+  const std::regex filter(options.filter);
+  const int repetitions = std::max(1, options.repetitions);
+
+  os
+    << std::left << std::setw(48) << "Benchmark"
+    << std::right << std::setw(14) << "Time"
+    << std::setw(14) << "CPU"
+    << std::setw(12) << "Iterations"
+    << "  Items/s" << std::endl
+    << std::string(100, '-') << std::endl;
+
+  std::vector<Run_Report> reports;
+  for (const Benchmark_Run & run : Registry())
+  {
+    if (!std::regex_search(run.name, filter))
+      continue;
+
+    Run_Report report;
+    report.name = run.name;
+    report.iterations = Calibrate(run, options.min_time, report.error_message);
+
+    std::vector<double> real_times, cpu_times;
+    std::size_t items_processed = 0;
+    for (int i = 0; i < repetitions && report.error_message.empty(); ++i)
+    {
+      const State state = Run_Once(run, report.iterations);
+      if (state.HasError())
+      {
+        report.error_message = state.ErrorMessage();
+        break;
+      }
+      real_times.push_back(state.RealTime() * 1e9 / report.iterations);
+      cpu_times.push_back(state.CpuTime() * 1e9 / report.iterations);
+      items_processed += state.ItemsProcessed();
+      // The counters of the last repetition are reported
+      report.counters = state.counters;
+    }
+
+    if (!report.error_message.empty())
+    {
+      os << std::left << std::setw(48) << run.name
+        << " ERROR: " << report.error_message << std::endl;
+      reports.push_back(report);
+      continue;
+    }
+
+    report.repetitions = static_cast<int>(real_times.size());
+    const double n = static_cast<double>(real_times.size());
+    report.real_time_mean =
+      std::accumulate(real_times.cbegin(), real_times.cend(), 0.0) / n;
+    report.cpu_time_mean =
+      std::accumulate(cpu_times.cbegin(), cpu_times.cend(), 0.0) / n;
+    double variance = 0.0;
+    for (const double time : real_times)
+      variance += (time - report.real_time_mean) * (time - report.real_time_mean);
+    report.real_time_stddev = (real_times.size() > 1) ?
+      std::sqrt(variance / (n - 1.0)) : 0.0;
+    std::sort(real_times.begin(), real_times.end());
+    report.real_time_min = real_times.front();
+    report.real_time_median = (real_times.size() % 2 == 1) ?
+      real_times[real_times.size() / 2] :
+      (real_times[real_times.size() / 2 - 1] + real_times[real_times.size() / 2]) / 2.0;
+    const double total_seconds = report.real_time_mean * 1e-9 * report.iterations * n;
+    report.items_per_second = (items_processed > 0 && total_seconds > 0.0) ?
+      items_processed / total_seconds : 0.0;
+
+    os
+      << std::left << std::setw(48) << run.name
+      << std::right << std::setw(14) << Format_Time(report.real_time_median)
+      << std::setw(14) << Format_Time(report.cpu_time_mean)
+      << std::setw(12) << report.iterations;
+    if (report.items_per_second > 0.0)
+      os << "  " << std::setprecision(4) << report.items_per_second;
+    for (const auto & counter : report.counters)
+      os << "  " << counter.first << "=" << std::setprecision(6) << counter.second;
+    os << std::endl;
+
+    reports.push_back(report);
+  }
+  return reports;
+}
+
+void Report_JSON
+(
+  const std::vector<Run_Report> & reports,
+  const Run_Options & options,
+  std::ostream & os
+)
+{
+  const std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+  os
+    << "{\n"
+    << "  \"context\": {\n"
+    << "    \"date\": \"" << date << "\",\n"
+    << "    \"openmvg_version\": \"" << OPENMVG_VERSION_STRING << "\",\n"
+#ifdef NDEBUG
+    << "    \"library_build_type\": \"release\",\n"
+#else
+    << "    \"library_build_type\": \"debug\",\n"
+#endif
+#ifdef OPENMVG_USE_AVX2
+    << "    \"avx2\": true,\n"
+#else
+    << "    \"avx2\": false,\n"
+#endif
+    << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+    << "    \"filter\": \"" << JSON_Escape(options.filter) << "\",\n"
+    << "    \"min_time\": " << JSON_Number(options.min_time) << ",\n"
+    << "    \"repetitions\": " << options.repetitions << "\n"
+    << "  },\n"
+    << "  \"benchmarks\": [";
+
+  for (std::size_t i = 0; i < reports.size(); ++i)
+  {
+    const Run_Report & report = reports[i];
+    os
+      << (i == 0 ? "\n" : ",\n")
+      << "    {\n"
+      << "      \"name\": \"" << JSON_Escape(report.name) << "\",\n";
+    if (!report.error_message.empty())
+    {
+      os
+        << "      \"error_occurred\": true,\n"
+        << "      \"error_message\": \"" << JSON_Escape(report.error_message) << "\"\n"
+        << "    }";
+      continue;
+    }
+    os
+      << "      \"iterations\": " << report.iterations << ",\n"
+      << "      \"repetitions\": " << report.repetitions << ",\n"
+      << "      \"real_time\": " << JSON_Number(report.real_time_mean) << ",\n"
+      << "      \"real_time_median\": " << JSON_Number(report.real_time_median) << ",\n"
+      << "      \"real_time_min\": " << JSON_Number(report.real_time_min) << ",\n"
+      << "      \"real_time_stddev\": " << JSON_Number(report.real_time_stddev) << ",\n"
+      << "      \"cpu_time\": " << JSON_Number(report.cpu_time_mean) << ",\n"
+      << "      \"time_unit\": \"ns\"";
+    if (report.items_per_second > 0.0)
+      os << ",\n      \"items_per_second\": " << JSON_Number(report.items_per_second);
+    for (const auto & counter : report.counters)
+      os << ",\n      \"" << JSON_Escape(counter.first) << "\": " << JSON_Number(counter.second);
+    os << "\n    }";
+  }
+  os << "\n  ]\n}" << std::endl;
+}
+
+} // namespace benchmark
+} // namespace openMVG
@@ -0,0 +1,172 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_BENCHMARKS_BENCHMARK_HPP
+#define OPENMVG_BENCHMARKS_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+// Micro benchmark harness of the openMVG_benchmarks executable.
+//
+// It follows the Google Benchmark semantics:
+//  - a benchmark is a function that runs its timed loop `while (state.KeepRunning())`,
+//  - the iteration count is calibrated until a run lasts at least a minimal time,
+//  - the calibrated run is repeated and the mean/median/min/stddev times are reported,
+//  - the results can be exported as JSON in order to compare several runs.
+//
+// Usage:
+//
+//  OPENMVG_BENCHMARK_ARGS(Matching_BruteForce, 1000, 4000)
+//  {
+//    const auto data = Synthetic_Descriptors(state.range(0), ...); // not timed
+//    while (state.KeepRunning())
+//    {
+//      ... // timed
+//      DoNotOptimize(result);
+//    }
+//    state.SetItemsProcessed(state.iterations() * state.range(0));
+//  }
+
+namespace openMVG {
+namespace benchmark {
+
+/// Benchmark run state: iteration loop, timers, arguments and user counters
+class State
+{
+public:
+  State(std::size_t max_iterations, const std::vector<int64_t> & args);
+
+  /// Return true while the timed loop must be run (the timer starts at the first call)
+  bool KeepRunning();
+
+  /// Exclude a part of the timed loop from the measure (data reset, copy...)
+  void PauseTiming();
+  void ResumeTiming();
+
+  /// Benchmark argument (see OPENMVG_BENCHMARK_ARGS)
+  int64_t range(std::size_t index = 0) const { return args_.at(index); }
+
+  /// Number of iterations of the timed loop
+  std::size_t iterations() const { return max_iterations_; }
+
+  /// Number of processed items (used to report an item throughput)
+  void SetItemsProcessed(std::size_t items) { items_processed_ = items; }
+  std::size_t ItemsProcessed() const { return items_processed_; }
+
+  /// Stop the benchmark and report an error (the run is not timed)
+  void SkipWithError(const std::string & message);
+  bool HasError() const { return !error_message_.empty(); }
+  const std::string & ErrorMessage() const { return error_message_; }
+
+  /// Timed real and CPU (process) time, in seconds
+  double RealTime() const { return real_time_; }
+  double CpuTime() const { return cpu_time_; }
+
+  /// User values reported along the timing (inlier count, residual...)
+  std::map<std::string, double> counters;
+
+private:
+  std::size_t max_iterations_;
+  std::size_t iteration_ = 0;
+  std::vector<int64_t> args_;
+  bool running_ = false;
+  std::chrono::steady_clock::time_point real_start_;
+  std::clock_t cpu_start_ = 0;
+  double real_time_ = 0.0;
+  double cpu_time_ = 0.0;
+  std::size_t items_processed_ = 0;
+  std::string error_message_;
+};
+
+using Benchmark_Function = void (*)(State &);
+
+/// Register a benchmark (one run per argument, a single run if args is empty)
+bool Register
+(
+  const std::string & name,
+  Benchmark_Function function,
+  const std::vector<int64_t> & args
+);
+
+/// Name of the registered benchmark runs ("name" or "name/arg")
+std::vector<std::string> Registered_Benchmarks();
+
+struct Run_Options
+{
+  std::string filter = ".*";  // ECMAScript regex on the benchmark run names
+  double min_time = 0.5;      // Minimal duration of a calibrated run (seconds)
+  int repetitions = 3;        // Number of timed runs of each benchmark
+};
+
+/// Statistics of the repetitions of a benchmark run (times in nanoseconds per iteration)
+struct Run_Report
+{
+  std::string name;
+  std::size_t iterations = 0;
+  int repetitions = 0;
+  double real_time_mean = 0.0;
+  double real_time_median = 0.0;
+  double real_time_min = 0.0;
+  double real_time_stddev = 0.0;
+  double cpu_time_mean = 0.0;
+  double items_per_second = 0.0;
+  std::map<std::string, double> counters;
+  std::string error_message;
+};
+
+/// Run the registered benchmarks that match the filter
+std::vector<Run_Report> Run_Benchmarks
+(
+  const Run_Options & options,
+  std::ostream & os // console progress/report
+);
+
+/// Export the reports as a JSON document (Google Benchmark like layout)
+void Report_JSON
+(
+  const std::vector<Run_Report> & reports,
+  const Run_Options & options,
+  std::ostream & os
+);
+
+/// Prevent the compiler to optimize away a computed value
+template <typename T>
+inline void DoNotOptimize(const T & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void * sink;
+  sink = static_cast<const void *>(&value);
+#endif
+}
+
+} // namespace benchmark
+} // namespace openMVG
+
+#define OPENMVG_BENCHMARK_REGISTER_(NAME, ARGS)                             \
+  static void NAME(openMVG::benchmark::State & state);                     \
+  static const bool NAME##_registered =                                    \
+    openMVG::benchmark::Register(#NAME, &NAME, std::vector<int64_t> ARGS); \
+  static void NAME(openMVG::benchmark::State & state)
+
+/// Declare a benchmark without argument
+#define OPENMVG_BENCHMARK(NAME) OPENMVG_BENCHMARK_REGISTER_(NAME, ())
+
+/// Declare a benchmark run for each of the given integer arguments (see State::range)
+#define OPENMVG_BENCHMARK_ARGS(NAME, ...) \
+  OPENMVG_BENCHMARK_REGISTER_(NAME, ({__VA_ARGS__}))
+
+#endif // OPENMVG_BENCHMARKS_BENCHMARK_HPP
@@ -0,0 +1,87 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+
+using namespace openMVG::benchmark;
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+
+  Run_Options options;
+  std::string sOutputJSON;
+
+  cmd.add( make_option('f', options.filter, "filter") );
+  cmd.add( make_option('t', options.min_time, "min_time") );
+  cmd.add( make_option('r', options.repetitions, "repetitions") );
+  cmd.add( make_option('o', sOutputJSON, "output_json") );
+  cmd.add( make_switch('l', "list") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    std::cerr << "Usage: " << argv[0] << '\n'
+      << "[-f|--filter] regex on the benchmark names (default: " << options.filter << ")\n"
+      << "[-t|--min_time] minimal duration of a timed run in seconds (default: " << options.min_time << ")\n"
+      << "[-r|--repetitions] number of timed runs of each benchmark (default: " << options.repetitions << ")\n"
+      << "[-o|--output_json] export the results to this JSON file\n"
+      << "[-l|--list] list the benchmarks and exit\n"
+      << std::endl;
+    std::cerr << s << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (cmd.used('l'))
+  {
+    for (const std::string & name : Registered_Benchmarks())
+      std::cout << name << '\n';
+    return EXIT_SUCCESS;
+  }
+
+  if (options.min_time < 0.0 || options.repetitions < 1)
+  {
+    std::cerr << "Invalid benchmark parameters." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const std::regex filter(options.filter);
+  } catch (const std::regex_error & e) {
+    std::cerr << "Invalid filter: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<Run_Report> reports = Run_Benchmarks(options, std::cout);
+
+  if (!sOutputJSON.empty())
+  {
+    std::ofstream stream(sOutputJSON);
+    if (!stream)
+    {
+      std::cerr << "Cannot write the JSON file: " << sOutputJSON << std::endl;
+      return EXIT_FAILURE;
+    }
+    Report_JSON(reports, options, stream);
+  }
+
+  for (const Run_Report & report : reports)
+  {
+    if (!report.error_message.empty())
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,362 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/synthetic_data.hpp"
+
+#include "openMVG/cameras/Camera_Pinhole_Radial.hpp"
+#include "openMVG/geometry/pose3.hpp"
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/numeric/numeric.h"
+#include "openMVG/sfm/sfm_landmark.hpp"
+#include "openMVG/sfm/sfm_view.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace openMVG {
+namespace benchmark {
+
+using namespace openMVG::cameras;
+using namespace openMVG::geometry;
+using namespace openMVG::matching;
+using namespace openMVG::sfm;
+
+image::Image<unsigned char> Synthetic_Image
+(
+  int width,
+  int height,
+  uint32_t seed
+)
+{
+  std::mt19937 random_generator(seed);
+  std::uniform_real_distribution<float> x_distribution(0.f, width - 1.f);
+  std::uniform_real_distribution<float> y_distribution(0.f, height - 1.f);
+  std::uniform_real_distribution<float> sigma_distribution(1.5f, 10.f);
+  std::uniform_real_distribution<float> amplitude_distribution(40.f, 110.f);
+  std::bernoulli_distribution sign_distribution(0.5);
+  std::normal_distribution<float> noise_distribution(0.f, 3.f);
+
+  Eigen::MatrixXf canvas = Eigen::MatrixXf::Constant(height, width, 128.f);
+
+  // Rectangles (straight edges and corners)
+  const int rectangle_count = width * height / 20000;
+  for (int i = 0; i < rectangle_count; ++i)
+  {
+    const int x0 = x_distribution(random_generator), y0 = y_distribution(random_generator);
+    const int w = std::min<int>(width - x0, 8 + random_generator() % 64);
+    const int h = std::min<int>(height - y0, 8 + random_generator() % 64);
+    const float value = (sign_distribution(random_generator) ? 1.f : -1.f)
+      * amplitude_distribution(random_generator) / 2.f;
+    canvas.block(y0, x0, h, w).array() += value;
+  }
+
+  // Gaussian blobs (scale space extrema)
+  const int blob_count = width * height / 1000;
+  for (int i = 0; i < blob_count; ++i)
+  {
+    const float cx = x_distribution(random_generator), cy = y_distribution(random_generator);
+    const float sigma = sigma_distribution(random_generator);
+    const float amplitude = (sign_distribution(random_generator) ? 1.f : -1.f)
+      * amplitude_distribution(random_generator);
+    const int radius = static_cast<int>(std::ceil(3.f * sigma));
+    const int x_min = std::max(0, static_cast<int>(cx) - radius),
+      x_max = std::min(width - 1, static_cast<int>(cx) + radius),
+      y_min = std::max(0, static_cast<int>(cy) - radius),
+      y_max = std::min(height - 1, static_cast<int>(cy) + radius);
+    const float inv_two_sigma2 = 1.f / (2.f * sigma * sigma);
+    for (int y = y_min; y <= y_max; ++y)
+    {
+      for (int x = x_min; x <= x_max; ++x)
+      {
+        const float d2 = Square(x - cx) + Square(y - cy);
+        canvas(y, x) += amplitude * std::exp(-d2 * inv_two_sigma2);
+      }
+    }
+  }
+
+  image::Image<unsigned char> image(width, height);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      const float value = canvas(y, x) + noise_distribution(random_generator);
+      image(y, x) = static_cast<unsigned char>(
+        std::min(255.f, std::max(0.f, std::round(value))));
+    }
+  }
+  return image;
+}
+
+namespace {
+
+// SIFT like descriptor values: mostly small with a few large values
+template <typename Scalar>
+Descriptor_Dataset<Scalar> Synthetic_Gradient_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension,
+  float scale,
+  uint32_t seed
+)
+{
+  std::mt19937 random_generator(seed);
+  std::exponential_distribution<float> value_distribution(1.f / 24.f);
+  std::normal_distribution<float> noise_distribution(0.f, 6.f);
+  std::uniform_int_distribution<int> row_distribution(0, database_count - 1);
+
+  Descriptor_Dataset<Scalar> dataset;
+  dataset.dimension = dimension;
+  dataset.database_count = database_count;
+  dataset.query_count = query_count;
+  dataset.database.resize(static_cast<std::size_t>(database_count) * dimension);
+  dataset.query.resize(static_cast<std::size_t>(query_count) * dimension);
+  dataset.query_ground_truth.resize(query_count);
+
+  const auto clamp_value = [](float value) {
+    return std::min(255.f, std::max(0.f, std::round(value)));
+  };
+  for (auto & value : dataset.database)
+  {
+    value = static_cast<Scalar>(clamp_value(value_distribution(random_generator)) * scale);
+  }
+  for (int i = 0; i < query_count; ++i)
+  {
+    const int row = row_distribution(random_generator);
+    dataset.query_ground_truth[i] = row;
+    for (int d = 0; d < dimension; ++d)
+    {
+      const float value = dataset.database[row * dimension + d] / scale;
+      dataset.query[i * dimension + d] = static_cast<Scalar>(
+        clamp_value(value + noise_distribution(random_generator)) * scale);
+    }
+  }
+  return dataset;
+}
+
+} // namespace
+
+Descriptor_Dataset<float> Synthetic_Float_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension,
+  uint32_t seed
+)
+{
+  return Synthetic_Gradient_Descriptors<float>(
+    database_count, query_count, dimension, 1.f / 512.f, seed);
+}
+
+Descriptor_Dataset<uint8_t> Synthetic_Byte_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension,
+  uint32_t seed
+)
+{
+  return Synthetic_Gradient_Descriptors<uint8_t>(
+    database_count, query_count, dimension, 1.f, seed);
+}
+
+Descriptor_Dataset<uint8_t> Synthetic_Binary_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension,
+  uint32_t seed
+)
+{
+  std::mt19937 random_generator(seed);
+  std::uniform_int_distribution<int> byte_distribution(0, 255);
+  std::uniform_int_distribution<int> row_distribution(0, database_count - 1);
+  std::uniform_int_distribution<int> bit_distribution(0, dimension * 8 - 1);
+
+  Descriptor_Dataset<uint8_t> dataset;
+  dataset.dimension = dimension;
+  dataset.database_count = database_count;
+  dataset.query_count = query_count;
+  dataset.database.resize(static_cast<std::size_t>(database_count) * dimension);
+  dataset.query.resize(static_cast<std::size_t>(query_count) * dimension);
+  dataset.query_ground_truth.resize(query_count);
+
+  for (auto & value : dataset.database)
+    value = static_cast<uint8_t>(byte_distribution(random_generator));
+  for (int i = 0; i < query_count; ++i)
+  {
+    const int row = row_distribution(random_generator);
+    dataset.query_ground_truth[i] = row;
+    std::copy_n(&dataset.database[row * dimension], dimension, &dataset.query[i * dimension]);
+    // Flip 10% of the bits
+    for (int k = 0; k < dimension * 8 / 10; ++k)
+    {
+      const int bit = bit_distribution(random_generator);
+      dataset.query[i * dimension + bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+    }
+  }
+  return dataset;
+}
+
+Two_View_Dataset Synthetic_Two_View
+(
+  std::size_t correspondence_count,
+  double outlier_ratio,
+  bool b_planar,
+  uint32_t seed
+)
+{
+  std::mt19937 random_generator(seed);
+  std::uniform_real_distribution<double> unit_distribution(-1.0, 1.0);
+  std::normal_distribution<double> noise_distribution(0.0, 0.5);
+
+  Two_View_Dataset dataset;
+  dataset.width = 1000;
+  dataset.height = 1000;
+  dataset.K << 1000, 0, 500,
+               0, 1000, 500,
+               0, 0, 1;
+
+  // The first camera is the world frame, the second one is rotated and translated
+  const Mat3 R = RotationAroundY(D2R(10.0)) * RotationAroundX(D2R(3.0));
+  const Vec3 t(-1.0, 0.1, 0.2);
+  Mat34 P1, P2;
+  P_From_KRt(dataset.K, Mat3::Identity(), Vec3::Zero(), &P1);
+  P_From_KRt(dataset.K, R, t, &P2);
+
+  Mat3X X(3, correspondence_count);
+  for (std::size_t i = 0; i < correspondence_count; ++i)
+  {
+    const double x = 2.0 * unit_distribution(random_generator);
+    const double y = 2.0 * unit_distribution(random_generator);
+    const double z = b_planar ?
+      6.0 + 0.2 * x + 0.1 * y :
+      6.0 + 1.5 * unit_distribution(random_generator);
+    X.col(i) << x, y, z;
+  }
+  dataset.x1 = Project(P1, X);
+  dataset.x2 = Project(P2, X);
+
+  dataset.inlier_count = static_cast<std::size_t>(
+    std::round(correspondence_count * (1.0 - outlier_ratio)));
+  std::uniform_real_distribution<double> image_distribution(0.0, dataset.width - 1.0);
+  for (std::size_t i = 0; i < correspondence_count; ++i)
+  {
+    if (i < dataset.inlier_count)
+    {
+      dataset.x1.col(i) += Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+      dataset.x2.col(i) += Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+    }
+    else
+    {
+      dataset.x2.col(i) << image_distribution(random_generator), image_distribution(random_generator);
+    }
+  }
+
+  const Mat3 Kinv = dataset.K.inverse();
+  dataset.bearing1 = (Kinv * dataset.x1.colwise().homogeneous()).colwise().normalized();
+  dataset.bearing2 = (Kinv * dataset.x2.colwise().homogeneous()).colwise().normalized();
+  return dataset;
+}
+
+PairWiseMatches Synthetic_Pairwise_Matches
+(
+  int view_count,
+  int track_count,
+  int max_track_length,
+  double outlier_ratio,
+  uint32_t seed
+)
+{
+  max_track_length = std::max(2, std::min(max_track_length, view_count));
+
+  std::mt19937 random_generator(seed);
+  std::uniform_int_distribution<int> length_distribution(2, max_track_length);
+  std::uniform_int_distribution<int> view_distribution(0, view_count - 1);
+
+  std::vector<uint32_t> feature_count_per_view(view_count, 0);
+  PairWiseMatches map_pairwise_matches;
+  std::size_t match_count = 0;
+  for (int t = 0; t < track_count; ++t)
+  {
+    const int length = length_distribution(random_generator);
+    const int first_view = view_distribution(random_generator) % (view_count - length + 1);
+    std::vector<uint32_t> feat_ids(length);
+    for (int i = 0; i < length; ++i)
+      feat_ids[i] = feature_count_per_view[first_view + i]++;
+    for (int i = 0; i < length; ++i)
+    {
+      for (int j = i + 1; j < length; ++j)
+      {
+        map_pairwise_matches[{first_view + i, first_view + j}].emplace_back(feat_ids[i], feat_ids[j]);
+        ++match_count;
+      }
+    }
+  }
+  // Add some random matches (create track merges and conflicts)
+  const std::size_t outlier_count = match_count * outlier_ratio;
+  for (std::size_t i = 0; i < outlier_count; ++i)
+  {
+    const uint32_t I = view_distribution(random_generator);
+    const uint32_t J = view_distribution(random_generator);
+    if (I == J || feature_count_per_view[I] == 0 || feature_count_per_view[J] == 0)
+      continue;
+    map_pairwise_matches[{std::min(I, J), std::max(I, J)}].emplace_back(
+      random_generator() % feature_count_per_view[I],
+      random_generator() % feature_count_per_view[J]);
+  }
+  return map_pairwise_matches;
+}
+
+SfM_Data Synthetic_SfM_Scene
+(
+  int view_count,
+  int point_count,
+  uint32_t seed
+)
+{
+  // NRealisticCamerasRing uses the Eigen random generator (std::rand)
+  std::srand(seed);
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(view_count, point_count, config);
+
+  SfM_Data sfm_data;
+  const unsigned int w = config._cx * 2, h = config._cy * 2;
+  sfm_data.intrinsics[0] = std::make_shared<Pinhole_Intrinsic_Radial_K3>
+    (w, h, config._fx, config._cx, config._cy, 0., 0., 0.);
+
+  // Add a rotation to the ground truth poses (in order to make BA do some work)
+  const Mat3 rotation = RotationAroundX(D2R(6));
+  for (int i = 0; i < view_count; ++i)
+  {
+    sfm_data.views[i] = std::make_shared<View>("", i, 0, i, w, h);
+    sfm_data.poses[i] = Pose3(rotation * d._R[i], d._C[i]);
+  }
+
+  std::mt19937 random_generator(seed);
+  std::normal_distribution<double> noise_distribution(0.0, 0.1);
+  for (int i = 0; i < point_count; ++i)
+  {
+    Landmark landmark;
+    landmark.X = d._X.col(i);
+    for (int j = 0; j < view_count; ++j)
+    {
+      const Vec2 pt = d._x[j].col(i) +
+        Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+      landmark.obs[j] = Observation(pt, i);
+    }
+    sfm_data.structure[i] = landmark;
+  }
+  return sfm_data;
+}
+
+} // namespace benchmark
+} // namespace openMVG
@@ -0,0 +1,125 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_BENCHMARKS_SYNTHETIC_DATA_HPP
+#define OPENMVG_BENCHMARKS_SYNTHETIC_DATA_HPP
+
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/matching/indMatch.hpp"
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Synthetic data generators of the openMVG_benchmarks executable.
+// All the generators are deterministic: the same seed gives the same data,
+//  so the timings of two runs (or two revisions) are measured on the same inputs.
+
+namespace openMVG {
+namespace benchmark {
+
+const uint32_t kDefault_Seed = 5489u;
+
+/// Gray image textured with random gaussian blobs, rectangles and noise
+///  (give a feature detector a few thousands of keypoints)
+image::Image<unsigned char> Synthetic_Image
+(
+  int width,
+  int height,
+  uint32_t seed = kDefault_Seed
+);
+
+/// Descriptor arrays stored row by row. Each query is a noisy copy of a database row,
+///  so the nearest neighbor search has a meaningful answer.
+/// The storage is 32 bytes aligned (required by the AVX2 metrics).
+template <typename Scalar>
+struct Descriptor_Dataset
+{
+  int dimension = 0;
+  int database_count = 0;
+  int query_count = 0;
+  std::vector<Scalar, Eigen::aligned_allocator<Scalar>> database;
+  std::vector<Scalar, Eigen::aligned_allocator<Scalar>> query;
+  std::vector<int> query_ground_truth; // database row of each query
+};
+
+/// SIFT like descriptors (float values in [0, 0.5])
+Descriptor_Dataset<float> Synthetic_Float_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension = 128,
+  uint32_t seed = kDefault_Seed
+);
+
+/// SIFT like descriptors (byte values in [0, 255])
+Descriptor_Dataset<uint8_t> Synthetic_Byte_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension = 128,
+  uint32_t seed = kDefault_Seed
+);
+
+/// Binary descriptors (dimension is the byte count), queries have a few flipped bits
+Descriptor_Dataset<uint8_t> Synthetic_Binary_Descriptors
+(
+  int database_count,
+  int query_count,
+  int dimension = 64,
+  uint32_t seed = kDefault_Seed
+);
+
+/// Putative correspondences between two pinhole views (1000x1000 pixels images)
+struct Two_View_Dataset
+{
+  Mat3 K;
+  int width = 0, height = 0;
+  Mat2X x1, x2;             // pixel coordinates
+  Mat3X bearing1, bearing2; // unit bearing vectors
+  std::size_t inlier_count = 0; // the first inlier_count correspondences are inliers
+};
+
+/// Two views of a random point cloud (or of a plane if b_planar) with 0.5 pixel noise.
+/// outlier_ratio of the correspondences are replaced by random image points.
+Two_View_Dataset Synthetic_Two_View
+(
+  std::size_t correspondence_count,
+  double outlier_ratio,
+  bool b_planar,
+  uint32_t seed = kDefault_Seed
+);
+
+/// Pairwise matches of a synthetic sequence:
+///  - each track is observed by a random window of consecutive views,
+///  - its observations are linked by matches between all the view pairs of the window,
+///  - outlier_ratio random matches are added (they create track conflicts).
+matching::PairWiseMatches Synthetic_Pairwise_Matches
+(
+  int view_count,
+  int track_count,
+  int max_track_length,
+  double outlier_ratio,
+  uint32_t seed = kDefault_Seed
+);
+
+/// Scene of view_count pinhole cameras on a ring looking at point_count landmarks.
+/// The poses are rotated by 6 degrees and the observations have 0.1 pixel noise,
+///  so a bundle adjustment has some work to do.
+sfm::SfM_Data Synthetic_SfM_Scene
+(
+  int view_count,
+  int point_count,
+  uint32_t seed = kDefault_Seed
+);
+
+} // namespace benchmark
+} // namespace openMVG
+
+#endif // OPENMVG_BENCHMARKS_SYNTHETIC_DATA_HPP
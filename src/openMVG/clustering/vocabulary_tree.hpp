@@ -0,0 +1,190 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_CLUSTERING_VOCABULARY_TREE_HPP
+#define OPENMVG_CLUSTERING_VOCABULARY_TREE_HPP
+
+#include "openMVG/clustering/kmeans.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace openMVG
+{
+namespace clustering
+{
+
+/**
+* @brief Hierarchical kmeans vocabulary tree (Nister & Stewenius, CVPR 2006).
+* Each node is split in (at most) branching clusters by a kmeans of its descriptors,
+*  the leaves of the tree are the visual words.
+* A descriptor is quantized by descending the tree to the nearest child center,
+*  so its cost is O(branching * depth) distance computations.
+*/
+class VocabularyTree
+{
+  public:
+
+    VocabularyTree() = default;
+
+    /**
+    * @brief Build the tree from a descriptor sample
+    * @param descriptors Training descriptors (same dimension)
+    * @param branching Number of children of a node
+    * @param depth Maximal number of levels (at most branching^depth words)
+    * @param max_nb_iteration Maximal number of kmeans iterations per node
+    * @return true if the tree has been built
+    */
+    bool Train( const std::vector< std::vector< float > > & descriptors,
+                const uint32_t branching,
+                const uint32_t depth,
+                const uint32_t max_nb_iteration = 10 )
+    {
+      nodes_.clear();
+      centers_.clear();
+      word_count_ = 0;
+      if ( descriptors.empty() || branching < 2 || depth < 1 )
+      {
+        return false;
+      }
+      dimension_ = descriptors[0].size();
+
+      // Root node (its center is not used)
+      nodes_.push_back( {0, 0, 0} );
+      centers_.resize( dimension_, 0.f );
+
+      // Split the nodes level by level
+      std::vector< uint32_t > all_ids( descriptors.size() );
+      for ( uint32_t i = 0; i < all_ids.size(); ++i )
+      {
+        all_ids[i] = i;
+      }
+      std::vector< std::pair< uint32_t, std::vector< uint32_t > > > level_nodes;
+      level_nodes.emplace_back( 0, std::move( all_ids ) );
+
+      for ( uint32_t level = 0; level < depth && !level_nodes.empty(); ++level )
+      {
+        std::vector< std::pair< uint32_t, std::vector< uint32_t > > > next_level_nodes;
+        for ( auto & level_node : level_nodes )
+        {
+          const uint32_t node_id = level_node.first;
+          const std::vector< uint32_t > & ids = level_node.second;
+          if ( ids.size() <= branching )
+          {
+            continue; // too few descriptors to be split: the node is a leaf
+          }
+
+          std::vector< std::vector< float > > node_descriptors;
+          node_descriptors.reserve( ids.size() );
+          for ( const uint32_t id : ids )
+          {
+            node_descriptors.push_back( descriptors[id] );
+          }
+          std::vector< uint32_t > assignment;
+          std::vector< std::vector< float > > centers;
+          KMeans( node_descriptors, assignment, centers, branching, max_nb_iteration );
+
+          // Children are the non empty clusters (stored contiguously)
+          std::vector< std::vector< uint32_t > > cluster_ids( centers.size() );
+          for ( size_t i = 0; i < ids.size(); ++i )
+          {
+            cluster_ids[ assignment[i] ].push_back( ids[i] );
+          }
+          nodes_[node_id].first_child = static_cast<uint32_t>( nodes_.size() );
+          for ( size_t c = 0; c < centers.size(); ++c )
+          {
+            if ( cluster_ids[c].empty() )
+            {
+              continue;
+            }
+            const uint32_t child_id = static_cast<uint32_t>( nodes_.size() );
+            nodes_.push_back( {0, 0, 0} );
+            centers_.insert( centers_.end(), centers[c].cbegin(), centers[c].cend() );
+            ++nodes_[node_id].child_count;
+            next_level_nodes.emplace_back( child_id, std::move( cluster_ids[c] ) );
+          }
+        }
+        level_nodes.swap( next_level_nodes );
+      }
+
+      // Number the leaves
+      for ( auto & node : nodes_ )
+      {
+        if ( node.child_count == 0 )
+        {
+          node.word = word_count_++;
+        }
+      }
+      return true;
+    }
+
+    /// Number of visual words (leaves)
+    uint32_t WordCount() const
+    {
+      return word_count_;
+    }
+
+    /// Dimension of the descriptors
+    size_t Dimension() const
+    {
+      return dimension_;
+    }
+
+    /**
+    * @brief Quantize a descriptor
+    * @param descriptor Descriptor values (Dimension() values)
+    * @return the visual word of the descriptor
+    */
+    uint32_t Quantize( const float * descriptor ) const
+    {
+      uint32_t node_id = 0;
+      while ( nodes_[node_id].child_count > 0 )
+      {
+        const Node & node = nodes_[node_id];
+        float min_dist = std::numeric_limits<float>::max();
+        uint32_t nearest_child = node.first_child;
+        for ( uint32_t child_id = node.first_child; child_id < node.first_child + node.child_count; ++child_id )
+        {
+          const float * center = &centers_[ child_id * dimension_ ];
+          float dist = 0.f;
+          for ( size_t d = 0; d < dimension_; ++d )
+          {
+            const float diff = descriptor[d] - center[d];
+            dist += diff * diff;
+          }
+          if ( dist < min_dist )
+          {
+            min_dist = dist;
+            nearest_child = child_id;
+          }
+        }
+        node_id = nearest_child;
+      }
+      return nodes_[node_id].word;
+    }
+
+  private:
+
+    struct Node
+    {
+      uint32_t first_child; // index of the first child node (children are contiguous)
+      uint32_t child_count; // 0 for a leaf
+      uint32_t word;        // visual word of a leaf
+    };
+
+    std::vector< Node > nodes_;    // nodes_[0] is the root
+    std::vector< float > centers_; // center of the nodes (dimension_ values per node)
+    size_t dimension_ = 0;
+    uint32_t word_count_ = 0;
+};
+
+} // namespace clustering
+} // namespace openMVG
+
+#endif // OPENMVG_CLUSTERING_VOCABULARY_TREE_HPP
@@ -0,0 +1,83 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/clustering/vocabulary_tree.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace openMVG;
+using namespace clustering;
+
+TEST( clustering, vocabularyTree )
+{
+  // 4 well separated groups of 4 clusters of 100 points in dimension 8:
+  //  the 16 clusters can be recovered by a tree of branching 4 and depth 2
+  const int dimension = 8;
+  const int nb_group = 4;
+  const int nb_cluster_per_group = 4;
+  const int nb_cluster = nb_group * nb_cluster_per_group;
+  const int nb_point_per_cluster = 100;
+
+  std::mt19937_64 rng(std::mt19937_64::default_seed);
+  std::uniform_real_distribution<float> group_distrib(-1000.f, 1000.f);
+  std::uniform_real_distribution<float> cluster_distrib(-50.f, 50.f);
+  std::uniform_real_distribution<float> noise_distrib(-1.f, 1.f);
+
+  std::vector< std::vector< float > > centers;
+  for (int g = 0; g < nb_group; ++g)
+  {
+    std::vector< float > group_center(dimension);
+    for (auto & value : group_center)
+      value = group_distrib(rng);
+    for (int c = 0; c < nb_cluster_per_group; ++c)
+    {
+      std::vector< float > center = group_center;
+      for (auto & value : center)
+        value += cluster_distrib(rng);
+      centers.push_back(center);
+    }
+  }
+
+  std::vector< std::vector< float > > pts;
+  for (int c = 0; c < nb_cluster; ++c)
+  {
+    for (int i = 0; i < nb_point_per_cluster; ++i)
+    {
+      std::vector< float > pt = centers[c];
+      for (auto & value : pt)
+        value += noise_distrib(rng);
+      pts.push_back(pt);
+    }
+  }
+
+  VocabularyTree tree;
+  EXPECT_FALSE( tree.Train(std::vector< std::vector< float > >(), 4, 2) );
+  EXPECT_TRUE( tree.Train(pts, 4, 2) );
+  EXPECT_EQ( dimension, tree.Dimension() );
+  EXPECT_EQ( nb_cluster, tree.WordCount() );
+
+  // The points of a cluster are quantized to the same word, a word per cluster
+  std::set< uint32_t > cluster_words;
+  for (int c = 0; c < nb_cluster; ++c)
+  {
+    const uint32_t word = tree.Quantize(pts[c * nb_point_per_cluster].data());
+    EXPECT_TRUE( word < tree.WordCount() );
+    for (int i = 1; i < nb_point_per_cluster; ++i)
+      EXPECT_EQ( word, tree.Quantize(pts[c * nb_point_per_cluster + i].data()) );
+    cluster_words.insert(word);
+  }
+  EXPECT_EQ( nb_cluster, cluster_words.size() );
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
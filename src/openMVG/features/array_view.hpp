@@ -0,0 +1,62 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_FEATURES_ARRAY_VIEW_HPP
+#define OPENMVG_FEATURES_ARRAY_VIEW_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace openMVG {
+namespace features {
+
+/// Read-only view over count contiguous elements
+///  (i.e. regions kept in a std::vector or in a memory mapped file).
+/// The view is valid as long as the viewed container is not modified.
+template<typename T>
+class Array_View
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_reference = const T &;
+  using const_iterator = const T *;
+
+  Array_View() = default;
+  Array_View(const T * data, const size_t count) : data_(data), size_(count) {}
+
+  const T * data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  const T & operator[](const size_t i) const { assert(i < size_); return data_[i]; }
+  const T & front() const { assert(size_ > 0); return data_[0]; }
+  const T & back() const { assert(size_ > 0); return data_[size_ - 1]; }
+
+  /// Copy the viewed elements (i.e. for an API that takes a std::vector)
+  template<typename Alloc>
+  operator std::vector<T, Alloc>() const
+  {
+    return std::vector<T, Alloc>(begin(), end());
+  }
+
+private:
+  const T * data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // namespace features
+} // namespace openMVG
+
+#endif // OPENMVG_FEATURES_ARRAY_VIEW_HPP
@@ -9,9 +9,13 @@
 #ifndef OPENMVG_FEATURES_BINARY_REGIONS_HPP
 #define OPENMVG_FEATURES_BINARY_REGIONS_HPP
 
+#include <cassert>
+#include <memory>
 #include <typeinfo>
 
+#include "openMVG/features/array_view.hpp"
 #include "openMVG/features/regions.hpp"
+#include "openMVG/features/regions_binary_io.hpp"
 #include "openMVG/features/descriptor.hpp"
 #include "openMVG/matching/metric.hpp"
 
@@ -48,10 +52,15 @@ public:
   size_t DescriptorLength() const override {return static_cast<size_t>(L);}
 
   /// Read from files the regions and their corresponding descriptors.
+  /// If sfileNameFeats is a binary regions container, it is memory mapped
+  ///  (zero copy) and sfileNameDescs is ignored.
   bool Load(
     const std::string& sfileNameFeats,
     const std::string& sfileNameDescs) override
   {
+    if (isRegionsBinFile(sfileNameFeats))
+      return LoadBinary(sfileNameFeats);
+    mapped_file_.reset();
     return loadFeatsFromFile(sfileNameFeats, vec_feats_)
           & loadDescsFromBinFile(sfileNameDescs, vec_descs_);
   }
@@ -61,41 +70,84 @@ public:
     const std::string& sfileNameFeats,
     const std::string& sfileNameDescs) const override
   {
+    if (mapped_file_)
+    {
+      // Save a copy: the memory mapped regions are kept in use
+      const FeatsT feats(FeaturesData(), FeaturesData() + RegionCount());
+      const DescsT descs(DescriptorsData(), DescriptorsData() + RegionCount());
+      return saveFeatsToFile(sfileNameFeats, feats)
+            & saveDescsToBinFile(sfileNameDescs, descs);
+    }
     return saveFeatsToFile(sfileNameFeats, vec_feats_)
           & saveDescsToBinFile(sfileNameDescs, vec_descs_);
   }
 
   bool LoadFeatures(const std::string& sfileNameFeats) override
   {
+    if (isRegionsBinFile(sfileNameFeats))
+      return LoadBinary(sfileNameFeats);
+    mapped_file_.reset();
     return loadFeatsFromFile(sfileNameFeats, vec_feats_);
   }
 
+  /// Memory map a binary regions container (regions and descriptors).
+  /// The container is used in place until a mutable access is requested.
+  bool LoadBinary(const std::string& sfileNameRegions) override
+  {
+    vec_feats_.clear();
+    vec_descs_.clear();
+    mapped_file_.reset();
+    return mapRegionsBinFile(sfileNameRegions, true,
+      mapped_file_, mapped_feats_, mapped_descs_, mapped_count_);
+  }
+
+  /// Export the regions and their descriptors in a single binary regions container.
+  bool SaveBinary(const std::string& sfileNameRegions) const override
+  {
+    return saveRegionsToBinFile(sfileNameRegions,
+      FeaturesData(), DescriptorsData(), RegionCount(), true);
+  }
+
   PointFeatures GetRegionsPositions() const override
   {
-    return {vec_feats_.cbegin(), vec_feats_.cend()};
+    return {FeaturesData(), FeaturesData() + RegionCount()};
   }
 
   Vec2 GetRegionPosition(size_t i) const override
   {
-    return Vec2f(vec_feats_[i].coords()).cast<double>();
+    return Vec2f(FeaturesData()[i].coords()).cast<double>();
   }
 
   /// Return the number of defined regions
-  size_t RegionCount() const override {return vec_feats_.size();}
+  size_t RegionCount() const override
+  {
+    return mapped_file_ ? mapped_count_ : vec_feats_.size();
+  }
+
+  void Rescale(float factor) override
+  {
+    for (FeatT & feat : Features())
+      feat.Rescale(factor);
+  }
 
   /// Mutable and non-mutable FeatureT getters.
-  inline FeatsT & Features() { return vec_feats_; }
-  inline const FeatsT & Features() const { return vec_feats_; }
+  /// The mutable getter first copies the memory mapped regions (if any) to the containers.
+  /// The non-mutable getter does not modify the regions (memory mapped regions
+  ///  are shared by concurrent readers): it returns a view over the features,
+  ///  either in memory or memory mapped.
+  inline FeatsT & Features() { Detach(); return vec_feats_; }
+  inline Array_View<FeatureT> Features() const { return {FeaturesData(), RegionCount()}; }
 
-  /// Mutable and non-mutable DescriptorT getters.
-  inline DescsT & Descriptors() { return vec_descs_; }
-  inline const DescsT & Descriptors() const { return vec_descs_; }
+  /// Mutable and non-mutable DescriptorT getters (see Features()).
+  inline DescsT & Descriptors() { Detach(); return vec_descs_; }
+  inline Array_View<DescriptorT> Descriptors() const { return {DescriptorsData(), RegionCount()}; }
 
-  const void * DescriptorRawData() const override { return &vec_descs_[0];}
+  const void * DescriptorRawData() const override { return DescriptorsData();}
 
   template<class Archive>
   void serialize(Archive & ar)
   {
+    Detach();
     ar(vec_feats_, vec_descs_);
   }
 
@@ -107,30 +159,83 @@ public:
   // Return the squared Hamming distance between two descriptors
   double SquaredDescriptorDistance(size_t i, const Regions * regions, size_t j) const override
   {
-    assert(i < vec_descs_.size());
+    assert(i < RegionCount());
     assert(regions);
     assert(j < regions->RegionCount());
 
     const Binary_Regions<FeatT, L> * regionsT = dynamic_cast<const Binary_Regions<FeatT, L> *>(regions);
     matching::Hamming<unsigned char> metric;
     const typename matching::Hamming<unsigned char>::ResultType descDist =
-      metric(vec_descs_[i].data(), regionsT->vec_descs_[j].data(), DescriptorT::static_size);
+      metric(DescriptorsData()[i].data(), regionsT->DescriptorsData()[j].data(), DescriptorT::static_size);
     return descDist * descDist;
   }
 
+  // Return the squared Hamming distances between a descriptor and a set of descriptors
+  void SquaredDescriptorDistances
+  (
+    size_t i,
+    const Regions * regions,
+    const IndexT * j,
+    size_t count,
+    double * distances
+  ) const override
+  {
+    assert(i < RegionCount());
+    assert(regions);
+
+    const Binary_Regions<FeatT, L> * regionsT = dynamic_cast<const Binary_Regions<FeatT, L> *>(regions);
+    const unsigned char * query = DescriptorsData()[i].data();
+    const DescriptorT * descriptors = regionsT->DescriptorsData();
+    matching::Hamming<unsigned char> metric;
+    for (size_t k = 0; k < count; ++k)
+    {
+      assert(j[k] < regions->RegionCount());
+      const typename matching::Hamming<unsigned char>::ResultType descDist =
+        metric(query, descriptors[j[k]].data(), DescriptorT::static_size);
+      distances[k] = descDist * descDist;
+    }
+  }
+
   /// Add the Inth region to another Region container
   void CopyRegion(size_t i, Regions * region_container) const override
   {
-    assert(i < vec_feats_.size() && i < vec_descs_.size());
-    static_cast<Binary_Regions<FeatT, L> *>(region_container)->vec_feats_.push_back(vec_feats_[i]);
-    static_cast<Binary_Regions<FeatT, L> *>(region_container)->vec_descs_.push_back(vec_descs_[i]);
+    assert(i < RegionCount());
+    static_cast<Binary_Regions<FeatT, L> *>(region_container)->Features().push_back(FeaturesData()[i]);
+    static_cast<Binary_Regions<FeatT, L> *>(region_container)->Descriptors().push_back(DescriptorsData()[i]);
   }
 
 private:
+
+  const FeatureT * FeaturesData() const
+  {
+    return mapped_file_ ? mapped_feats_ : vec_feats_.data();
+  }
+
+  const DescriptorT * DescriptorsData() const
+  {
+    return mapped_file_ ? mapped_descs_ : vec_descs_.data();
+  }
+
+  /// Copy the memory mapped regions (if any) to the containers and release the mapping.
+  void Detach()
+  {
+    if (!mapped_file_)
+      return;
+    vec_feats_.assign(mapped_feats_, mapped_feats_ + mapped_count_);
+    vec_descs_.assign(mapped_descs_, mapped_descs_ + mapped_count_);
+    mapped_file_.reset();
+  }
+
   //--
   //-- internal data
   FeatsT vec_feats_; // region features
   DescsT vec_descs_; // region descriptions
+
+  //-- memory mapped binary regions container (used in place when valid)
+  std::shared_ptr<const system::Mapped_File> mapped_file_;
+  const FeatureT * mapped_feats_ = nullptr;
+  const DescriptorT * mapped_descs_ = nullptr;
+  size_t mapped_count_ = 0;
 };
 
 } // namespace features
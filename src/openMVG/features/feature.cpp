@@ -26,6 +26,12 @@ float& PointFeature::x() { return coords_(0); }
 float& PointFeature::y() { return coords_(1); }
 Vec2f& PointFeature::coords() { return coords_;}
 
+void PointFeature::Rescale(float factor)
+{
+  // The reduced pixel (x, y) covers the original pixels [x * factor; (x+1) * factor[
+  coords_ = (coords_.array() + 0.5f) * factor - 0.5f;
+}
+
 
 //with overloaded operators:
 std::ostream& operator<<(std::ostream& out, const PointFeature& obj)
@@ -58,6 +64,12 @@ float& SIOPointFeature::scale() { return scale_; }
 float SIOPointFeature::orientation() const { return orientation_; }
 float& SIOPointFeature::orientation() { return orientation_; }
 
+void SIOPointFeature::Rescale(float factor)
+{
+  PointFeature::Rescale(factor);
+  scale_ *= factor;
+}
+
 bool SIOPointFeature::operator ==(const SIOPointFeature& b) const {
   return (scale_ == b.scale()) &&
          (orientation_ == b.orientation()) &&
@@ -134,6 +146,17 @@ float AffinePointFeature::l1() const { return l1_; }
 float AffinePointFeature::l2() const { return l2_; }
 float AffinePointFeature::orientation() const { return phi_; }
 
+void AffinePointFeature::Rescale(float factor)
+{
+  PointFeature::Rescale(factor);
+  // Ellipse x^T [a b; b c] x = 1
+  l1_ *= factor;
+  l2_ *= factor;
+  a_ /= factor * factor;
+  b_ /= factor * factor;
+  c_ /= factor * factor;
+}
+
 bool AffinePointFeature::operator ==(const AffinePointFeature& b) const {
   return ((x() == b.x()) && (y() == b.y() &&
     (l1_ == b.l1_) && (l2_ == b.l2_) && (phi_ == b.phi_)));
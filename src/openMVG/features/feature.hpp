@@ -40,6 +40,10 @@ public:
   float& y();
   Vec2f& coords();
 
+  /// Express the feature detected in an image reduced by 1/factor in the
+  ///  original image frame (pixel centers are at integer coordinates)
+  void Rescale(float factor);
+
   template<class Archive>
   void serialize(Archive & ar)
   {
@@ -72,6 +76,9 @@ public:
   float orientation() const;
   float& orientation();
 
+  /// Express the feature in the original image frame (see PointFeature::Rescale)
+  void Rescale(float factor);
+
   bool operator ==(const SIOPointFeature& b) const;
 
   bool operator !=(const SIOPointFeature& b) const;
@@ -120,6 +127,9 @@ public:
   float l2() const;
   float orientation() const;
 
+  /// Express the feature in the original image frame (see PointFeature::Rescale)
+  void Rescale(float factor);
+
   bool operator ==(const AffinePointFeature& b) const;
 
   bool operator !=(const AffinePointFeature& rhs) const;
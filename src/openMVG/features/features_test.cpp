@@ -8,6 +8,7 @@
 
 #include "openMVG/features/feature.hpp"
 #include "openMVG/features/descriptor.hpp"
+#include "openMVG/features/regions_factory.hpp"
 
 #include "testing/testing.h"
 
@@ -129,6 +130,102 @@ TEST(descriptorIO, BINARY) {
   }
 }
 
+//--
+//-- Binary regions container test
+//--
+TEST(regionsIO, BINARY) {
+  SIFT_Regions regions;
+  for (int i = 0; i < CARD; ++i)
+  {
+    regions.Features().emplace_back(i, i*2, i*3, i*4);
+    SIFT_Regions::DescriptorT desc;
+    for (int j = 0; j < SIFT_Regions::DescriptorT::static_size; ++j)
+      desc[j] = static_cast<unsigned char>(i + j);
+    regions.Descriptors().emplace_back(desc);
+  }
+
+  //Save them to a file
+  EXPECT_TRUE(regions.SaveBinary("tempRegions.feat"));
+  EXPECT_TRUE(isRegionsBinFile("tempRegions.feat"));
+
+  //Read the saved data (memory mapped) and compare to input
+  SIFT_Regions regions_read;
+  EXPECT_TRUE(regions_read.Load("tempRegions.feat", "unused.desc"));
+  EXPECT_EQ(CARD, regions_read.RegionCount());
+  for (int i = 0; i < CARD; ++i)
+  {
+    EXPECT_EQ(regions.GetRegionPosition(i), regions_read.GetRegionPosition(i));
+    EXPECT_EQ(0.0, regions.SquaredDescriptorDistance(i, &regions_read, i));
+  }
+
+  // Saving the mapped regions as a .feat/.desc pair keeps them mapped
+  const void * mapped_descriptors = regions_read.DescriptorRawData();
+  const SIFT_Regions & const_regions_read = regions_read;
+  EXPECT_TRUE(const_regions_read.Save("tempFeats.feat", "tempDescs.desc"));
+  EXPECT_EQ(mapped_descriptors, regions_read.DescriptorRawData());
+  SIFT_Regions regions_pair;
+  EXPECT_TRUE(regions_pair.Load("tempFeats.feat", "tempDescs.desc"));
+  EXPECT_EQ(CARD, regions_pair.RegionCount());
+  for (int i = 0; i < CARD; ++i)
+  {
+    EXPECT_EQ(regions.GetRegionPosition(i), regions_pair.GetRegionPosition(i));
+    EXPECT_EQ(0.0, regions.SquaredDescriptorDistance(i, &regions_pair, i));
+  }
+
+  // Non-mutable access views the mapped data (the regions stay mapped)
+  EXPECT_EQ(CARD, const_regions_read.Features().size());
+  EXPECT_EQ(CARD, const_regions_read.Descriptors().size());
+  for (int i = 0; i < CARD; ++i)
+  {
+    EXPECT_EQ(regions.Features()[i], const_regions_read.Features()[i]);
+    EXPECT_TRUE(regions.Descriptors()[i] == const_regions_read.Descriptors()[i]);
+  }
+  const std::vector<SIOPointFeature> feats_copy = const_regions_read.Features();
+  EXPECT_TRUE(regions.Features() == feats_copy);
+  EXPECT_EQ(mapped_descriptors, const_regions_read.Descriptors().data());
+
+  // Mutable access copies the mapped data to the containers
+  EXPECT_EQ(CARD, regions_read.Features().size());
+  for (int i = 0; i < CARD; ++i)
+  {
+    EXPECT_EQ(regions.Features()[i], regions_read.Features()[i]);
+    for (int j = 0; j < SIFT_Regions::DescriptorT::static_size; ++j)
+      EXPECT_EQ(regions.Descriptors()[i][j], regions_read.Descriptors()[i][j]);
+  }
+
+  // A region container of another type must be rejected
+  AKAZE_Binary_Regions other_regions;
+  EXPECT_FALSE(other_regions.LoadBinary("tempRegions.feat"));
+
+  // Non-mutable access to mapped binary regions
+  AKAZE_Binary_Regions binary_regions;
+  for (int i = 0; i < CARD; ++i)
+  {
+    binary_regions.Features().emplace_back(i, i*2, i*3, i*4);
+    AKAZE_Binary_Regions::DescriptorT desc;
+    desc.fill(0);
+    desc[i] = static_cast<unsigned char>(i + 1);
+    binary_regions.Descriptors().emplace_back(desc);
+  }
+  EXPECT_TRUE(binary_regions.SaveBinary("tempBinaryRegions.feat"));
+  AKAZE_Binary_Regions binary_regions_read;
+  EXPECT_TRUE(binary_regions_read.LoadBinary("tempBinaryRegions.feat"));
+  const AKAZE_Binary_Regions & const_binary_regions_read = binary_regions_read;
+  const void * mapped_binary_descriptors = binary_regions_read.DescriptorRawData();
+  EXPECT_EQ(CARD, const_binary_regions_read.Features().size());
+  EXPECT_EQ(CARD, const_binary_regions_read.Descriptors().size());
+  for (int i = 0; i < CARD; ++i)
+  {
+    EXPECT_EQ(binary_regions.Features()[i], const_binary_regions_read.Features()[i]);
+    EXPECT_TRUE(binary_regions.Descriptors()[i] == const_binary_regions_read.Descriptors()[i]);
+  }
+  EXPECT_EQ(mapped_binary_descriptors, binary_regions_read.DescriptorRawData());
+
+  // The ASCII feature file is not a binary container
+  EXPECT_TRUE(saveFeatsToFile("tempFeats.feat", regions.Features()));
+  EXPECT_FALSE(isRegionsBinFile("tempFeats.feat"));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -13,6 +13,7 @@
 #include <openMVG/features/feature.hpp>
 #include <openMVG/features/feature_container.hpp>
 #include <openMVG/numeric/eigen_alias_definition.hpp>
+#include <openMVG/types.hpp>
 
 namespace openMVG {
 namespace features {
@@ -40,6 +41,17 @@ public:
   virtual bool LoadFeatures(
     const std::string& sfileNameFeats) = 0;
 
+  //--
+  // IO - one binary file for region features and descriptors
+  //  (see regions_binary_io.hpp for the file layout)
+  //--
+
+  virtual bool LoadBinary(
+    const std::string& sfileNameRegions) = 0;
+
+  virtual bool SaveBinary(
+    const std::string& sfileNameRegions) const = 0;
+
   //--
   //- Basic description of a descriptor [Type, Length]
   //--
@@ -58,6 +70,10 @@ public:
   /// Return the number of defined regions
   virtual size_t RegionCount() const = 0;
 
+  /// Express the regions detected in an image reduced by 1/factor
+  ///  in the original image frame (positions and scales)
+  virtual void Rescale(float factor) = 0;
+
   /// Return a pointer to the first value of the descriptor array
   // Used to avoid complex template imbrication
   virtual const void * DescriptorRawData() const = 0;
@@ -71,6 +87,16 @@ public:
     const Regions *,
     size_t j) const = 0;
 
+  /// Return the squared distances between the descriptor i and a set of
+  ///  descriptors of another regions container (batched version of
+  ///  SquaredDescriptorDistance: one virtual call for all the descriptors)
+  virtual void SquaredDescriptorDistances(
+    size_t i,
+    const Regions *,
+    const IndexT * j,
+    size_t count,
+    double * distances) const = 0;
+
   /// Add the Inth region to another Region container
   virtual void CopyRegion(size_t i, Regions *) const = 0;
 
@@ -0,0 +1,162 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_FEATURES_REGIONS_BINARY_IO_HPP
+#define OPENMVG_FEATURES_REGIONS_BINARY_IO_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "openMVG/system/mapped_file.hpp"
+
+namespace openMVG {
+namespace features {
+
+/// Binary regions container (one file per image, usually named *.feat):
+///  - a Regions_Binary_Header,
+///  - the packed region features (region_count * feature_size bytes),
+///  - the packed descriptors (region_count * descriptor_length * descriptor_value_size bytes).
+/// Each data block starts at an offset aligned on REGIONS_BINARY_ALIGNMENT bytes
+/// so the file can be memory mapped and used in place (zero copy).
+/// Values are stored in the host byte order.
+struct Regions_Binary_Header
+{
+  char magic[8];                   // REGIONS_BINARY_MAGIC
+  uint32_t version;                // REGIONS_BINARY_VERSION
+  uint32_t is_binary;              // 0: scalar descriptor, 1: binary descriptor
+  uint64_t region_count;           // number of regions
+  uint32_t feature_size;           // size in bytes of one region feature
+  uint32_t descriptor_length;      // number of values per descriptor
+  uint32_t descriptor_value_size;  // size in bytes of one descriptor value
+  uint32_t reserved;
+  uint64_t features_offset;        // offset in bytes of the feature block
+  uint64_t descriptors_offset;     // offset in bytes of the descriptor block
+};
+
+static const char REGIONS_BINARY_MAGIC[8] = {'O', 'M', 'V', 'G', 'R', 'E', 'G', '\0'};
+static const uint32_t REGIONS_BINARY_VERSION = 1;
+static const uint64_t REGIONS_BINARY_ALIGNMENT = 64;
+
+/// Return true if the file is a binary regions container
+inline bool isRegionsBinFile(const std::string & sfileName)
+{
+  std::ifstream fileIn(sfileName.c_str(), std::ios::in | std::ios::binary);
+  if (!fileIn.is_open())
+    return false;
+  char magic[sizeof(REGIONS_BINARY_MAGIC)];
+  fileIn.read(magic, sizeof(magic));
+  return fileIn.good()
+    && std::memcmp(magic, REGIONS_BINARY_MAGIC, sizeof(REGIONS_BINARY_MAGIC)) == 0;
+}
+
+/// Write regions and their descriptors to a single binary regions container
+template<typename FeatureT, typename DescriptorT>
+inline bool saveRegionsToBinFile(
+  const std::string & sfileName,
+  const FeatureT * feats,
+  const DescriptorT * descs,
+  const std::size_t region_count,
+  const bool bBinaryDescriptor)
+{
+  static_assert(!std::is_polymorphic<FeatureT>::value,
+    "Region features must be plain data to be stored in a binary regions file");
+  static_assert(sizeof(DescriptorT) ==
+    DescriptorT::static_size * sizeof(typename DescriptorT::bin_type),
+    "Descriptors must be tightly packed to be stored in a binary regions file");
+
+  const auto align = [](uint64_t offset)
+  {
+    return (offset + REGIONS_BINARY_ALIGNMENT - 1)
+      / REGIONS_BINARY_ALIGNMENT * REGIONS_BINARY_ALIGNMENT;
+  };
+
+  Regions_Binary_Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, REGIONS_BINARY_MAGIC, sizeof(REGIONS_BINARY_MAGIC));
+  header.version = REGIONS_BINARY_VERSION;
+  header.is_binary = bBinaryDescriptor ? 1 : 0;
+  header.region_count = region_count;
+  header.feature_size = sizeof(FeatureT);
+  header.descriptor_length = DescriptorT::static_size;
+  header.descriptor_value_size = sizeof(typename DescriptorT::bin_type);
+  header.features_offset = align(sizeof(Regions_Binary_Header));
+  header.descriptors_offset =
+    align(header.features_offset + region_count * sizeof(FeatureT));
+
+  std::ofstream file(sfileName.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  const std::vector<char> padding(REGIONS_BINARY_ALIGNMENT, 0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(padding.data(), header.features_offset - sizeof(header));
+  if (region_count > 0)
+  {
+    file.write(reinterpret_cast<const char*>(feats), region_count * sizeof(FeatureT));
+    file.write(padding.data(),
+      header.descriptors_offset - header.features_offset - region_count * sizeof(FeatureT));
+    file.write(reinterpret_cast<const char*>(descs), region_count * sizeof(DescriptorT));
+  }
+  const bool bOk = file.good();
+  file.close();
+  return bOk;
+}
+
+/// Memory map a binary regions container and return pointers to its content.
+/// The returned pointers remain valid as long as the mapped_file is alive.
+template<typename FeatureT, typename DescriptorT>
+inline bool mapRegionsBinFile(
+  const std::string & sfileName,
+  const bool bBinaryDescriptor,
+  std::shared_ptr<const system::Mapped_File> & mapped_file,
+  const FeatureT * & feats,
+  const DescriptorT * & descs,
+  std::size_t & region_count)
+{
+  std::shared_ptr<system::Mapped_File> mapping = std::make_shared<system::Mapped_File>();
+  if (!mapping->open(sfileName) || mapping->size() < sizeof(Regions_Binary_Header))
+    return false;
+
+  Regions_Binary_Header header;
+  std::memcpy(&header, mapping->data(), sizeof(header));
+
+  // Check that the file content matches the requested region type
+  if (std::memcmp(header.magic, REGIONS_BINARY_MAGIC, sizeof(REGIONS_BINARY_MAGIC)) != 0
+      || header.version != REGIONS_BINARY_VERSION
+      || header.is_binary != (bBinaryDescriptor ? 1u : 0u)
+      || header.feature_size != sizeof(FeatureT)
+      || header.descriptor_length != DescriptorT::static_size
+      || header.descriptor_value_size != sizeof(typename DescriptorT::bin_type)
+      || header.features_offset % REGIONS_BINARY_ALIGNMENT != 0
+      || header.descriptors_offset % REGIONS_BINARY_ALIGNMENT != 0)
+  {
+    return false;
+  }
+  // Check that the file is large enough to hold the announced regions
+  if (header.features_offset + header.region_count * sizeof(FeatureT) > mapping->size()
+      || header.descriptors_offset + header.region_count * sizeof(DescriptorT) > mapping->size())
+  {
+    return false;
+  }
+
+  feats = reinterpret_cast<const FeatureT*>(mapping->data() + header.features_offset);
+  descs = reinterpret_cast<const DescriptorT*>(mapping->data() + header.descriptors_offset);
+  region_count = static_cast<std::size_t>(header.region_count);
+  mapped_file = std::move(mapping);
+  return true;
+}
+
+} // namespace features
+} // namespace openMVG
+
+#endif // OPENMVG_FEATURES_REGIONS_BINARY_IO_HPP
@@ -8,6 +8,7 @@
 
 #include "openMVG/image/image_io.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -132,6 +133,39 @@ int ReadJpgStream(FILE * file,
                   int * w,
                   int * h,
                   int * depth) {
+  return ReadJpgReducedStream(file, 1, false, ptr, w, h, depth);
+}
+
+int ReadJpgReduced(const char * filename,
+                   int scale_denom,
+                   bool gray,
+                   std::vector<unsigned char> * ptr,
+                   int * w,
+                   int * h,
+                   int * depth) {
+
+  FILE *file = fopen(filename, "rb");
+  if (!file) {
+    std::cerr << "Error: Couldn't open " << filename << " fopen returned 0";
+    return 0;
+  }
+  int res = ReadJpgReducedStream(file, scale_denom, gray, ptr, w, h, depth);
+  fclose(file);
+  return res;
+}
+
+int ReadJpgReducedStream(FILE * file,
+                         int scale_denom,
+                         bool gray,
+                         std::vector<unsigned char> * ptr,
+                         int * w,
+                         int * h,
+                         int * depth) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != 8) {
+    std::cerr << "Error JPG: Invalid scale denominator " << scale_denom;
+    return 0;
+  }
+
   jpeg_decompress_struct cinfo;
   struct my_error_mgr jerr;
   cinfo.err = jpeg_std_error(&jerr.pub);
@@ -146,6 +180,12 @@ int ReadJpgStream(FILE * file,
   jpeg_create_decompress(&cinfo);
   jpeg_stdio_src(&cinfo, file);
   jpeg_read_header(&cinfo, TRUE);
+  // Scaled inverse DCT: the image is directly decoded at the reduced size
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = scale_denom;
+  // The luminance of YCbCr images is decoded alone (the chroma is skipped)
+  if (gray && (cinfo.jpeg_color_space == JCS_YCbCr || cinfo.jpeg_color_space == JCS_GRAYSCALE))
+    cinfo.out_color_space = JCS_GRAYSCALE;
   jpeg_start_decompress(&cinfo);
 
   int row_stride = cinfo.output_width * cinfo.output_components;
@@ -859,5 +899,77 @@ bool Read_TIFF_ImageHeader(const char * filename, ImageHeader * imgheader)
   return bStatus;
 }
 
+// Reduce an image by averaging the pixels of each scale_denom x scale_denom block
+//  (the blocks of the last row and column are truncated to the image)
+static void ImageBoxReduce(const Image<unsigned char> & src,
+                           int scale_denom,
+                           Image<unsigned char> * out) {
+  const int width = (src.Width() + scale_denom - 1) / scale_denom;
+  const int height = (src.Height() + scale_denom - 1) / scale_denom;
+  out->resize(width, height);
+  std::vector<unsigned int> row_sums(width);
+  for (int y = 0; y < height; ++y) {
+    std::fill(row_sums.begin(), row_sums.end(), 0);
+    const int src_y_end = std::min((y + 1) * scale_denom, src.Height());
+    for (int src_y = y * scale_denom; src_y < src_y_end; ++src_y)
+      for (int src_x = 0; src_x < src.Width(); ++src_x)
+        row_sums[src_x / scale_denom] += src(src_y, src_x);
+    for (int x = 0; x < width; ++x) {
+      const int block_width = std::min((x + 1) * scale_denom, src.Width()) - x * scale_denom;
+      const int block_size = block_width * (src_y_end - y * scale_denom);
+      (*out)(y, x) = static_cast<unsigned char>((row_sums[x] + block_size / 2) / block_size);
+    }
+  }
+}
+
+int ReadImageReduced(const char * filename,
+                     int scale_denom,
+                     Image<unsigned char> * im) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != 8) {
+    std::cerr << "Error: Invalid scale denominator " << scale_denom;
+    return 0;
+  }
+
+  if (GetFormat(filename) != Jpg) {
+    if (scale_denom == 1)
+      return ReadImage(filename, im);
+    Image<unsigned char> full_image;
+    if (!ReadImage(filename, &full_image))
+      return 0;
+    ImageBoxReduce(full_image, scale_denom, im);
+    return 1;
+  }
+
+  std::vector<unsigned char> ptr;
+  int w, h, depth;
+  if (!ReadJpgReduced(filename, scale_denom, true, &ptr, &w, &h, &depth))
+    return 0;
+  if (depth == 1) {
+    ( *im ) = Eigen::Map<Image<unsigned char>::Base>( &ptr[0], h, w );
+  }
+  else if (depth == 3) {
+    //-- The color space does not allow a luminance only decoding (i.e RGB JPEG)
+    RGBColor * ptrCol = reinterpret_cast<RGBColor*>( &ptr[0] );
+    Image<RGBColor> rgbColIm;
+    rgbColIm = Eigen::Map<Image<RGBColor>::Base>( ptrCol, h, w );
+    ConvertPixelType( rgbColIm, im );
+  }
+  else {
+    std::cerr << "Error JPG: Unsupported number of channels " << depth;
+    return 0;
+  }
+  return 1;
+}
+
+int ReducedScaleDenom(const ImageHeader & hdr, int max_dimension) {
+  int scale_denom = 1;
+  if (max_dimension > 0) {
+    const int dimension = std::max(hdr.width, hdr.height);
+    while (scale_denom < 8 && (dimension + scale_denom - 1) / scale_denom > max_dimension)
+      scale_denom *= 2;
+  }
+  return scale_denom;
+}
+
 }  // namespace image
 }  // namespace openMVG
@@ -175,6 +175,28 @@ int ReadJpg( const char * path , std::vector<unsigned char> * array, int * w, in
 */
 int ReadJpgStream( FILE * stream , std::vector<unsigned char> * array, int * w, int * h, int * depth );
 
+/**
+* @brief Read JPEG image from file at a reduced resolution
+* The image is downscaled in the DCT domain while decoding (the full resolution
+*  image is never decoded) and the luminance can be decoded alone.
+* The image size is ceil(width / scale_denom) x ceil(height / scale_denom).
+* @param[in] path Input filepath
+* @param[in] scale_denom Downscale factor (1, 2, 4 or 8)
+* @param[in] gray Decode only the luminance (if the color space allows it)
+* @param[out] array Output image data
+* @param[out] w Image width
+* @param[out] h Image height
+* @param[out] depth Depth of image
+* @retval 0 if there is an error during read operation
+* @return non nul value if read operation is valid
+*/
+int ReadJpgReduced( const char * path , int scale_denom, bool gray, std::vector<unsigned char> * array, int * w, int * h, int * depth );
+
+/**
+* @brief Read JPEG image from stream at a reduced resolution (see ReadJpgReduced)
+*/
+int ReadJpgReducedStream( FILE * stream , int scale_denom, bool gray, std::vector<unsigned char> * array, int * w, int * h, int * depth );
+
 /**
 * @brief Write JPEG file
 * @param path Output image path
@@ -355,6 +377,28 @@ bool Read_PNM_ImageHeader( const char * path , ImageHeader * hdr );
 */
 bool Read_TIFF_ImageHeader( const char * path , ImageHeader * hdr );
 
+/**
+* @brief Read a gray image at a reduced resolution
+* JPEG images are downscaled and converted to gray while decoding (see ReadJpgReduced),
+*  the other formats are decoded at full resolution and then box filtered.
+* The image size is ceil(width / scale_denom) x ceil(height / scale_denom).
+* @param[in] path Input image path
+* @param[in] scale_denom Downscale factor (1, 2, 4 or 8)
+* @param[out] im Output image
+* @retval 0 if there was an error during read operation
+* @retval 1 if read is correct
+*/
+int ReadImageReduced( const char * path , int scale_denom, Image<unsigned char> * im );
+
+/**
+* @brief Smallest downscale factor (1, 2, 4 or 8) for which the reduced image
+*  dimensions do not exceed max_dimension (the largest factor if none fits)
+* @param hdr Full resolution image header
+* @param max_dimension Maximal image width or height (0: no limit)
+* @return Downscale factor to use with ReadImageReduced
+*/
+int ReducedScaleDenom( const ImageHeader & hdr , int max_dimension );
+
 
 /**
 * @brief Generic Image read from file
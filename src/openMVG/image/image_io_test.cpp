@@ -126,6 +126,73 @@ TEST(ImageIOTest, Jpg) {
   remove(filename.c_str());
 }
 
+// Smooth color image (odd size: the last reduced pixels cover truncated blocks)
+static Image<RGBColor> MakeGradientImage() {
+  Image<RGBColor> image(101, 75);
+  for (int y = 0; y < image.Height(); ++y)
+    for (int x = 0; x < image.Width(); ++x)
+      image(y, x) = RGBColor(2 * x, 3 * y, x + y);
+  return image;
+}
+
+TEST(ImageIOTest, Jpg_Reduced) {
+  const std::string filename = ("test_reduced_jpg.jpg");
+  EXPECT_TRUE(WriteJpg(filename.c_str(), MakeGradientImage(), 100));
+
+  Image<unsigned char> full_image;
+  EXPECT_TRUE(ReadImage(filename.c_str(), &full_image));
+  for (const int scale_denom : {1, 2, 4, 8}) {
+    Image<unsigned char> reduced_image;
+    EXPECT_TRUE(ReadImageReduced(filename.c_str(), scale_denom, &reduced_image));
+    EXPECT_EQ((101 + scale_denom - 1) / scale_denom, reduced_image.Width());
+    EXPECT_EQ((75 + scale_denom - 1) / scale_denom, reduced_image.Height());
+    // The DCT domain scaling is close to the block average of the full resolution image
+    for (int y = 0; y < reduced_image.Height(); ++y)
+      for (int x = 0; x < reduced_image.Width(); ++x) {
+        const auto block = full_image.block(y * scale_denom, x * scale_denom,
+          std::min(scale_denom, full_image.Height() - y * scale_denom),
+          std::min(scale_denom, full_image.Width() - x * scale_denom));
+        const double mean = block.cast<double>().mean();
+        EXPECT_TRUE(std::abs(reduced_image(y, x) - mean) <= 4.0);
+      }
+  }
+  EXPECT_FALSE(ReadImageReduced(filename.c_str(), 3, &full_image));
+  remove(filename.c_str());
+}
+
+TEST(ImageIOTest, Png_Reduced) {
+  Image<unsigned char> image(5, 3);
+  for (int y = 0; y < image.Height(); ++y)
+    for (int x = 0; x < image.Width(); ++x)
+      image(y, x) = 10 * (y * image.Width() + x);
+  const std::string filename = ("test_reduced_png.png");
+  EXPECT_TRUE(WriteImage(filename.c_str(), image));
+
+  // Average of the 2x2 blocks (truncated on the borders)
+  Image<unsigned char> reduced_image;
+  EXPECT_TRUE(ReadImageReduced(filename.c_str(), 2, &reduced_image));
+  EXPECT_EQ(3, reduced_image.Width());
+  EXPECT_EQ(2, reduced_image.Height());
+  EXPECT_EQ(30, reduced_image(0, 0));
+  EXPECT_EQ(50, reduced_image(0, 1));
+  EXPECT_EQ(65, reduced_image(0, 2));
+  EXPECT_EQ(105, reduced_image(1, 0));
+  EXPECT_EQ(140, reduced_image(1, 2));
+  remove(filename.c_str());
+}
+
+TEST(ImageHeader, ReducedScaleDenom) {
+  ImageHeader header;
+  header.width = 7728;
+  header.height = 5152;
+  EXPECT_EQ(1, ReducedScaleDenom(header, 0));
+  EXPECT_EQ(1, ReducedScaleDenom(header, 8000));
+  EXPECT_EQ(2, ReducedScaleDenom(header, 4000));
+  EXPECT_EQ(4, ReducedScaleDenom(header, 1932));
+  EXPECT_EQ(8, ReducedScaleDenom(header, 1931));
+  EXPECT_EQ(8, ReducedScaleDenom(header, 100));
+}
+
 TEST(ReadPnm, Pgm) {
   Image<unsigned char> image;
   const std::string pgm_filename = string(THIS_SOURCE_DIR) + "/image_test/two_pixels.pgm";
@@ -72,6 +72,8 @@ class PairWiseMatchesContainer
 public:
   virtual ~PairWiseMatchesContainer() = default;
   virtual void insert(std::pair<Pair, IndMatches>&& pairWiseMatches) = 0;
+  /// True if insert can be called concurrently (the container does its own locking)
+  virtual bool IsThreadSafe() const { return false; }
 };
 
 //--
@@ -9,9 +9,14 @@
 
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 
 #include "testing/testing.h"
 
+#include <cstddef>
+#include <fstream>
+#include <limits>
+
 using namespace openMVG;
 using namespace matching;
 
@@ -53,6 +58,126 @@ TEST(IndMatch, IO)
   EXPECT_EQ(3, matches.at({1,2}).size());
 }
 
+TEST(IndMatch, StreamIO)
+{
+  // Write the pairs in any order (as a parallel matcher would do)
+  {
+    PairWiseMatchesStreamWriter writer;
+    EXPECT_TRUE(writer.Open("matches_stream.bin"));
+    writer.insert({{1,2}, {{0,0},{1,1},{2,2}}});
+    writer.insert({{0,1}, {{0,0},{1,1}}});
+    writer.insert({{0,2}, {}});
+    EXPECT_TRUE(writer.Write({3,4}, {{7,8},{9,10}}));
+    EXPECT_TRUE(writer.Write({3,4}, {{5,6}})); // the first version of a pair is kept
+    EXPECT_EQ(5, writer.PairCount());
+    EXPECT_TRUE(writer.Close());
+  }
+  EXPECT_TRUE(IsPairWiseMatchesStreamFile("matches_stream.bin"));
+
+  // Random access to the pairs
+  PairWiseMatchesStreamReader reader;
+  EXPECT_TRUE(reader.Open("matches_stream.bin"));
+  EXPECT_EQ(4, reader.PairCount());
+  EXPECT_TRUE(reader.GetPairs() == Pair_Set({{0,1}, {0,2}, {1,2}, {3,4}}));
+  EXPECT_EQ(3, reader.MatchCount({1,2}));
+  EXPECT_EQ(0, reader.MatchCount({5,6}));
+
+  IndMatches pair_matches;
+  EXPECT_TRUE(reader.Read({3,4}, pair_matches));
+  EXPECT_TRUE(pair_matches == IndMatches({{7,8},{9,10}}));
+  EXPECT_TRUE(reader.Read({0,2}, pair_matches));
+  EXPECT_EQ(0, pair_matches.size());
+  EXPECT_FALSE(reader.Read({5,6}, pair_matches));
+
+  // Read by range
+  PairWiseMatches matches;
+  EXPECT_TRUE(reader.ReadRange(1, 3, matches));
+  EXPECT_EQ(2, matches.size());
+  EXPECT_EQ(1, matches.count({0,2}));
+  EXPECT_EQ(1, matches.count({1,2}));
+
+  // The generic Load function must handle the indexed file
+  EXPECT_TRUE(Load(matches, "matches_stream.bin"));
+  EXPECT_EQ(4, matches.size());
+  EXPECT_EQ(2, matches.at({0,1}).size());
+  EXPECT_EQ(3, matches.at({1,2}).size());
+}
+
+TEST(IndMatch, StreamIO_NotClosed)
+{
+  // A file without index table (interrupted matching) can still be read
+  {
+    PairWiseMatchesStreamWriter writer;
+    EXPECT_TRUE(writer.Open("matches_stream_interrupted.bin"));
+    writer.insert({{1,2}, {{0,0},{1,1},{2,2}}});
+    writer.insert({{0,1}, {{0,0},{1,1}}});
+    EXPECT_TRUE(writer.Write({0,1}, {{3,3}}));
+    // Copy the file before the writer is closed
+    std::ifstream in("matches_stream_interrupted.bin", std::ios::binary);
+    std::ofstream out("matches_stream_copy.bin", std::ios::binary);
+    out << in.rdbuf();
+  }
+
+  PairWiseMatches matches;
+  EXPECT_TRUE(Load(matches, "matches_stream_copy.bin"));
+  EXPECT_EQ(2, matches.size());
+  EXPECT_EQ(2, matches.at({0,1}).size());
+  EXPECT_EQ(3, matches.at({1,2}).size());
+}
+
+TEST(IndMatch, StreamIO_DuplicatePair)
+{
+  // A pair inserted twice keeps the same matches in a PairWiseMatches
+  //  and in an indexed file
+  const std::vector<std::pair<Pair, IndMatches>> insertions =
+  {
+    {{0,1}, {{0,0},{1,1}}},
+    {{1,2}, {{2,2}}},
+    {{0,1}, {{3,3}}},
+    {{1,2}, {{4,4},{5,5},{6,6}}}
+  };
+
+  PairWiseMatches map_matches;
+  {
+    PairWiseMatchesStreamWriter writer;
+    EXPECT_TRUE(writer.Open("matches_stream_duplicate.bin"));
+    for (auto pair_matches : insertions)
+    {
+      writer.insert(std::pair<Pair, IndMatches>(pair_matches));
+      map_matches.insert(std::move(pair_matches));
+    }
+    EXPECT_TRUE(writer.Close());
+  }
+
+  PairWiseMatches stream_matches;
+  EXPECT_TRUE(Load(stream_matches, "matches_stream_duplicate.bin"));
+  EXPECT_EQ(2, stream_matches.size());
+  EXPECT_TRUE(map_matches == stream_matches);
+  EXPECT_TRUE(stream_matches.at({0,1}) == IndMatches({{0,0},{1,1}}));
+  EXPECT_TRUE(stream_matches.at({1,2}) == IndMatches({{2,2}}));
+}
+
+TEST(IndMatch, StreamIO_CorruptedIndex)
+{
+  // An index table larger than the file is rejected (nothing is allocated from it)
+  {
+    PairWiseMatchesStreamWriter writer;
+    EXPECT_TRUE(writer.Open("matches_stream_corrupted.bin"));
+    writer.insert({{0,1}, {{0,0},{1,1}}});
+    EXPECT_TRUE(writer.Close());
+  }
+  {
+    std::fstream file("matches_stream_corrupted.bin",
+      std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t pair_count = std::numeric_limits<uint64_t>::max() / 64;
+    file.seekp(offsetof(PairWiseMatches_Stream_Header, pair_count));
+    file.write(reinterpret_cast<const char*>(&pair_count), sizeof(pair_count));
+  }
+  PairWiseMatchesStreamReader reader;
+  EXPECT_FALSE(reader.Open("matches_stream_corrupted.bin"));
+  EXPECT_EQ(0, reader.PairCount());
+}
+
 TEST(IndMatch, DuplicateRemoval_NoRemoval)
 {
   std::vector<IndMatch> vec_indMatch = {
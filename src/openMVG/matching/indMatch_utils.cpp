@@ -11,6 +11,7 @@
 
 #include "openMVG/matching/indMatch_utils.hpp"
 #include "openMVG/matching/indMatch_io.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 
 #include <algorithm>
 #include <fstream>
@@ -60,6 +61,12 @@ bool Load
   }
   else if (ext == "bin")
   {
+    // Indexed pairwise matches file (see pairwise_matches_stream.hpp)
+    if (IsPairWiseMatchesStreamFile(filename))
+    {
+      PairWiseMatchesStreamReader reader;
+      return reader.Open(filename) && reader.ReadAll(matches);
+    }
     std::ifstream stream (filename.c_str(), std::ios::in | std::ios::binary);
     if (stream.is_open())
     {
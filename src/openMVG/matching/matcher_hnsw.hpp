@@ -9,10 +9,12 @@
 #ifndef OPENMVG_MATCHING_MATCHER_HNSW_HPP
 #define OPENMVG_MATCHING_MATCHER_HNSW_HPP
 
+#include <fstream>
 #include <memory>
 #ifdef OPENMVG_USE_OPENMP
 #include <omp.h>
 #endif
+#include <string>
 #include <vector>
 
 #include "openMVG/matching/matching_interface.hpp"
@@ -60,15 +62,8 @@ class HNSWMatcher: public ArrayMatcher<Scalar, Metric>
 
     dimension_ = dimension;
     
-    // Here this is tricky since there is no specialization
-    if(typeid(DistanceType)== typeid(int)) {
-      HNSWmetric.reset(dynamic_cast<SpaceInterface<DistanceType> *>(new L2SpaceI(dimension)));
-    } else
-    if (typeid(DistanceType) == typeid(float))  {
-      HNSWmetric.reset(dynamic_cast<SpaceInterface<DistanceType> *>(new L2Space(dimension)));
-    } else {
-      std::cerr << "HNSW matcher: this type of distance is not handled Yet" << std::endl;
-    }
+    if (!ResetMetric(dimension))
+      return false;
     
     HNSWmatcher.reset(new HierarchicalNSW<DistanceType>(HNSWmetric.get(), nbRows, 16, 100) );
     HNSWmatcher->setEf(16);
@@ -86,6 +81,55 @@ class HNSWMatcher: public ArrayMatcher<Scalar, Metric>
     return true;
   };
 
+  /**
+   * Save the HNSW graph (it contains a copy of the dataset).
+   */
+  bool Save(const std::string & filename) const override
+  {
+    if (HNSWmatcher.get() == nullptr)
+      return false;
+    HNSWmatcher->saveIndex(filename);
+    return std::ifstream(filename, std::ios::binary).good();
+  }
+
+  /**
+   * Load a HNSW graph saved by Save (the dataset is read from the graph).
+   */
+  bool Load
+  (
+    const std::string & filename,
+    const Scalar * /*dataset*/,
+    int nbRows,
+    int dimension
+  ) override
+  {
+    HNSWmatcher.reset(nullptr);
+    if (nbRows < 1 || !std::ifstream(filename, std::ios::binary).good())
+      return false;
+
+    dimension_ = dimension;
+    if (!ResetMetric(dimension))
+      return false;
+    try
+    {
+      HNSWmatcher.reset(new HierarchicalNSW<DistanceType>(HNSWmetric.get(), filename));
+    }
+    catch (const std::exception & e)
+    {
+      std::cerr << "Cannot load the HNSW graph: " << e.what() << std::endl;
+      HNSWmatcher.reset(nullptr);
+      return false;
+    }
+    // Check that the graph matches the dataset
+    if (HNSWmatcher->cur_element_count != static_cast<size_t>(nbRows))
+    {
+      HNSWmatcher.reset(nullptr);
+      return false;
+    }
+    HNSWmatcher->setEf(16);
+    return true;
+  }
+
   /**
    * Search the nearest Neighbor of the scalar array query.
    *
@@ -159,6 +203,22 @@ class HNSWMatcher: public ArrayMatcher<Scalar, Metric>
   };
 
 private:
+  /// Create the distance used by the graph
+  bool ResetMetric(int dimension)
+  {
+    // Here this is tricky since there is no specialization
+    if(typeid(DistanceType)== typeid(int)) {
+      HNSWmetric.reset(dynamic_cast<SpaceInterface<DistanceType> *>(new L2SpaceI(dimension)));
+    } else
+    if (typeid(DistanceType) == typeid(float))  {
+      HNSWmetric.reset(dynamic_cast<SpaceInterface<DistanceType> *>(new L2Space(dimension)));
+    } else {
+      std::cerr << "HNSW matcher: this type of distance is not handled Yet" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   int dimension_;
   std::unique_ptr<SpaceInterface<DistanceType>> HNSWmetric;
   std::unique_ptr<HierarchicalNSW<DistanceType>> HNSWmatcher;
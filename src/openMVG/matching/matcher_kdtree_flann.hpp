@@ -9,7 +9,10 @@
 #ifndef OPENMVG_MATCHING_MATCHER_KDTREE_FLANN_HPP
 #define OPENMVG_MATCHING_MATCHER_KDTREE_FLANN_HPP
 
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #ifdef OPENMVG_USE_OPENMP
@@ -74,6 +77,63 @@ class ArrayMatcher_Kdtree_Flann : public ArrayMatcher<Scalar, Metric>
     return false;
   }
 
+  /**
+   * Save the FLANN index (the dataset is not saved).
+   */
+  bool Save(const std::string & filename) const override
+  {
+    if (index_.get() == nullptr)
+      return false;
+    try
+    {
+      index_->save(filename);
+    }
+    catch (const flann::FLANNException & e)
+    {
+      std::cerr << "Cannot save the FLANN index: " << e.what() << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Load a FLANN index saved by Save on the same dataset.
+   */
+  bool Load
+  (
+    const std::string & filename,
+    const Scalar * dataset,
+    int nbRows,
+    int dimension
+  ) override
+  {
+    index_.reset();
+    if (nbRows < 1 || !std::ifstream(filename, std::ios::binary).good())
+      return false;
+    dimension_ = dimension;
+    datasetM_.reset(
+        new flann::Matrix<Scalar>((Scalar*)dataset, nbRows, dimension));
+    try
+    {
+      index_.reset(
+          new flann::Index<Metric> (*datasetM_, flann::SavedIndexParams(filename)));
+    }
+    catch (const flann::FLANNException & e)
+    {
+      std::cerr << "Cannot load the FLANN index: " << e.what() << std::endl;
+      index_.reset();
+      return false;
+    }
+    // Check that the index matches the dataset
+    if (index_->size() != static_cast<size_t>(nbRows) ||
+        index_->veclen() != static_cast<size_t>(dimension))
+    {
+      index_.reset();
+      return false;
+    }
+    return true;
+  }
+
   /**
    * Search the nearest Neighbor of the scalar array query.
    *
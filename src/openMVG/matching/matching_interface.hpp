@@ -9,6 +9,7 @@
 #ifndef OPENMVG_MATCHING_MATCHING_INTERFACE_HPP
 #define OPENMVG_MATCHING_MATCHING_INTERFACE_HPP
 
+#include <string>
 #include <vector>
 
 #include "openMVG/matching/indMatch.hpp"
@@ -68,6 +69,32 @@ class ArrayMatcher
                                   IndMatches * indices,
                                   std::vector<DistanceType> * distances,
                                   size_t NN)=0;
+
+  /**
+   * Save the matching structure (optional, for the matchers that can be
+   *  reloaded instead of being rebuilt).
+   *
+   * \param[in] filename The file where the structure is saved.
+   *
+   * \return True if success.
+   */
+  virtual bool Save(const std::string & /*filename*/) const { return false; }
+
+  /**
+   * Load a matching structure saved by Save instead of building it.
+   *
+   * \param[in] filename  The file where the structure has been saved.
+   * \param[in] dataset   Input data (the data used to build the structure).
+   * \param[in] nbRows    The number of component.
+   * \param[in] dimension Length of the data contained in the dataset.
+   *
+   * \return True if success.
+   */
+  virtual bool Load( const std::string & /*filename*/,
+                     const Scalar * /*dataset*/, int /*nbRows*/, int /*dimension*/)
+  {
+    return false;
+  }
 };
 
 }  // namespace matching
@@ -18,7 +18,10 @@
 
 #include "testing/testing.h"
 
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <vector>
 using namespace std;
 
 using namespace openMVG;
@@ -151,6 +154,48 @@ TEST(Matching, ArrayMatcher_Hnsw_Simple__NN)
   EXPECT_EQ(IndMatch(0,4), vec_nIndice[4]);
 }
 
+// Return true if a saved matcher structure is reloaded with the same search results
+template <typename MatcherT>
+bool SaveLoadKeepsSearchResults(const std::string & filename)
+{
+  const int nb_points = 200, dimension = 8;
+  std::vector<float> dataset(nb_points * dimension);
+  for (size_t i = 0; i < dataset.size(); ++i)
+    dataset[i] = static_cast<float>((i * 7919) % 101);
+
+  MatcherT matcher;
+  if (matcher.Save(filename)) // not built
+    return false;
+  if (!matcher.Build(dataset.data(), nb_points, dimension) || !matcher.Save(filename))
+    return false;
+
+  MatcherT loaded_matcher;
+  const bool bLoadMissing =
+    loaded_matcher.Load(filename + ".missing", dataset.data(), nb_points, dimension);
+  const bool bLoad = loaded_matcher.Load(filename, dataset.data(), nb_points, dimension);
+  std::remove(filename.c_str());
+  if (bLoadMissing || !bLoad)
+    return false;
+
+  const int NN = 2;
+  IndMatches indices, loaded_indices;
+  vector<float> distances, loaded_distances;
+  if (!matcher.SearchNeighbours(dataset.data(), nb_points, &indices, &distances, NN) ||
+      !loaded_matcher.SearchNeighbours(dataset.data(), nb_points, &loaded_indices, &loaded_distances, NN))
+    return false;
+  return indices.size() == loaded_indices.size() && distances == loaded_distances;
+}
+
+TEST(Matching, ArrayMatcher_Kdtree_Flann_SaveLoad)
+{
+  EXPECT_TRUE( SaveLoadKeepsSearchResults<ArrayMatcher_Kdtree_Flann<float>>("matcher_kdtree_flann.idx") );
+}
+
+TEST(Matching, ArrayMatcher_Hnsw_SaveLoad)
+{
+  EXPECT_TRUE( SaveLoadKeepsSearchResults<HNSWMatcher<float>>("matcher_hnsw.idx") );
+}
+
 //-- Test LIMIT case (empty arrays)
 
 TEST(Matching, ArrayMatcherBruteForce_Simple_EmptyArrays)
@@ -12,12 +12,71 @@
 #include <string>
 
 #include "openMVG/matching/indMatch.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 #include "openMVG/graphics/color_gradient.hpp"
 #include "third_party/vectorGraphics/svgDrawer.hpp"
 
 namespace openMVG  {
 namespace matching {
 
+/// Display pair wises match counts as an Adjacency matrix in svg format
+/// MatchCountFunctor returns the match count of a pair (0 if the pair has no matches)
+template <typename MatchCountFunctor>
+void PairWiseMatchCountToAdjacencyMatrixSVG
+(
+  const size_t NbImages,
+  const float max_match_count,
+  const MatchCountFunctor & match_count,
+  const std::string & sOutName
+)
+{
+  // Set the coloring gradient interface
+  graphics::Color_Gradient heatMapGradient(graphics::Color_Gradient::k2BlueRedHeatMap());
+
+  const float scaleFactor = 5.0f;
+  svg::svgDrawer svgStream((NbImages+3)*5, (NbImages+3)*5);
+  // Go along all possible pair
+  for (size_t I = 0; I < NbImages; ++I) {
+    for (size_t J = 0; J < NbImages; ++J) {
+      // If the pair have matches display a blue boxes at I,J position.
+      const size_t pair_match_count = match_count(Pair(I,J));
+      if (pair_match_count > 0)
+      {
+        // Display as a tooltip: "(IndexI, IndexJ NbMatches)"
+        std::ostringstream os_tooltip;
+        os_tooltip << "(" << J << "," << I << " " << pair_match_count <<")";
+
+        float r,g,b;
+        heatMapGradient.getColor(pair_match_count / max_match_count, r, g, b);
+        std::ostringstream os_color;
+        os_color << "rgb(" << int(r * 255) << "," << int(g  * 255) << "," << int(b * 255) << ")";
+
+        svgStream.drawSquare(J*scaleFactor, I*scaleFactor, scaleFactor/2.0f,
+          svg::svgStyle().fill(os_color.str()).noStroke().tooltip(os_tooltip.str()));
+      }
+    }
+  }
+  // Display axes with 0 -> NbImages annotation : _|
+  std::ostringstream osNbImages;
+  osNbImages << NbImages;
+  svgStream.drawText((NbImages+1)*scaleFactor, scaleFactor, scaleFactor, "0", "black");
+  svgStream.drawText((NbImages+1)*scaleFactor,
+    (NbImages)*scaleFactor - scaleFactor, scaleFactor, osNbImages.str(), "black");
+  svgStream.drawLine((NbImages+1)*scaleFactor, 2*scaleFactor,
+    (NbImages+1)*scaleFactor, (NbImages)*scaleFactor - 2*scaleFactor,
+    svg::svgStyle().stroke("black", 1.0));
+
+  svgStream.drawText(scaleFactor, (NbImages+1)*scaleFactor, scaleFactor, "0", "black");
+  svgStream.drawText((NbImages)*scaleFactor - scaleFactor,
+    (NbImages+1)*scaleFactor, scaleFactor, osNbImages.str(), "black");
+  svgStream.drawLine(2*scaleFactor, (NbImages+1)*scaleFactor,
+    (NbImages)*scaleFactor - 2*scaleFactor, (NbImages+1)*scaleFactor,
+    svg::svgStyle().stroke("black", 1.0));
+
+  std::ofstream svgFileStream( sOutName.c_str());
+  svgFileStream << svgStream.closeSvgFile().str();
+}
+
 /// Display pair wises matches as an Adjacency matrix in svg format
 void PairWiseMatchingToAdjacencyMatrixSVG
 (
@@ -28,56 +87,41 @@ void PairWiseMatchingToAdjacencyMatrixSVG
 {
   if ( !map_Matches.empty())
   {
-    // Set the coloring gradient interface
-    graphics::Color_Gradient heatMapGradient(graphics::Color_Gradient::k2BlueRedHeatMap());
     float max_match_count = 0;
     for (const auto & match_it : map_Matches)
     {
       max_match_count = std::max(max_match_count, static_cast<float>(match_it.second.size()));
     }
+    PairWiseMatchCountToAdjacencyMatrixSVG(NbImages, max_match_count,
+      [&](const Pair & pair)
+      {
+        const auto iterSearch = map_Matches.find(pair);
+        return (iterSearch != map_Matches.end()) ? iterSearch->second.size() : size_t(0);
+      },
+      sOutName);
+  }
+}
 
-    const float scaleFactor = 5.0f;
-    svg::svgDrawer svgStream((NbImages+3)*5, (NbImages+3)*5);
-    // Go along all possible pair
-    for (size_t I = 0; I < NbImages; ++I) {
-      for (size_t J = 0; J < NbImages; ++J) {
-        // If the pair have matches display a blue boxes at I,J position.
-        auto iterSearch = map_Matches.find({I,J});
-        if (iterSearch != map_Matches.end() && !iterSearch->second.empty())
-        {
-          // Display as a tooltip: "(IndexI, IndexJ NbMatches)"
-          std::ostringstream os_tooltip;
-          os_tooltip << "(" << J << "," << I << " " << iterSearch->second.size() <<")";
-
-          float r,g,b;
-          heatMapGradient.getColor(iterSearch->second.size() / max_match_count, r, g, b);
-          std::ostringstream os_color;
-          os_color << "rgb(" << int(r * 255) << "," << int(g  * 255) << "," << int(b * 255) << ")";
-
-          svgStream.drawSquare(J*scaleFactor, I*scaleFactor, scaleFactor/2.0f,
-            svg::svgStyle().fill(os_color.str()).noStroke().tooltip(os_tooltip.str()));
-        }
-      }
+/// Display the pair wises matches of an indexed matches file as an Adjacency matrix
+///  in svg format (only the index table of the file is used)
+void PairWiseMatchingToAdjacencyMatrixSVG
+(
+  const size_t NbImages,
+  const matching::PairWiseMatchesStreamReader & matches_reader,
+  const std::string & sOutName
+)
+{
+  if (matches_reader.PairCount() > 0)
+  {
+    float max_match_count = 0;
+    for (size_t i = 0; i < matches_reader.PairCount(); ++i)
+    {
+      max_match_count = std::max(max_match_count,
+        static_cast<float>(matches_reader.MatchCount(matches_reader.GetPair(i))));
     }
-    // Display axes with 0 -> NbImages annotation : _|
-    std::ostringstream osNbImages;
-    osNbImages << NbImages;
-    svgStream.drawText((NbImages+1)*scaleFactor, scaleFactor, scaleFactor, "0", "black");
-    svgStream.drawText((NbImages+1)*scaleFactor,
-      (NbImages)*scaleFactor - scaleFactor, scaleFactor, osNbImages.str(), "black");
-    svgStream.drawLine((NbImages+1)*scaleFactor, 2*scaleFactor,
-      (NbImages+1)*scaleFactor, (NbImages)*scaleFactor - 2*scaleFactor,
-      svg::svgStyle().stroke("black", 1.0));
-
-    svgStream.drawText(scaleFactor, (NbImages+1)*scaleFactor, scaleFactor, "0", "black");
-    svgStream.drawText((NbImages)*scaleFactor - scaleFactor,
-      (NbImages+1)*scaleFactor, scaleFactor, osNbImages.str(), "black");
-    svgStream.drawLine(2*scaleFactor, (NbImages+1)*scaleFactor,
-      (NbImages)*scaleFactor - 2*scaleFactor, (NbImages+1)*scaleFactor,
-      svg::svgStyle().stroke("black", 1.0));
-
-    std::ofstream svgFileStream( sOutName.c_str());
-    svgFileStream << svgStream.closeSvgFile().str();
+    PairWiseMatchCountToAdjacencyMatrixSVG(NbImages, max_match_count,
+      [&](const Pair & pair) { return matches_reader.MatchCount(pair); },
+      sOutName);
   }
 }
 
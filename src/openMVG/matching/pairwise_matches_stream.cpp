@@ -0,0 +1,328 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/matching/pairwise_matches_stream.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+namespace openMVG {
+namespace matching {
+
+namespace {
+
+// On disk layout of a chunk header and of an index table entry
+struct Chunk_Header
+{
+  uint32_t I;
+  uint32_t J;
+  uint64_t count;
+};
+
+struct Index_Record
+{
+  uint32_t I;
+  uint32_t J;
+  uint64_t offset;
+  uint64_t count;
+};
+
+static_assert(sizeof(IndMatch) == 2 * sizeof(uint32_t),
+  "IndMatch must be tightly packed to be streamed");
+
+// Sort the index entries by pair and keep only the first written chunk of a pair
+//  (as PairWiseMatches::insert does)
+template <typename EntryT>
+void SortIndex(std::vector<EntryT> & entries)
+{
+  std::stable_sort(entries.begin(), entries.end(),
+    [](const EntryT & a, const EntryT & b) { return a.pair < b.pair; });
+  entries.erase(std::unique(entries.begin(), entries.end(),
+    [](const EntryT & a, const EntryT & b) { return a.pair == b.pair; }),
+    entries.end());
+}
+
+} // namespace
+
+bool IsPairWiseMatchesStreamFile(const std::string & filename)
+{
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    return false;
+  char magic[sizeof(PAIRWISE_MATCHES_STREAM_MAGIC)];
+  stream.read(magic, sizeof(magic));
+  return stream.good()
+    && std::memcmp(magic, PAIRWISE_MATCHES_STREAM_MAGIC, sizeof(magic)) == 0;
+}
+
+//--
+// PairWiseMatchesStreamWriter
+//--
+
+PairWiseMatchesStreamWriter::~PairWiseMatchesStreamWriter()
+{
+  Close();
+}
+
+bool PairWiseMatchesStreamWriter::Open(const std::string & filename)
+{
+  Close();
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  stream_.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream_.is_open())
+    return false;
+
+  PairWiseMatches_Stream_Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, PAIRWISE_MATCHES_STREAM_MAGIC, sizeof(header.magic));
+  header.version = PAIRWISE_MATCHES_STREAM_VERSION;
+  stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  bValid_ = stream_.good();
+  return bValid_;
+}
+
+void PairWiseMatchesStreamWriter::insert(std::pair<Pair, IndMatches> && pairWiseMatches)
+{
+  if (!Write(pairWiseMatches.first, pairWiseMatches.second))
+  {
+    std::cerr << "Cannot write the matches of the pair: "
+      << pairWiseMatches.first.first << "-" << pairWiseMatches.first.second << std::endl;
+  }
+}
+
+bool PairWiseMatchesStreamWriter::Write(const Pair & pair, const IndMatches & matches)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!stream_.is_open() || !bValid_)
+    return false;
+
+  const uint64_t offset = static_cast<uint64_t>(stream_.tellp());
+  const Chunk_Header chunk_header =
+    {static_cast<uint32_t>(pair.first), static_cast<uint32_t>(pair.second), matches.size()};
+  stream_.write(reinterpret_cast<const char*>(&chunk_header), sizeof(chunk_header));
+  stream_.write(reinterpret_cast<const char*>(matches.data()), matches.size() * sizeof(IndMatch));
+  // Flush each pair so an interrupted matching keeps the already computed pairs
+  stream_.flush();
+  bValid_ = stream_.good();
+  if (bValid_)
+    index_.push_back({pair, offset, matches.size()});
+  return bValid_;
+}
+
+bool PairWiseMatchesStreamWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!stream_.is_open())
+    return bValid_;
+
+  if (bValid_)
+  {
+    SortIndex(index_);
+
+    // Write the index table and update the header
+    const uint64_t index_offset = static_cast<uint64_t>(stream_.tellp());
+    for (const Index_Entry & entry : index_)
+    {
+      const Index_Record record = {static_cast<uint32_t>(entry.pair.first),
+        static_cast<uint32_t>(entry.pair.second), entry.offset, entry.count};
+      stream_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    const uint64_t pair_count = index_.size();
+    stream_.seekp(offsetof(PairWiseMatches_Stream_Header, index_offset));
+    stream_.write(reinterpret_cast<const char*>(&index_offset), sizeof(index_offset));
+    stream_.write(reinterpret_cast<const char*>(&pair_count), sizeof(pair_count));
+    bValid_ = stream_.good();
+  }
+  stream_.close();
+  index_.clear();
+  return bValid_;
+}
+
+size_t PairWiseMatchesStreamWriter::PairCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+bool SavePairWiseMatchesStream
+(
+  const PairWiseMatches & matches,
+  const std::string & filename
+)
+{
+  PairWiseMatchesStreamWriter writer;
+  if (!writer.Open(filename))
+    return false;
+  for (const auto & pair_matches : matches)
+  {
+    if (!writer.Write(pair_matches.first, pair_matches.second))
+      return false;
+  }
+  return writer.Close();
+}
+
+//--
+// PairWiseMatchesStreamReader
+//--
+
+bool PairWiseMatchesStreamReader::Open(const std::string & filename)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  if (stream_.is_open())
+    stream_.close();
+  stream_.clear();
+  stream_.open(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream_.is_open())
+    return false;
+
+  PairWiseMatches_Stream_Header header;
+  stream_.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!stream_.good()
+      || std::memcmp(header.magic, PAIRWISE_MATCHES_STREAM_MAGIC, sizeof(header.magic)) != 0
+      || header.version != PAIRWISE_MATCHES_STREAM_VERSION)
+  {
+    std::cerr << "Invalid pairwise matches file: " << filename << std::endl;
+    stream_.close();
+    return false;
+  }
+
+  stream_.seekg(0, std::ios::end);
+  const uint64_t file_size = static_cast<uint64_t>(stream_.tellg());
+
+  if (header.index_offset != 0)
+  {
+    // Read the index table (its size is checked against the file size
+    //  before any allocation: the header may be corrupted)
+    if (header.index_offset < sizeof(header)
+        || header.index_offset > file_size
+        || header.pair_count > (file_size - header.index_offset) / sizeof(Index_Record))
+    {
+      std::cerr << "Invalid pairwise matches index table: " << filename << std::endl;
+      stream_.close();
+      return false;
+    }
+    std::vector<Index_Record> records(header.pair_count);
+    stream_.seekg(header.index_offset);
+    stream_.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(Index_Record));
+    // Each chunk must lie between the header and the index table
+    const auto is_valid_record = [&header](const Index_Record & record)
+    {
+      return record.offset >= sizeof(header)
+        && record.offset + sizeof(Chunk_Header) <= header.index_offset
+        && record.count <=
+          (header.index_offset - record.offset - sizeof(Chunk_Header)) / sizeof(IndMatch);
+    };
+    if (!stream_.good()
+        || !std::all_of(records.cbegin(), records.cend(), is_valid_record))
+    {
+      std::cerr << "Invalid pairwise matches index table: " << filename << std::endl;
+      stream_.close();
+      return false;
+    }
+    index_.reserve(records.size());
+    for (const Index_Record & record : records)
+      index_.push_back({{record.I, record.J}, record.offset, record.count});
+  }
+  else
+  {
+    // The file was not closed: rebuild the index from the complete chunks
+    uint64_t offset = sizeof(header);
+    Chunk_Header chunk_header;
+    while (offset + sizeof(chunk_header) <= file_size)
+    {
+      stream_.seekg(offset);
+      stream_.read(reinterpret_cast<char*>(&chunk_header), sizeof(chunk_header));
+      if (!stream_.good()
+          || chunk_header.count > (file_size - offset - sizeof(chunk_header)) / sizeof(IndMatch))
+        break;
+      const uint64_t next_offset =
+        offset + sizeof(chunk_header) + chunk_header.count * sizeof(IndMatch);
+      index_.push_back({{chunk_header.I, chunk_header.J}, offset, chunk_header.count});
+      offset = next_offset;
+    }
+    SortIndex(index_);
+    stream_.clear();
+  }
+  return true;
+}
+
+Pair_Set PairWiseMatchesStreamReader::GetPairs() const
+{
+  Pair_Set pairs;
+  for (const Index_Entry & entry : index_)
+    pairs.insert(pairs.end(), entry.pair);
+  return pairs;
+}
+
+size_t PairWiseMatchesStreamReader::MatchCount(const Pair & pair) const
+{
+  const auto it = std::lower_bound(index_.cbegin(), index_.cend(), pair,
+    [](const Index_Entry & entry, const Pair & p) { return entry.pair < p; });
+  if (it == index_.cend() || it->pair != pair)
+    return 0;
+  return it->count;
+}
+
+bool PairWiseMatchesStreamReader::ReadEntry
+(
+  const Index_Entry & entry,
+  IndMatches & matches
+) const
+{
+  matches.resize(entry.count);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!stream_.is_open())
+    return false;
+  stream_.seekg(entry.offset + sizeof(Chunk_Header));
+  stream_.read(reinterpret_cast<char*>(matches.data()), entry.count * sizeof(IndMatch));
+  if (!stream_.good())
+  {
+    stream_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool PairWiseMatchesStreamReader::Read(const Pair & pair, IndMatches & matches) const
+{
+  const auto it = std::lower_bound(index_.cbegin(), index_.cend(), pair,
+    [](const Index_Entry & entry, const Pair & p) { return entry.pair < p; });
+  if (it == index_.cend() || it->pair != pair)
+    return false;
+  return ReadEntry(*it, matches);
+}
+
+bool PairWiseMatchesStreamReader::ReadRange
+(
+  size_t begin,
+  size_t end,
+  PairWiseMatchesContainer & matches
+) const
+{
+  end = std::min(end, index_.size());
+  for (size_t i = begin; i < end; ++i)
+  {
+    IndMatches pair_matches;
+    if (!ReadEntry(index_[i], pair_matches))
+      return false;
+    matches.insert({index_[i].pair, std::move(pair_matches)});
+  }
+  return true;
+}
+
+bool PairWiseMatchesStreamReader::ReadAll(PairWiseMatchesContainer & matches) const
+{
+  return ReadRange(0, index_.size(), matches);
+}
+
+}  // namespace matching
+}  // namespace openMVG
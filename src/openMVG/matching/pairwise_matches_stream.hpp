@@ -0,0 +1,145 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MATCHING_PAIRWISE_MATCHES_STREAM_HPP
+#define OPENMVG_MATCHING_PAIRWISE_MATCHES_STREAM_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "openMVG/matching/indMatch.hpp"
+
+namespace openMVG {
+namespace matching {
+
+/// Indexed, append-only, pairwise matches file (usually named matches.*.bin):
+///  - a PairWiseMatches_Stream_Header,
+///  - a series of chunks, one per pair, appended as soon as the pair is available:
+///    {uint32 I, uint32 J, uint64 match count, match count * {uint32 i, uint32 j}},
+///  - an index table written once the file is closed:
+///    pair count * {uint32 I, uint32 J, uint64 chunk offset, uint64 match count}
+///    sorted by pair.
+/// A file that was not closed (no index table) can still be read: its index is
+///  then rebuilt by scanning the chunks.
+/// Values are stored in the host byte order.
+struct PairWiseMatches_Stream_Header
+{
+  char magic[8];         // PAIRWISE_MATCHES_STREAM_MAGIC
+  uint32_t version;      // PAIRWISE_MATCHES_STREAM_VERSION
+  uint32_t reserved;
+  uint64_t index_offset; // offset in bytes of the index table (0 if the file was not closed)
+  uint64_t pair_count;   // number of entries of the index table
+};
+
+static const char PAIRWISE_MATCHES_STREAM_MAGIC[8] = {'O', 'M', 'V', 'G', 'P', 'W', 'M', '\0'};
+static const uint32_t PAIRWISE_MATCHES_STREAM_VERSION = 1;
+
+/// Return true if the file is an indexed pairwise matches file
+bool IsPairWiseMatchesStreamFile(const std::string & filename);
+
+/// Write pairwise matches to an indexed pairwise matches file.
+/// Pairs are written as soon as they are inserted, so the matches do not have
+///  to be kept in memory (the insert method is thread safe).
+class PairWiseMatchesStreamWriter : public PairWiseMatchesContainer
+{
+public:
+  PairWiseMatchesStreamWriter() = default;
+  ~PairWiseMatchesStreamWriter() override;
+
+  /// Create (or overwrite) the file
+  bool Open(const std::string & filename);
+
+  /// Append the matches of a pair (a pair written twice keeps its first version,
+  ///  as PairWiseMatches::insert does)
+  void insert(std::pair<Pair, IndMatches> && pairWiseMatches) override;
+  bool IsThreadSafe() const override { return true; }
+
+  /// Append the matches of a pair, return false if the write failed
+  bool Write(const Pair & pair, const IndMatches & matches);
+
+  /// Write the index table and close the file
+  bool Close();
+
+  bool IsOpen() const { return stream_.is_open(); }
+
+  /// Number of pairs written so far
+  size_t PairCount() const;
+
+private:
+  struct Index_Entry
+  {
+    Pair pair;
+    uint64_t offset;
+    uint64_t count;
+  };
+
+  mutable std::mutex mutex_;
+  std::ofstream stream_;
+  std::vector<Index_Entry> index_;
+  bool bValid_ = false;
+};
+
+/// Write all the pairwise matches to an indexed pairwise matches file
+bool SavePairWiseMatchesStream
+(
+  const PairWiseMatches & matches,
+  const std::string & filename
+);
+
+/// Read pairwise matches from an indexed pairwise matches file.
+/// Only the index table is kept in memory: the matches of a pair (or of a range
+///  of pairs) are read on demand (the read methods are thread safe).
+class PairWiseMatchesStreamReader
+{
+public:
+  /// Open the file and read its index table
+  bool Open(const std::string & filename);
+
+  /// Number of pairs of the file
+  size_t PairCount() const { return index_.size(); }
+
+  /// Return the i-th pair (pairs are sorted)
+  const Pair & GetPair(size_t i) const { return index_[i].pair; }
+
+  /// Return the pairs of the file
+  Pair_Set GetPairs() const;
+
+  /// Return the number of matches of the pair (0 if the pair is not in the file)
+  size_t MatchCount(const Pair & pair) const;
+
+  /// Read the matches of a pair
+  bool Read(const Pair & pair, IndMatches & matches) const;
+
+  /// Read the matches of the pairs [begin, end) (indexes in the sorted pair list)
+  bool ReadRange(size_t begin, size_t end, PairWiseMatchesContainer & matches) const;
+
+  /// Read the matches of all the pairs
+  bool ReadAll(PairWiseMatchesContainer & matches) const;
+
+private:
+  struct Index_Entry
+  {
+    Pair pair;
+    uint64_t offset;
+    uint64_t count;
+  };
+
+  bool ReadEntry(const Index_Entry & entry, IndMatches & matches) const;
+
+  mutable std::mutex mutex_;
+  mutable std::ifstream stream_;
+  std::vector<Index_Entry> index_; // sorted by pair
+};
+
+}  // namespace matching
+}  // namespace openMVG
+
+#endif // OPENMVG_MATCHING_PAIRWISE_MATCHES_STREAM_HPP
@@ -53,7 +53,8 @@ void DistanceRatioMatch
 std::unique_ptr<RegionsMatcher> RegionMatcherFactory
 (
   matching::EMatcherType eMatcherType,
-  const features::Regions & regions
+  const features::Regions & regions,
+  const std::string & index_filename
 )
 {
   // Handle invalid request
@@ -75,28 +76,28 @@ std::unique_ptr<RegionsMatcher> RegionMatcherFactory
         {
           using MetricT = L2<unsigned char>;
           using MatcherT = ArrayMatcherBruteForce<unsigned char, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case ANN_L2:
         {
           using MetricT = flann::L2<unsigned char>;
           using MatcherT = ArrayMatcher_Kdtree_Flann<unsigned char, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case HNSW_L2: 
         {
           using MetricT = L2<unsigned char>;
           using MatcherT = HNSWMatcher<unsigned char, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case CASCADE_HASHING_L2:
         {
           using MetricT = L2<unsigned char>;
           using MatcherT = ArrayMatcherCascadeHashing<unsigned char, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         default:
@@ -112,28 +113,28 @@ std::unique_ptr<RegionsMatcher> RegionMatcherFactory
         {
           using MetricT = L2<float>;
           using MatcherT = ArrayMatcherBruteForce<float, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case ANN_L2:
         {
           using MetricT = flann::L2<float>;
           using MatcherT = ArrayMatcher_Kdtree_Flann<float, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case HNSW_L2: 
         {
           using MetricT = L2<float>;
           using MatcherT = HNSWMatcher<float, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case CASCADE_HASHING_L2:
         {
           using MetricT = L2<float>;
           using MatcherT = ArrayMatcherCascadeHashing<float, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         default:
@@ -149,14 +150,14 @@ std::unique_ptr<RegionsMatcher> RegionMatcherFactory
         {
           using MetricT = L2<double>;
           using MatcherT = ArrayMatcherBruteForce<double, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case ANN_L2:
         {
           using MetricT = flann::L2<double>;
           using MatcherT = ArrayMatcher_Kdtree_Flann<double, MetricT>;
-          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true));
+          region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, true, index_filename));
         }
         break;
         case CASCADE_HASHING_L2:
@@ -177,7 +178,7 @@ std::unique_ptr<RegionsMatcher> RegionMatcherFactory
       {
         using MetricT = Hamming<unsigned char>;
         using MatcherT = ArrayMatcherBruteForce<unsigned char, MetricT>;
-        region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, false));
+        region_matcher.reset(new matching::RegionsMatcherT<MatcherT>(regions, false, index_filename));
       }
       break;
       default:
@@ -9,6 +9,8 @@
 #ifndef OPENMVG_MATCHING_REGION_MATCHER_HPP
 #define OPENMVG_MATCHING_REGION_MATCHER_HPP
 
+#include <iostream>
+#include <string>
 #include <vector>
 
 #include "openMVG/features/regions.hpp"
@@ -81,19 +83,29 @@ class RegionsMatcher
     const features::Regions & query_regions,
     matching::IndMatches & vec_putative_matches
   ) = 0;
+
+  /**
+   * @brief Save the matching structure of the database
+   *  (it can then be given to RegionMatcherFactory instead of being rebuilt).
+   * @return false if the matcher type does not support it.
+   */
+  virtual bool SaveIndex(const std::string & filename) const = 0;
 };
 
 /**
  * @brief Create a region matcher according a matcher type and the regions type.
  * @param[in] matcher_type The Matcher type.
  * @param[in] regions The database regions.
+ * @param[in] index_filename A matching structure saved by RegionsMatcher::SaveIndex
+ *  for these regions (optional). If it cannot be loaded the structure is built.
  * @return The created RegionsMatcher or an empty smart pointer if the a matcher
  * for the region type asked matcher type cannot be created.
  */
 std::unique_ptr<RegionsMatcher> RegionMatcherFactory
 (
   matching::EMatcherType matcher_type,
-  const features::Regions & regions
+  const features::Regions & regions,
+  const std::string & index_filename = ""
 );
 
 /**
@@ -115,11 +127,14 @@ public:
 
   /**
    * @brief Init the matcher with some reference regions.
+   * If index_filename is a matching structure saved for these regions it is
+   *  loaded, else the structure is built.
    */
   RegionsMatcherT
   (
     const features::Regions & regions,
-    bool b_squared_metric = false
+    bool b_squared_metric = false,
+    const std::string & index_filename = ""
   ):
     regions_(&regions),
     b_squared_metric_(b_squared_metric)
@@ -128,9 +143,21 @@ public:
       return;
 
     const Scalar * tab = reinterpret_cast<const Scalar *>(regions_->DescriptorRawData());
+    if (!index_filename.empty())
+    {
+      if (matcher_.Load(index_filename, tab, regions_->RegionCount(), regions_->DescriptorLength()))
+        return;
+      std::cerr << "Cannot load the matching structure: " << index_filename
+        << ", it is built." << std::endl;
+    }
     matcher_.Build(tab, regions_->RegionCount(), regions_->DescriptorLength());
   }
 
+  bool SaveIndex(const std::string & filename) const override
+  {
+    return regions_ && matcher_.Save(filename);
+  }
+
   bool Match
   (
     const features::Regions & query_regions,
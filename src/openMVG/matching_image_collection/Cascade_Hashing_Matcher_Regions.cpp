@@ -17,6 +17,13 @@
 
 #include "third_party/progress/progress.hpp"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace openMVG {
 namespace matching_image_collection {
 
@@ -33,12 +40,64 @@ Cascade_Hashing_Matcher_Regions
 
 namespace impl
 {
+// Collect used view indexes (sorted, unique)
+std::vector<IndexT> Used_Views
+(
+  const Pair_Set & pairs
+)
+{
+  std::vector<IndexT> used_index;
+  used_index.reserve(pairs.size() * 2);
+  for (const auto & pair_idx : pairs)
+  {
+    used_index.push_back(pair_idx.first);
+    used_index.push_back(pair_idx.second);
+  }
+  std::sort(used_index.begin(), used_index.end());
+  used_index.erase(std::unique(used_index.begin(), used_index.end()), used_index.end());
+  return used_index;
+}
+
+// Compute the zero mean descriptor that will be used for hashing (one for all the image regions)
+//  (the regions are requested one after the other)
+template <typename ScalarT>
+Eigen::VectorXf Zero_Mean_Descriptor
+(
+  const sfm::Regions_Provider & regions_provider,
+  const std::vector<IndexT> & used_index
+)
+{
+  using BaseMat = Eigen::Matrix<ScalarT, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  Eigen::MatrixXf matForZeroMean;
+  for (int i =0; i < static_cast<int>(used_index.size()); ++i)
+  {
+    const IndexT I = used_index[i];
+    const std::shared_ptr<features::Regions> regionsI = regions_provider.get(I);
+    const ScalarT * tabI =
+      reinterpret_cast<const ScalarT*>(regionsI->DescriptorRawData());
+    const size_t dimension = regionsI->DescriptorLength();
+    if (i==0)
+    {
+      matForZeroMean.resize(used_index.size(), dimension);
+      matForZeroMean.fill(0.0f);
+    }
+    if (regionsI->RegionCount() > 0)
+    {
+      Eigen::Map<BaseMat> mat_I( (ScalarT*)tabI, regionsI->RegionCount(), dimension);
+      matForZeroMean.row(i) = CascadeHasher::GetZeroMeanDescriptor(mat_I);
+    }
+  }
+  return CascadeHasher::GetZeroMeanDescriptor(matForZeroMean);
+}
+
 template <typename ScalarT>
 void Match
 (
   const sfm::Regions_Provider & regions_provider,
   const Pair_Set & pairs,
   float fDistRatio,
+  const Eigen::VectorXf & prepared_zero_mean_descriptor, // used if not empty
   PairWiseMatchesContainer & map_PutativesMatches, // the pairwise photometric corresponding points
   C_Progress * my_progress_bar
 )
@@ -47,184 +106,196 @@ void Match
     my_progress_bar = &C_Progress::dummy();
   my_progress_bar->restart(pairs.size(), "\n- Matching -\n");
 
-  // Collect used view indexes
-  std::set<IndexT> used_index;
-  // Sort pairs according the first index to minimize later memory swapping
-  using Map_vectorT = std::map<IndexT, std::vector<IndexT>>;
-  Map_vectorT map_Pairs;
-  for (const auto & pair_idx : pairs)
+  // Collect used view indexes (sorted, unique) and their dense index
+  const std::vector<IndexT> used_index = Used_Views(pairs);
+
+  Hash_Map<IndexT, int> dense_index;
+  for (int i = 0; i < static_cast<int>(used_index.size()); ++i)
   {
-    map_Pairs[pair_idx.first].push_back(pair_idx.second);
-    used_index.insert(pair_idx.first);
-    used_index.insert(pair_idx.second);
+    dense_index[used_index[i]] = i;
   }
 
+  // Flatten the pairs and sort them according the first index
+  //  to minimize later memory swapping
+  std::vector<Pair> vec_pairs(pairs.cbegin(), pairs.cend());
+  std::stable_sort(vec_pairs.begin(), vec_pairs.end(),
+    [](const Pair & a, const Pair & b) { return a.first < b.first; });
+
   using BaseMat = Eigen::Matrix<ScalarT, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
   // Init the cascade hasher
   CascadeHasher cascade_hasher;
   if (!used_index.empty())
   {
-    const IndexT I = *used_index.begin();
+    const IndexT I = used_index.front();
     const std::shared_ptr<features::Regions> regionsI = regions_provider.get(I);
     const size_t dimension = regionsI->DescriptorLength();
     cascade_hasher.Init(dimension);
   }
 
-  std::map<IndexT, HashedDescriptions> hashed_base_;
+  // Hashed descriptions of the used views (indexed by their dense index)
+  std::vector<HashedDescriptions> hashed_base_(used_index.size());
 
-  // Compute the zero mean descriptor that will be used for hashing (one for all the image regions)
-  Eigen::VectorXf zero_mean_descriptor;
-  {
-    Eigen::MatrixXf matForZeroMean;
-    for (int i =0; i < used_index.size(); ++i)
-    {
-      std::set<IndexT>::const_iterator iter = used_index.begin();
-      std::advance(iter, i);
-      const IndexT I = *iter;
-      const std::shared_ptr<features::Regions> regionsI = regions_provider.get(I);
-      const ScalarT * tabI =
-        reinterpret_cast<const ScalarT*>(regionsI->DescriptorRawData());
-      const size_t dimension = regionsI->DescriptorLength();
-      if (i==0)
-      {
-        matForZeroMean.resize(used_index.size(), dimension);
-        matForZeroMean.fill(0.0f);
-      }
-      if (regionsI->RegionCount() > 0)
-      {
-        Eigen::Map<BaseMat> mat_I( (ScalarT*)tabI, regionsI->RegionCount(), dimension);
-        matForZeroMean.row(i) = CascadeHasher::GetZeroMeanDescriptor(mat_I);
-      }
-    }
-    zero_mean_descriptor = CascadeHasher::GetZeroMeanDescriptor(matForZeroMean);
-  }
+  // The zero mean descriptor used for hashing: the prepared one (computed over
+  //  all the views of a pair set this one is a subset of) or the one of these views
+  const Eigen::VectorXf zero_mean_descriptor =
+    (prepared_zero_mean_descriptor.size() > 0) ?
+      prepared_zero_mean_descriptor :
+      Zero_Mean_Descriptor<ScalarT>(regions_provider, used_index);
 
-  // Index the input regions
+  // Index the input regions (each thread writes its own slot)
 #ifdef OPENMVG_USE_OPENMP
   #pragma omp parallel for schedule(dynamic)
 #endif
-  for (int i =0; i < used_index.size(); ++i)
+  for (int i =0; i < static_cast<int>(used_index.size()); ++i)
   {
-    std::set<IndexT>::const_iterator iter = used_index.begin();
-    std::advance(iter, i);
-    const IndexT I = *iter;
+    const IndexT I = used_index[i];
     const std::shared_ptr<features::Regions> regionsI = regions_provider.get(I);
     const ScalarT * tabI =
       reinterpret_cast<const ScalarT*>(regionsI->DescriptorRawData());
     const size_t dimension = regionsI->DescriptorLength();
 
     Eigen::Map<BaseMat> mat_I( (ScalarT*)tabI, regionsI->RegionCount(), dimension);
+    hashed_base_[i] = cascade_hasher.CreateHashedDescriptions(mat_I, zero_mean_descriptor);
+  }
+
+  // A thread safe container (i.e. streaming or pipelined) receives each pair
+  //  as soon as it is matched, else the pairs go to per thread buffers that
+  //  are merged once all the pairs are matched (no lock in both cases)
+  const bool b_direct_insert = map_PutativesMatches.IsThreadSafe();
 #ifdef OPENMVG_USE_OPENMP
-    #pragma omp critical
+  std::vector<std::vector<std::pair<Pair, IndMatches>>> thread_matches(
+    b_direct_insert ? 0 : omp_get_max_threads());
+#else
+  std::vector<std::vector<std::pair<Pair, IndMatches>>> thread_matches(
+    b_direct_insert ? 0 : 1);
 #endif
-    {
-      hashed_base_[I] =
-        std::move(cascade_hasher.CreateHashedDescriptions(mat_I, zero_mean_descriptor));
-    }
-  }
 
   // Perform matching between all the pairs
-  for (const auto & pair_it : map_Pairs)
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < static_cast<int>(vec_pairs.size()); ++k)
   {
     if (my_progress_bar->hasBeenCanceled())
-      break;
-    const IndexT I = pair_it.first;
-    const std::vector<IndexT> & indexToCompare = pair_it.second;
+      continue;
+    const IndexT I = vec_pairs[k].first;
+    const IndexT J = vec_pairs[k].second;
 
-    const std::shared_ptr<features::Regions> regionsI = regions_provider.get(I);
-    if (regionsI->RegionCount() == 0)
+    const std::shared_ptr<features::Regions>
+      regionsI = regions_provider.get(I),
+      regionsJ = regions_provider.get(J);
+
+    if (regionsI->RegionCount() == 0
+        || regionsI->Type_id() != regionsJ->Type_id())
     {
-      (*my_progress_bar) += indexToCompare.size();
+      ++(*my_progress_bar);
       continue;
     }
 
-    const std::vector<features::PointFeature> pointFeaturesI = regionsI->GetRegionsPositions();
-    const ScalarT * tabI =
-      reinterpret_cast<const ScalarT*>(regionsI->DescriptorRawData());
+    // Matrix representation of the query and database input data;
     const size_t dimension = regionsI->DescriptorLength();
+    const ScalarT * tabI = reinterpret_cast<const ScalarT*>(regionsI->DescriptorRawData());
     Eigen::Map<BaseMat> mat_I( (ScalarT*)tabI, regionsI->RegionCount(), dimension);
-
-#ifdef OPENMVG_USE_OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
-    for (int j = 0; j < (int)indexToCompare.size(); ++j)
+    const ScalarT * tabJ = reinterpret_cast<const ScalarT*>(regionsJ->DescriptorRawData());
+    Eigen::Map<BaseMat> mat_J( (ScalarT*)tabJ, regionsJ->RegionCount(), dimension);
+
+    IndMatches pvec_indices;
+    using ResultType = typename Accumulator<ScalarT>::Type;
+    std::vector<ResultType> pvec_distances;
+    pvec_distances.reserve(regionsJ->RegionCount() * 2);
+    pvec_indices.reserve(regionsJ->RegionCount() * 2);
+
+    // Match the query descriptors to the database
+    cascade_hasher.Match_HashedDescriptions<BaseMat, ResultType>(
+      hashed_base_[dense_index.at(J)], mat_J,
+      hashed_base_[dense_index.at(I)], mat_I,
+      &pvec_indices, &pvec_distances);
+
+    std::vector<int> vec_nn_ratio_idx;
+    // Filter the matches using a distance ratio test:
+    //   The probability that a match is correct is determined by taking
+    //   the ratio of distance from the closest neighbor to the distance
+    //   of the second closest.
+    matching::NNdistanceRatio(
+      pvec_distances.begin(), // distance start
+      pvec_distances.end(),   // distance end
+      2, // Number of neighbor in iterator sequence (minimum required 2)
+      vec_nn_ratio_idx, // output (indices that respect the distance Ratio)
+      Square(fDistRatio));
+
+    matching::IndMatches vec_putative_matches;
+    vec_putative_matches.reserve(vec_nn_ratio_idx.size());
+    for (const int index : vec_nn_ratio_idx)
     {
-      if (my_progress_bar->hasBeenCanceled())
-        continue;
-      const size_t J = indexToCompare[j];
-      const std::shared_ptr<features::Regions> regionsJ = regions_provider.get(J);
+      vec_putative_matches.emplace_back(pvec_indices[index*2].j_, pvec_indices[index*2].i_);
+    }
 
-      if (regionsI->Type_id() != regionsJ->Type_id())
-      {
-        ++(*my_progress_bar);
-        continue;
-      }
+    // Remove duplicates
+    matching::IndMatch::getDeduplicated(vec_putative_matches);
+
+    // Remove matches that have the same (X,Y) coordinates
+    const std::vector<features::PointFeature>
+      pointFeaturesI = regionsI->GetRegionsPositions(),
+      pointFeaturesJ = regionsJ->GetRegionsPositions();
+    matching::IndMatchDecorator<float> matchDeduplicator(vec_putative_matches,
+      pointFeaturesI, pointFeaturesJ);
+    matchDeduplicator.getDeduplicated(vec_putative_matches);
 
-      // Matrix representation of the query input data;
-      const ScalarT * tabJ = reinterpret_cast<const ScalarT*>(regionsJ->DescriptorRawData());
-      Eigen::Map<BaseMat> mat_J( (ScalarT*)tabJ, regionsJ->RegionCount(), dimension);
-
-      IndMatches pvec_indices;
-      using ResultType = typename Accumulator<ScalarT>::Type;
-      std::vector<ResultType> pvec_distances;
-      pvec_distances.reserve(regionsJ->RegionCount() * 2);
-      pvec_indices.reserve(regionsJ->RegionCount() * 2);
-
-      // Match the query descriptors to the database
-      cascade_hasher.Match_HashedDescriptions<BaseMat, ResultType>(
-        hashed_base_[J], mat_J,
-        hashed_base_[I], mat_I,
-        &pvec_indices, &pvec_distances);
-
-      std::vector<int> vec_nn_ratio_idx;
-      // Filter the matches using a distance ratio test:
-      //   The probability that a match is correct is determined by taking
-      //   the ratio of distance from the closest neighbor to the distance
-      //   of the second closest.
-      matching::NNdistanceRatio(
-        pvec_distances.begin(), // distance start
-        pvec_distances.end(),   // distance end
-        2, // Number of neighbor in iterator sequence (minimum required 2)
-        vec_nn_ratio_idx, // output (indices that respect the distance Ratio)
-        Square(fDistRatio));
-
-      matching::IndMatches vec_putative_matches;
-      vec_putative_matches.reserve(vec_nn_ratio_idx.size());
-      for (size_t k=0; k < vec_nn_ratio_idx.size(); ++k)
+    if (!vec_putative_matches.empty())
+    {
+      if (b_direct_insert)
       {
-        const size_t index = vec_nn_ratio_idx[k];
-        vec_putative_matches.emplace_back(pvec_indices[index*2].j_, pvec_indices[index*2].i_);
+        map_PutativesMatches.insert( { {I,J}, std::move(vec_putative_matches) } );
       }
-
-      // Remove duplicates
-      matching::IndMatch::getDeduplicated(vec_putative_matches);
-
-      // Remove matches that have the same (X,Y) coordinates
-      const std::vector<features::PointFeature> pointFeaturesJ = regionsJ->GetRegionsPositions();
-      matching::IndMatchDecorator<float> matchDeduplicator(vec_putative_matches,
-        pointFeaturesI, pointFeaturesJ);
-      matchDeduplicator.getDeduplicated(vec_putative_matches);
-
+      else
+      {
 #ifdef OPENMVG_USE_OPENMP
-#pragma omp critical
+        const int thread_id = omp_get_thread_num();
+#else
+        const int thread_id = 0;
 #endif
-      {
-        if (!vec_putative_matches.empty())
-        {
-          map_PutativesMatches.insert(
-            {
-              {I,J},
-              std::move(vec_putative_matches)
-            });
-        }
+        thread_matches[thread_id].emplace_back(Pair(I, J), std::move(vec_putative_matches));
       }
-      ++(*my_progress_bar);
+    }
+    ++(*my_progress_bar);
+  }
+
+  // Merge the per thread results
+  for (auto & matches : thread_matches)
+  {
+    for (auto & pair_matches : matches)
+    {
+      map_PutativesMatches.insert(std::move(pair_matches));
     }
   }
 }
 } // namespace impl
 
+void Cascade_Hashing_Matcher_Regions::Prepare
+(
+  const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+  const Pair_Set & pairs
+)
+{
+  zero_mean_descriptor_.resize(0);
+  if (!regions_provider || regions_provider->IsBinary() || pairs.empty())
+    return;
+
+  const std::vector<IndexT> used_index = impl::Used_Views(pairs);
+  if (regions_provider->Type_id() == typeid(unsigned char).name())
+  {
+    zero_mean_descriptor_ =
+      impl::Zero_Mean_Descriptor<unsigned char>(*regions_provider.get(), used_index);
+  }
+  else
+  if (regions_provider->Type_id() == typeid(float).name())
+  {
+    zero_mean_descriptor_ =
+      impl::Zero_Mean_Descriptor<float>(*regions_provider.get(), used_index);
+  }
+}
+
 void Cascade_Hashing_Matcher_Regions::Match
 (
   const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
@@ -248,6 +319,7 @@ void Cascade_Hashing_Matcher_Regions::Match
       *regions_provider.get(),
       pairs,
       f_dist_ratio_,
+      zero_mean_descriptor_,
       map_PutativesMatches,
       my_progress_bar);
   }
@@ -258,6 +330,7 @@ void Cascade_Hashing_Matcher_Regions::Match
       *regions_provider.get(),
       pairs,
       f_dist_ratio_,
+      zero_mean_descriptor_,
       map_PutativesMatches,
       my_progress_bar);
   }
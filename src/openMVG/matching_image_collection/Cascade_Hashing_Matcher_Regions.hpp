@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "openMVG/matching_image_collection/Matcher.hpp"
+#include "openMVG/numeric/eigen_alias_definition.hpp"
 
 namespace openMVG { namespace matching { class PairWiseMatchesContainer; } }
 namespace openMVG { namespace sfm { struct Regions_Provider; } }
@@ -25,6 +26,8 @@ namespace matching_image_collection {
 ///  a threshold over the distance ratio of the 2 nearest neighbours.
 /// Using a Cascade Hashing matching
 /// Cascade hashing tables are computed once and used for all the regions.
+/// The zero mean descriptor used for hashing can be prepared once for a pair set
+///  whose subsets are then matched (see Tiled_Matcher).
 ///
 class Cascade_Hashing_Matcher_Regions : public Matcher
 {
@@ -42,9 +45,18 @@ class Cascade_Hashing_Matcher_Regions : public Matcher
     C_Progress * progress = nullptr
   ) const override;
 
+  /// Compute the zero mean descriptor of the views of the pairs
+  void Prepare
+  (
+    const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+    const Pair_Set & pairs
+  ) override;
+
   private:
   // Distance ratio used to discard spurious correspondence
   float f_dist_ratio_;
+  // Prepared zero mean descriptor (empty if the matched views are used)
+  Eigen::VectorXf zero_mean_descriptor_;
 };
 
 } // namespace matching_image_collection
@@ -0,0 +1,144 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/matching_image_collection/Cascade_Hashing_Matcher_Regions.hpp"
+#include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "testing/testing.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::matching;
+using namespace openMVG::matching_image_collection;
+
+// Regions provider filled with in memory regions
+struct Synthetic_Regions_Provider : public sfm::Regions_Provider
+{
+  Synthetic_Regions_Provider()
+  {
+    region_type_.reset(new SIFT_Regions);
+  }
+
+  void add(const IndexT view_id, std::shared_ptr<Regions> regions)
+  {
+    cache_[view_id] = regions;
+  }
+};
+
+// Views observing a noisy subset of a scene descriptor set
+std::shared_ptr<Synthetic_Regions_Provider> Synthetic_Regions(const int nb_view, const int nb_desc)
+{
+  std::mt19937 rng(std::mt19937::default_seed);
+  std::uniform_int_distribution<int> value_distrib(0, 127);
+  std::uniform_int_distribution<int> noise_distrib(-4, 4);
+  std::uniform_real_distribution<float> position_distrib(0.f, 1000.f);
+  std::bernoulli_distribution keep_distrib(0.7);
+
+  std::vector<SIFT_Regions::DescriptorT> scene_descriptors(nb_desc);
+  for (auto & desc : scene_descriptors)
+    for (int i = 0; i < desc.size(); ++i)
+      desc[i] = value_distrib(rng);
+
+  auto regions_provider = std::make_shared<Synthetic_Regions_Provider>();
+  for (int view_id = 0; view_id < nb_view; ++view_id)
+  {
+    std::shared_ptr<SIFT_Regions> regions = std::make_shared<SIFT_Regions>();
+    for (const auto & scene_desc : scene_descriptors)
+    {
+      if (!keep_distrib(rng))
+        continue;
+      SIFT_Regions::DescriptorT desc;
+      for (int i = 0; i < desc.size(); ++i)
+        desc[i] = std::min(255, std::max(0, scene_desc[i] + noise_distrib(rng)));
+      regions->Descriptors().push_back(desc);
+      regions->Features().emplace_back(position_distrib(rng), position_distrib(rng), 1.f, 0.f);
+    }
+    regions_provider->add(view_id, regions);
+  }
+  return regions_provider;
+}
+
+// Thread safe container that records how many matcher threads are inserting at once
+//  (optionally, an insert waits a bit for another thread to insert too)
+struct Concurrent_Matches_Container : public PairWiseMatchesContainer
+{
+  explicit Concurrent_Matches_Container(const bool b_wait = false) : b_wait_(b_wait) {}
+
+  void insert(std::pair<Pair, IndMatches> && pairWiseMatches) override
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++inserting_count_;
+    max_inserting_count_ = std::max(max_inserting_count_, inserting_count_);
+    condition_.notify_all();
+    if (b_wait_)
+      condition_.wait_for(lock, std::chrono::milliseconds(100),
+        [this]{ return max_inserting_count_ > 1; });
+    --inserting_count_;
+    matches_.insert(std::move(pairWiseMatches));
+  }
+
+  bool IsThreadSafe() const override { return true; }
+
+  const bool b_wait_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  int inserting_count_ = 0;
+  int max_inserting_count_ = 0;
+  PairWiseMatches matches_;
+};
+
+TEST(Cascade_Hashing_Matcher_Regions, SameMatchesForAllContainers)
+{
+  const int nb_view = 8;
+  const auto regions_provider = Synthetic_Regions(nb_view, 200);
+  const Pair_Set pairs = exhaustivePairs(nb_view);
+
+  // Per thread buffers (PairWiseMatches) and direct inserts (thread safe container)
+  PairWiseMatches buffered_matches;
+  Cascade_Hashing_Matcher_Regions(0.8f).Match(regions_provider, pairs, buffered_matches);
+  Concurrent_Matches_Container direct_matches;
+  Cascade_Hashing_Matcher_Regions(0.8f).Match(regions_provider, pairs, direct_matches);
+
+  EXPECT_EQ( pairs.size(), buffered_matches.size() );
+  EXPECT_TRUE( buffered_matches == direct_matches.matches_ );
+}
+
+#ifdef OPENMVG_USE_OPENMP
+TEST(Cascade_Hashing_Matcher_Regions, NoGlobalLockOnInsert)
+{
+  const int nb_view = 8;
+  const auto regions_provider = Synthetic_Regions(nb_view, 200);
+  const Pair_Set pairs = exhaustivePairs(nb_view);
+
+  // Two matcher threads must be able to insert at the same time
+  //  (impossible if the container is written under a global lock)
+  const int nb_thread = omp_get_max_threads();
+  omp_set_num_threads(2);
+  Concurrent_Matches_Container matches(true);
+  Cascade_Hashing_Matcher_Regions(0.8f).Match(regions_provider, pairs, matches);
+  omp_set_num_threads(nb_thread);
+
+  EXPECT_EQ( pairs.size(), matches.matches_.size() );
+  EXPECT_EQ( 2, matches.max_inserting_count_ );
+}
+#endif
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -37,6 +37,15 @@ namespace matching_image_collection {
 //-- A contrario essential matrix estimation template functor used for filter pair of putative correspondences
 struct GeometricFilter_EMatrix_AC
 {
+  // The AContrario adapted Essential matrix solver
+  using KernelType =
+    openMVG::robust::ACKernelAdaptorEssential<
+      openMVG::essential::kernel::FivePointSolver,
+      openMVG::fundamental::kernel::EpipolarDistanceError,
+      Mat3>;
+  /// ACRANSAC buffers of the essential matrix estimation
+  using Workspace = robust::ACRansac_Workspace<KernelType>;
+
   GeometricFilter_EMatrix_AC
   (
     double dPrecision = std::numeric_limits<double>::infinity(),
@@ -57,7 +66,8 @@ struct GeometricFilter_EMatrix_AC
     const std::shared_ptr<Regions_or_Features_ProviderT> & regions_provider,
     const Pair pairIndex,
     const matching::IndMatches & vec_PutativeMatches,
-    matching::IndMatches & geometric_inliers)
+    matching::IndMatches & geometric_inliers,
+    Workspace & workspace)
   {
     geometric_inliers.clear();
 
@@ -99,13 +109,6 @@ struct GeometricFilter_EMatrix_AC
     // Robust estimation
     //--
 
-    // Define the AContrario adapted Essential matrix solver
-    using KernelType =
-      openMVG::robust::ACKernelAdaptorEssential<
-        openMVG::essential::kernel::FivePointSolver,
-        openMVG::fundamental::kernel::EpipolarDistanceError,
-        Mat3>;
-
     const cameras::Pinhole_Intrinsic
       * ptrPinhole_I = dynamic_cast<const cameras::Pinhole_Intrinsic*>(cam_I),
       * ptrPinhole_J = dynamic_cast<const cameras::Pinhole_Intrinsic*>(cam_J);
@@ -121,7 +124,7 @@ struct GeometricFilter_EMatrix_AC
     const double upper_bound_precision = Square(m_dPrecision);
     std::vector<uint32_t> vec_inliers;
     const auto ACRansacOut =
-      openMVG::robust::ACRANSAC(kernel, vec_inliers, m_stIteration, &m_E, upper_bound_precision);
+      openMVG::robust::ACRANSAC(kernel, workspace, vec_inliers, m_stIteration, &m_E, upper_bound_precision);
 
     if (vec_inliers.size() > KernelType::MINIMUM_SAMPLES *2.5)
     {
@@ -183,10 +186,9 @@ struct GeometricFilter_EMatrix_AC
         regionsI = regions_provider->get(iIndex),
         regionsJ = regions_provider->get(jIndex);
 
-      geometry_aware::GuidedMatching<
-        Mat3,
+      // Only the regions close to the epipolar lines are compared
+      geometry_aware::GuidedMatching_Epipolar_Fast<
         openMVG::fundamental::kernel::EpipolarDistanceError>(
-          //openMVG::fundamental::kernel::SymmetricEpipolarDistanceError>(
           F,
           cam_I, *regionsI,
           cam_J, *regionsJ,
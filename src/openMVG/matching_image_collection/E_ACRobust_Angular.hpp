@@ -19,19 +19,29 @@
 #include "openMVG/multiview/essential.hpp"
 #include "openMVG/multiview/motion_from_essential.hpp"
 #include "openMVG/multiview/solver_essential_eight_point.hpp"
+#include "openMVG/robust_estimation/guided_matching.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
 #include "openMVG/sfm/pipelines/sfm_robust_model_estimation.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 
-namespace openMVG { namespace sfm { struct Regions_Provider; } }
-
 namespace openMVG {
 namespace matching_image_collection {
 
 //-- A contrario essential matrix estimation template functor used for filter pair of putative correspondences
 struct GeometricFilter_ESphericalMatrix_AC_Angular
 {
+  // The AContrario angular error adaptor
+  typedef openMVG::robust::ACKernelAdaptor_AngularRadianError<
+      // Use the 8 point solver in order to estimate E
+      openMVG::EightPointRelativePoseSolver,
+      openMVG::AngularError,
+      Mat3>
+      KernelType;
+  /// ACRANSAC buffers of the angular essential matrix estimation
+  using Workspace = robust::ACRansac_Workspace<KernelType>;
+
   GeometricFilter_ESphericalMatrix_AC_Angular(
     double precision_upper_bound = std::numeric_limits<double>::infinity(),
     size_t iteration = 1024)
@@ -50,7 +60,8 @@ struct GeometricFilter_ESphericalMatrix_AC_Angular
     const std::shared_ptr<Regions_or_Features_ProviderT> & regions_provider,
     const Pair pairIndex,
     const matching::IndMatches & vec_PutativeMatches,
-    matching::IndMatches & geometric_inliers)
+    matching::IndMatches & geometric_inliers,
+    Workspace & workspace)
   {
     using namespace openMVG;
     using namespace openMVG::robust;
@@ -95,14 +106,6 @@ struct GeometricFilter_ESphericalMatrix_AC_Angular
     // Robust estimation
     //--
 
-    // Define the AContrario angular error adaptor
-    typedef openMVG::robust::ACKernelAdaptor_AngularRadianError<
-        // Use the 8 point solver in order to estimate E
-        openMVG::EightPointRelativePoseSolver,
-        openMVG::AngularError,
-        Mat3>
-        KernelType;
-
     KernelType kernel(xI_bearing_vector, xJ_bearing_vector);
 
     // Robustly estimate the Essential matrix with A Contrario ransac
@@ -111,7 +114,7 @@ struct GeometricFilter_ESphericalMatrix_AC_Angular
         D2R(m_precision_upper_bound) : std::numeric_limits<double>::infinity();
     std::vector<uint32_t> vec_inliers;
     const auto ac_ransac_output =
-      ACRANSAC(kernel, vec_inliers, m_stIteration, &m_E, upper_bound_precision);
+      ACRANSAC(kernel, workspace, vec_inliers, m_stIteration, &m_E, upper_bound_precision);
 
     const double & threshold = ac_ransac_output.first;
 
@@ -160,7 +163,53 @@ struct GeometricFilter_ESphericalMatrix_AC_Angular
     matching::IndMatches & matches
   )
   {
-    return false;
+    if (m_precision_upper_bound_robust == std::numeric_limits<double>::infinity())
+      return false;
+
+    // Get back corresponding view index
+    const IndexT iIndex = pairIndex.first;
+    const IndexT jIndex = pairIndex.second;
+
+    const sfm::View
+      * view_I = sfm_data->views.at(iIndex).get(),
+      * view_J = sfm_data->views.at(jIndex).get();
+
+    // Check that valid cameras can be retrieved for the pair of views
+    const cameras::IntrinsicBase
+      * cam_I =
+        sfm_data->GetIntrinsics().count(view_I->id_intrinsic) ?
+          sfm_data->GetIntrinsics().at(view_I->id_intrinsic).get() : nullptr,
+      * cam_J =
+        sfm_data->GetIntrinsics().count(view_J->id_intrinsic) ?
+          sfm_data->GetIntrinsics().at(view_J->id_intrinsic).get() : nullptr;
+
+    if (!cam_I || !cam_J)
+      return false;
+
+    const std::shared_ptr<features::Regions>
+      regionsI = regions_provider->get(iIndex),
+      regionsJ = regions_provider->get(jIndex);
+    if (regionsI->RegionCount() == 0 || regionsJ->RegionCount() == 0)
+      return false;
+
+    // Bearing vectors of all the regions
+    const std::vector<Vec2>
+      xI = geometry_aware::RegionPositions(cam_I, *regionsI),
+      xJ = geometry_aware::RegionPositions(cam_J, *regionsJ);
+    const Mat3X
+      xI_bearing_vector = (*cam_I)(Eigen::Map<const Mat2X>(xI[0].data(), 2, xI.size())),
+      xJ_bearing_vector = (*cam_J)(Eigen::Map<const Mat2X>(xJ[0].data(), 2, xJ.size()));
+
+    // Check the features correspondences that agree in the geometric and photometric domain
+    // (only the bearing vectors close to the epipolar planes are compared)
+    geometry_aware::GuidedMatching_Angular_Fast<openMVG::AngularError>(
+      m_E,
+      xI_bearing_vector, *regionsI,
+      xJ_bearing_vector, *regionsJ,
+      m_precision_upper_bound_robust, Square(dDistanceRatio),
+      matches);
+
+    return matches.size() != 0;
   }
 
   double m_precision_upper_bound;  // upper_bound precision used for robust estimation
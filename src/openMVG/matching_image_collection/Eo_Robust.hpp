@@ -34,6 +34,16 @@ namespace matching_image_collection {
 //-- A contrario essential matrix estimation template functor used for filter pair of putative correspondences
 struct GeometricFilter_EOMatrix_RA
 {
+    // The AContrario adapted orthographic Essential matrix solver
+    // --- using KernelType = essential::kernel::ThreePointKernel;
+    using KernelType =
+      robust::ACKernelAdaptorEssentialOrtho<
+        essential::kernel::ThreePointKernel,
+        essential::kernel::OrthographicSymmetricEpipolarDistanceError,
+        Mat3>;
+    /// ACRANSAC buffers of the orthographic essential matrix estimation
+    using Workspace = robust::ACRansac_Workspace<KernelType>;
+
     GeometricFilter_EOMatrix_RA
     (
       double dPrecision = std::numeric_limits<double>::infinity(),
@@ -53,7 +63,8 @@ struct GeometricFilter_EOMatrix_RA
       const std::shared_ptr<Regions_or_Features_ProviderT> & regions_provider,
       const Pair pairIndex,
       const matching::IndMatches & vec_PutativeMatches,
-      matching::IndMatches & geometric_inliers
+      matching::IndMatches & geometric_inliers,
+      Workspace & workspace
     )
     {
       geometric_inliers.clear();
@@ -103,14 +114,6 @@ struct GeometricFilter_EOMatrix_RA
       // Robust estimation
       //--
 
-      // Define the Kernel
-      // --- using KernelType = essential::kernel::ThreePointKernel;
-      using KernelType =
-        robust::ACKernelAdaptorEssentialOrtho<
-          essential::kernel::ThreePointKernel,
-          essential::kernel::OrthographicSymmetricEpipolarDistanceError,
-          Mat3>;
-
       const KernelType kernel(
         (*cam_I)(xI),
         sfm_data->GetViews().at(iIndex)->ui_width,
@@ -122,9 +125,8 @@ struct GeometricFilter_EOMatrix_RA
 
       // Robustly estimate the model with AC-RANSAC
       std::vector<uint32_t> vec_inliers;
-
       const auto ACRansacOut = ACRANSAC(
-        kernel, vec_inliers, m_stIteration, &m_E, m_dPrecision);
+        kernel, workspace, vec_inliers, m_stIteration, &m_E, m_dPrecision);
 
       if (vec_inliers.size() > KernelType::MINIMUM_SAMPLES * 2.5)
       {
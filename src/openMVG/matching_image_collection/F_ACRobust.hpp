@@ -30,6 +30,17 @@ namespace matching_image_collection {
 //-- A contrario fundamental matrix estimation template functor used for filter pair of putative correspondences
 struct GeometricFilter_FMatrix_AC
 {
+  // The AContrario adapted Fundamental matrix solver
+  using KernelType =
+    robust::ACKernelAdaptor<
+      openMVG::fundamental::kernel::SevenPointSolver,
+      openMVG::fundamental::kernel::EpipolarDistanceError,
+      //openMVG::fundamental::kernel::SymmetricEpipolarDistanceError,
+      UnnormalizerT,
+      Mat3>;
+  /// ACRANSAC buffers of the fundamental matrix estimation
+  using Workspace = robust::ACRansac_Workspace<KernelType>;
+
   GeometricFilter_FMatrix_AC
   (
     double dPrecision = std::numeric_limits<double>::infinity(),
@@ -48,7 +59,8 @@ struct GeometricFilter_FMatrix_AC
     const std::shared_ptr<Regions_or_Features_ProviderT> & regions_provider,
     const Pair pairIndex,
     const matching::IndMatches & vec_PutativeMatches,
-    matching::IndMatches & geometric_inliers)
+    matching::IndMatches & geometric_inliers,
+    Workspace & workspace)
   {
     using namespace openMVG;
     using namespace openMVG::robust;
@@ -69,15 +81,6 @@ struct GeometricFilter_FMatrix_AC
     // Robust estimation
     //--
 
-    // Define the AContrario adapted Fundamental matrix solver
-    using KernelType =
-      ACKernelAdaptor<
-        openMVG::fundamental::kernel::SevenPointSolver,
-        openMVG::fundamental::kernel::EpipolarDistanceError,
-        //openMVG::fundamental::kernel::SymmetricEpipolarDistanceError,
-        UnnormalizerT,
-        Mat3>;
-
     const KernelType kernel(
       xI, sfm_data->GetViews().at(iIndex)->ui_width, sfm_data->GetViews().at(iIndex)->ui_height,
       xJ, sfm_data->GetViews().at(jIndex)->ui_width, sfm_data->GetViews().at(jIndex)->ui_height, true);
@@ -86,7 +89,7 @@ struct GeometricFilter_FMatrix_AC
     const double upper_bound_precision = Square(m_dPrecision);
     std::vector<uint32_t> vec_inliers;
     const std::pair<double,double> ACRansacOut =
-      ACRANSAC(kernel, vec_inliers, m_stIteration, &m_F, upper_bound_precision);
+      ACRANSAC(kernel, workspace, vec_inliers, m_stIteration, &m_F, upper_bound_precision);
 
     if (vec_inliers.size() > KernelType::MINIMUM_SAMPLES *2.5)
     {
@@ -137,10 +140,9 @@ struct GeometricFilter_FMatrix_AC
         regionsJ = regions_provider->get(jIndex);
 
       // Check the features correspondences that agree in the geometric and photometric domain
-      geometry_aware::GuidedMatching<
-        Mat3,
+      // (only the regions close to the epipolar lines are compared)
+      geometry_aware::GuidedMatching_Epipolar_Fast<
         openMVG::fundamental::kernel::EpipolarDistanceError>(
-          //openMVG::fundamental::kernel::SymmetricEpipolarDistanceError>(
           m_F,
           cam_I, *regionsI,
           cam_J, *regionsJ,
@@ -10,9 +10,16 @@
 #define OPENMVG_MATCHING_IMAGE_COLLECTION_GEOMETRIC_FILTER_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <map>
+#include <utility>
 #include <vector>
 
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 #include "openMVG/features/feature.hpp"
 #include "openMVG/matching/indMatch.hpp"
 
@@ -27,6 +34,66 @@ namespace matching_image_collection {
 
 using namespace openMVG::matching;
 
+namespace geometric_filter_internal {
+
+template <typename T>
+struct Void_Type
+{
+  using type = void;
+};
+
+/// Robust estimation buffers of a geometry functor (GeometryFunctor::Workspace if defined)
+template <typename GeometryFunctor, typename = void>
+struct Functor_Workspace
+{
+  struct type {};
+};
+
+template <typename GeometryFunctor>
+struct Functor_Workspace<GeometryFunctor,
+  typename Void_Type<typename GeometryFunctor::Workspace>::type>
+{
+  using type = typename GeometryFunctor::Workspace;
+};
+
+/// Run the robust estimation with the workspace if the functor uses one
+template <typename GeometryFunctor, typename Workspace>
+auto Robust_estimation
+(
+  GeometryFunctor & functor,
+  const sfm::SfM_Data * sfm_data,
+  const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+  const Pair & pair,
+  const IndMatches & putative_matches,
+  IndMatches & putative_inliers,
+  Workspace & workspace,
+  int
+) -> decltype(functor.Robust_estimation(sfm_data, regions_provider, pair,
+                putative_matches, putative_inliers, workspace))
+{
+  return functor.Robust_estimation(sfm_data, regions_provider, pair,
+    putative_matches, putative_inliers, workspace);
+}
+
+template <typename GeometryFunctor, typename Workspace>
+bool Robust_estimation
+(
+  GeometryFunctor & functor,
+  const sfm::SfM_Data * sfm_data,
+  const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+  const Pair & pair,
+  const IndMatches & putative_matches,
+  IndMatches & putative_inliers,
+  Workspace &,
+  long
+)
+{
+  return functor.Robust_estimation(sfm_data, regions_provider, pair,
+    putative_matches, putative_inliers);
+}
+
+} // namespace geometric_filter_internal
+
 /// Allow to keep only geometrically coherent matches
 /// -> It discards pairs that do not lead to a valid robust model estimation
 struct ImageCollectionGeometricFilter
@@ -52,6 +119,45 @@ struct ImageCollectionGeometricFilter
     C_Progress *progress_bar = nullptr
   );
 
+  /// Perform robust model estimation (with optional guided_matching) for the
+  /// pair_count pairs returned by read_pair (i.e. pairs read from a file):
+  ///  const IndMatches * read_pair(size_t i, Pair & pair, IndMatches & buffer)
+  /// sets the i-th pair and returns its putative matches (kept in buffer or
+  /// elsewhere), or nullptr if they cannot be read.
+  /// read_pair is called concurrently: the threads take the pairs one by one.
+  /// Return false if a pair cannot be read.
+  template<typename GeometryFunctor, typename PairReader>
+  bool Robust_model_estimation
+  (
+    const GeometryFunctor & functor,
+    const size_t pair_count,
+    const PairReader & read_pair,
+    const bool b_guided_matching = false,
+    const double d_distance_ratio = 0.6,
+    C_Progress *progress_bar = nullptr
+  );
+
+  /// Buffers of the robust estimation of a geometry functor.
+  /// A workspace is reused for all the pairs filtered by a thread (one per thread).
+  template<typename GeometryFunctor>
+  using Workspace =
+    typename geometric_filter_internal::Functor_Workspace<GeometryFunctor>::type;
+
+  /// Perform robust model estimation (with optional guided_matching) for one
+  /// pair and its regions correspondences.
+  /// Return true if a model is found (geometric_inliers is then filled).
+  template<typename GeometryFunctor>
+  bool Robust_model_estimation
+  (
+    const GeometryFunctor & functor,
+    const Pair & pair,
+    const IndMatches & putative_matches,
+    const bool b_guided_matching,
+    const double d_distance_ratio,
+    IndMatches & geometric_inliers,
+    Workspace<GeometryFunctor> & workspace
+  ) const;
+
   const PairWiseMatches & Get_geometric_matches() const
   {
     return _map_GeometricMatches;
@@ -72,60 +178,159 @@ void ImageCollectionGeometricFilter::Robust_model_estimation
   const double d_distance_ratio,
   C_Progress * my_progress_bar
 )
+{
+  // Flatten the pairs in a random access array.
+  // The pairs are sorted by decreasing putative match count: the most expensive
+  //  robust estimations start first, so the dynamic schedule does not end with
+  //  a few large pairs running alone.
+  std::vector<PairWiseMatches::const_iterator> pair_iterators;
+  pair_iterators.reserve(putative_matches.size());
+  for (auto iter = putative_matches.cbegin(); iter != putative_matches.cend(); ++iter)
+  {
+    pair_iterators.push_back(iter);
+  }
+  std::stable_sort(pair_iterators.begin(), pair_iterators.end(),
+    [](const PairWiseMatches::const_iterator & a, const PairWiseMatches::const_iterator & b)
+    {
+      return a->second.size() > b->second.size();
+    });
+
+  Robust_model_estimation(functor, pair_iterators.size(),
+    [&pair_iterators](const size_t i, Pair & pair, IndMatches &) -> const IndMatches *
+    {
+      pair = pair_iterators[i]->first;
+      return &pair_iterators[i]->second;
+    },
+    b_guided_matching, d_distance_ratio, my_progress_bar);
+}
+
+template<typename GeometryFunctor, typename PairReader>
+bool ImageCollectionGeometricFilter::Robust_model_estimation
+(
+  const GeometryFunctor & functor,
+  const size_t pair_count,
+  const PairReader & read_pair,
+  const bool b_guided_matching,
+  const double d_distance_ratio,
+  C_Progress * my_progress_bar
+)
 {
   if (!my_progress_bar)
     my_progress_bar = &C_Progress::dummy();
-  my_progress_bar->restart( putative_matches.size(), "\n- Geometric filtering -\n" );
+  my_progress_bar->restart( pair_count, "\n- Geometric filtering -\n" );
+
+  // Per thread geometric matches, merged once all the pairs are filtered,
+  //  and per thread robust estimation buffers
+#ifdef OPENMVG_USE_OPENMP
+  const int thread_count = omp_get_max_threads();
+#else
+  const int thread_count = 1;
+#endif
+  std::vector<std::vector<std::pair<Pair, IndMatches>>> thread_matches(thread_count);
+  std::vector<Workspace<GeometryFunctor>> thread_workspaces(thread_count);
+  std::atomic<bool> b_read_ok(true);
 
 #ifdef OPENMVG_USE_OPENMP
 #pragma omp parallel for schedule(dynamic)
 #endif
-  for (int i = 0; i < (int)putative_matches.size(); ++i)
+  for (int i = 0; i < static_cast<int>(pair_count); ++i)
   {
-    if (my_progress_bar->hasBeenCanceled())
+    if (!b_read_ok || my_progress_bar->hasBeenCanceled())
       continue;
-    auto iter = putative_matches.begin();
-    advance(iter,i);
 
-    Pair current_pair = iter->first;
-    const std::vector<IndMatch> & vec_PutativeMatches = iter->second;
+#ifdef OPENMVG_USE_OPENMP
+    const int thread_id = omp_get_thread_num();
+#else
+    const int thread_id = 0;
+#endif
+    Pair current_pair;
+    IndMatches putative_buffer;
+    const IndMatches * vec_PutativeMatches = read_pair(i, current_pair, putative_buffer);
+    if (!vec_PutativeMatches)
+    {
+      b_read_ok = false;
+      continue;
+    }
 
     //-- Apply the geometric filter (robust model estimation)
+    IndMatches putative_inliers;
+    if (Robust_model_estimation(functor, current_pair, *vec_PutativeMatches,
+          b_guided_matching, d_distance_ratio, putative_inliers,
+          thread_workspaces[thread_id]))
     {
-      IndMatches putative_inliers;
-      GeometryFunctor geometricFilter = functor; // use a copy since we are in a multi-thread context
-      if (geometricFilter.Robust_estimation(
-        sfm_data_,
-        regions_provider_,
-        iter->first,
-        vec_PutativeMatches,
-        putative_inliers))
-      {
-        if (b_guided_matching)
-        {
-          IndMatches guided_geometric_inliers;
-          geometricFilter.Geometry_guided_matching(
-            sfm_data_,
-            regions_provider_,
-            iter->first,
-            d_distance_ratio,
-            guided_geometric_inliers);
-          //std::cout
-          // << "#before/#after: " << putative_inliers.size()
-          // << "/" << guided_geometric_inliers.size() << std::endl;
-          std::swap(putative_inliers, guided_geometric_inliers);
-        }
-
-#ifdef OPENMVG_USE_OPENMP
-#pragma omp critical
-#endif
-        {
-          _map_GeometricMatches.insert( {current_pair, std::move(putative_inliers)});
-        }
-      }
+      thread_matches[thread_id].emplace_back(current_pair, std::move(putative_inliers));
     }
     ++(*my_progress_bar);
   }
+
+  // Merge the per thread results in pair order (the map insertions are then
+  //  done at the end of the map in amortized constant time)
+  std::vector<std::pair<Pair, IndMatches>> geometric_matches;
+  std::size_t geometric_match_count = 0;
+  for (const auto & matches : thread_matches)
+  {
+    geometric_match_count += matches.size();
+  }
+  geometric_matches.reserve(geometric_match_count);
+  for (auto & matches : thread_matches)
+  {
+    std::move(matches.begin(), matches.end(), std::back_inserter(geometric_matches));
+    matches.clear();
+  }
+  std::sort(geometric_matches.begin(), geometric_matches.end(),
+    [](const std::pair<Pair, IndMatches> & a, const std::pair<Pair, IndMatches> & b)
+    {
+      return a.first < b.first;
+    });
+  for (auto & pair_matches : geometric_matches)
+  {
+    _map_GeometricMatches.emplace_hint(_map_GeometricMatches.end(), std::move(pair_matches));
+  }
+  return b_read_ok;
+}
+
+template<typename GeometryFunctor>
+bool ImageCollectionGeometricFilter::Robust_model_estimation
+(
+  const GeometryFunctor & functor,
+  const Pair & pair,
+  const IndMatches & putative_matches,
+  const bool b_guided_matching,
+  const double d_distance_ratio,
+  IndMatches & geometric_inliers,
+  Workspace<GeometryFunctor> & workspace
+) const
+{
+  IndMatches putative_inliers;
+  GeometryFunctor geometricFilter = functor; // use a copy since we are in a multi-thread context
+  if (!geometric_filter_internal::Robust_estimation(
+    geometricFilter,
+    sfm_data_,
+    regions_provider_,
+    pair,
+    putative_matches,
+    putative_inliers,
+    workspace,
+    0))
+  {
+    return false;
+  }
+  if (b_guided_matching)
+  {
+    IndMatches guided_geometric_inliers;
+    geometricFilter.Geometry_guided_matching(
+      sfm_data_,
+      regions_provider_,
+      pair,
+      d_distance_ratio,
+      guided_geometric_inliers);
+    //std::cout
+    // << "#before/#after: " << putative_inliers.size()
+    // << "/" << guided_geometric_inliers.size() << std::endl;
+    std::swap(putative_inliers, guided_geometric_inliers);
+  }
+  geometric_inliers = std::move(putative_inliers);
+  return true;
 }
 
 } // namespace matching_image_collection
@@ -0,0 +1,129 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/matching_image_collection/GeometricFilter.hpp"
+#include "testing/testing.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::matching;
+using namespace openMVG::matching_image_collection;
+
+// Geometric filter that keeps the matches with an even i_ index.
+// A pair without any kept match is rejected.
+struct EvenMatchesFilter
+{
+  bool Robust_estimation
+  (
+    const sfm::SfM_Data *,
+    const std::shared_ptr<sfm::Regions_Provider> &,
+    const Pair &,
+    const IndMatches & vec_PutativeMatches,
+    IndMatches & geometric_inliers
+  )
+  {
+    for (const IndMatch & match : vec_PutativeMatches)
+    {
+      if (match.i_ % 2 == 0)
+        geometric_inliers.push_back(match);
+    }
+    return !geometric_inliers.empty();
+  }
+
+  bool Geometry_guided_matching
+  (
+    const sfm::SfM_Data *,
+    const std::shared_ptr<sfm::Regions_Provider> &,
+    const Pair &,
+    const double,
+    IndMatches & matches
+  )
+  {
+    return true;
+  }
+};
+
+TEST(GeometricFilter, PerThreadMergeIsOrderedAndComplete)
+{
+  // Pairs with very different match counts (they are not processed in pair order)
+  PairWiseMatches putative_matches;
+  for (IndexT I = 0; I < 30; ++I)
+  {
+    for (IndexT J = I + 1; J < 30; ++J)
+    {
+      IndMatches & matches = putative_matches[{I, J}];
+      const IndexT match_count = (I * 7 + J * 13) % 50;
+      for (IndexT k = 0; k < match_count; ++k)
+        matches.emplace_back(k + (I + J) % 2, k);
+    }
+  }
+
+  const std::shared_ptr<sfm::Regions_Provider> regions_provider;
+  ImageCollectionGeometricFilter filter(nullptr, regions_provider);
+  filter.Robust_model_estimation(EvenMatchesFilter(), putative_matches);
+  const PairWiseMatches & geometric_matches = filter.Get_geometric_matches();
+
+  // Expected result (serial evaluation)
+  PairWiseMatches expected_matches;
+  for (const auto & pair_matches : putative_matches)
+  {
+    IndMatches inliers;
+    if (EvenMatchesFilter().Robust_estimation(
+          nullptr, regions_provider, pair_matches.first, pair_matches.second, inliers))
+      expected_matches[pair_matches.first] = inliers;
+  }
+
+  EXPECT_TRUE(!expected_matches.empty());
+  EXPECT_EQ(expected_matches.size(), geometric_matches.size());
+  EXPECT_TRUE(
+    std::equal(expected_matches.cbegin(), expected_matches.cend(),
+               geometric_matches.cbegin()));
+}
+
+TEST(GeometricFilter, ReadPairByPair)
+{
+  // Pairs given one by one (as read from a putative matches file)
+  std::vector<std::pair<Pair, IndMatches>> putative_pairs;
+  for (IndexT I = 0; I < 20; ++I)
+    putative_pairs.push_back({{I, I + 1}, {{I, 0}, {I + 1, 1}, {I + 2, 2}}});
+
+  const std::shared_ptr<sfm::Regions_Provider> regions_provider;
+  ImageCollectionGeometricFilter filter(nullptr, regions_provider);
+  EXPECT_TRUE(filter.Robust_model_estimation(EvenMatchesFilter(), putative_pairs.size(),
+    [&putative_pairs](const size_t i, Pair & pair, IndMatches & buffer) -> const IndMatches *
+    {
+      pair = putative_pairs[i].first;
+      buffer = putative_pairs[i].second;
+      return &buffer;
+    }));
+  const PairWiseMatches & geometric_matches = filter.Get_geometric_matches();
+  EXPECT_EQ(putative_pairs.size(), geometric_matches.size());
+  for (const auto & pair_matches : putative_pairs)
+  {
+    IndMatches inliers;
+    EvenMatchesFilter().Robust_estimation(
+      nullptr, regions_provider, pair_matches.first, pair_matches.second, inliers);
+    EXPECT_TRUE(inliers == geometric_matches.at(pair_matches.first));
+  }
+
+  // A pair that cannot be read is reported
+  ImageCollectionGeometricFilter failing_filter(nullptr, regions_provider);
+  EXPECT_FALSE(failing_filter.Robust_model_estimation(EvenMatchesFilter(), putative_pairs.size(),
+    [&putative_pairs](const size_t i, Pair & pair, IndMatches &) -> const IndMatches *
+    {
+      pair = putative_pairs[i].first;
+      return i == 10 ? nullptr : &putative_pairs[i].second;
+    }));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -34,6 +34,16 @@ namespace matching_image_collection {
 //-- A contrario homography matrix estimation template functor used for filter pair of putative correspondences
 struct GeometricFilter_HMatrix_AC
 {
+  // The AContrario adapted Homography matrix solver
+  using KernelType =
+    robust::ACKernelAdaptor<
+      openMVG::homography::kernel::FourPointSolver,
+      openMVG::homography::kernel::AsymmetricError,
+      UnnormalizerI,
+      Mat3>;
+  /// ACRANSAC buffers of the homography estimation
+  using Workspace = robust::ACRansac_Workspace<KernelType>;
+
   GeometricFilter_HMatrix_AC
   (
     double dPrecision = std::numeric_limits<double>::infinity(),
@@ -54,7 +64,8 @@ struct GeometricFilter_HMatrix_AC
     const std::shared_ptr<Regions_or_Features_ProviderT> & regions_provider,
     const Pair pairIndex,
     const matching::IndMatches & vec_PutativeMatches,
-    matching::IndMatches & geometric_inliers)
+    matching::IndMatches & geometric_inliers,
+    Workspace & workspace)
   {
     using namespace openMVG;
     using namespace openMVG::robust;
@@ -75,14 +86,6 @@ struct GeometricFilter_HMatrix_AC
     // Robust estimation
     //--
 
-    // Define the AContrario adapted Homography matrix solver
-    using KernelType =
-      ACKernelAdaptor<
-        openMVG::homography::kernel::FourPointSolver,
-        openMVG::homography::kernel::AsymmetricError,
-        UnnormalizerI,
-        Mat3>;
-
     KernelType kernel(
       xI, sfm_data->GetViews().at(iIndex)->ui_width, sfm_data->GetViews().at(iIndex)->ui_height,
       xJ, sfm_data->GetViews().at(jIndex)->ui_width, sfm_data->GetViews().at(jIndex)->ui_height,
@@ -92,7 +95,7 @@ struct GeometricFilter_HMatrix_AC
     const double upper_bound_precision = Square(m_dPrecision);
     std::vector<uint32_t> vec_inliers;
     const std::pair<double,double> ACRansacOut =
-      ACRANSAC(kernel, vec_inliers, m_stIteration, &m_H, upper_bound_precision);
+      ACRANSAC(kernel, workspace, vec_inliers, m_stIteration, &m_H, upper_bound_precision);
 
     if (vec_inliers.size() > KernelType::MINIMUM_SAMPLES *2.5)
     {
@@ -188,8 +191,8 @@ struct GeometricFilter_HMatrix_AC
       else
       {
         // Filtering based on region positions and regions descriptors
-        geometry_aware::GuidedMatching<
-          Mat3,
+        // (only the regions close to the transfered points are compared)
+        geometry_aware::GuidedMatching_Homography_Fast<
           openMVG::homography::kernel::AsymmetricError>(
             m_H,
             cam_I, *regionsI,
@@ -41,6 +41,16 @@ class Matcher
     matching::PairWiseMatchesContainer & map_putatives_matches, // the output pairwise photometric corresponding points
     C_Progress * progress = nullptr
     )const = 0;
+
+  /// Compute once the matcher state that depends on all the views of the pairs.
+  /// Called before the pairs are matched by subsets (see Tiled_Matcher),
+  ///  so the subsets are matched as if all the pairs were matched at once.
+  virtual void Prepare(
+    const std::shared_ptr<sfm::Regions_Provider> & /*regions_provider*/,
+    const Pair_Set & /*pairs*/
+    )
+  {
+  }
 };
 
 } // namespace matching_image_collection
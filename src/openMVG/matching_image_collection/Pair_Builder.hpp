@@ -9,8 +9,10 @@
 #ifndef OPENMVG_MATCHING_IMAGE_COLLECTION_PAIR_BUILDER_HPP
 #define OPENMVG_MATCHING_IMAGE_COLLECTION_PAIR_BUILDER_HPP
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
@@ -43,6 +45,71 @@ inline Pair_Set contiguousWithOverlap(const size_t N, const size_t overlapSize)
   return pairs;
 }
 
+/// Split a set of pairs into tiles of the (I,J) pair matrix.
+/// The used view indexes are gathered by blocks of tile_size consecutive indexes,
+///  a tile contains all the pairs (I,J) such that I and J belong to a given couple of blocks.
+/// So matching a tile requires at most 2*tile_size views in memory.
+/// The tiles are ordered along a path over the block matrix such that
+///  two consecutive tiles share a block of views (if all the tiles are used).
+inline std::vector<std::vector<Pair>> tilePairs
+(
+  const Pair_Set & pairs,
+  const size_t tile_size
+)
+{
+  std::vector<std::vector<Pair>> tiles;
+  if (pairs.empty() || tile_size == 0)
+    return tiles;
+
+  // Rank of the used view indexes
+  std::set<IndexT> used_index;
+  for (const auto & cur_pair : pairs)
+  {
+    used_index.insert(cur_pair.first);
+    used_index.insert(cur_pair.second);
+  }
+  std::map<IndexT, size_t> block_index;
+  {
+    size_t rank = 0;
+    for (const auto & index : used_index)
+      block_index[index] = (rank++) / tile_size;
+  }
+  const size_t block_count = (used_index.size() + tile_size - 1) / tile_size;
+
+  // Dispatch the pairs to their tile
+  std::map<Pair, std::vector<Pair>> tile_pairs;
+  for (const auto & cur_pair : pairs)
+  {
+    const size_t
+      block_I = block_index.at(cur_pair.first),
+      block_J = block_index.at(cur_pair.second);
+    tile_pairs[{std::min(block_I, block_J), std::max(block_I, block_J)}].push_back(cur_pair);
+  }
+
+  // Column-wise path over the upper triangular block matrix:
+  //  each column starts with the block row on which the previous column ended.
+  size_t last_block_I = 0;
+  for (size_t block_J = 0; block_J < block_count; ++block_J)
+  {
+    std::vector<size_t> block_rows;
+    for (size_t block_I = last_block_I; block_I <= block_J; ++block_I)
+      block_rows.push_back(block_I);
+    for (size_t block_I = last_block_I; block_I > 0; --block_I)
+      block_rows.push_back(block_I - 1);
+
+    for (const size_t block_I : block_rows)
+    {
+      const auto it = tile_pairs.find({block_I, block_J});
+      if (it != tile_pairs.end())
+      {
+        tiles.emplace_back(std::move(it->second));
+        last_block_I = block_I;
+      }
+    }
+  }
+  return tiles;
+}
+
 /// Load a set of Pair_Set from a file
 /// I J K L (pair that link I)
 inline bool loadPairs(
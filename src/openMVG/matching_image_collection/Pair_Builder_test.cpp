@@ -56,6 +56,54 @@ TEST(matching_image_collection, contiguousWithOverlap)
   EXPECT_TRUE( pairSet.find({2,3}) != pairSet.end() );
 }
 
+TEST(matching_image_collection, tilePairs)
+{
+  EXPECT_EQ( 0, tilePairs(Pair_Set(), 2).size());
+
+  const Pair_Set pairSet = exhaustivePairs(6);
+  const std::vector<std::vector<Pair>> tiles = tilePairs(pairSet, 2);
+  // 3 blocks of 2 views -> 6 tiles of the upper triangular block matrix
+  EXPECT_EQ( 6, tiles.size());
+
+  Pair_Set tiledPairSet;
+  for (const auto & tile : tiles)
+  {
+    std::set<IndexT> tile_views;
+    for (const auto & cur_pair : tile)
+    {
+      tiledPairSet.insert(cur_pair);
+      tile_views.insert(cur_pair.first);
+      tile_views.insert(cur_pair.second);
+    }
+    EXPECT_TRUE( tile_views.size() <= 4 );
+  }
+  // All the pairs are kept, and only once
+  EXPECT_EQ( pairSet.size(), tiledPairSet.size());
+  size_t count = 0;
+  for (const auto & tile : tiles)
+    count += tile.size();
+  EXPECT_EQ( pairSet.size(), count);
+
+  // Consecutive tiles share some views
+  for (size_t i = 1; i < tiles.size(); ++i)
+  {
+    std::set<IndexT> previous_views, shared_views;
+    for (const auto & cur_pair : tiles[i-1])
+    {
+      previous_views.insert(cur_pair.first);
+      previous_views.insert(cur_pair.second);
+    }
+    for (const auto & cur_pair : tiles[i])
+    {
+      if (previous_views.count(cur_pair.first))
+        shared_views.insert(cur_pair.first);
+      if (previous_views.count(cur_pair.second))
+        shared_views.insert(cur_pair.second);
+    }
+    EXPECT_FALSE( shared_views.empty() );
+  }
+}
+
 TEST(matching_image_collection, IO)
 {
   Pair_Set pairSetGT;
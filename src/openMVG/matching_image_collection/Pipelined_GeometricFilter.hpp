@@ -0,0 +1,162 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MATCHING_IMAGE_COLLECTION_PIPELINED_GEOMETRIC_FILTER_HPP
+#define OPENMVG_MATCHING_IMAGE_COLLECTION_PIPELINED_GEOMETRIC_FILTER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "openMVG/matching/indMatch.hpp"
+#include "openMVG/matching_image_collection/GeometricFilter.hpp"
+#include "openMVG/system/bounded_queue.hpp"
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace openMVG {
+namespace matching_image_collection {
+
+/// Bounded, blocking, multi-producer/multi-consumer queue of pairwise matches
+using PairWiseMatches_Queue = system::Bounded_Queue<std::pair<Pair, IndMatches>>;
+
+/// Geometric filtering of the putative matches as soon as they are computed.
+/// The collection matcher inserts its putative pairs into a bounded queue that
+///  is consumed by geometric filter workers:
+///  - the putative matching and the robust model estimations overlap,
+///  - at most queue_size putative pairs wait in memory (the matcher threads
+///    are blocked while the queue is full),
+///  - the OpenMP regions run by a worker use a single thread.
+/// Usage:
+///  Pipelined_GeometricFilter<GeometricFilter_FMatrix_AC> pipeline(filter, functor, ...);
+///  collectionMatcher->Match(regions_provider, pairs, pipeline, &progress);
+///  pipeline.Finish();
+///  pipeline.Get_geometric_matches();
+template <typename GeometryFunctor>
+class Pipelined_GeometricFilter : public PairWiseMatchesContainer
+{
+public:
+  /// Called with the putative matches of each pair (i.e. to save them)
+  using Putative_Callback = std::function<void(const Pair &, const IndMatches &)>;
+  /// Return true if the geometric matches of a pair must be kept
+  using Pair_Acceptance = std::function<bool(const IndMatches & putative, const IndMatches & geometric)>;
+
+  Pipelined_GeometricFilter
+  (
+    const ImageCollectionGeometricFilter & filter,
+    const GeometryFunctor & functor,
+    const bool b_guided_matching,
+    const double d_distance_ratio,
+    const size_t queue_size,
+    const size_t worker_count,
+    Putative_Callback putative_callback = Putative_Callback(),
+    Pair_Acceptance pair_acceptance = Pair_Acceptance()
+  ):filter_(filter),
+    functor_(functor),
+    b_guided_matching_(b_guided_matching),
+    d_distance_ratio_(d_distance_ratio),
+    queue_(queue_size),
+    putative_callback_(std::move(putative_callback)),
+    pair_acceptance_(std::move(pair_acceptance))
+  {
+    for (size_t i = 0; i < std::max<size_t>(1, worker_count); ++i)
+      workers_.emplace_back(&Pipelined_GeometricFilter::Work, this);
+  }
+
+  ~Pipelined_GeometricFilter() override
+  {
+    Finish();
+  }
+
+  /// Receive the putative matches of a pair (called by the collection matcher)
+  void insert(std::pair<Pair, IndMatches> && pairWiseMatches) override
+  {
+    if (putative_callback_)
+      putative_callback_(pairWiseMatches.first, pairWiseMatches.second);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      putative_pairs_.insert(pairWiseMatches.first);
+    }
+    queue_.push(std::move(pairWiseMatches));
+  }
+
+  /// The matcher threads can insert concurrently (they block only on the full queue)
+  bool IsThreadSafe() const override { return true; }
+
+  /// Wait for the geometric filtering of all the inserted pairs
+  void Finish()
+  {
+    queue_.close();
+    for (std::thread & worker : workers_)
+    {
+      if (worker.joinable())
+        worker.join();
+    }
+  }
+
+  /// The pairs that have putative matches
+  const Pair_Set & Get_putative_pairs() const
+  {
+    return putative_pairs_;
+  }
+
+  /// The geometric matches (valid once Finish has been called)
+  const PairWiseMatches & Get_geometric_matches() const
+  {
+    return geometric_matches_;
+  }
+
+private:
+  void Work()
+  {
+#ifdef OPENMVG_USE_OPENMP
+    // The workers already run concurrently: the OpenMP regions of the
+    //  filtering (i.e. guided matching) must not start a team per worker
+    omp_set_num_threads(1);
+#endif
+    // Robust estimation buffers of this worker
+    ImageCollectionGeometricFilter::Workspace<GeometryFunctor> workspace;
+    std::pair<Pair, IndMatches> pair_matches;
+    while (queue_.pop(pair_matches))
+    {
+      IndMatches geometric_inliers;
+      if (filter_.Robust_model_estimation(
+            functor_, pair_matches.first, pair_matches.second,
+            b_guided_matching_, d_distance_ratio_, geometric_inliers, workspace)
+          && (!pair_acceptance_ || pair_acceptance_(pair_matches.second, geometric_inliers)))
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        geometric_matches_.insert({pair_matches.first, std::move(geometric_inliers)});
+      }
+    }
+  }
+
+  const ImageCollectionGeometricFilter & filter_;
+  const GeometryFunctor functor_;
+  const bool b_guided_matching_;
+  const double d_distance_ratio_;
+
+  PairWiseMatches_Queue queue_;
+  std::vector<std::thread> workers_;
+  Putative_Callback putative_callback_;
+  Pair_Acceptance pair_acceptance_;
+
+  std::mutex mutex_;
+  Pair_Set putative_pairs_;
+  PairWiseMatches geometric_matches_;
+};
+
+} // namespace matching_image_collection
+} // namespace openMVG
+
+#endif // OPENMVG_MATCHING_IMAGE_COLLECTION_PIPELINED_GEOMETRIC_FILTER_HPP
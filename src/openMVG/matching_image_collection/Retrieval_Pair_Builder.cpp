@@ -0,0 +1,351 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/matching_image_collection/Retrieval_Pair_Builder.hpp"
+#include "openMVG/features/regions.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "third_party/progress/progress.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <typeinfo>
+
+namespace openMVG {
+namespace matching_image_collection {
+
+namespace {
+
+// Convert the descriptors of a regions type to float values
+//  (the bits of the binary descriptors are unpacked, so L2 = Hamming distance)
+class Descriptor_Converter
+{
+public:
+  bool Init(const features::Regions & regions)
+  {
+    length_ = regions.DescriptorLength();
+    if (regions.IsBinary() && regions.Type_id() == typeid(unsigned char).name())
+    {
+      type_ = BINARY;
+      dimension_ = length_ * 8;
+    }
+    else if (regions.IsScalar() && regions.Type_id() == typeid(unsigned char).name())
+    {
+      type_ = UCHAR;
+      dimension_ = length_;
+    }
+    else if (regions.IsScalar() && regions.Type_id() == typeid(float).name())
+    {
+      type_ = FLOAT;
+      dimension_ = length_;
+    }
+    else if (regions.IsScalar() && regions.Type_id() == typeid(double).name())
+    {
+      type_ = DOUBLE;
+      dimension_ = length_;
+    }
+    else
+    {
+      std::cerr << "Unsupported regions type for the image retrieval: "
+        << regions.Type_id() << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  size_t Dimension() const { return dimension_; }
+
+  // Convert the i-th descriptor of a regions (Dimension() values)
+  void operator()(const features::Regions & regions, const size_t i, float * out) const
+  {
+    switch (type_)
+    {
+      case UCHAR:
+      {
+        const unsigned char * desc =
+          static_cast<const unsigned char*>(regions.DescriptorRawData()) + i * length_;
+        std::copy(desc, desc + length_, out);
+      }
+      break;
+      case FLOAT:
+      {
+        const float * desc = static_cast<const float*>(regions.DescriptorRawData()) + i * length_;
+        std::copy(desc, desc + length_, out);
+      }
+      break;
+      case DOUBLE:
+      {
+        const double * desc = static_cast<const double*>(regions.DescriptorRawData()) + i * length_;
+        std::copy(desc, desc + length_, out);
+      }
+      break;
+      case BINARY:
+      {
+        const unsigned char * desc =
+          static_cast<const unsigned char*>(regions.DescriptorRawData()) + i * length_;
+        for (size_t b = 0; b < length_; ++b)
+          for (int bit = 0; bit < 8; ++bit)
+            out[b * 8 + bit] = static_cast<float>((desc[b] >> bit) & 1);
+      }
+      break;
+    }
+  }
+
+private:
+  enum EType { UCHAR, FLOAT, DOUBLE, BINARY };
+  EType type_ = FLOAT;
+  size_t length_ = 0;
+  size_t dimension_ = 0;
+};
+
+} // namespace
+
+Vocabulary_Tree_Retrieval::Vocabulary_Tree_Retrieval
+(
+  const Retrieval_Options & options
+):options_(options)
+{
+}
+
+bool Vocabulary_Tree_Retrieval::Build
+(
+  const sfm::Regions_Provider & regions_provider,
+  const std::vector<IndexT> & view_ids,
+  C_Progress * my_progress_bar
+)
+{
+  if (!my_progress_bar)
+    my_progress_bar = &C_Progress::dummy();
+
+  view_ids_ = view_ids;
+  view_rank_.clear();
+  for (uint32_t rank = 0; rank < view_ids_.size(); ++rank)
+    view_rank_[view_ids_[rank]] = rank;
+  view_words_.assign(view_ids_.size(), {});
+  inverted_files_.clear();
+  if (view_ids_.empty() || !regions_provider.getRegionsType())
+    return false;
+
+  Descriptor_Converter converter;
+  if (!converter.Init(*regions_provider.getRegionsType()))
+    return false;
+  const size_t dimension = converter.Dimension();
+
+  //--
+  // Train the vocabulary on a sample of every view descriptors
+  //--
+  {
+    const size_t per_view_count =
+      std::max<size_t>(1, options_.max_training_descriptors / view_ids_.size());
+    std::vector<std::vector<float>> training_descriptors;
+    for (const IndexT view_id : view_ids_)
+    {
+      const std::shared_ptr<features::Regions> regions = regions_provider.get(view_id);
+      if (!regions || regions->RegionCount() == 0)
+        continue;
+      const size_t count = regions->RegionCount();
+      const size_t step = std::max<size_t>(1, count / per_view_count);
+      for (size_t i = 0; i < count; i += step)
+      {
+        training_descriptors.emplace_back(dimension);
+        converter(*regions, i, training_descriptors.back().data());
+      }
+    }
+    if (!vocabulary_.Train(training_descriptors, options_.branching,
+          options_.depth, options_.kmeans_iterations))
+    {
+      std::cerr << "Cannot train the vocabulary tree." << std::endl;
+      return false;
+    }
+  }
+
+  //--
+  // Compute the visual word histogram of each view
+  //--
+  my_progress_bar->restart(view_ids_.size(), "\n- Image retrieval: view indexing -\n");
+  std::atomic<bool> bContinue(true);
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int rank = 0; rank < static_cast<int>(view_ids_.size()); ++rank)
+  {
+    if (!bContinue)
+      continue;
+    if (my_progress_bar->hasBeenCanceled())
+    {
+      bContinue = false;
+      continue;
+    }
+    const std::shared_ptr<features::Regions> regions = regions_provider.get(view_ids_[rank]);
+    if (regions && regions->RegionCount() > 0)
+    {
+      std::vector<uint32_t> words(regions->RegionCount());
+      std::vector<float> descriptor(dimension);
+      for (size_t i = 0; i < words.size(); ++i)
+      {
+        converter(*regions, i, descriptor.data());
+        words[i] = vocabulary_.Quantize(descriptor.data());
+      }
+      // Term frequencies
+      std::sort(words.begin(), words.end());
+      std::vector<std::pair<uint32_t, float>> & histogram = view_words_[rank];
+      for (size_t i = 0; i < words.size(); )
+      {
+        size_t j = i;
+        while (j < words.size() && words[j] == words[i])
+          ++j;
+        histogram.emplace_back(words[i], static_cast<float>(j - i) / words.size());
+        i = j;
+      }
+    }
+    ++(*my_progress_bar);
+  }
+  if (!bContinue)
+    return false;
+
+  //--
+  // TF-IDF weighting and inverted files
+  //--
+  std::vector<uint32_t> document_frequency(vocabulary_.WordCount(), 0);
+  for (const auto & histogram : view_words_)
+    for (const auto & word : histogram)
+      ++document_frequency[word.first];
+
+  inverted_files_.assign(vocabulary_.WordCount(), {});
+  for (uint32_t rank = 0; rank < view_words_.size(); ++rank)
+  {
+    std::vector<std::pair<uint32_t, float>> & histogram = view_words_[rank];
+    double norm = 0.0;
+    for (auto & word : histogram)
+    {
+      word.second *= std::log(static_cast<float>(view_ids_.size()) / document_frequency[word.first]);
+      norm += word.second * word.second;
+    }
+    norm = std::sqrt(norm);
+    // Words that are seen in every view have a null weight: they are dropped
+    histogram.erase(
+      std::remove_if(histogram.begin(), histogram.end(),
+        [](const std::pair<uint32_t, float> & word) { return word.second <= 0.f; }),
+      histogram.end());
+    for (auto & word : histogram)
+    {
+      word.second /= norm;
+      inverted_files_[word.first].emplace_back(rank, word.second);
+    }
+  }
+  return true;
+}
+
+std::vector<std::pair<uint32_t, float>> Vocabulary_Tree_Retrieval::QueryRank
+(
+  const uint32_t view_rank,
+  const size_t neighbor_count,
+  std::vector<float> & scores
+) const
+{
+  // Accumulate the dot products with the views that share a word
+  std::vector<uint32_t> candidates;
+  for (const auto & word : view_words_[view_rank])
+  {
+    for (const auto & posting : inverted_files_[word.first])
+    {
+      if (posting.first == view_rank)
+        continue;
+      if (scores[posting.first] == 0.f)
+        candidates.push_back(posting.first);
+      scores[posting.first] += word.second * posting.second;
+    }
+  }
+
+  std::vector<std::pair<uint32_t, float>> neighbors;
+  neighbors.reserve(candidates.size());
+  for (const uint32_t candidate : candidates)
+  {
+    neighbors.emplace_back(candidate, scores[candidate]);
+    scores[candidate] = 0.f;
+  }
+  const auto by_score = [](const std::pair<uint32_t, float> & a, const std::pair<uint32_t, float> & b)
+  {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  };
+  if (neighbors.size() > neighbor_count)
+  {
+    std::partial_sort(neighbors.begin(), neighbors.begin() + neighbor_count, neighbors.end(), by_score);
+    neighbors.resize(neighbor_count);
+  }
+  else
+  {
+    std::sort(neighbors.begin(), neighbors.end(), by_score);
+  }
+  return neighbors;
+}
+
+std::vector<std::pair<IndexT, float>> Vocabulary_Tree_Retrieval::Query
+(
+  const IndexT view_id,
+  const size_t neighbor_count
+) const
+{
+  std::vector<std::pair<IndexT, float>> neighbors;
+  const auto rank_it = view_rank_.find(view_id);
+  if (rank_it == view_rank_.end())
+    return neighbors;
+
+  std::vector<float> scores(view_ids_.size(), 0.f);
+  for (const auto & neighbor : QueryRank(rank_it->second, neighbor_count, scores))
+    neighbors.emplace_back(view_ids_[neighbor.first], neighbor.second);
+  return neighbors;
+}
+
+Pair_Set Vocabulary_Tree_Retrieval::Pairs(const size_t neighbor_count) const
+{
+  std::vector<std::vector<std::pair<uint32_t, float>>> neighbors(view_ids_.size());
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    // Score accumulator of the thread (reset by QueryRank)
+    std::vector<float> scores(view_ids_.size(), 0.f);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp for schedule(dynamic)
+#endif
+    for (int rank = 0; rank < static_cast<int>(view_ids_.size()); ++rank)
+      neighbors[rank] = QueryRank(rank, neighbor_count, scores);
+  }
+
+  Pair_Set pairs;
+  for (uint32_t rank = 0; rank < neighbors.size(); ++rank)
+  {
+    for (const auto & neighbor : neighbors[rank])
+    {
+      const IndexT I = view_ids_[rank], J = view_ids_[neighbor.first];
+      pairs.insert({std::min(I, J), std::max(I, J)});
+    }
+  }
+  return pairs;
+}
+
+Pair_Set retrievalPairs
+(
+  const sfm::Regions_Provider & regions_provider,
+  const std::vector<IndexT> & view_ids,
+  const size_t neighbor_count,
+  const Retrieval_Options & options,
+  C_Progress * progress
+)
+{
+  Vocabulary_Tree_Retrieval retrieval(options);
+  if (!retrieval.Build(regions_provider, view_ids, progress))
+    return {};
+  return retrieval.Pairs(neighbor_count);
+}
+
+} // namespace matching_image_collection
+} // namespace openMVG
@@ -0,0 +1,106 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MATCHING_IMAGE_COLLECTION_RETRIEVAL_PAIR_BUILDER_HPP
+#define OPENMVG_MATCHING_IMAGE_COLLECTION_RETRIEVAL_PAIR_BUILDER_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "openMVG/clustering/vocabulary_tree.hpp"
+#include "openMVG/types.hpp"
+
+class C_Progress;
+
+namespace openMVG {
+
+namespace sfm {
+  struct Regions_Provider;
+} // namespace sfm
+
+namespace matching_image_collection {
+
+/// Parameters of the vocabulary tree image retrieval
+struct Retrieval_Options
+{
+  uint32_t branching = 10;               // children per vocabulary tree node
+  uint32_t depth = 4;                    // vocabulary tree levels (up to branching^depth words)
+  uint32_t max_training_descriptors = 100000; // size of the descriptor sample used to train the tree
+  uint32_t kmeans_iterations = 10;       // kmeans iterations per tree node
+};
+
+/// Image retrieval with a vocabulary tree and TF-IDF weighted inverted files:
+///  - a hierarchical kmeans vocabulary is trained on a descriptor sample of the views,
+///  - every view is described by the L2 normalized TF-IDF histogram of its visual words,
+///  - the similarity of two views is the dot product of their histograms, computed
+///    for all the views at once by walking the inverted files of the query words.
+/// Binary descriptors are clustered in the Hamming space (their bits are unpacked).
+class Vocabulary_Tree_Retrieval
+{
+public:
+  explicit Vocabulary_Tree_Retrieval(const Retrieval_Options & options = Retrieval_Options());
+
+  /// Train the vocabulary on the regions of the views and index the views
+  bool Build
+  (
+    const sfm::Regions_Provider & regions_provider,
+    const std::vector<IndexT> & view_ids,
+    C_Progress * progress = nullptr
+  );
+
+  /// Return the neighbor_count views that are the most similar to the view
+  ///  ({view id, score} sorted by decreasing score)
+  std::vector<std::pair<IndexT, float>> Query
+  (
+    const IndexT view_id,
+    const size_t neighbor_count
+  ) const;
+
+  /// Link every view to its neighbor_count most similar views
+  Pair_Set Pairs(const size_t neighbor_count) const;
+
+  const clustering::VocabularyTree & Vocabulary() const { return vocabulary_; }
+
+private:
+  /// Query a view from its rank in view_ids_
+  ///  (scores is a zeroed accumulator of view_ids_.size() values, zeroed again on return)
+  std::vector<std::pair<uint32_t, float>> QueryRank
+  (
+    const uint32_t view_rank,
+    const size_t neighbor_count,
+    std::vector<float> & scores
+  ) const;
+
+  Retrieval_Options options_;
+  clustering::VocabularyTree vocabulary_;
+
+  std::vector<IndexT> view_ids_;
+  Hash_Map<IndexT, uint32_t> view_rank_;
+  // Sparse TF-IDF histogram of each view: {word, weight} sorted by word
+  std::vector<std::vector<std::pair<uint32_t, float>>> view_words_;
+  // Inverted files: {view rank, weight} of the views that contain a word
+  std::vector<std::vector<std::pair<uint32_t, float>>> inverted_files_;
+};
+
+/// Generate the pairs that link every view to its neighbor_count most similar
+///  views (vocabulary tree image retrieval).
+/// The matching cost then grows linearly with the number of views.
+Pair_Set retrievalPairs
+(
+  const sfm::Regions_Provider & regions_provider,
+  const std::vector<IndexT> & view_ids,
+  const size_t neighbor_count,
+  const Retrieval_Options & options = Retrieval_Options(),
+  C_Progress * progress = nullptr
+);
+
+} // namespace matching_image_collection
+} // namespace openMVG
+
+#endif // OPENMVG_MATCHING_IMAGE_COLLECTION_RETRIEVAL_PAIR_BUILDER_HPP
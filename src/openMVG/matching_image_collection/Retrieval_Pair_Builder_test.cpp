@@ -0,0 +1,103 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/matching_image_collection/Retrieval_Pair_Builder.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::matching_image_collection;
+
+// Regions provider filled with in memory regions
+struct Synthetic_Regions_Provider : public sfm::Regions_Provider
+{
+  Synthetic_Regions_Provider()
+  {
+    region_type_.reset(new SIFT_Regions);
+  }
+
+  void add(const IndexT view_id, std::shared_ptr<Regions> regions)
+  {
+    cache_[view_id] = regions;
+  }
+};
+
+TEST(matching_image_collection, retrievalPairs)
+{
+  // 3 places seen by 4 views each:
+  //  the views of a place observe a noisy subset of the place descriptors
+  const int nb_place = 3, nb_view_per_place = 4, nb_desc_per_place = 300;
+  std::mt19937 rng(std::mt19937::default_seed);
+  std::uniform_int_distribution<int> value_distrib(0, 255);
+  std::uniform_int_distribution<int> noise_distrib(-3, 3);
+  std::bernoulli_distribution keep_distrib(0.8);
+
+  Synthetic_Regions_Provider regions_provider;
+  std::vector<IndexT> view_ids;
+  for (int place = 0; place < nb_place; ++place)
+  {
+    std::vector<SIFT_Regions::DescriptorT> place_descriptors(nb_desc_per_place);
+    for (auto & desc : place_descriptors)
+      for (int i = 0; i < desc.size(); ++i)
+        desc[i] = value_distrib(rng);
+
+    for (int v = 0; v < nb_view_per_place; ++v)
+    {
+      std::shared_ptr<SIFT_Regions> regions = std::make_shared<SIFT_Regions>();
+      for (const auto & place_desc : place_descriptors)
+      {
+        if (!keep_distrib(rng))
+          continue;
+        SIFT_Regions::DescriptorT desc;
+        for (int i = 0; i < desc.size(); ++i)
+          desc[i] = std::min(255, std::max(0, place_desc[i] + noise_distrib(rng)));
+        regions->Descriptors().push_back(desc);
+        regions->Features().emplace_back(0.f, 0.f, 1.f, 0.f);
+      }
+      const IndexT view_id = place * nb_view_per_place + v;
+      regions_provider.add(view_id, regions);
+      view_ids.push_back(view_id);
+    }
+  }
+
+  Retrieval_Options options;
+  options.branching = 8;
+  options.depth = 3;
+  Vocabulary_Tree_Retrieval retrieval(options);
+  EXPECT_TRUE( retrieval.Build(regions_provider, view_ids) );
+
+  // The most similar views are the other views of the same place
+  for (const IndexT view_id : view_ids)
+  {
+    const auto neighbors = retrieval.Query(view_id, nb_view_per_place - 1);
+    EXPECT_EQ( nb_view_per_place - 1, neighbors.size() );
+    for (const auto & neighbor : neighbors)
+    {
+      EXPECT_EQ( view_id / nb_view_per_place, neighbor.first / nb_view_per_place );
+      EXPECT_TRUE( neighbor.first != view_id );
+    }
+  }
+
+  // All the pairs of a place are retrieved, and only them
+  const Pair_Set pairs = retrievalPairs(regions_provider, view_ids, nb_view_per_place - 1, options);
+  EXPECT_EQ( nb_place * nb_view_per_place * (nb_view_per_place - 1) / 2, pairs.size() );
+  for (const auto & pair : pairs)
+  {
+    EXPECT_TRUE( pair.first < pair.second );
+    EXPECT_EQ( pair.first / nb_view_per_place, pair.second / nb_view_per_place );
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -0,0 +1,116 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/matching_image_collection/Tiled_Matcher.hpp"
+#include "openMVG/features/regions.hpp"
+#include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "third_party/progress/progress.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace openMVG {
+namespace matching_image_collection {
+
+using namespace openMVG::matching;
+
+namespace
+{
+// Request the regions of the views of some pairs
+//  (holding them prevents their eviction from a Regions_Provider_Cache)
+std::vector<std::shared_ptr<features::Regions>> Load_Regions
+(
+  const sfm::Regions_Provider & regions_provider,
+  const std::vector<Pair> & pairs
+)
+{
+  std::set<IndexT> views;
+  for (const auto & cur_pair : pairs)
+  {
+    views.insert(cur_pair.first);
+    views.insert(cur_pair.second);
+  }
+  std::vector<std::shared_ptr<features::Regions>> regions;
+  regions.reserve(views.size());
+  for (const IndexT view_id : views)
+    regions.push_back(regions_provider.get(view_id));
+  return regions;
+}
+} // namespace
+
+Tiled_Matcher::Tiled_Matcher
+(
+  std::unique_ptr<Matcher> matcher,
+  const size_t max_regions_in_memory
+):
+  Matcher(),
+  matcher_(std::move(matcher)),
+  // The current and the next tile (2 blocks of views each) must fit in memory
+  tile_size_(std::max(size_t(1), max_regions_in_memory / 4))
+{
+}
+
+void Tiled_Matcher::Match
+(
+  const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+  const Pair_Set & pairs,
+  PairWiseMatchesContainer & map_PutativesMatches,
+  C_Progress * my_progress_bar
+) const
+{
+  if (!my_progress_bar)
+    my_progress_bar = &C_Progress::dummy();
+  if (!matcher_ || !regions_provider)
+    return;
+
+  const std::vector<std::vector<Pair>> tiles = tilePairs(pairs, tile_size_);
+  std::cout
+    << "Tiled matching: " << tiles.size() << " tiles of at most "
+    << 2 * tile_size_ << " views." << std::endl;
+
+  // The state shared by all the pairs (i.e. the cascade hashing zero mean descriptor)
+  //  is computed once, so the tiled matching gives the same matches as the untiled one
+  matcher_->Prepare(regions_provider, pairs);
+
+  my_progress_bar->restart(pairs.size(), "\n- Matching -\n");
+
+  // The regions of the current tile are held while it is matched
+  std::vector<std::shared_ptr<features::Regions>> tile_regions;
+  if (!tiles.empty())
+    tile_regions = Load_Regions(*regions_provider, tiles.front());
+
+  for (size_t i = 0; i < tiles.size(); ++i)
+  {
+    if (my_progress_bar->hasBeenCanceled())
+      break;
+
+    // Load the regions of the next tile while the current one is matched
+    std::future<std::vector<std::shared_ptr<features::Regions>>> prefetch;
+    if (i + 1 < tiles.size())
+    {
+      prefetch = std::async(std::launch::async,
+        Load_Regions, std::cref(*regions_provider), std::cref(tiles[i + 1]));
+    }
+
+    const Pair_Set tile_pairs(tiles[i].cbegin(), tiles[i].cend());
+    matcher_->Match(regions_provider, tile_pairs, map_PutativesMatches);
+    (*my_progress_bar) += tile_pairs.size();
+
+    tile_regions = prefetch.valid() ?
+      prefetch.get() : std::vector<std::shared_ptr<features::Regions>>();
+  }
+}
+
+} // namespace matching_image_collection
+} // namespace openMVG
@@ -0,0 +1,59 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MATCHING_IMAGE_COLLECTION_TILED_MATCHER_HPP
+#define OPENMVG_MATCHING_IMAGE_COLLECTION_TILED_MATCHER_HPP
+
+#include <memory>
+
+#include "openMVG/matching_image_collection/Matcher.hpp"
+
+namespace openMVG { namespace matching { class PairWiseMatchesContainer; } }
+namespace openMVG { namespace sfm { struct Regions_Provider; } }
+
+namespace openMVG {
+namespace matching_image_collection {
+
+/// Out-of-core scheduling of an Image Collection Matcher
+/// The pair matrix is split in tiles whose regions fit a given memory budget
+///  (a count of regions, see tilePairs). The tiles are matched one after the other
+///  by the wrapped matcher while the regions of the next tile are loaded
+///  asynchronously by the Regions_Provider (the regions of the current and of the
+///  next tile are held until the tile is matched).
+/// The wrapped matcher is prepared once with all the pairs (see Matcher::Prepare).
+/// Designed to be used with a Regions_Provider_Cache of the same budget.
+///
+class Tiled_Matcher : public Matcher
+{
+  public:
+  Tiled_Matcher
+  (
+    std::unique_ptr<Matcher> matcher,
+    const size_t max_regions_in_memory
+  );
+
+  /// Find corresponding points between some pair of view Ids
+  void Match
+  (
+    const std::shared_ptr<sfm::Regions_Provider> & regions_provider,
+    const Pair_Set & pairs,
+    matching::PairWiseMatchesContainer & map_PutativesMatches, // the pairwise photometric corresponding points
+    C_Progress *  progress = nullptr
+  ) const override;
+
+  private:
+  // The matcher used for each tile
+  std::unique_ptr<Matcher> matcher_;
+  // Number of views per tile block
+  size_t tile_size_;
+};
+
+} // namespace matching_image_collection
+} // namespace openMVG
+
+#endif // OPENMVG_MATCHING_IMAGE_COLLECTION_TILED_MATCHER_HPP
@@ -0,0 +1,98 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/matching_image_collection/Cascade_Hashing_Matcher_Regions.hpp"
+#include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/matching_image_collection/Tiled_Matcher.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::matching;
+using namespace openMVG::matching_image_collection;
+
+// Regions provider filled with in memory regions
+struct Synthetic_Regions_Provider : public sfm::Regions_Provider
+{
+  Synthetic_Regions_Provider()
+  {
+    region_type_.reset(new SIFT_Regions);
+  }
+
+  void add(const IndexT view_id, std::shared_ptr<Regions> regions)
+  {
+    cache_[view_id] = regions;
+  }
+};
+
+TEST(Tiled_Matcher, SameMatchesAsUntiled)
+{
+  // Views observing a noisy subset of a scene descriptor set,
+  //  the descriptor distribution drifts along the views
+  //  (so the per tile statistics differ from the global ones)
+  const int nb_view = 8, nb_desc = 200;
+  std::mt19937 rng(std::mt19937::default_seed);
+  std::uniform_int_distribution<int> value_distrib(0, 127);
+  std::uniform_int_distribution<int> noise_distrib(-4, 4);
+  std::uniform_real_distribution<float> position_distrib(0.f, 1000.f);
+  std::bernoulli_distribution keep_distrib(0.7);
+
+  std::vector<SIFT_Regions::DescriptorT> scene_descriptors(nb_desc);
+  for (auto & desc : scene_descriptors)
+    for (int i = 0; i < desc.size(); ++i)
+      desc[i] = value_distrib(rng);
+
+  auto regions_provider = std::make_shared<Synthetic_Regions_Provider>();
+  for (int view_id = 0; view_id < nb_view; ++view_id)
+  {
+    std::shared_ptr<SIFT_Regions> regions = std::make_shared<SIFT_Regions>();
+    for (const auto & scene_desc : scene_descriptors)
+    {
+      if (!keep_distrib(rng))
+        continue;
+      SIFT_Regions::DescriptorT desc;
+      for (int i = 0; i < desc.size(); ++i)
+        desc[i] = std::min(255, std::max(0, scene_desc[i] + 4 * view_id + noise_distrib(rng)));
+      regions->Descriptors().push_back(desc);
+      regions->Features().emplace_back(position_distrib(rng), position_distrib(rng), 1.f, 0.f);
+    }
+    regions_provider->add(view_id, regions);
+  }
+
+  const Pair_Set pairs = exhaustivePairs(nb_view);
+
+  PairWiseMatches untiled_matches;
+  Cascade_Hashing_Matcher_Regions(0.8f).Match(regions_provider, pairs, untiled_matches);
+  EXPECT_EQ( pairs.size(), untiled_matches.size() );
+
+  // Tiles of at most 4 views
+  const Tiled_Matcher tiled_matcher(
+    std::unique_ptr<Matcher>(new Cascade_Hashing_Matcher_Regions(0.8f)), 8);
+  PairWiseMatches tiled_matches;
+  tiled_matcher.Match(regions_provider, pairs, tiled_matches);
+
+  EXPECT_EQ( untiled_matches.size(), tiled_matches.size() );
+  for (const auto & pair_matches : untiled_matches)
+  {
+    const auto it = tiled_matches.find(pair_matches.first);
+    EXPECT_TRUE( it != tiled_matches.end() );
+    if (it != tiled_matches.end())
+    {
+      EXPECT_TRUE( pair_matches.second == it->second );
+    }
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
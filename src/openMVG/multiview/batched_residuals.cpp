@@ -0,0 +1,261 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/multiview/batched_residuals.hpp"
+#include "openMVG/multiview/batched_residuals_kernels.hpp"
+
+#ifdef OPENMVG_USE_AVX2
+#include "openMVG/system/cpu_instruction_set.hpp"
+#endif
+
+#include <cassert>
+#include <cmath>
+
+namespace openMVG {
+namespace batched_residuals {
+
+namespace scalar {
+
+void EpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Epipolar line F x1 and its algebraic distance to x2
+    const double l0 = F[0] * x1.x[i] + F[1] * x1.y[i] + F[2];
+    const double l1 = F[3] * x1.x[i] + F[4] * x1.y[i] + F[5];
+    const double l2 = F[6] * x1.x[i] + F[7] * x1.y[i] + F[8];
+    const double d = l0 * x2.x[i] + l1 * x2.y[i] + l2;
+    errors[i] = d * d / (l0 * l0 + l1 * l1);
+  }
+}
+
+void SampsonErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Epipolar lines F x1 and F^t x2
+    const double l0 = F[0] * x1.x[i] + F[1] * x1.y[i] + F[2];
+    const double l1 = F[3] * x1.x[i] + F[4] * x1.y[i] + F[5];
+    const double l2 = F[6] * x1.x[i] + F[7] * x1.y[i] + F[8];
+    const double t0 = F[0] * x2.x[i] + F[3] * x2.y[i] + F[6];
+    const double t1 = F[1] * x2.x[i] + F[4] * x2.y[i] + F[7];
+    const double d = l0 * x2.x[i] + l1 * x2.y[i] + l2;
+    errors[i] = d * d / (l0 * l0 + l1 * l1 + t0 * t0 + t1 * t1);
+  }
+}
+
+void SymmetricEpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Epipolar lines F x1 and F^t x2
+    const double l0 = F[0] * x1.x[i] + F[1] * x1.y[i] + F[2];
+    const double l1 = F[3] * x1.x[i] + F[4] * x1.y[i] + F[5];
+    const double l2 = F[6] * x1.x[i] + F[7] * x1.y[i] + F[8];
+    const double t0 = F[0] * x2.x[i] + F[3] * x2.y[i] + F[6];
+    const double t1 = F[1] * x2.x[i] + F[4] * x2.y[i] + F[7];
+    const double d = l0 * x2.x[i] + l1 * x2.y[i] + l2;
+    errors[i] = d * d
+      * (1.0 / (l0 * l0 + l1 * l1) + 1.0 / (t0 * t0 + t1 * t1)) / 4.0;
+  }
+}
+
+void HomographyTransferErrors
+(
+  const double H[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double h0 = H[0] * x1.x[i] + H[1] * x1.y[i] + H[2];
+    const double h1 = H[3] * x1.x[i] + H[4] * x1.y[i] + H[5];
+    const double h2 = H[6] * x1.x[i] + H[7] * x1.y[i] + H[8];
+    const double dx = x2.x[i] - h0 / h2;
+    const double dy = x2.y[i] - h1 / h2;
+    errors[i] = dx * dx + dy * dy;
+  }
+}
+
+void EpipolarPlaneSines
+(
+  const double E[9], Points3_SoA x1, Points3_SoA x2,
+  std::size_t count, double * sines
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Epipolar plane normal E x1
+    const double n0 = E[0] * x1.x[i] + E[1] * x1.y[i] + E[2] * x1.z[i];
+    const double n1 = E[3] * x1.x[i] + E[4] * x1.y[i] + E[5] * x1.z[i];
+    const double n2 = E[6] * x1.x[i] + E[7] * x1.y[i] + E[8] * x1.z[i];
+    const double norm2 = n0 * n0 + n1 * n1 + n2 * n2;
+    // A null normal gives a null angle (as Eigen normalized() does)
+    sines[i] = (norm2 > 0.0) ?
+      (n0 * x2.x[i] + n1 * x2.y[i] + n2 * x2.z[i]) / std::sqrt(norm2) : 0.0;
+  }
+}
+
+void ReprojectionErrors
+(
+  const double P[12], Points2_SoA x, Points3_SoA X,
+  std::size_t count, double * errors
+)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double p0 = P[0] * X.x[i] + P[1] * X.y[i] + P[2]  * X.z[i] + P[3];
+    const double p1 = P[4] * X.x[i] + P[5] * X.y[i] + P[6]  * X.z[i] + P[7];
+    const double p2 = P[8] * X.x[i] + P[9] * X.y[i] + P[10] * X.z[i] + P[11];
+    const double dx = x.x[i] - p0 / p2;
+    const double dy = x.y[i] - p1 / p2;
+    errors[i] = dx * dx + dy * dy;
+  }
+}
+
+} // namespace scalar
+
+bool UseAVX2()
+{
+#ifdef OPENMVG_USE_AVX2
+  static const bool use_avx2 = system::CpuInstructionSet().supportAVX2();
+  return use_avx2;
+#else
+  return false;
+#endif
+}
+
+namespace {
+
+Points2_SoA SoA(const Mat2X_SoA & x)
+{
+  return {x.row(0).data(), x.row(1).data()};
+}
+
+Points3_SoA SoA(const Mat3X_SoA & x)
+{
+  return {x.row(0).data(), x.row(1).data(), x.row(2).data()};
+}
+
+} // namespace
+
+// Call the AVX2 or the scalar implementation of a batched residual function
+#ifdef OPENMVG_USE_AVX2
+#define OPENMVG_BATCHED_RESIDUALS_DISPATCH(FUNCTION, ...) \
+  if (UseAVX2())                                          \
+    avx2::FUNCTION(__VA_ARGS__);                          \
+  else                                                    \
+    scalar::FUNCTION(__VA_ARGS__);
+#else
+#define OPENMVG_BATCHED_RESIDUALS_DISPATCH(FUNCTION, ...) \
+  scalar::FUNCTION(__VA_ARGS__);
+#endif
+
+void EpipolarDistanceErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+)
+{
+  assert(x1.cols() == x2.cols());
+  const RMat3 F_row_major = F;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(EpipolarDistanceErrors,
+    F_row_major.data(), SoA(x1), SoA(x2), x1.cols(), errors)
+}
+
+void SampsonErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+)
+{
+  assert(x1.cols() == x2.cols());
+  const RMat3 F_row_major = F;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(SampsonErrors,
+    F_row_major.data(), SoA(x1), SoA(x2), x1.cols(), errors)
+}
+
+void SymmetricEpipolarDistanceErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+)
+{
+  assert(x1.cols() == x2.cols());
+  const RMat3 F_row_major = F;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(SymmetricEpipolarDistanceErrors,
+    F_row_major.data(), SoA(x1), SoA(x2), x1.cols(), errors)
+}
+
+void HomographyTransferErrors
+(
+  const Mat3 & H,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+)
+{
+  assert(x1.cols() == x2.cols());
+  const RMat3 H_row_major = H;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(HomographyTransferErrors,
+    H_row_major.data(), SoA(x1), SoA(x2), x1.cols(), errors)
+}
+
+void AngularErrors
+(
+  const Mat3 & E,
+  const Mat3X_SoA & x1,
+  const Mat3X_SoA & x2,
+  double * errors
+)
+{
+  assert(x1.cols() == x2.cols());
+  const RMat3 E_row_major = E;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(EpipolarPlaneSines,
+    E_row_major.data(), SoA(x1), SoA(x2), x1.cols(), errors)
+  // The angle is computed in a second pass (there is no SIMD arc sine)
+  for (Mat::Index i = 0; i < x1.cols(); ++i)
+    errors[i] = std::abs(std::asin(errors[i]));
+}
+
+void ReprojectionErrors
+(
+  const Mat34 & P,
+  const Mat2X_SoA & x,
+  const Mat3X_SoA & X,
+  double * errors
+)
+{
+  assert(x.cols() == X.cols());
+  const Eigen::Matrix<double, 3, 4, Eigen::RowMajor> P_row_major = P;
+  OPENMVG_BATCHED_RESIDUALS_DISPATCH(ReprojectionErrors,
+    P_row_major.data(), SoA(x), SoA(X), x.cols(), errors)
+}
+
+#undef OPENMVG_BATCHED_RESIDUALS_DISPATCH
+
+} // namespace batched_residuals
+} // namespace openMVG
@@ -0,0 +1,117 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_HPP
+#define OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_HPP
+
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+
+#include <type_traits>
+
+namespace openMVG {
+
+/// 2D points stored as a Structure of Arrays (row major storage):
+///  all the x coordinates are contiguous, then all the y coordinates.
+/// The residuals of consecutive points can then be computed with SIMD instructions.
+using Mat2X_SoA = Eigen::Matrix<double, 2, Eigen::Dynamic, Eigen::RowMajor>;
+/// 3D points stored as a Structure of Arrays (row major storage)
+using Mat3X_SoA = Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>;
+
+/// Tell if an error functor provides a batched evaluation
+///  (static void ErrorT::Errors(model, x1_soa, x2_soa, double * errors))
+template <typename ErrorT, typename = void>
+struct Has_Batched_Errors : std::false_type {};
+
+template <typename ErrorT>
+struct Has_Batched_Errors<ErrorT, decltype(&ErrorT::Errors, void())> : std::true_type {};
+
+/**
+* @brief Residual errors of a model for a whole set of correspondences.
+*
+* The values are the same as the per correspondence Error functions
+*  (up to the floating point rounding), but the correspondences are processed
+*  by batch: the AVX2 implementation is used if the library has been built with
+*  AVX2 support and if the CPU supports it (checked at runtime),
+*  else a portable implementation is used.
+*/
+namespace batched_residuals {
+
+/// Tell if the AVX2 implementation is used
+bool UseAVX2();
+
+/**
+* @brief Squared distance of x2 to the epipolar line F x1
+*  (see fundamental::kernel::EpipolarDistanceError)
+* @param F Fundamental matrix
+* @param x1 Points of the first image
+* @param x2 Points of the second image
+* @param[out] errors Residual array (x1.cols() values)
+*/
+void EpipolarDistanceErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+);
+
+/// Sampson error (see fundamental::kernel::SampsonError)
+void SampsonErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+);
+
+/// Symmetric epipolar distance (see fundamental::kernel::SymmetricEpipolarDistanceError)
+void SymmetricEpipolarDistanceErrors
+(
+  const Mat3 & F,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+);
+
+/// Squared transfer error in the second image (see homography::kernel::AsymmetricError)
+void HomographyTransferErrors
+(
+  const Mat3 & H,
+  const Mat2X_SoA & x1,
+  const Mat2X_SoA & x2,
+  double * errors
+);
+
+/// Angular error between [0; PI/2] of bearing vector pairs (see AngularError)
+void AngularErrors
+(
+  const Mat3 & E,
+  const Mat3X_SoA & x1,
+  const Mat3X_SoA & x2,
+  double * errors
+);
+
+/**
+* @brief Squared reprojection error |x - P X|^2
+* @param P Projection matrix
+* @param x Image points
+* @param X 3D points
+* @param[out] errors Residual array (x.cols() values)
+*/
+void ReprojectionErrors
+(
+  const Mat34 & P,
+  const Mat2X_SoA & x,
+  const Mat3X_SoA & X,
+  double * errors
+);
+
+} // namespace batched_residuals
+} // namespace openMVG
+
+#endif // OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_HPP
@@ -0,0 +1,233 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// AVX2 batched residuals.
+// This file is compiled with the AVX2 architecture flag: it must only include
+//  the intrinsics and the raw function declarations (no inline template code).
+
+#include "openMVG/multiview/batched_residuals_kernels.hpp"
+
+#ifdef OPENMVG_USE_AVX2
+
+#include <immintrin.h>
+
+namespace openMVG {
+namespace batched_residuals {
+namespace avx2 {
+
+namespace {
+
+/// Broadcast the model coefficients
+template <int N>
+struct Coefficients
+{
+  explicit Coefficients(const double * values)
+  {
+    for (int i = 0; i < N; ++i)
+      m[i] = _mm256_set1_pd(values[i]);
+  }
+  __m256d m[N];
+};
+
+/// a * x + b * y + c
+inline __m256d Dot3
+(
+  const __m256d a, const __m256d b, const __m256d c,
+  const __m256d x, const __m256d y
+)
+{
+  return _mm256_add_pd(
+    _mm256_add_pd(_mm256_mul_pd(a, x), _mm256_mul_pd(b, y)), c);
+}
+
+/// a * x + b * y + c * z
+inline __m256d Dot3
+(
+  const __m256d a, const __m256d b, const __m256d c,
+  const __m256d x, const __m256d y, const __m256d z
+)
+{
+  return _mm256_add_pd(
+    _mm256_add_pd(_mm256_mul_pd(a, x), _mm256_mul_pd(b, y)),
+    _mm256_mul_pd(c, z));
+}
+
+/// a * a + b * b
+inline __m256d SquaredNorm
+(
+  const __m256d a, const __m256d b
+)
+{
+  return _mm256_add_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b));
+}
+
+} // namespace
+
+void EpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  const Coefficients<9> f(F);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d x1x = _mm256_loadu_pd(x1.x + i), x1y = _mm256_loadu_pd(x1.y + i);
+    const __m256d x2x = _mm256_loadu_pd(x2.x + i), x2y = _mm256_loadu_pd(x2.y + i);
+    // Epipolar line F x1 and its algebraic distance to x2
+    const __m256d l0 = Dot3(f.m[0], f.m[1], f.m[2], x1x, x1y);
+    const __m256d l1 = Dot3(f.m[3], f.m[4], f.m[5], x1x, x1y);
+    const __m256d l2 = Dot3(f.m[6], f.m[7], f.m[8], x1x, x1y);
+    const __m256d d = Dot3(l0, l1, l2, x2x, x2y);
+    _mm256_storeu_pd(errors + i,
+      _mm256_div_pd(_mm256_mul_pd(d, d), SquaredNorm(l0, l1)));
+  }
+  scalar::EpipolarDistanceErrors(F,
+    {x1.x + i, x1.y + i}, {x2.x + i, x2.y + i}, count - i, errors + i);
+}
+
+void SampsonErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  const Coefficients<9> f(F);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d x1x = _mm256_loadu_pd(x1.x + i), x1y = _mm256_loadu_pd(x1.y + i);
+    const __m256d x2x = _mm256_loadu_pd(x2.x + i), x2y = _mm256_loadu_pd(x2.y + i);
+    // Epipolar lines F x1 and F^t x2
+    const __m256d l0 = Dot3(f.m[0], f.m[1], f.m[2], x1x, x1y);
+    const __m256d l1 = Dot3(f.m[3], f.m[4], f.m[5], x1x, x1y);
+    const __m256d l2 = Dot3(f.m[6], f.m[7], f.m[8], x1x, x1y);
+    const __m256d t0 = Dot3(f.m[0], f.m[3], f.m[6], x2x, x2y);
+    const __m256d t1 = Dot3(f.m[1], f.m[4], f.m[7], x2x, x2y);
+    const __m256d d = Dot3(l0, l1, l2, x2x, x2y);
+    _mm256_storeu_pd(errors + i,
+      _mm256_div_pd(_mm256_mul_pd(d, d),
+        _mm256_add_pd(SquaredNorm(l0, l1), SquaredNorm(t0, t1))));
+  }
+  scalar::SampsonErrors(F,
+    {x1.x + i, x1.y + i}, {x2.x + i, x2.y + i}, count - i, errors + i);
+}
+
+void SymmetricEpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  const Coefficients<9> f(F);
+  const __m256d one = _mm256_set1_pd(1.0), quarter = _mm256_set1_pd(0.25);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d x1x = _mm256_loadu_pd(x1.x + i), x1y = _mm256_loadu_pd(x1.y + i);
+    const __m256d x2x = _mm256_loadu_pd(x2.x + i), x2y = _mm256_loadu_pd(x2.y + i);
+    // Epipolar lines F x1 and F^t x2
+    const __m256d l0 = Dot3(f.m[0], f.m[1], f.m[2], x1x, x1y);
+    const __m256d l1 = Dot3(f.m[3], f.m[4], f.m[5], x1x, x1y);
+    const __m256d l2 = Dot3(f.m[6], f.m[7], f.m[8], x1x, x1y);
+    const __m256d t0 = Dot3(f.m[0], f.m[3], f.m[6], x2x, x2y);
+    const __m256d t1 = Dot3(f.m[1], f.m[4], f.m[7], x2x, x2y);
+    const __m256d d = Dot3(l0, l1, l2, x2x, x2y);
+    const __m256d inverse_norms = _mm256_add_pd(
+      _mm256_div_pd(one, SquaredNorm(l0, l1)),
+      _mm256_div_pd(one, SquaredNorm(t0, t1)));
+    _mm256_storeu_pd(errors + i,
+      _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(d, d), inverse_norms), quarter));
+  }
+  scalar::SymmetricEpipolarDistanceErrors(F,
+    {x1.x + i, x1.y + i}, {x2.x + i, x2.y + i}, count - i, errors + i);
+}
+
+void HomographyTransferErrors
+(
+  const double H[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+)
+{
+  const Coefficients<9> h(H);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d x1x = _mm256_loadu_pd(x1.x + i), x1y = _mm256_loadu_pd(x1.y + i);
+    const __m256d h0 = Dot3(h.m[0], h.m[1], h.m[2], x1x, x1y);
+    const __m256d h1 = Dot3(h.m[3], h.m[4], h.m[5], x1x, x1y);
+    const __m256d h2 = Dot3(h.m[6], h.m[7], h.m[8], x1x, x1y);
+    const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x2.x + i), _mm256_div_pd(h0, h2));
+    const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(x2.y + i), _mm256_div_pd(h1, h2));
+    _mm256_storeu_pd(errors + i, SquaredNorm(dx, dy));
+  }
+  scalar::HomographyTransferErrors(H,
+    {x1.x + i, x1.y + i}, {x2.x + i, x2.y + i}, count - i, errors + i);
+}
+
+void EpipolarPlaneSines
+(
+  const double E[9], Points3_SoA x1, Points3_SoA x2,
+  std::size_t count, double * sines
+)
+{
+  const Coefficients<9> e(E);
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d x1x = _mm256_loadu_pd(x1.x + i);
+    const __m256d x1y = _mm256_loadu_pd(x1.y + i);
+    const __m256d x1z = _mm256_loadu_pd(x1.z + i);
+    // Epipolar plane normal E x1
+    const __m256d n0 = Dot3(e.m[0], e.m[1], e.m[2], x1x, x1y, x1z);
+    const __m256d n1 = Dot3(e.m[3], e.m[4], e.m[5], x1x, x1y, x1z);
+    const __m256d n2 = Dot3(e.m[6], e.m[7], e.m[8], x1x, x1y, x1z);
+    const __m256d norm2 = _mm256_add_pd(SquaredNorm(n0, n1), _mm256_mul_pd(n2, n2));
+    const __m256d dot = Dot3(n0, n1, n2,
+      _mm256_loadu_pd(x2.x + i), _mm256_loadu_pd(x2.y + i), _mm256_loadu_pd(x2.z + i));
+    // A null normal gives a null angle
+    const __m256d valid = _mm256_cmp_pd(norm2, zero, _CMP_GT_OQ);
+    _mm256_storeu_pd(sines + i,
+      _mm256_and_pd(valid, _mm256_div_pd(dot, _mm256_sqrt_pd(norm2))));
+  }
+  scalar::EpipolarPlaneSines(E,
+    {x1.x + i, x1.y + i, x1.z + i}, {x2.x + i, x2.y + i, x2.z + i},
+    count - i, sines + i);
+}
+
+void ReprojectionErrors
+(
+  const double P[12], Points2_SoA x, Points3_SoA X,
+  std::size_t count, double * errors
+)
+{
+  const Coefficients<12> p(P);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d Xx = _mm256_loadu_pd(X.x + i);
+    const __m256d Xy = _mm256_loadu_pd(X.y + i);
+    const __m256d Xz = _mm256_loadu_pd(X.z + i);
+    const __m256d p0 = _mm256_add_pd(Dot3(p.m[0], p.m[1], p.m[2], Xx, Xy, Xz), p.m[3]);
+    const __m256d p1 = _mm256_add_pd(Dot3(p.m[4], p.m[5], p.m[6], Xx, Xy, Xz), p.m[7]);
+    const __m256d p2 = _mm256_add_pd(Dot3(p.m[8], p.m[9], p.m[10], Xx, Xy, Xz), p.m[11]);
+    const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x.x + i), _mm256_div_pd(p0, p2));
+    const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(x.y + i), _mm256_div_pd(p1, p2));
+    _mm256_storeu_pd(errors + i, SquaredNorm(dx, dy));
+  }
+  scalar::ReprojectionErrors(P,
+    {x.x + i, x.y + i}, {X.x + i, X.y + i, X.z + i}, count - i, errors + i);
+}
+
+} // namespace avx2
+} // namespace batched_residuals
+} // namespace openMVG
+
+#endif // OPENMVG_USE_AVX2
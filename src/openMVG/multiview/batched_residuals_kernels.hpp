@@ -0,0 +1,137 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_KERNELS_HPP
+#define OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_KERNELS_HPP
+
+#include <cstddef>
+
+// Raw implementations of the batched residual evaluations
+//  (see openMVG/multiview/batched_residuals.hpp for the Eigen interface).
+//
+// This header must not include Eigen (or any other inline template code):
+//  the AVX2 implementation is compiled with specific architecture flags,
+//  and must not define inline functions that could be shared with the other
+//  translation units.
+//
+// Model matrices are given as row major arrays (M[3*row + col]).
+
+namespace openMVG {
+namespace batched_residuals {
+
+/// Coordinates of a set of 2D points (one array per coordinate)
+struct Points2_SoA
+{
+  const double * x;
+  const double * y;
+};
+
+/// Coordinates of a set of 3D points (one array per coordinate)
+struct Points3_SoA
+{
+  const double * x;
+  const double * y;
+  const double * z;
+};
+
+/// Portable implementation
+namespace scalar {
+
+/// Squared distance of x2 to the epipolar line F x1
+void EpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+/// Sampson error (first order approximation of the epipolar geometric error)
+void SampsonErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+/// Mean of the squared distances to the epipolar lines of both images
+void SymmetricEpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+/// Squared transfer error in the second image: |x2 - H x1|^2
+void HomographyTransferErrors
+(
+  const double H[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+/// Sine of the angle between the bearing vector x2 and the epipolar plane
+///  of the bearing vector x1 (plane of normal E x1)
+void EpipolarPlaneSines
+(
+  const double E[9], Points3_SoA x1, Points3_SoA x2,
+  std::size_t count, double * sines
+);
+
+/// Squared reprojection error: |x - P X|^2 (P is a row major 3x4 matrix)
+void ReprojectionErrors
+(
+  const double P[12], Points2_SoA x, Points3_SoA X,
+  std::size_t count, double * errors
+);
+
+} // namespace scalar
+
+#ifdef OPENMVG_USE_AVX2
+/// AVX2 implementation of the scalar functions (4 correspondences per instruction).
+/// It must be used only if the CPU supports AVX2.
+namespace avx2 {
+
+void EpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+void SampsonErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+void SymmetricEpipolarDistanceErrors
+(
+  const double F[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+void HomographyTransferErrors
+(
+  const double H[9], Points2_SoA x1, Points2_SoA x2,
+  std::size_t count, double * errors
+);
+
+void EpipolarPlaneSines
+(
+  const double E[9], Points3_SoA x1, Points3_SoA x2,
+  std::size_t count, double * sines
+);
+
+void ReprojectionErrors
+(
+  const double P[12], Points2_SoA x, Points3_SoA X,
+  std::size_t count, double * errors
+);
+
+} // namespace avx2
+#endif // OPENMVG_USE_AVX2
+
+} // namespace batched_residuals
+} // namespace openMVG
+
+#endif // OPENMVG_MULTIVIEW_BATCHED_RESIDUALS_KERNELS_HPP
@@ -0,0 +1,140 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/multiview/batched_residuals.hpp"
+#include "openMVG/multiview/batched_residuals_kernels.hpp"
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/solver_essential_eight_point.hpp"
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+
+#include "testing/testing.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace openMVG;
+
+// Not a multiple of the SIMD width: the remaining points are tested too
+static const int kNumPoints = 1003;
+
+// Relative comparison of the batched and the per correspondence errors
+static bool AreNear(const double a, const double b)
+{
+  return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+}
+
+TEST(BatchedResiduals, EpipolarErrors)
+{
+  std::cout << "AVX2 batched residuals: " << batched_residuals::UseAVX2() << std::endl;
+
+  const Mat3 F = Mat3::Random();
+  const Mat2X x1 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const Mat2X x2 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const Mat2X_SoA x1_soa = x1, x2_soa = x2;
+
+  std::vector<double> errors(kNumPoints);
+  fundamental::kernel::EpipolarDistanceError::Errors(F, x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i],
+      fundamental::kernel::EpipolarDistanceError::Error(F, x1.col(i), x2.col(i))));
+
+  fundamental::kernel::SampsonError::Errors(F, x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i],
+      fundamental::kernel::SampsonError::Error(F, x1.col(i), x2.col(i))));
+
+  fundamental::kernel::SymmetricEpipolarDistanceError::Errors(F, x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i],
+      fundamental::kernel::SymmetricEpipolarDistanceError::Error(F, x1.col(i), x2.col(i))));
+}
+
+TEST(BatchedResiduals, HomographyErrors)
+{
+  Mat3 H = Mat3::Random();
+  H(2, 2) = 10.0; // Keep the transfered points far from the infinity
+  const Mat2X x1 = Mat2X::Random(2, kNumPoints);
+  const Mat2X x2 = Mat2X::Random(2, kNumPoints);
+  const Mat2X_SoA x1_soa = x1, x2_soa = x2;
+
+  std::vector<double> errors(kNumPoints);
+  homography::kernel::AsymmetricError::Errors(H, x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i],
+      homography::kernel::AsymmetricError::Error(H, x1.col(i), x2.col(i))));
+}
+
+TEST(BatchedResiduals, AngularErrors)
+{
+  const Mat3 E = Mat3::Random();
+  const Mat3X x1 = Mat3X(Mat3X::Random(3, kNumPoints)).colwise().normalized();
+  const Mat3X x2 = Mat3X(Mat3X::Random(3, kNumPoints)).colwise().normalized();
+  const Mat3X_SoA x1_soa = x1, x2_soa = x2;
+
+  std::vector<double> errors(kNumPoints);
+  AngularError::Errors(E, x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i], AngularError::Error(E, x1.col(i), x2.col(i))));
+
+  // A null epipolar plane normal gives a null angle
+  AngularError::Errors(Mat3::Zero(), x1_soa, x2_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    EXPECT_EQ(0.0, errors[i]);
+}
+
+TEST(BatchedResiduals, ReprojectionErrors)
+{
+  Mat34 P = Mat34::Random();
+  P(2, 3) = 10.0; // Keep the points in front of the camera
+  const Mat3X X = Mat3X::Random(3, kNumPoints);
+  const Mat2X x = Mat2X::Random(2, kNumPoints) * 5.0;
+  const Mat2X_SoA x_soa = x;
+  const Mat3X_SoA X_soa = X;
+
+  std::vector<double> errors(kNumPoints);
+  batched_residuals::ReprojectionErrors(P, x_soa, X_soa, errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i], (Project(P, Vec3(X.col(i))) - x.col(i)).squaredNorm()));
+}
+
+// The dispatched implementation (AVX2 if available) gives the portable results
+TEST(BatchedResiduals, PortableImplementation)
+{
+  const Mat3 F = Mat3::Random();
+  const Mat2X_SoA x1 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const Mat2X_SoA x2 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const RMat3 F_row_major = F;
+
+  std::vector<double> errors(kNumPoints), scalar_errors(kNumPoints);
+  batched_residuals::SampsonErrors(F, x1, x2, errors.data());
+  batched_residuals::scalar::SampsonErrors(F_row_major.data(),
+    {x1.row(0).data(), x1.row(1).data()}, {x2.row(0).data(), x2.row(1).data()},
+    kNumPoints, scalar_errors.data());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i], scalar_errors[i]));
+}
+
+// The two view kernel batched evaluation gives the per sample errors
+TEST(BatchedResiduals, TwoViewKernel)
+{
+  const Mat x1 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const Mat x2 = Mat2X::Random(2, kNumPoints) * 500.0;
+  const Mat3 F = Mat3::Random();
+
+  const fundamental::kernel::SevenPointKernel kernel(x1, x2);
+  std::vector<double> errors;
+  kernel.Errors(F, errors);
+  EXPECT_EQ(kNumPoints, errors.size());
+  for (int i = 0; i < kNumPoints; ++i)
+    CHECK(AreNear(errors[i], kernel.Error(i, F)));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -60,4 +60,15 @@ double AngularError::Error
   return std::abs(std::asin(angleVal));
 }
 
+void AngularError::Errors
+(
+  const Mat3 & model,
+  const Mat3X_SoA & x1,
+  const Mat3X_SoA & x2,
+  double * errors
+)
+{
+  batched_residuals::AngularErrors(model, x1, x2, errors);
+}
+
 } // namespace openMVG
@@ -10,6 +10,7 @@
 #define OPENMVG_MULTIVIEW_SOLVER_ESSENTIAL_SPHERICAL_HPP
 
 #include <vector>
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
 namespace openMVG {
@@ -40,6 +41,15 @@ struct AngularError
     const Vec3 & x1,
     const Vec3 & x2
   );
+
+  /// Batched version (one error per bearing vector pair)
+  static void Errors
+  (
+    const Mat3 & model,
+    const Mat3X_SoA & x1,
+    const Mat3X_SoA & x2,
+    double * errors
+  );
 };
 
 } // namespace openMVG
@@ -131,6 +131,21 @@ public:
     FundamentalFromEssential(model, K1_, K2_, &F);
     return ErrorArg::Error(F, this->x1_.col(sample), this->x2_.col(sample));
   }
+
+  template <typename E = ErrorArg,
+            typename std::enable_if<Has_Batched_Errors<E>::value, int>::type = 0>
+  void Errors
+  (
+    const ModelArg &model,
+    std::vector<double> &errors
+  )
+  const
+  {
+    Mat3 F;
+    FundamentalFromEssential(model, K1_, K2_, &F);
+    errors.resize(this->x1_.cols());
+    ErrorArg::Errors(F, this->x1_soa_, this->x2_soa_, errors.data());
+  }
 protected:
   Mat3 K1_, K2_; // The two calibrated camera matrices
   Mat3X bearing_x1_, bearing_x2_;
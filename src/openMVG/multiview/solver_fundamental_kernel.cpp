@@ -191,6 +191,30 @@ double EpipolarDistanceError::Error
   return Square(F_x.dot(y.homogeneous())) /  F_x.head<2>().squaredNorm();
 }
 
+void SampsonError::Errors
+(
+  const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors
+)
+{
+  batched_residuals::SampsonErrors(F, x, y, errors);
+}
+
+void SymmetricEpipolarDistanceError::Errors
+(
+  const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors
+)
+{
+  batched_residuals::SymmetricEpipolarDistanceErrors(F, x, y, errors);
+}
+
+void EpipolarDistanceError::Errors
+(
+  const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors
+)
+{
+  batched_residuals::EpipolarDistanceErrors(F, x, y, errors);
+}
+
 }  // namespace kernel
 }  // namespace fundamental
 }  // namespace openMVG
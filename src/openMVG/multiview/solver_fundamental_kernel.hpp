@@ -32,6 +32,7 @@
 
 #include <vector>
 
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/multiview/two_view_kernel.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
@@ -97,14 +98,20 @@ inline void EncodeEpipolarEquation(const TMatX &x1, const TMatX &x2, TMatA *A) {
 /// Compute SampsonError related to the Fundamental matrix and 2 correspondences
 struct SampsonError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched version (one error per correspondence)
+  static void Errors(const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors);
 };
 
 struct SymmetricEpipolarDistanceError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched version (one error per correspondence)
+  static void Errors(const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors);
 };
 
 struct EpipolarDistanceError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched version (one error per correspondence)
+  static void Errors(const Mat3 &F, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors);
 };
 
 //-- Kernel solver for the 8pt Fundamental Matrix Estimation
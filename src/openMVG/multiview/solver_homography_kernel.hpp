@@ -32,6 +32,7 @@
 
 #include <vector>
 
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/multiview/projection.hpp"
 #include "openMVG/multiview/two_view_kernel.hpp"
 
@@ -60,6 +61,10 @@ struct AsymmetricError {
   static double Error(const Mat &H, const Vec2 &x, const Vec2 &y) {
     return (y - Vec3( H * x.homogeneous()).hnormalized() ).squaredNorm();
   }
+  /// Batched version (one error per correspondence)
+  static void Errors(const Mat3 &H, const Mat2X_SoA &x, const Mat2X_SoA &y, double *errors) {
+    batched_residuals::HomographyTransferErrors(H, x, y, errors);
+  }
 };
 
 // Kernel that works on original data point
@@ -30,8 +30,10 @@
 #ifndef OPENMVG_MULTIVIEW_TWO_VIEW_KERNEL_HPP
 #define OPENMVG_MULTIVIEW_TWO_VIEW_KERNEL_HPP
 
+#include <type_traits>
 #include <vector>
 
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/multiview/conditioning.hpp"
 #include "openMVG/numeric/extract_columns.hpp"
 
@@ -61,6 +63,10 @@ namespace kernel {
 //   3. Kernel::Fit(std::vector<uint32_t>, std::vector<Kernel::Model> *)
 //   4. Kernel::Error(uint32_t, Model) -> error
 //
+// If the error functor provides a batched evaluation (ErrorArg::Errors), the
+// kernel keeps a Structure of Arrays copy of the points and provides:
+//   5. Kernel::Errors(Model, std::vector<double> &) -> errors of all the samples
+//
 // The fit routine must not clear existing entries in the vector of models; it
 // should append new solutions to the end.
 template<typename SolverArg,
@@ -68,7 +74,12 @@ template<typename SolverArg,
          typename ModelArg = Mat3>
 class Kernel {
  public:
-  Kernel(const Mat &x1, const Mat &x2) : x1_(x1), x2_(x2) {}
+  Kernel(const Mat &x1, const Mat &x2) : x1_(x1), x2_(x2) {
+    if (Has_Batched_Errors<ErrorArg>::value) {
+      x1_soa_ = x1;
+      x2_soa_ = x2;
+    }
+  }
   using Solver = SolverArg;
   using Model = ModelArg;
   using ErrorT = ErrorArg;
@@ -89,6 +100,14 @@ class Kernel {
   double Error(uint32_t sample, const Model &model) const {
     return ErrorArg::Error(model, x1_.col(sample), x2_.col(sample));
   }
+  /// Return the errors associated to the model and all the points
+  ///  (only available for the error functors with a batched evaluation)
+  template <typename E = ErrorArg,
+            typename std::enable_if<Has_Batched_Errors<E>::value, int>::type = 0>
+  void Errors(const Model &model, std::vector<double> &errors) const {
+    errors.resize(x1_.cols());
+    ErrorArg::Errors(model, x1_soa_, x2_soa_, errors.data());
+  }
   /// Number of putative point
   size_t NumSamples() const {
     return x1_.cols();
@@ -100,6 +119,7 @@ class Kernel {
   }
  protected:
   const Mat & x1_, & x2_; // Left/Right corresponding point
+  Mat2X_SoA x1_soa_, x2_soa_; // Left/Right points SoA copy (batched errors)
 };
 
 // Analog Normalized version of the previous Kernel.
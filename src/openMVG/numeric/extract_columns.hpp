@@ -37,6 +37,30 @@ Mat ExtractColumns
   return compressed;
 }
 
+/**
+* @brief Extract a submatrix given a list of column into an existing matrix
+* @param A Input matrix
+* @param columns A vector of columns index to extract
+* @param[out] compressed Matrix containing a subset of input matrix columns
+*  (no memory allocation is done if it has already the required size)
+* @note columns index start at index 0
+* @note Assuming columns contains a list of valid columns index
+*/
+template <typename TMat, typename TCols, typename TOutMat>
+void ExtractColumns
+(
+  const Eigen::MatrixBase<TMat> &A,
+  const TCols &columns,
+  Eigen::PlainObjectBase<TOutMat> * compressed
+)
+{
+  compressed->resize( A.rows(), columns.size() );
+  for ( size_t i = 0; i < static_cast<size_t>( columns.size() ); ++i )
+  {
+    compressed->col( i ) = A.col( columns[i] );
+  }
+}
+
 } // namespace openMVG
 
 #endif  // OPENMVG_NUMERIC_EXTRACT_COLUMNS_HPP
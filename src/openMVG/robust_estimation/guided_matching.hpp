@@ -17,6 +17,11 @@
 #include "openMVG/features/regions.hpp"
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/numeric/numeric.h"
+#include "openMVG/robust_estimation/guided_matching_grid.hpp"
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace openMVG{
 namespace geometry_aware{
@@ -390,6 +395,209 @@ void GuidedMatching_Fundamental_Fast(
   }
 }
 
+/// Region positions (un-distorted on the fly if a camera is provided)
+inline std::vector<Vec2> RegionPositions(
+  const cameras::IntrinsicBase * cam, // Optional camera (can be nullptr)
+  const features::Regions & regions)
+{
+  std::vector<Vec2> positions(regions.RegionCount());
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for if(!omp_in_parallel())
+#endif
+  for (int i = 0; i < static_cast<int>(positions.size()); ++i) {
+    positions[i] = cam ? cam->get_ud_pixel(regions.GetRegionPosition(i)) : regions.GetRegionPosition(i);
+  }
+  return positions;
+}
+
+/// Guided Matching (features + descriptors with distance ratio) on a set of
+///  geometric candidates:
+///   Keep the best corresponding points for the given model under the
+///   user specified distance ratio.
+/// The left regions are processed in parallel (unless called from a parallel
+///  region, or from a thread limited to one OpenMP thread, i.e. a pipeline worker),
+///  the geometric candidates of a left region are provided by a functor:
+///  void(IndexT i, std::vector<IndexT> & candidates) (valid right indexes).
+template<typename CandidatesFunctor>
+void GuidedMatching_Candidates(
+  const features::Regions & lRegions,  // regions (point features & corresponding descriptors)
+  const features::Regions & rRegions,  // regions (point features & corresponding descriptors)
+  const CandidatesFunctor & geometric_candidates, // Right candidates of a left region
+  double distRatio,     // Maximal authorized distance ratio
+  matching::IndMatches & vec_corresponding_index) // Ouput corresponding index
+{
+  const int left_count = static_cast<int>(lRegions.RegionCount());
+  std::vector<distanceRatio<double>> dR(left_count);
+
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel if(!omp_in_parallel())
+#endif
+  {
+    // Per thread buffers
+    std::vector<IndexT> candidates;
+    std::vector<double> distances;
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (int i = 0; i < left_count; ++i) {
+      candidates.clear();
+      geometric_candidates(static_cast<IndexT>(i), candidates);
+      if (candidates.empty())
+        continue;
+      // Same candidate order as the exhaustive search (same ties resolution)
+      std::sort(candidates.begin(), candidates.end());
+
+      // Compute the descriptor distances of all the candidates at once
+      distances.resize(candidates.size());
+      lRegions.SquaredDescriptorDistances(
+        i, &rRegions, candidates.data(), candidates.size(), distances.data());
+      // Update the corresponding points & distance (if required)
+      for (size_t k = 0; k < candidates.size(); ++k) {
+        dR[i].update(candidates[k], distances[k]);
+      }
+    }
+  }
+
+  // Add correspondence only iff the distance ratio is valid
+  for (int i = 0; i < left_count; ++i) {
+    if (dR[i].isValid(distRatio)) {
+      // save the best corresponding index
+      vec_corresponding_index.push_back(matching::IndMatch(i, dR[i].idx));
+    }
+  }
+
+  // Remove duplicates (when multiple points at same position exist)
+  matching::IndMatch::getDeduplicated(vec_corresponding_index);
+}
+
+/// Guided Matching (features + descriptors with distance ratio) for a homography:
+///  Same result as GuidedMatching, but only the right regions that are close
+///  to the transfered left point are compared (a grid indexes the right regions).
+/// ErrorArg must be the squared transfer error in the right image
+///  (homography::kernel::AsymmetricError).
+template<
+  typename ErrorArg> // The metric to compute distance to the model
+void GuidedMatching_Homography_Fast(
+  const Mat3 & H,       // The homography
+  const cameras::IntrinsicBase * camL, // Optional camera (in order to undistord on the fly feature positions, can be nullptr)
+  const features::Regions & lRegions,  // regions (point features & corresponding descriptors)
+  const cameras::IntrinsicBase * camR, // Optional camera (in order to undistord on the fly feature positions, can be nullptr)
+  const features::Regions & rRegions,  // regions (point features & corresponding descriptors)
+  double errorTh,       // Maximal authorized error threshold (consider it's a square threshold)
+  double distRatio,     // Maximal authorized distance ratio
+  matching::IndMatches & vec_corresponding_index) // Ouput corresponding index
+{
+  const std::vector<Vec2>
+    lRegionsPos = RegionPositions(camL, lRegions),
+    rRegionsPos = RegionPositions(camR, rRegions);
+  const Points_Grid<2> grid(rRegionsPos);
+  const double radius = std::sqrt(errorTh);
+
+  GuidedMatching_Candidates(lRegions, rRegions,
+    [&](IndexT i, std::vector<IndexT> & candidates)
+    {
+      // The right candidates are in the disk centered on the transfered point
+      const Vec3 x = H * lRegionsPos[i].homogeneous();
+      if (x(2) == 0.0)
+        return;
+      grid.QueryBall(x.hnormalized(), radius, candidates);
+      // Keep the candidates that have a valid geometric error
+      candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+        [&](IndexT j) {
+          return !(ErrorArg::Error(H, lRegionsPos[i], rRegionsPos[j]) < errorTh);
+        }), candidates.end());
+    },
+    distRatio, vec_corresponding_index);
+}
+
+/// Guided Matching (features + descriptors with distance ratio) for a fundamental matrix:
+///  Same result as GuidedMatching, but only the right regions that are close
+///  to the epipolar line are compared (a grid indexes the right regions).
+/// ErrorArg must be the squared distance to the epipolar line in the right image
+///  (fundamental::kernel::EpipolarDistanceError).
+template<
+  typename ErrorArg> // The metric to compute distance to the model
+void GuidedMatching_Epipolar_Fast(
+  const Mat3 & F,       // The fundamental matrix
+  const cameras::IntrinsicBase * camL, // Optional camera (in order to undistord on the fly feature positions, can be nullptr)
+  const features::Regions & lRegions,  // regions (point features & corresponding descriptors)
+  const cameras::IntrinsicBase * camR, // Optional camera (in order to undistord on the fly feature positions, can be nullptr)
+  const features::Regions & rRegions,  // regions (point features & corresponding descriptors)
+  double errorTh,       // Maximal authorized error threshold (consider it's a square threshold)
+  double distRatio,     // Maximal authorized distance ratio
+  matching::IndMatches & vec_corresponding_index) // Ouput corresponding index
+{
+  const std::vector<Vec2>
+    lRegionsPos = RegionPositions(camL, lRegions),
+    rRegionsPos = RegionPositions(camR, rRegions);
+  const Points_Grid<2> grid(rRegionsPos);
+  const double distance = std::sqrt(errorTh);
+
+  GuidedMatching_Candidates(lRegions, rRegions,
+    [&](IndexT i, std::vector<IndexT> & candidates)
+    {
+      // The right candidates are in the band centered on the epipolar line
+      const Vec3 line = F * lRegionsPos[i].homogeneous();
+      const double norm = line.head<2>().norm();
+      if (norm == 0.0)
+        return;
+      grid.QueryBand(line.head<2>(), line(2), distance * norm, candidates);
+      // Keep the candidates that have a valid geometric error
+      candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+        [&](IndexT j) {
+          return !(ErrorArg::Error(F, lRegionsPos[i], rRegionsPos[j]) < errorTh);
+        }), candidates.end());
+    },
+    distRatio, vec_corresponding_index);
+}
+
+/// Guided Matching (features + descriptors with distance ratio) for an
+///  essential matrix and bearing vectors (angular error):
+///  Same result as an exhaustive search, but only the right bearing vectors that
+///  are close to the epipolar plane are compared (a grid indexes the right bearing vectors).
+/// ErrorArg must be the angle between the bearing vector and the epipolar plane
+///  (AngularError).
+template<
+  typename ErrorArg> // The metric to compute distance to the model
+void GuidedMatching_Angular_Fast(
+  const Mat3 & E,          // The essential matrix
+  const Mat3X & lBearings, // The left bearing vectors
+  const features::Regions & lRegions,  // regions (point features & corresponding descriptors)
+  const Mat3X & rBearings, // The right bearing vectors
+  const features::Regions & rRegions,  // regions (point features & corresponding descriptors)
+  double errorTh,          // Maximal authorized angular error (radian)
+  double distRatio,        // Maximal authorized distance ratio
+  matching::IndMatches & vec_corresponding_index) // Ouput corresponding index
+{
+  assert(lBearings.cols() == lRegions.RegionCount());
+  assert(rBearings.cols() == rRegions.RegionCount());
+
+  std::vector<Vec3> rBearingsVec(rBearings.cols());
+  for (Mat::Index j = 0; j < rBearings.cols(); ++j) {
+    rBearingsVec[j] = rBearings.col(j);
+  }
+  const Points_Grid<3> grid(rBearingsVec);
+  // The sine of the angle to the epipolar plane is the distance to the plane
+  const double distance = (errorTh < M_PI / 2.0) ? std::sin(errorTh) : 1.0;
+
+  GuidedMatching_Candidates(lRegions, rRegions,
+    [&](IndexT i, std::vector<IndexT> & candidates)
+    {
+      // The right candidates are in the band centered on the epipolar plane
+      const Vec3 normal = E * lBearings.col(i);
+      const double norm = normal.norm();
+      if (norm == 0.0)
+        return;
+      grid.QueryBand(normal / norm, 0.0, distance, candidates);
+      // Keep the candidates that have a valid geometric error
+      candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+        [&](IndexT j) {
+          return !(ErrorArg::Error(E, lBearings.col(i), rBearings.col(j)) < errorTh);
+        }), candidates.end());
+    },
+    distRatio, vec_corresponding_index);
+}
+
 } // namespace geometry_aware
 } // namespace openMVG
 
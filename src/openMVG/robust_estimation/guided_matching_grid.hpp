@@ -0,0 +1,254 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_ROBUST_ESTIMATION_GUIDED_MATCHING_GRID_HPP
+#define OPENMVG_ROBUST_ESTIMATION_GUIDED_MATCHING_GRID_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/types.hpp"
+
+namespace openMVG{
+namespace geometry_aware{
+
+/// Uniform grid over a set of points (spatial index used by the guided matching).
+/// The points are bucketed in axis aligned cells, the queries return the
+///  points of the cells that intersect a region (ball or hyperplane band):
+///  the returned points are candidates that must then be checked exactly.
+/// N is the point dimension (2: image points, 3: bearing vectors).
+template <int N>
+class Points_Grid
+{
+public:
+  using PointT = Eigen::Matrix<double, N, 1>;
+  using CellT = Eigen::Matrix<int, N, 1>;
+
+  /**
+  * @brief Bucket the points in a grid of (about) points.size() / points_per_cell cells
+  * @param points The indexed points
+  * @param points_per_cell Mean number of points in a cell of the bounding box
+  */
+  explicit Points_Grid
+  (
+    const std::vector<PointT> & points,
+    const double points_per_cell = 4.0
+  )
+  {
+    if (points.empty())
+    {
+      cell_size_ = 1.0;
+      origin_.setZero();
+      resolution_.setOnes();
+      cell_start_.assign(2, 0);
+      return;
+    }
+
+    // Bounding box of the points
+    PointT min_corner = points[0], max_corner = points[0];
+    for (const PointT & point : points)
+    {
+      min_corner = min_corner.cwiseMin(point);
+      max_corner = max_corner.cwiseMax(point);
+    }
+
+    // Cubic cells sized to reach the required occupancy.
+    // The cells are enlarged if the point set is flat (small bounding box volume)
+    //  in order to keep a grid size close to the required cell count.
+    const PointT extent = max_corner - min_corner;
+    const double cell_count =
+      std::max(1.0, points.size() / std::max(points_per_cell, 1.0));
+    cell_size_ = std::max(
+      std::pow(extent.prod() / cell_count, 1.0 / N),
+      extent.maxCoeff() / cell_count);
+    if (!(cell_size_ > 0.0)) // All the points are at the same position
+      cell_size_ = 1.0;
+    origin_ = min_corner;
+    while (true)
+    {
+      for (int k = 0; k < N; ++k)
+        resolution_(k) = std::max(1, static_cast<int>(std::ceil(extent(k) / cell_size_)));
+      if (resolution_.template cast<double>().prod() <= 2.0 * cell_count)
+        break;
+      cell_size_ *= 1.25;
+    }
+
+    // Compressed storage: the point indexes sorted by cell
+    std::vector<IndexT> point_cells(points.size());
+    cell_start_.assign(CellCount() + 1, 0);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      point_cells[i] = Flatten(Cell(points[i]));
+      ++cell_start_[point_cells[i] + 1];
+    }
+    for (size_t c = 1; c < cell_start_.size(); ++c)
+      cell_start_[c] += cell_start_[c - 1];
+    indexes_.resize(points.size());
+    std::vector<IndexT> cell_fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i)
+      indexes_[cell_fill[point_cells[i]]++] = static_cast<IndexT>(i);
+  }
+
+  /// Append to candidates the points of the cells that intersect
+  ///  the ball of given center and radius
+  void QueryBall
+  (
+    const PointT & center,
+    const double radius,
+    std::vector<IndexT> & candidates
+  ) const
+  {
+    CellT first, last;
+    for (int k = 0; k < N; ++k)
+    {
+      if (!CellRange(k, center(k) - radius, center(k) + radius, first(k), last(k)))
+        return;
+    }
+    AppendBox(first, last, candidates);
+  }
+
+  /// Append to candidates the points of the cells that intersect
+  ///  the hyperplane band |normal.x + offset| <= half_width
+  void QueryBand
+  (
+    const PointT & normal,
+    const double offset,
+    const double half_width,
+    std::vector<IndexT> & candidates
+  ) const
+  {
+    // The cells are scanned along the other axes, and the band range is
+    //  computed along the axis the most aligned with the normal.
+    int axis;
+    if (normal.cwiseAbs().maxCoeff(&axis) <= 0.0)
+      return;
+
+    CellT cell = CellT::Zero(), first, last;
+    while (true)
+    {
+      // Range of normal.x (without the axis coordinate) over the cell column
+      double dot_min = offset, dot_max = offset;
+      for (int k = 0; k < N; ++k)
+      {
+        if (k == axis)
+          continue;
+        const double lower = normal(k) * (origin_(k) + cell(k) * cell_size_);
+        const double upper = normal(k) * (origin_(k) + (cell(k) + 1) * cell_size_);
+        dot_min += std::min(lower, upper);
+        dot_max += std::max(lower, upper);
+      }
+      // Coordinates along the axis for which the band intersects the column
+      double coord_min = (-half_width - dot_max) / normal(axis);
+      double coord_max = (half_width - dot_min) / normal(axis);
+      if (coord_min > coord_max)
+        std::swap(coord_min, coord_max);
+
+      first = last = cell;
+      if (CellRange(axis, coord_min, coord_max, first(axis), last(axis)))
+        AppendBox(first, last, candidates);
+
+      // Next column
+      int k = 0;
+      for (; k < N; ++k)
+      {
+        if (k == axis)
+          continue;
+        if (++cell(k) < resolution_(k))
+          break;
+        cell(k) = 0;
+      }
+      if (k == N)
+        break;
+    }
+  }
+
+private:
+  int CellCount() const { return resolution_.prod(); }
+
+  CellT Cell(const PointT & point) const
+  {
+    CellT cell;
+    for (int k = 0; k < N; ++k)
+      cell(k) = std::min(resolution_(k) - 1,
+        std::max(0, static_cast<int>((point(k) - origin_(k)) / cell_size_)));
+    return cell;
+  }
+
+  IndexT Flatten(const CellT & cell) const
+  {
+    IndexT index = 0;
+    for (int k = N - 1; k >= 0; --k)
+      index = index * resolution_(k) + cell(k);
+    return index;
+  }
+
+  /// Range of cells along an axis that intersect [coord_min, coord_max]
+  bool CellRange
+  (
+    const int axis,
+    const double coord_min,
+    const double coord_max,
+    int & first,
+    int & last
+  ) const
+  {
+    if (!(coord_min <= coord_max)) // Empty or undefined (NaN) range
+      return false;
+    const double cell_min = std::floor((coord_min - origin_(axis)) / cell_size_);
+    const double cell_max = std::floor((coord_max - origin_(axis)) / cell_size_);
+    if (cell_max < 0.0 || cell_min >= resolution_(axis))
+      return false;
+    first = static_cast<int>(std::max(0.0, cell_min));
+    last = static_cast<int>(std::min(resolution_(axis) - 1.0, cell_max));
+    return true;
+  }
+
+  /// Append the points of the cells [first, last] (inclusive bounds)
+  void AppendBox
+  (
+    const CellT & first,
+    const CellT & last,
+    std::vector<IndexT> & candidates
+  ) const
+  {
+    CellT cell = first;
+    while (true)
+    {
+      // The cells along the first axis are contiguous
+      const IndexT begin = cell_start_[Flatten(cell)];
+      cell(0) = last(0);
+      const IndexT end = cell_start_[Flatten(cell) + 1];
+      candidates.insert(candidates.end(), indexes_.begin() + begin, indexes_.begin() + end);
+
+      int k = 1;
+      for (; k < N; ++k)
+      {
+        if (++cell(k) <= last(k))
+          break;
+        cell(k) = first(k);
+      }
+      if (k == N)
+        break;
+      cell(0) = first(0);
+    }
+  }
+
+  double cell_size_;               // Cell edge length
+  PointT origin_;                  // Lower corner of the grid
+  CellT resolution_;               // Cell count along each axis
+  std::vector<IndexT> cell_start_; // Index of the first point of each cell (cell count + 1)
+  std::vector<IndexT> indexes_;    // Point indexes sorted by cell
+};
+
+} // namespace geometry_aware
+} // namespace openMVG
+
+#endif // OPENMVG_ROBUST_ESTIMATION_GUIDED_MATCHING_GRID_HPP
@@ -0,0 +1,193 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/multiview/essential.hpp"
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/solver_essential_eight_point.hpp"
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/robust_estimation/guided_matching.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+
+// Left regions observing the given points, and right regions observing the
+//  corresponding points (with noisy descriptors) and some distractors.
+static void MakeRegions
+(
+  const Mat2X & x1,
+  const Mat2X & x2,
+  SIFT_Regions & lRegions,
+  SIFT_Regions & rRegions
+)
+{
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::uniform_int_distribution<int> descriptor_value(0, 255);
+  std::uniform_int_distribution<int> descriptor_noise(-20, 20);
+  std::uniform_real_distribution<double> position(0.0, 1000.0);
+
+  for (Mat::Index i = 0; i < x1.cols(); ++i)
+  {
+    SIFT_Regions::DescriptorT descriptor, noisy_descriptor;
+    for (int k = 0; k < SIFT_Regions::DescriptorT::static_size; ++k)
+    {
+      descriptor[k] = descriptor_value(random_generator);
+      noisy_descriptor[k] =
+        std::min(255, std::max(0, descriptor[k] + descriptor_noise(random_generator)));
+    }
+    lRegions.Features().emplace_back(x1(0, i), x1(1, i));
+    lRegions.Descriptors().push_back(descriptor);
+    rRegions.Features().emplace_back(x2(0, i), x2(1, i));
+    rRegions.Descriptors().push_back(noisy_descriptor);
+  }
+  // Distractors
+  for (Mat::Index i = 0; i < x2.cols(); ++i)
+  {
+    SIFT_Regions::DescriptorT descriptor;
+    for (int k = 0; k < SIFT_Regions::DescriptorT::static_size; ++k)
+      descriptor[k] = descriptor_value(random_generator);
+    rRegions.Features().emplace_back(position(random_generator), position(random_generator));
+    rRegions.Descriptors().push_back(descriptor);
+  }
+}
+
+static NViewDataSet MakeDataset()
+{
+  const NViewDataSet d = NRealisticCamerasRing(2, 2000,
+    nViewDatasetConfigurator(1000, 1000, 500, 500, 5, 0));
+  return d;
+}
+
+TEST(GuidedMatching, Epipolar_Fast)
+{
+  const NViewDataSet d = MakeDataset();
+  SIFT_Regions lRegions, rRegions;
+  MakeRegions(d._x[0], d._x[1], lRegions, rRegions);
+  const Mat3 F = F_from_P(d.P(0), d.P(1));
+
+  matching::IndMatches exhaustive_matches, fast_matches;
+  geometry_aware::GuidedMatching<Mat3, fundamental::kernel::EpipolarDistanceError>(
+    F, nullptr, lRegions, nullptr, rRegions,
+    Square(4.0), Square(0.8), exhaustive_matches);
+  geometry_aware::GuidedMatching_Epipolar_Fast<fundamental::kernel::EpipolarDistanceError>(
+    F, nullptr, lRegions, nullptr, rRegions,
+    Square(4.0), Square(0.8), fast_matches);
+
+  CHECK(exhaustive_matches.size() > d._x[0].cols() / 2);
+  CHECK(exhaustive_matches == fast_matches);
+}
+
+TEST(GuidedMatching, Homography_Fast)
+{
+  // Points of a plane observed by two cameras
+  NViewDataSet d = MakeDataset();
+  d._X.row(2).setZero();
+  d._x[0] = Project(d.P(0), d._X);
+  d._x[1] = Project(d.P(1), d._X);
+  const Mat3 H =
+    d._K[1] * (Mat3() << d._R[1].col(0), d._R[1].col(1), d._t[1]).finished()
+    * ((Mat3() << d._R[0].col(0), d._R[0].col(1), d._t[0]).finished()).inverse()
+    * d._K[0].inverse();
+
+  SIFT_Regions lRegions, rRegions;
+  MakeRegions(d._x[0], d._x[1], lRegions, rRegions);
+
+  matching::IndMatches exhaustive_matches, fast_matches;
+  geometry_aware::GuidedMatching<Mat3, homography::kernel::AsymmetricError>(
+    H, nullptr, lRegions, nullptr, rRegions,
+    Square(4.0), Square(0.8), exhaustive_matches);
+  geometry_aware::GuidedMatching_Homography_Fast<homography::kernel::AsymmetricError>(
+    H, nullptr, lRegions, nullptr, rRegions,
+    Square(4.0), Square(0.8), fast_matches);
+
+  CHECK(exhaustive_matches.size() > d._x[0].cols() / 2);
+  CHECK(exhaustive_matches == fast_matches);
+}
+
+TEST(GuidedMatching, Angular_Fast)
+{
+  const NViewDataSet d = MakeDataset();
+  SIFT_Regions lRegions, rRegions;
+  MakeRegions(d._x[0], d._x[1], lRegions, rRegions);
+  Mat3 E;
+  EssentialFromRt(d._R[0], d._t[0], d._R[1], d._t[1], &E);
+
+  // Bearing vectors of all the regions
+  Mat3X lBearings(3, lRegions.RegionCount()), rBearings(3, rRegions.RegionCount());
+  for (size_t i = 0; i < lRegions.RegionCount(); ++i)
+    lBearings.col(i) = (d._K[0].inverse() * lRegions.GetRegionPosition(i).homogeneous()).normalized();
+  for (size_t j = 0; j < rRegions.RegionCount(); ++j)
+    rBearings.col(j) = (d._K[1].inverse() * rRegions.GetRegionPosition(j).homogeneous()).normalized();
+
+  const double angular_threshold = D2R(0.2);
+  matching::IndMatches exhaustive_matches, fast_matches;
+  // Exhaustive search
+  for (size_t i = 0; i < lRegions.RegionCount(); ++i)
+  {
+    geometry_aware::distanceRatio<double> dR;
+    for (size_t j = 0; j < rRegions.RegionCount(); ++j)
+    {
+      if (AngularError::Error(E, lBearings.col(i), rBearings.col(j)) < angular_threshold)
+        dR.update(j, lRegions.SquaredDescriptorDistance(i, &rRegions, j));
+    }
+    if (dR.isValid(Square(0.8)))
+      exhaustive_matches.emplace_back(i, dR.idx);
+  }
+  matching::IndMatch::getDeduplicated(exhaustive_matches);
+
+  geometry_aware::GuidedMatching_Angular_Fast<AngularError>(
+    E, lBearings, lRegions, rBearings, rRegions,
+    angular_threshold, Square(0.8), fast_matches);
+
+  CHECK(exhaustive_matches.size() > d._x[0].cols() / 2);
+  CHECK(exhaustive_matches == fast_matches);
+}
+
+// The grid returns all the points that are in the queried regions
+TEST(GuidedMatching, Points_Grid)
+{
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+  std::vector<Vec3> points(5000);
+  for (Vec3 & point : points)
+    point << coordinate(random_generator), coordinate(random_generator), coordinate(random_generator);
+  const geometry_aware::Points_Grid<3> grid(points);
+
+  std::vector<IndexT> candidates;
+  for (int query = 0; query < 20; ++query)
+  {
+    const Vec3 center(coordinate(random_generator), coordinate(random_generator), coordinate(random_generator));
+    const Vec3 normal = center.normalized();
+    const double offset = coordinate(random_generator);
+
+    candidates.clear();
+    grid.QueryBall(center, 0.3, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    for (size_t i = 0; i < points.size(); ++i)
+      if ((points[i] - center).norm() <= 0.3)
+        CHECK(std::binary_search(candidates.begin(), candidates.end(), i));
+
+    candidates.clear();
+    grid.QueryBand(normal, offset, 0.1, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    CHECK(candidates.size() < points.size() / 2);
+    for (size_t i = 0; i < points.size(); ++i)
+      if (std::abs(normal.dot(points[i]) + offset) <= 0.1)
+        CHECK(std::binary_search(candidates.begin(), candidates.end(), i));
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
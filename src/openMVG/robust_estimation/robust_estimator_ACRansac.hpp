@@ -52,6 +52,84 @@
 namespace openMVG {
 namespace robust{
 
+namespace acransac_internal {
+
+template <typename T>
+struct Void_Type { using type = void; };
+
+/// Minimal sample storage of the kernel (Kernel::Sample_Buffer if defined)
+template <typename Kernel, typename = void>
+struct Kernel_Sample_Buffer
+{
+  struct type {};
+};
+
+template <typename Kernel>
+struct Kernel_Sample_Buffer<Kernel,
+  typename Void_Type<typename Kernel::Sample_Buffer>::type>
+{
+  using type = typename Kernel::Sample_Buffer;
+};
+
+/// Fit the model(s) by using the sample storage if the kernel can use one
+template <typename Kernel, typename Buffer>
+auto Fit
+(
+  const Kernel & kernel,
+  const std::vector<uint32_t> & samples,
+  std::vector<typename Kernel::Model> * models,
+  Buffer & sample_buffer,
+  int
+) -> decltype(kernel.Fit(samples, models, sample_buffer), void())
+{
+  kernel.Fit(samples, models, sample_buffer);
+}
+
+template <typename Kernel, typename Buffer>
+void Fit
+(
+  const Kernel & kernel,
+  const std::vector<uint32_t> & samples,
+  std::vector<typename Kernel::Model> * models,
+  Buffer &,
+  long
+)
+{
+  kernel.Fit(samples, models);
+}
+
+}  // namespace acransac_internal
+
+/**
+ * @brief Preallocated buffers used by the ACRANSAC routine.
+ *
+ * Once a workspace has been used for a dataset of a given size, the next
+ *  ACRANSAC runs on datasets of the same (or a smaller) size do not perform
+ *  any heap allocation in their iterations (as long as the kernel minimal
+ *  solver does not allocate by itself).
+ * A workspace can be reused by many ACRANSAC calls, but must not be shared
+ *  by concurrent calls: use one workspace per thread.
+ */
+template <typename Kernel>
+struct ACRansac_Workspace
+{
+  /// Model hypotheses of the current iteration
+  std::vector<typename Kernel::Model> models;
+  /// Possible sampling indices & current minimal sample indices
+  std::vector<uint32_t> vec_index, vec_sample;
+  /// Residual array
+  std::vector<double> residuals;
+  /// [residual,index] array -> used in the exhaustive nfa computation mode
+  std::vector<std::pair<double,uint32_t>> sorted_residuals;
+  /// Residual histogram and bin values -> used in the quantified nfa computation mode
+  std::vector<uint32_t> histogram;
+  std::vector<double> histogram_bin_values;
+  /// Combinatorial log lookup tables
+  std::vector<float> log10_table, logc_n, logc_k;
+  /// Kernel minimal sample storage (see Kernel::Sample_Buffer)
+  typename acransac_internal::Kernel_Sample_Buffer<Kernel>::type sample_buffer;
+};
+
 namespace acransac_nfa_internal {
 
 /// logarithm (base 10) of binomial coefficient
@@ -101,12 +179,13 @@ static void makelogcombi
 (
   uint32_t k,
   uint32_t n,
+  std::vector<float> & vec_log10,
   std::vector<float> & vec_logc_k,
   std::vector<float> & vec_logc_n
 )
 {
   // compute a lookuptable of log10 value for the range [0,n+1]
-  std::vector<float> vec_log10(n + 1);
+  vec_log10.resize(n + 1);
   for (uint32_t i = 0; i <= n; ++i)
     vec_log10[i] = log10(static_cast<float>(i));
 
@@ -121,6 +200,7 @@ public:
   /**
    * @brief NFA_Interface constructor
    * @param[in] kernel Template kernel model estimator & residual error evaluation interface
+   * @param[in] workspace Storage of the residuals, histogram & lookup tables
    * @param[in] dmaxThreshold Upper bound of the residual error (default infinity)
    * @param[in] bquantified_nfa_evaluation Tell if NFA evaluation is using the quantified or exhaustive evaluation method.
    *  An upper bound different from infinity must be provided to be set to true.
@@ -128,17 +208,37 @@ public:
   NFA_Interface
   (
     const Kernel & kernel,
+    ACRansac_Workspace<Kernel> & workspace,
     const double dmaxThreshold = std::numeric_limits<double>::infinity(),
     const bool bquantified_nfa_evaluation = false
   ):
-    m_residuals(kernel.NumSamples()),
+    m_residuals(workspace.residuals),
+    m_sorted_residuals(workspace.sorted_residuals),
+    m_histogram(workspace.histogram),
+    m_histogram_bin_values(workspace.histogram_bin_values),
+    m_logc_n(workspace.logc_n),
+    m_logc_k(workspace.logc_k),
     m_kernel(kernel),
     m_bquantified_nfa_evaluation(bquantified_nfa_evaluation),
     m_max_threshold(dmaxThreshold)
   {
+    m_residuals.resize(kernel.NumSamples());
+    if (m_bquantified_nfa_evaluation)
+    {
+      // Residual values of the histogram bins
+      m_histogram.resize(NB_BINS);
+      m_histogram_bin_values.resize(NB_BINS);
+      for (int bin = 0; bin < NB_BINS; ++bin)
+        m_histogram_bin_values[bin] = m_max_threshold / (NB_BINS - 1) * bin;
+    }
+    else
+    {
+      m_sorted_residuals.reserve(kernel.NumSamples());
+    }
     // Precompute log combi
     m_loge0 = log10((double)Kernel::MAX_MODELS * (kernel.NumSamples() - Kernel::MINIMUM_SAMPLES));
-    makelogcombi(Kernel::MINIMUM_SAMPLES, kernel.NumSamples(), m_logc_k, m_logc_n);
+    makelogcombi(Kernel::MINIMUM_SAMPLES, kernel.NumSamples(),
+      workspace.log10_table, m_logc_k, m_logc_n);
   };
 
   std::vector<double> & residuals()
@@ -168,13 +268,19 @@ public:
 
 private:
 
+  /// Number of bins of the quantified nfa computation mode histogram
+  static const int NB_BINS = 20;
+
   /// residual array
-  std::vector<double> m_residuals;
+  std::vector<double> & m_residuals;
   /// [residual,index] array -> used in the exhaustive nfa computation mode
-  std::vector<std::pair<double,uint32_t>> m_sorted_residuals;
+  std::vector<std::pair<double,uint32_t>> & m_sorted_residuals;
+  /// residual histogram -> used in the quantified nfa computation mode
+  std::vector<uint32_t> & m_histogram;
+  std::vector<double> & m_histogram_bin_values;
 
   /// Combinatorial log
-  std::vector<float> m_logc_n, m_logc_k;
+  std::vector<float> & m_logc_n, & m_logc_k;
   /// A-Contrario Epsilon 0 value
   double m_loge0;
 
@@ -208,20 +314,27 @@ NFA_Interface<Kernel>::ComputeNFA_and_inliers
     // This version avoid:
     //   - to sort explicitly the residual error array,
     //   - to compute the NFA for every sample of the datum.
-    const int nBins = 20;
-    Histogram<double> histo(0.0f, m_max_threshold, nBins);
-    histo.Add(m_residuals.cbegin(), m_residuals.cend());
+    std::fill(m_histogram.begin(), m_histogram.end(), 0);
+    const double nBins_by_interval = NB_BINS / m_max_threshold;
+    for (const double residual : m_residuals)
+    {
+      if (residual >= 0.0)
+      {
+        const size_t bin = static_cast<size_t>(residual * nBins_by_interval);
+        if (bin < NB_BINS)
+          ++m_histogram[bin];
+      }
+    }
 
     // Compute NFA scoring from the cumulative histogram
 
     using nfa_thresholdT = std::pair<double,double>; // NFA and residual threshold
     nfa_thresholdT current_best_nfa(std::numeric_limits<double>::infinity(), 0.0);
     unsigned int cumulative_count = 0;
-    const std::vector<size_t> & frequencies = histo.GetHist();
-    const std::vector<double> residual_val = histo.GetXbinsValue();
-    for (int bin = 0; bin < nBins; ++bin)
+    const std::vector<double> & residual_val = m_histogram_bin_values;
+    for (int bin = 0; bin < NB_BINS; ++bin)
     {
-      cumulative_count += frequencies[bin];
+      cumulative_count += m_histogram[bin];
       if (cumulative_count > Kernel::MINIMUM_SAMPLES
           && residual_val[bin] > std::numeric_limits<float>::epsilon())
       {
@@ -258,7 +371,6 @@ NFA_Interface<Kernel>::ComputeNFA_and_inliers
     // Residuals sorting (ascending order while keeping original point indexes)
     {
       m_sorted_residuals.clear();
-      m_sorted_residuals.reserve(m_kernel.NumSamples());
       for (uint32_t i = 0; i < m_kernel.NumSamples(); ++i)
       {
         m_sorted_residuals.emplace_back(m_residuals[i], i);
@@ -313,6 +425,7 @@ NFA_Interface<Kernel>::ComputeNFA_and_inliers
  *  - The NFA is estimated by using all the residual errors.
  *
  * @param[in] kernel model and metric object
+ * @param[in,out] workspace preallocated buffers (reused from call to call)
  * @param[out] vec_inliers points that fit the estimated model
  * @param[in] nIter maximum number of consecutive iterations
  * @param[out] model returned model if found
@@ -325,6 +438,7 @@ template<typename Kernel>
 std::pair<double, double> ACRANSAC
 (
   const Kernel &kernel,
+  ACRansac_Workspace<Kernel> & workspace,
   std::vector<uint32_t> & vec_inliers,
   const unsigned int num_max_iteration = 1024,
   typename Kernel::Model * model = nullptr,
@@ -339,13 +453,21 @@ std::pair<double, double> ACRANSAC
   if (nData <= sizeSample)
     return {0.0, 0.0};
 
+  vec_inliers.reserve(nData);
+
   //--
   // Sampling:
   // Possible sampling indices [0,..,nData] (will change in the optimization phase)
-  std::vector<uint32_t> vec_index(nData);
+  std::vector<uint32_t> & vec_index = workspace.vec_index;
+  vec_index.reserve(nData);
+  vec_index.resize(nData);
   std::iota(vec_index.begin(), vec_index.end(), 0);
   // Sample indices (used for model evaluation)
-  std::vector<uint32_t> vec_sample(sizeSample);
+  std::vector<uint32_t> & vec_sample = workspace.vec_sample;
+  vec_sample.resize(sizeSample);
+  // Model hypotheses
+  std::vector<typename Kernel::Model> & vec_models = workspace.models;
+  vec_models.reserve(Kernel::MAX_MODELS);
 
   const double maxThreshold = (precision == std::numeric_limits<double>::infinity()) ?
     std::numeric_limits<double>::infinity() :
@@ -354,7 +476,7 @@ std::pair<double, double> ACRANSAC
   // Initialize the NFA computation interface
   // (quantified NFA computation is used if a valid upper bound is provided)
   acransac_nfa_internal::NFA_Interface<Kernel> nfa_interface
-    (kernel, maxThreshold, (precision != std::numeric_limits<double>::infinity()));
+    (kernel, workspace, maxThreshold, (precision != std::numeric_limits<double>::infinity()));
 
   // Output parameters
   double minNFA = std::numeric_limits<double>::infinity();
@@ -388,8 +510,8 @@ std::pair<double, double> ACRANSAC
       UniformSample(sizeSample, nData, random_generator, &vec_sample);
 
     // Fit model(s). Can find up to Kernel::MAX_MODELS solution(s)
-    std::vector<typename Kernel::Model> vec_models;
-    kernel.Fit(vec_sample, &vec_models);
+    vec_models.clear();
+    acransac_internal::Fit(kernel, vec_sample, &vec_models, workspace.sample_buffer, 0);
 
     // Evaluate model(s)
     bool better = false;
@@ -486,6 +608,36 @@ std::pair<double, double> ACRANSAC
   return {errorMax, minNFA};
 }
 
+/**
+ * @brief ACRANSAC routine (ErrorThreshold, NFA)
+ * Convenience overload that uses a temporary workspace
+ *  (prefer the workspace version when many estimations are run in a row).
+ *
+ * @param[in] kernel model and metric object
+ * @param[out] vec_inliers points that fit the estimated model
+ * @param[in] nIter maximum number of consecutive iterations
+ * @param[out] model returned model if found
+ * @param[in] precision upper bound of the precision (squared error)
+ * @param[in] bVerbose display console log
+ *
+ * @return (errorMax, minNFA)
+ */
+template<typename Kernel>
+std::pair<double, double> ACRANSAC
+(
+  const Kernel &kernel,
+  std::vector<uint32_t> & vec_inliers,
+  const unsigned int num_max_iteration = 1024,
+  typename Kernel::Model * model = nullptr,
+  double precision = std::numeric_limits<double>::infinity(),
+  bool bVerbose = false
+)
+{
+  ACRansac_Workspace<Kernel> workspace;
+  return ACRANSAC(kernel, workspace, vec_inliers,
+    num_max_iteration, model, precision, bVerbose);
+}
+
 } // namespace robust
 } // namespace openMVG
 #endif // OPENMVG_ROBUST_ESTIMATOR_ACRANSAC_HPP
@@ -25,12 +25,19 @@
 // Mainly it add correct data normalization and define the required functions
 //  by the ACRANSAC algorithm.
 //
+// If the error functor provides a batched evaluation (ErrorT::Errors), the
+//  adaptors keep a Structure of Arrays copy of the data and compute all the
+//  residuals at once (SIMD evaluation).
+//
 
+#include <type_traits>
 #include <vector>
 
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/multiview/conditioning.hpp"
 #include "openMVG/multiview/essential.hpp"
 #include "openMVG/numeric/extract_columns.hpp"
+#include "openMVG/numeric/numeric.h"
 
 namespace openMVG {
 namespace robust{
@@ -42,6 +49,24 @@ enum AContrarioParametrizationType
   RADIAN_ANGLE = 2
 };
 
+/// Storage of the minimal sample given to a two view solver
+///  (the sample matrix types are deduced from the Solver::Solve signature:
+///   static void Solve(const T1 & x1, const T2 & x2, std::vector<Model> * models, ...))
+/// It is reused from iteration to iteration to avoid memory allocations.
+template <typename Solver>
+struct Minimal_Sample_Buffer
+{
+private:
+  template <typename T1, typename T2, typename... Args>
+  static T1 First_Sample_Type(void (*)(const T1 &, const T2 &, Args...));
+  template <typename T1, typename T2, typename... Args>
+  static T2 Second_Sample_Type(void (*)(const T1 &, const T2 &, Args...));
+
+public:
+  decltype(First_Sample_Type(&Solver::Solve)) x1;
+  decltype(Second_Sample_Type(&Solver::Solve)) x2;
+};
+
 template <int PARAMETRIZATION = AContrarioParametrizationType::POINT_TO_LINE>
 struct ACParametrizationHelper
 {
@@ -127,6 +152,11 @@ public:
 
     NormalizePoints(x1, &x1_, &N1_, w1, h1);
     NormalizePoints(x2, &x2_, &N2_, w2, h2);
+    if (Has_Batched_Errors<ErrorT>::value)
+    {
+      x1_soa_ = x1_;
+      x2_soa_ = x2_;
+    }
 
     // LogAlpha0 is used to make error data scale invariant
     logalpha0_ =
@@ -138,15 +168,28 @@ public:
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
+  using Sample_Buffer = Minimal_Sample_Buffer<Solver>;
+
+  void Fit
+  (
+    const std::vector<uint32_t> &samples,
+    std::vector<Model> *models,
+    Sample_Buffer & sample_buffer
+  ) const
+  {
+    ExtractColumns(x1_, samples, &sample_buffer.x1);
+    ExtractColumns(x2_, samples, &sample_buffer.x2);
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2, models);
+  }
+
   void Fit
   (
     const std::vector<uint32_t> &samples,
     std::vector<Model> *models
   ) const
   {
-    const auto x1 = ExtractColumns(x1_, samples);
-    const auto x2 = ExtractColumns(x2_, samples);
-    Solver::Solve(x1, x2, models);
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
   }
 
   double Error
@@ -165,8 +208,7 @@ public:
   ) const
   {
     vec_errors.resize(x1_.cols());
-    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(model, x1_.col(sample), x2_.col(sample));
+    Errors(model, vec_errors.data(), Has_Batched_Errors<ErrorT>());
   }
 
   size_t NumSamples() const
@@ -194,7 +236,21 @@ public:
   double unormalizeError(double val) const {return sqrt(val) / N2_(0,0);}
 
 private:
+  // Batched residual evaluation
+  void Errors(const Model & model, double * errors, std::true_type) const
+  {
+    ErrorT::Errors(model, x1_soa_, x2_soa_, errors);
+  }
+
+  // Per correspondence residual evaluation
+  void Errors(const Model & model, double * errors, std::false_type) const
+  {
+    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
+      errors[sample] = ErrorT::Error(model, x1_.col(sample), x2_.col(sample));
+  }
+
   Mat x1_, x2_;       // Normalized input data
+  Mat2X_SoA x1_soa_, x2_soa_; // Normalized input data SoA copy (batched residuals)
   Mat3 N1_, N2_;      // Matrix used to normalize data
   double logalpha0_;  // Alpha0 is used to make the error adaptive to the image size
   bool bPointToLine_; // Store if error model is pointToLine or point to point
@@ -235,20 +291,38 @@ public:
     assert(x2d_.cols() == x3D_.cols());
 
     NormalizePoints(x2d, &x2d_, &N1_, w, h);
+    if (Has_Batched_Errors<ErrorT>::value)
+    {
+      x2d_soa_ = x2d_;
+      x3D_soa_ = x3D_;
+    }
   }
 
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
+  using Sample_Buffer = Minimal_Sample_Buffer<Solver>;
+
+  void Fit
+  (
+    const std::vector<uint32_t> &samples,
+    std::vector<Model> *models,
+    Sample_Buffer & sample_buffer
+  ) const
+  {
+    ExtractColumns(x2d_, samples, &sample_buffer.x1);
+    ExtractColumns(x3D_, samples, &sample_buffer.x2);
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2, models);
+  }
+
   void Fit
   (
     const std::vector<uint32_t> &samples,
     std::vector<Model> *models
   ) const
   {
-    const auto x1 = ExtractColumns(x2d_, samples);
-    const auto x2 = ExtractColumns(x3D_, samples);
-    Solver::Solve(x1, x2, models);
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
   }
 
   double Error(uint32_t sample, const Model &model) const
@@ -263,8 +337,7 @@ public:
   ) const
   {
     vec_errors.resize(x2d_.cols());
-    for (uint32_t sample = 0; sample < x2d_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(model, x2d_.col(sample), x3D_.col(sample));
+    Errors(model, vec_errors.data(), Has_Batched_Errors<ErrorT>());
   }
 
   size_t NumSamples() const { return x2d_.cols(); }
@@ -281,8 +354,23 @@ public:
   double unormalizeError(double val) const {return sqrt(val) / N1_(0,0);}
 
 private:
+  // Batched residual evaluation
+  void Errors(const Model & model, double * errors, std::true_type) const
+  {
+    ErrorT::Errors(model, x2d_soa_, x3D_soa_, errors);
+  }
+
+  // Per correspondence residual evaluation
+  void Errors(const Model & model, double * errors, std::false_type) const
+  {
+    for (uint32_t sample = 0; sample < x2d_.cols(); ++sample)
+      errors[sample] = ErrorT::Error(model, x2d_.col(sample), x3D_.col(sample));
+  }
+
   Mat x2d_;
   const Mat & x3D_;
+  Mat2X_SoA x2d_soa_; // Normalized 2d points SoA copy (batched residuals)
+  Mat3X_SoA x3D_soa_; // 3d points SoA copy (batched residuals)
   Mat3 N1_;          // Matrix used to normalize data
   double logalpha0_; // Alpha0 is used to make the error adaptive to the image size
 };
@@ -320,20 +408,38 @@ public:
     assert(bearing1_.cols() == bearing2_.cols());
 
     logalpha0_ = ACParametrizationHelper<AContrarioParametrizationType::POINT_TO_LINE>::LogAlpha0(w2, h2, 0.5);
+    if (Has_Batched_Errors<ErrorT>::value)
+    {
+      x1_soa_ = x1_;
+      x2_soa_ = x2_;
+    }
   }
 
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
+  using Sample_Buffer = Minimal_Sample_Buffer<Solver>;
+
+  void Fit
+  (
+    const std::vector<uint32_t> &samples,
+    std::vector<Model> *models,
+    Sample_Buffer & sample_buffer
+  ) const
+  {
+    ExtractColumns(bearing1_, samples, &sample_buffer.x1);
+    ExtractColumns(bearing2_, samples, &sample_buffer.x2);
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2, models);
+  }
+
   void Fit
   (
     const std::vector<uint32_t> &samples,
     std::vector<Model> *models
   ) const
   {
-    const auto x1 = ExtractColumns(bearing1_, samples);
-    const auto x2 = ExtractColumns(bearing2_, samples);
-    Solver::Solve(x1, x2, models);
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
   }
 
   double Error
@@ -356,8 +462,7 @@ public:
     Mat3 F;
     FundamentalFromEssential(model, K1_, K2_, &F);
     vec_errors.resize(x1_.cols());
-    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(F, this->x1_.col(sample), this->x2_.col(sample));
+    Errors(F, vec_errors.data(), Has_Batched_Errors<ErrorT>());
   }
 
   size_t NumSamples() const { return x1_.cols(); }
@@ -369,7 +474,21 @@ public:
   double unormalizeError(double val) const { return val; }
 
 private:
+  // Batched residual evaluation
+  void Errors(const Mat3 & F, double * errors, std::true_type) const
+  {
+    ErrorT::Errors(F, x1_soa_, x2_soa_, errors);
+  }
+
+  // Per correspondence residual evaluation
+  void Errors(const Mat3 & F, double * errors, std::false_type) const
+  {
+    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
+      errors[sample] = ErrorT::Error(F, x1_.col(sample), x2_.col(sample));
+  }
+
   Mat2X x1_, x2_;             // image points
+  Mat2X_SoA x1_soa_, x2_soa_; // image points SoA copy (batched residuals)
   Mat3X bearing1_, bearing2_; // bearing vectors
   Mat3 N1_, N2_;              // Matrix used to normalize data
   double logalpha0_;          // Alpha0 is used to make the error adaptive to the image size
@@ -410,15 +529,28 @@ public:
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
+  using Sample_Buffer = Minimal_Sample_Buffer<Solver>;
+
+  void Fit
+  (
+    const std::vector<uint32_t> &samples,
+    std::vector<Model> *models,
+    Sample_Buffer & sample_buffer
+  ) const
+  {
+    ExtractColumns(bearing1_, samples, &sample_buffer.x1);
+    ExtractColumns(bearing2_, samples, &sample_buffer.x2);
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2, models);
+  }
+
   void Fit
   (
     const std::vector<uint32_t> &samples,
     std::vector<Model> *models
   ) const
   {
-    const auto x1 = ExtractColumns(bearing1_, samples);
-    const auto x2 = ExtractColumns(bearing2_, samples);
-    Solver::Solve(x1, x2, models);
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
   }
 
   double Error
@@ -480,20 +612,38 @@ public:
     assert(3 == x1_.rows());
     assert(x1_.rows() == x2_.rows());
     assert(x1_.cols() == x2_.cols());
+    if (Has_Batched_Errors<ErrorT>::value)
+    {
+      x1_soa_ = x1_;
+      x2_soa_ = x2_;
+    }
   }
 
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
+  using Sample_Buffer = Minimal_Sample_Buffer<Solver>;
+
+  void Fit
+  (
+    const std::vector<uint32_t> &samples,
+    std::vector<Model> *models,
+    Sample_Buffer & sample_buffer
+  ) const
+  {
+    ExtractColumns(x1_, samples, &sample_buffer.x1);
+    ExtractColumns(x2_, samples, &sample_buffer.x2);
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2, models);
+  }
+
   void Fit
   (
     const std::vector<uint32_t> &samples,
     std::vector<Model> *models
   ) const
   {
-    const Mat x1 = ExtractColumns(x1_, samples);
-    const Mat x2 = ExtractColumns(x2_, samples);
-    Solver::Solve(x1, x2, models);
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
   }
 
   double Error
@@ -512,8 +662,7 @@ public:
   ) const
   {
     vec_errors.resize(x1_.cols());
-    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
-      vec_errors[sample] = Square(ErrorT::Error(model, x1_.col(sample), x2_.col(sample)));
+    Errors(model, vec_errors.data(), Has_Batched_Errors<ErrorT>());
   }
 
   size_t NumSamples() const
@@ -534,7 +683,23 @@ public:
   double unormalizeError(double val) const {return sqrt(val);}
 
 private:
+  // Batched residual evaluation
+  void Errors(const Model & model, double * errors, std::true_type) const
+  {
+    ErrorT::Errors(model, x1_soa_, x2_soa_, errors);
+    for (Mat::Index sample = 0; sample < x1_.cols(); ++sample)
+      errors[sample] = Square(errors[sample]);
+  }
+
+  // Per correspondence residual evaluation
+  void Errors(const Model & model, double * errors, std::false_type) const
+  {
+    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
+      errors[sample] = Square(ErrorT::Error(model, x1_.col(sample), x2_.col(sample)));
+  }
+
   Mat x1_, x2_;       // Normalized input data
+  Mat3X_SoA x1_soa_, x2_soa_; // Bearing vectors SoA copy (batched residuals)
   double logalpha0_;  // Alpha0 is used to make the error scale invariant
 };
 
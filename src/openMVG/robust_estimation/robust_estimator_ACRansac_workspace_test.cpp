@@ -0,0 +1,141 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/multiview/conditioning.hpp"
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::robust;
+
+//-- Count the heap allocations done by the test executable
+static std::atomic<size_t> allocation_count(0);
+
+void * operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void * ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+using KernelType =
+  ACKernelAdaptor<
+    fundamental::kernel::SevenPointSolver,
+    fundamental::kernel::EpipolarDistanceError,
+    UnnormalizerT,
+    Mat3>;
+
+// Two views of a random scene, with 30% of outliers
+static void MakeDataset(Mat2X & x1, Mat2X & x2)
+{
+  const NViewDataSet d = NRealisticCamerasRing(2, 200);
+  x1 = d._x[0];
+  x2 = d._x[1];
+
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+  for (Mat::Index i = 0; i < x2.cols(); i += 3)
+    x2.col(i) << distribution(random_generator), distribution(random_generator);
+}
+
+// Results of an ACRANSAC run with a temporary workspace (reference)
+//  and of an ACRANSAC run with a warmed up workspace
+struct Workspace_Run
+{
+  size_t allocation_count = 0; // heap allocations done by the workspace run
+  std::pair<double, double> ACRansacOut_ref, ACRansacOut;
+  std::vector<uint32_t> vec_inliers_ref, vec_inliers;
+  Mat3 F_ref, F;
+};
+
+static Workspace_Run RunACRansac(const double precision)
+{
+  Mat2X x1, x2;
+  MakeDataset(x1, x2);
+  const KernelType kernel(x1, 1000, 1000, x2, 1000, 1000, true);
+
+  Workspace_Run run;
+  run.ACRansacOut_ref =
+    ACRANSAC(kernel, run.vec_inliers_ref, 1024, &run.F_ref, precision, false);
+
+  ACRansac_Workspace<KernelType> workspace;
+  // Warm up: the workspace buffers get their final capacity
+  ACRANSAC(kernel, workspace, run.vec_inliers, 1024, &run.F, precision, false);
+
+  const size_t allocation_count_before = allocation_count;
+  run.ACRansacOut =
+    ACRANSAC(kernel, workspace, run.vec_inliers, 1024, &run.F, precision, false);
+  run.allocation_count = allocation_count - allocation_count_before;
+  return run;
+}
+
+TEST(ACRansacWorkspace, AllocationFree_ExhaustiveNFA)
+{
+  const Workspace_Run run = RunACRansac(std::numeric_limits<double>::infinity());
+  EXPECT_EQ(0, run.allocation_count);
+
+  // The workspace version gives the same result
+  CHECK(!run.vec_inliers_ref.empty());
+  CHECK(run.vec_inliers_ref == run.vec_inliers);
+  EXPECT_EQ(run.ACRansacOut_ref.first, run.ACRansacOut.first);
+  EXPECT_EQ(run.ACRansacOut_ref.second, run.ACRansacOut.second);
+  EXPECT_MATRIX_NEAR(run.F_ref, run.F, 1e-8);
+}
+
+TEST(ACRansacWorkspace, AllocationFree_QuantifiedNFA)
+{
+  const Workspace_Run run = RunACRansac(4.0);
+  EXPECT_EQ(0, run.allocation_count);
+
+  // The workspace version gives the same result
+  CHECK(!run.vec_inliers_ref.empty());
+  CHECK(run.vec_inliers_ref == run.vec_inliers);
+  EXPECT_EQ(run.ACRansacOut_ref.first, run.ACRansacOut.first);
+  EXPECT_EQ(run.ACRansacOut_ref.second, run.ACRansacOut.second);
+  EXPECT_MATRIX_NEAR(run.F_ref, run.F, 1e-8);
+}
+
+// The temporary Fit storage is the same as the reused one
+TEST(ACRansacWorkspace, Fit_SampleBuffer)
+{
+  Mat2X x1, x2;
+  MakeDataset(x1, x2);
+  const KernelType kernel(x1, 1000, 1000, x2, 1000, 1000, true);
+
+  KernelType::Sample_Buffer sample_buffer;
+  const std::vector<uint32_t> samples = {1, 2, 4, 5, 7, 8, 10};
+  for (int i = 0; i < 2; ++i)
+  {
+    std::vector<Mat3> models, models_buffer;
+    kernel.Fit(samples, &models);
+    kernel.Fit(samples, &models_buffer, sample_buffer);
+    EXPECT_EQ(7, sample_buffer.x1.cols());
+    EXPECT_EQ(models.size(), models_buffer.size());
+    for (size_t j = 0; j < models.size(); ++j)
+      EXPECT_MATRIX_NEAR(models[j], models_buffer[j], 1e-8);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -68,10 +68,7 @@ template <typename Kernel>
     for (const auto& model_it : models)
     {
       //Compute Residuals :
-      for (uint32_t l = 0; l < total_samples; ++l)
-      {
-        residuals[l] = kernel.Error(l, model_it);
-      }
+      ComputeErrors(kernel, model_it, residuals);
 
       // Compute median
       const auto itMedian = residuals.begin() +
@@ -31,6 +31,8 @@
 #define OPENMVG_ROBUST_RANSAC_TOOLS_HPP
 
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 namespace openMVG {
 namespace robust{
@@ -56,6 +58,43 @@ inline size_t IterationsRequired(
     std::log(1.0 - std::pow(inlier_ratio, static_cast<int>(min_samples))));
 }
 
+/// Compute the residual errors of a model for all the kernel samples
+///  with the kernel batched evaluation (Kernel::Errors(Model, std::vector<double>&))
+template <typename Kernel>
+inline auto ComputeErrors(
+  const Kernel &kernel,
+  const typename Kernel::Model &model,
+  std::vector<double> &errors,
+  int) -> decltype(kernel.Errors(model, errors), void())
+{
+  kernel.Errors(model, errors);
+}
+
+/// Compute the residual errors of a model for all the kernel samples
+///  (fallback to the per sample evaluation: Kernel::Error(int, Model))
+template <typename Kernel>
+inline void ComputeErrors(
+  const Kernel &kernel,
+  const typename Kernel::Model &model,
+  std::vector<double> &errors,
+  long)
+{
+  errors.resize(kernel.NumSamples());
+  for (uint32_t sample = 0; sample < errors.size(); ++sample)
+    errors[sample] = kernel.Error(sample, model);
+}
+
+/// Compute the residual errors of a model for all the kernel samples
+///  (use the kernel batched evaluation if any)
+template <typename Kernel>
+inline void ComputeErrors(
+  const Kernel &kernel,
+  const typename Kernel::Model &model,
+  std::vector<double> &errors)
+{
+  ComputeErrors(kernel, model, errors, 0);
+}
+
 } // namespace robust
 } // namespace openMVG
 
@@ -10,6 +10,8 @@
 
 #include <vector>
 
+#include "openMVG/robust_estimation/robust_ransac_tools.hpp"
+
 namespace openMVG {
 namespace robust{
 
@@ -26,8 +28,15 @@ public:
     std::vector<T> *inliers) const
   {
     double cost = 0.0;
+    // If all the samples are evaluated, compute the residuals at once
+    //  (the kernel can use a batched residual evaluation)
+    std::vector<double> errors;
+    const bool all_samples = samples.size() == kernel.NumSamples();
+    if (all_samples)
+      ComputeErrors(kernel, model, errors);
     for (size_t j = 0; j < samples.size(); ++j) {
-      const double error = kernel.Error(samples[j], model);
+      const double error =
+        all_samples ? errors[samples[j]] : kernel.Error(samples[j], model);
       if (error < threshold_) {
         cost += error;
         inliers->push_back(samples[j]);
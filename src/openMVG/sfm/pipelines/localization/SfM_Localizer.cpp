@@ -11,6 +11,7 @@
 #include "openMVG/cameras/Camera_Common.hpp"
 #include "openMVG/cameras/Camera_Intrinsics.hpp"
 #include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/multiview/batched_residuals.hpp"
 #include "openMVG/multiview/solver_resection_kernel.hpp"
 #include "openMVG/multiview/solver_resection_p3p.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
@@ -56,12 +57,21 @@ public:
   enum { MINIMUM_SAMPLES = Solver::MINIMUM_SAMPLES };
   enum { MAX_MODELS = Solver::MAX_MODELS };
 
-  void Fit(const std::vector<uint32_t> &samples, std::vector<Model> *models) const {
-    Solver::Solve(ExtractColumns(bearing_vectors_, samples), // bearing vectors
-                  ExtractColumns(x3D_, samples), // 3D points
+  using Sample_Buffer = robust::Minimal_Sample_Buffer<Solver>;
+
+  void Fit(const std::vector<uint32_t> &samples, std::vector<Model> *models,
+           Sample_Buffer & sample_buffer) const {
+    ExtractColumns(bearing_vectors_, samples, &sample_buffer.x1); // bearing vectors
+    ExtractColumns(x3D_, samples, &sample_buffer.x2); // 3D points
+    Solver::Solve(sample_buffer.x1, sample_buffer.x2,
                   models); // Found model hypothesis
   }
 
+  void Fit(const std::vector<uint32_t> &samples, std::vector<Model> *models) const {
+    Sample_Buffer sample_buffer;
+    Fit(samples, models, sample_buffer);
+  }
+
   void Errors(const Model & model, std::vector<double> & vec_errors) const
   {
     // Convert the found model into a Pose3
@@ -111,6 +121,10 @@ namespace sfm {
       const Vec2 x = Project(P, pt3D);
       return (x - pt2D).squaredNorm();
     }
+    // Compute the residuals of all the correspondences at once
+    static void Errors(const Mat34 & P, const Mat2X_SoA & pt2D, const Mat3X_SoA & pt3D, double * errors) {
+      batched_residuals::ReprojectionErrors(P, pt2D, pt3D, errors);
+    }
   };
 
   bool SfM_Localizer::Localize
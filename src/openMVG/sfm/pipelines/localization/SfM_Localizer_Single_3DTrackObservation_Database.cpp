@@ -9,18 +9,228 @@
 #include "openMVG/sfm/pipelines/localization/SfM_Localizer_Single_3DTrackObservation_Database.hpp"
 
 #include "openMVG/cameras/Camera_Intrinsics.hpp"
+#include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/geometry/frustum.hpp"
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <set>
+
 using namespace openMVG::matching;
 
 namespace openMVG {
 namespace sfm {
 
+namespace {
+
+// Database index file:
+//  - a Localization_Database_Header,
+//  - descriptor_count * uint32 landmark ids (landmark of each descriptor).
+// The descriptors and the matcher structure are stored next to it
+//  (filename.regions and filename.matcher).
+// Values are stored in the host byte order.
+struct Localization_Database_Header
+{
+  char magic[8];              // LOCALIZATION_DATABASE_MAGIC
+  uint32_t version;           // LOCALIZATION_DATABASE_VERSION
+  uint32_t matcher_type;      // matching::EMatcherType
+  uint64_t descriptor_count;
+  uint64_t descriptor_length;
+  uint64_t landmark_count;    // number of landmarks of the described scene
+  uint64_t scene_hash;        // SceneHash of the described scene landmarks
+  uint32_t max_descriptors_per_landmark; // Landmark_Pruning_Options
+  uint32_t min_landmarks_per_view;
+};
+
+const char LOCALIZATION_DATABASE_MAGIC[8] = {'O', 'M', 'V', 'G', 'L', 'O', 'C', '\0'};
+const uint32_t LOCALIZATION_DATABASE_VERSION = 2;
+
+// FNV-1a hash of some bytes
+uint64_t HashBytes(const void * data, const size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+  const unsigned char * bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Hash of the landmarks of a scene (ids, positions and observed features),
+//  independent of the landmarks and observations storage order
+uint64_t SceneHash(const Landmarks & landmarks)
+{
+  uint64_t scene_hash = 0;
+  for (const auto & landmark : landmarks)
+  {
+    uint64_t hash = HashBytes(&landmark.first, sizeof(landmark.first));
+    hash = HashBytes(landmark.second.X.data(), 3 * sizeof(double), hash);
+    std::vector<std::pair<IndexT, IndexT>> observations;
+    observations.reserve(landmark.second.obs.size());
+    for (const auto & observation : landmark.second.obs)
+      observations.emplace_back(observation.first, observation.second.id_feat);
+    std::sort(observations.begin(), observations.end());
+    for (const auto & observation : observations)
+    {
+      hash = HashBytes(&observation.first, sizeof(observation.first), hash);
+      hash = HashBytes(&observation.second, sizeof(observation.second), hash);
+    }
+    scene_hash += hash;
+  }
+  return scene_hash;
+}
+
+std::string RegionsFilename(const std::string & filename)
+{
+  return filename + ".regions";
+}
+
+std::string MatcherFilename(const std::string & filename)
+{
+  return filename + ".matcher";
+}
+
+} // namespace
+
+std::vector<size_t> SelectRepresentativeDescriptors
+(
+  const features::Regions & regions,
+  const size_t max_count
+)
+{
+  const size_t count = regions.RegionCount();
+  std::vector<size_t> selected;
+  if (max_count == 0 || count <= max_count)
+  {
+    selected.resize(count);
+    std::iota(selected.begin(), selected.end(), 0);
+    return selected;
+  }
+
+  // The distances are computed on the fly (no count * count distance matrix
+  //  for the long tracks)
+  const auto distance = [&](const size_t i, const size_t j)
+  {
+    return std::sqrt(regions.SquaredDescriptorDistance(i, &regions, j));
+  };
+
+  // Medoid: the descriptor with the smallest sum of distances to the others
+  std::vector<double> distance_sums(count, 0.0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count; ++j)
+    {
+      const double d = distance(i, j);
+      distance_sums[i] += d;
+      distance_sums[j] += d;
+    }
+  }
+  const size_t medoid = std::distance(distance_sums.cbegin(),
+    std::min_element(distance_sums.cbegin(), distance_sums.cend()));
+  selected.push_back(medoid);
+
+  // k-centers: distance of each descriptor to its nearest selected descriptor
+  std::vector<double> nearest(count);
+  for (size_t i = 0; i < count; ++i)
+    nearest[i] = distance(medoid, i);
+  while (selected.size() < max_count)
+  {
+    const size_t farthest = std::distance(nearest.cbegin(),
+      std::max_element(nearest.cbegin(), nearest.cend()));
+    if (nearest[farthest] <= 0.0)
+      break; // the remaining descriptors are duplicates
+    selected.push_back(farthest);
+    for (size_t i = 0; i < count; ++i)
+      nearest[i] = std::min(nearest[i], distance(farthest, i));
+  }
+  return selected;
+}
+
+std::set<IndexT> SelectCoveringLandmarks
+(
+  const Landmarks & landmarks,
+  const uint32_t min_landmarks_per_view
+)
+{
+  // Views of each landmark and number of landmarks still required per view
+  Hash_Map<IndexT, std::vector<IndexT>> landmark_views;
+  Hash_Map<IndexT, uint32_t> view_need;
+  for (const auto & landmark : landmarks)
+  {
+    std::vector<IndexT> & views = landmark_views[landmark.first];
+    for (const auto & observation : landmark.second.obs)
+    {
+      if (observation.second.id_feat != UndefinedIndexT)
+      {
+        views.push_back(observation.first);
+        ++view_need[observation.first];
+      }
+    }
+  }
+  for (auto & need : view_need)
+    need.second = std::min(need.second, min_landmarks_per_view);
+
+  const auto gain = [&](const IndexT landmark_id)
+  {
+    uint32_t covered = 0;
+    for (const IndexT view_id : landmark_views.at(landmark_id))
+      covered += (view_need.at(view_id) > 0) ? 1 : 0;
+    return covered;
+  };
+
+  // Lazy greedy: the gains can only decrease, so a popped landmark whose gain
+  //  is still up to date is the best one.
+  std::priority_queue<std::pair<uint32_t, IndexT>> queue;
+  for (const auto & landmark : landmark_views)
+  {
+    if (!landmark.second.empty())
+      queue.emplace(static_cast<uint32_t>(landmark.second.size()), landmark.first);
+  }
+  std::set<IndexT> selected;
+  while (!queue.empty())
+  {
+    const std::pair<uint32_t, IndexT> top = queue.top();
+    queue.pop();
+    const uint32_t current_gain = gain(top.second);
+    if (current_gain == 0)
+      continue;
+    if (current_gain < top.first)
+    {
+      queue.emplace(current_gain, top.second);
+      continue;
+    }
+    selected.insert(top.second);
+    for (const IndexT view_id : landmark_views.at(top.second))
+    {
+      uint32_t & need = view_need.at(view_id);
+      if (need > 0)
+        --need;
+    }
+  }
+  return selected;
+}
+
   SfM_Localization_Single_3DTrackObservation_Database::
-  SfM_Localization_Single_3DTrackObservation_Database()
-  :SfM_Localizer()
+  SfM_Localization_Single_3DTrackObservation_Database
+  (
+    matching::EMatcherType matcher_type,
+    const Landmark_Pruning_Options & pruning_options
+  )
+  :SfM_Localizer(),
+   matcher_type_(matcher_type),
+   pruning_options_(pruning_options),
+   sfm_data_(nullptr)
   {}
 
   bool
@@ -42,28 +252,87 @@ namespace sfm {
     // - each view observation leads to a new regions
     // - link each observation region to a track id to ease 2D-3D correspondences search
 
+    // - optionally, only a covisibility-greedy subset of landmarks is kept
+    // - optionally, only some representative descriptors of each landmark are kept
+
+    std::set<IndexT> covering_landmarks;
+    if (pruning_options_.min_landmarks_per_view > 0)
+    {
+      covering_landmarks = SelectCoveringLandmarks(
+        sfm_data.GetLandmarks(), pruning_options_.min_landmarks_per_view);
+    }
+
     landmark_observations_descriptors_.reset(regions_provider.getRegionsType()->EmptyClone());
+    index_to_landmark_id_.clear();
+    size_t observation_count = 0, landmark_count = 0;
+    std::unique_ptr<features::Regions> landmark_descriptors(
+      regions_provider.getRegionsType()->EmptyClone());
     for (const auto & landmark : sfm_data.GetLandmarks())
     {
-      for (const auto & observation : landmark.second.obs)
+      const size_t landmark_observation_count = std::count_if(
+        landmark.second.obs.cbegin(), landmark.second.obs.cend(),
+        [](const Observations::value_type & observation)
+        { return observation.second.id_feat != UndefinedIndexT; });
+      observation_count += landmark_observation_count;
+      if (landmark_observation_count == 0
+          || (pruning_options_.min_landmarks_per_view > 0 && covering_landmarks.count(landmark.first) == 0))
+      {
+        continue;
+      }
+      ++landmark_count;
+
+      if (pruning_options_.max_descriptors_per_landmark == 0)
       {
-        if (observation.second.id_feat != UndefinedIndexT)
+        for (const auto & observation : landmark.second.obs)
+        {
+          if (observation.second.id_feat != UndefinedIndexT)
+          {
+            // copy the feature/descriptor to landmark_observations_descriptors
+            const std::shared_ptr<features::Regions> view_regions = regions_provider.get(observation.first);
+            view_regions->CopyRegion(observation.second.id_feat, landmark_observations_descriptors_.get());
+            // link this descriptor to the track Id
+            index_to_landmark_id_.push_back(landmark.first);
+          }
+        }
+      }
+      else
+      {
+        // gather the landmark descriptors and keep the representative ones
+        landmark_descriptors.reset(regions_provider.getRegionsType()->EmptyClone());
+        for (const auto & observation : landmark.second.obs)
+        {
+          if (observation.second.id_feat != UndefinedIndexT)
+          {
+            const std::shared_ptr<features::Regions> view_regions = regions_provider.get(observation.first);
+            view_regions->CopyRegion(observation.second.id_feat, landmark_descriptors.get());
+          }
+        }
+        for (const size_t i : SelectRepresentativeDescriptors(
+               *landmark_descriptors, pruning_options_.max_descriptors_per_landmark))
         {
-          // copy the feature/descriptor to landmark_observations_descriptors
-          const std::shared_ptr<features::Regions> view_regions = regions_provider.get(observation.first);
-          view_regions->CopyRegion(observation.second.id_feat, landmark_observations_descriptors_.get());
-          // link this descriptor to the track Id
+          landmark_descriptors->CopyRegion(i, landmark_observations_descriptors_.get());
           index_to_landmark_id_.push_back(landmark.first);
         }
       }
     }
     std::cout << "Init retrieval database ... " << std::endl;
+    if (pruning_options_.max_descriptors_per_landmark > 0 || pruning_options_.min_landmarks_per_view > 0)
+    {
+      std::cout << "Database pruning:\n"
+        << "#landmarks: " << landmark_count << " kept out of " << sfm_data.GetLandmarks().size() << "\n"
+        << "#descriptors: " << index_to_landmark_id_.size() << " kept out of " << observation_count
+        << " (size reduced by a factor "
+        << (index_to_landmark_id_.empty() ? 0.0 : double(observation_count) / index_to_landmark_id_.size())
+        << ")" << std::endl;
+    }
     // Initialize the matching interface
     matching_interface_ =
-      RegionMatcherFactory(matching::ANN_L2, *landmark_observations_descriptors_);
+      RegionMatcherFactory(matcher_type_, *landmark_observations_descriptors_);
     if (!matching_interface_)
       return false;
 
+    InitLandmarkDescriptorIndexes(sfm_data);
+
     std::cout << "Retrieval database initialized with:\n"
       << "#landmarks: " << sfm_data.GetLandmarks().size() << "\n"
       << "#descriptors: " << landmark_observations_descriptors_->RegionCount() << std::endl;
@@ -73,6 +342,147 @@ namespace sfm {
     return true;
   }
 
+  bool
+  SfM_Localization_Single_3DTrackObservation_Database::Save
+  (
+    const std::string & filename
+  ) const
+  {
+    if (!sfm_data_ || !matching_interface_)
+    {
+      return false;
+    }
+
+    Localization_Database_Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, LOCALIZATION_DATABASE_MAGIC, sizeof(header.magic));
+    header.version = LOCALIZATION_DATABASE_VERSION;
+    header.matcher_type = static_cast<uint32_t>(matcher_type_);
+    header.descriptor_count = index_to_landmark_id_.size();
+    header.descriptor_length = landmark_observations_descriptors_->DescriptorLength();
+    header.landmark_count = sfm_data_->GetLandmarks().size();
+    header.scene_hash = SceneHash(sfm_data_->GetLandmarks());
+    header.max_descriptors_per_landmark = pruning_options_.max_descriptors_per_landmark;
+    header.min_landmarks_per_view = pruning_options_.min_landmarks_per_view;
+
+    std::ofstream stream(filename, std::ios::out | std::ios::binary);
+    if (!stream)
+    {
+      std::cerr << "Cannot write the localization database: " << filename << std::endl;
+      return false;
+    }
+    const std::vector<uint32_t> landmark_ids(index_to_landmark_id_.cbegin(), index_to_landmark_id_.cend());
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(landmark_ids.data()),
+      landmark_ids.size() * sizeof(uint32_t));
+    if (!stream)
+    {
+      return false;
+    }
+
+    if (!landmark_observations_descriptors_->SaveBinary(RegionsFilename(filename)))
+    {
+      std::cerr << "Cannot write the localization database descriptors." << std::endl;
+      return false;
+    }
+    if (!matching_interface_->SaveIndex(MatcherFilename(filename)))
+    {
+      std::cerr << "The matcher structure cannot be saved: it will be built on load." << std::endl;
+    }
+    return true;
+  }
+
+  bool
+  SfM_Localization_Single_3DTrackObservation_Database::Load
+  (
+    const SfM_Data & sfm_data,
+    const features::Regions & regions_type,
+    const std::string & filename
+  )
+  {
+    sfm_data_ = nullptr;
+    matching_interface_.reset();
+
+    std::ifstream stream(filename, std::ios::in | std::ios::binary);
+    Localization_Database_Header header;
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, LOCALIZATION_DATABASE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != LOCALIZATION_DATABASE_VERSION)
+    {
+      std::cerr << "Invalid localization database: " << filename << std::endl;
+      return false;
+    }
+    if (header.landmark_count != sfm_data.GetLandmarks().size()
+        || header.scene_hash != SceneHash(sfm_data.GetLandmarks())
+        || header.descriptor_length != regions_type.DescriptorLength())
+    {
+      std::cerr << "The localization database does not match the scene or the regions type." << std::endl;
+      return false;
+    }
+    if (header.matcher_type != static_cast<uint32_t>(matcher_type_)
+        || header.max_descriptors_per_landmark != pruning_options_.max_descriptors_per_landmark
+        || header.min_landmarks_per_view != pruning_options_.min_landmarks_per_view)
+    {
+      std::cerr << "The localization database was built with another matcher or pruning options." << std::endl;
+      return false;
+    }
+
+    // The landmark ids fill the rest of the file: check their count against
+    //  the file size before any allocation (the header may be corrupted)
+    const std::streamoff ids_offset = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const uint64_t ids_size = static_cast<uint64_t>(stream.tellg() - ids_offset);
+    stream.seekg(ids_offset);
+    if (header.descriptor_count != ids_size / sizeof(uint32_t))
+    {
+      std::cerr << "Invalid localization database: " << filename << std::endl;
+      return false;
+    }
+
+    std::vector<uint32_t> landmark_ids(header.descriptor_count);
+    if (!stream.read(reinterpret_cast<char*>(landmark_ids.data()),
+          landmark_ids.size() * sizeof(uint32_t)))
+    {
+      std::cerr << "Invalid localization database: " << filename << std::endl;
+      return false;
+    }
+    for (const uint32_t landmark_id : landmark_ids)
+    {
+      if (sfm_data.GetLandmarks().count(landmark_id) == 0)
+      {
+        std::cerr << "The localization database does not match the scene." << std::endl;
+        return false;
+      }
+    }
+    index_to_landmark_id_.assign(landmark_ids.cbegin(), landmark_ids.cend());
+
+    // Map the descriptors (zero copy)
+    landmark_observations_descriptors_.reset(regions_type.EmptyClone());
+    if (!landmark_observations_descriptors_->LoadBinary(RegionsFilename(filename))
+        || landmark_observations_descriptors_->RegionCount() != header.descriptor_count)
+    {
+      std::cerr << "Invalid localization database descriptors." << std::endl;
+      return false;
+    }
+
+    // Reload the matcher structure
+    matching_interface_ =
+      RegionMatcherFactory(matcher_type_, *landmark_observations_descriptors_,
+        MatcherFilename(filename));
+    if (!matching_interface_)
+      return false;
+
+    InitLandmarkDescriptorIndexes(sfm_data);
+
+    std::cout << "Retrieval database loaded with:\n"
+      << "#landmarks: " << sfm_data.GetLandmarks().size() << "\n"
+      << "#descriptors: " << landmark_observations_descriptors_->RegionCount() << std::endl;
+
+    sfm_data_ = &sfm_data;
+
+    return true;
+  }
+
   bool
   SfM_Localization_Single_3DTrackObservation_Database::Localize
   (
@@ -95,6 +505,207 @@ namespace sfm {
       return false;
     }
 
+    return LocalizeFromMatches(solver_type, image_size, optional_intrinsics,
+      query_regions, vec_putative_matches, pose, resection_data_ptr);
+  }
+
+  bool
+  SfM_Localization_Single_3DTrackObservation_Database::Localize
+  (
+    const resection::SolverType & solver_type,
+    const Pair & image_size,
+    const cameras::IntrinsicBase * optional_intrinsics,
+    const features::Regions & query_regions,
+    const Localization_Prior & prior,
+    geometry::Pose3 & pose,
+    Image_Localizer_Match_Data * resection_data_ptr
+  ) const
+  {
+    if (!sfm_data_ || !matching_interface_)
+    {
+      return false;
+    }
+
+    if (prior.intrinsics)
+    {
+      const matching::IndMatches guided_matches =
+        GuidedMatch(image_size, query_regions, prior);
+      std::cout << "#3D2d prior-guided correspondences: " << guided_matches.size() << std::endl;
+      if (guided_matches.size() >= prior.min_matches
+          && LocalizeFromMatches(solver_type, image_size, optional_intrinsics,
+               query_regions, guided_matches, pose, resection_data_ptr))
+      {
+        return true;
+      }
+      std::cout << "Prior-guided localization failed, use the global matching." << std::endl;
+    }
+    return Localize(solver_type, image_size, optional_intrinsics, query_regions,
+      pose, resection_data_ptr);
+  }
+
+  matching::IndMatches
+  SfM_Localization_Single_3DTrackObservation_Database::GuidedMatch
+  (
+    const Pair & image_size,
+    const features::Regions & query_regions,
+    const Localization_Prior & prior
+  ) const
+  {
+    const double width = image_size.first, height = image_size.second;
+    const geometry::Pose3 & prior_pose = prior.pose;
+    const cameras::IntrinsicBase & prior_camera = *prior.intrinsics;
+
+    // Frustum culling of the landmarks (for pinhole cameras)
+    std::unique_ptr<geometry::Frustum> frustum;
+    if (const cameras::Pinhole_Intrinsic * pinhole_camera =
+          dynamic_cast<const cameras::Pinhole_Intrinsic *>(prior.intrinsics))
+    {
+      frustum.reset(new geometry::Frustum(image_size.first, image_size.second,
+        pinhole_camera->K(), prior_pose.rotation(), prior_pose.center()));
+    }
+
+    // Bucket the query regions in a grid of search_radius sized cells
+    const double cell_size = std::max(1.0, prior.search_radius);
+    const int grid_width = static_cast<int>(std::ceil(width / cell_size)) + 1;
+    const int grid_height = static_cast<int>(std::ceil(height / cell_size)) + 1;
+    std::vector<std::vector<uint32_t>> grid(grid_width * grid_height);
+    for (size_t j = 0; j < query_regions.RegionCount(); ++j)
+    {
+      const Vec2 x = query_regions.GetRegionPosition(j);
+      if (x(0) < 0.0 || x(1) < 0.0 || x(0) >= width || x(1) >= height)
+        continue;
+      grid[static_cast<int>(x(1) / cell_size) * grid_width
+        + static_cast<int>(x(0) / cell_size)].push_back(j);
+    }
+
+    // For each query region: (squared distance, database descriptor index) of its best landmark
+    std::vector<std::pair<double, uint32_t>> best_matches(query_regions.RegionCount(),
+      {std::numeric_limits<double>::infinity(), UndefinedIndexT});
+    // Candidate landmarks: the landmarks observed by the scene views the closest
+    //  to the prior pose (covisibility prefilter), or all the database landmarks
+    std::vector<IndexT> candidate_landmarks;
+    if (prior.neighbor_view_count == 0)
+    {
+      candidate_landmarks.reserve(landmark_descriptor_indexes_.size());
+      for (const auto & landmark_descriptors : landmark_descriptor_indexes_)
+        candidate_landmarks.push_back(landmark_descriptors.first);
+    }
+    else
+    {
+      // Distance of the scene views looking at the same half-space to the prior pose
+      const Vec3 prior_direction = prior_pose.rotation().row(2);
+      std::vector<std::pair<double, IndexT>> view_distances;
+      view_distances.reserve(view_landmark_ids_.size());
+      for (const auto & view_landmarks : view_landmark_ids_)
+      {
+        const geometry::Pose3 view_pose =
+          sfm_data_->GetPoseOrDie(sfm_data_->GetViews().at(view_landmarks.first).get());
+        if (view_pose.rotation().row(2).dot(prior_direction) <= 0.0)
+          continue;
+        view_distances.emplace_back(
+          (view_pose.center() - prior_pose.center()).squaredNorm(), view_landmarks.first);
+      }
+      const size_t neighbor_count =
+        std::min(static_cast<size_t>(prior.neighbor_view_count), view_distances.size());
+      std::partial_sort(view_distances.begin(), view_distances.begin() + neighbor_count,
+        view_distances.end());
+      for (size_t k = 0; k < neighbor_count; ++k)
+      {
+        const std::vector<IndexT> & landmark_ids = view_landmark_ids_.at(view_distances[k].second);
+        candidate_landmarks.insert(candidate_landmarks.end(), landmark_ids.cbegin(), landmark_ids.cend());
+      }
+      std::sort(candidate_landmarks.begin(), candidate_landmarks.end());
+      candidate_landmarks.erase(
+        std::unique(candidate_landmarks.begin(), candidate_landmarks.end()),
+        candidate_landmarks.end());
+    }
+
+    const double squared_radius = prior.search_radius * prior.search_radius;
+    const double squared_ratio = prior.distance_ratio * prior.distance_ratio;
+    for (const IndexT landmark_id : candidate_landmarks)
+    {
+      const std::vector<uint32_t> & descriptor_indexes = landmark_descriptor_indexes_.at(landmark_id);
+      const Vec3 & X = sfm_data_->GetLandmarks().at(landmark_id).X;
+      if (frustum && !frustum->contains(X))
+        continue;
+      const Vec3 X_camera = prior_pose(X);
+      if (X_camera(2) <= 0.0)
+        continue;
+      const Vec2 projection = prior_camera.project(X_camera);
+      if (projection(0) < 0.0 || projection(1) < 0.0 || projection(0) >= width || projection(1) >= height)
+        continue;
+
+      // Best and second best query regions in the landmark window
+      double best_distance = std::numeric_limits<double>::infinity();
+      double second_best_distance = std::numeric_limits<double>::infinity();
+      uint32_t best_query_index = UndefinedIndexT, best_database_index = UndefinedIndexT;
+      const int cell_x = static_cast<int>(projection(0) / cell_size);
+      const int cell_y = static_cast<int>(projection(1) / cell_size);
+      for (int y = std::max(0, cell_y - 1); y <= std::min(grid_height - 1, cell_y + 1); ++y)
+      {
+        for (int x = std::max(0, cell_x - 1); x <= std::min(grid_width - 1, cell_x + 1); ++x)
+        {
+          for (const uint32_t j : grid[y * grid_width + x])
+          {
+            if ((query_regions.GetRegionPosition(j) - projection).squaredNorm() > squared_radius)
+              continue;
+            // distance of the query region to the landmark: its closest descriptor
+            double distance = std::numeric_limits<double>::infinity();
+            uint32_t database_index = UndefinedIndexT;
+            for (const uint32_t i : descriptor_indexes)
+            {
+              const double descriptor_distance =
+                landmark_observations_descriptors_->SquaredDescriptorDistance(i, &query_regions, j);
+              if (descriptor_distance < distance)
+              {
+                distance = descriptor_distance;
+                database_index = i;
+              }
+            }
+            if (distance < best_distance)
+            {
+              second_best_distance = best_distance;
+              best_distance = distance;
+              best_query_index = j;
+              best_database_index = database_index;
+            }
+            else if (distance < second_best_distance)
+            {
+              second_best_distance = distance;
+            }
+          }
+        }
+      }
+      // Distance ratio test (on the squared distances) among the window candidates
+      if (best_query_index == UndefinedIndexT
+          || best_distance >= squared_ratio * second_best_distance)
+        continue;
+      // Keep the best landmark of each query region
+      if (best_distance < best_matches[best_query_index].first)
+        best_matches[best_query_index] = {best_distance, best_database_index};
+    }
+
+    matching::IndMatches guided_matches;
+    for (size_t j = 0; j < best_matches.size(); ++j)
+    {
+      if (best_matches[j].second != UndefinedIndexT)
+        guided_matches.emplace_back(best_matches[j].second, j);
+    }
+    return guided_matches;
+  }
+
+  bool
+  SfM_Localization_Single_3DTrackObservation_Database::LocalizeFromMatches
+  (
+    const resection::SolverType & solver_type,
+    const Pair & image_size,
+    const cameras::IntrinsicBase * optional_intrinsics,
+    const features::Regions & query_regions,
+    const matching::IndMatches & vec_putative_matches,
+    geometry::Pose3 & pose,
+    Image_Localizer_Match_Data * resection_data_ptr
+  ) const
+  {
     std::cout << "#3D2d putative correspondences: " << vec_putative_matches.size() << std::endl;
     // Init the 3D-2d correspondences array
     Image_Localizer_Match_Data resection_data;
@@ -128,5 +739,33 @@ namespace sfm {
     return bResection;
   }
 
+  void
+  SfM_Localization_Single_3DTrackObservation_Database::InitLandmarkDescriptorIndexes
+  (
+    const SfM_Data & sfm_data
+  )
+  {
+    landmark_descriptor_indexes_.clear();
+    for (size_t i = 0; i < index_to_landmark_id_.size(); ++i)
+    {
+      landmark_descriptor_indexes_[index_to_landmark_id_[i]].push_back(static_cast<uint32_t>(i));
+    }
+
+    view_landmark_ids_.clear();
+    for (const auto & landmark_descriptors : landmark_descriptor_indexes_)
+    {
+      for (const auto & observation : sfm_data.GetLandmarks().at(landmark_descriptors.first).obs)
+      {
+        const auto view_it = sfm_data.GetViews().find(observation.first);
+        if (observation.second.id_feat != UndefinedIndexT
+            && view_it != sfm_data.GetViews().end()
+            && sfm_data.IsPoseAndIntrinsicDefined(view_it->second.get()))
+        {
+          view_landmark_ids_[observation.first].push_back(landmark_descriptors.first);
+        }
+      }
+    }
+  }
+
 } // namespace sfm
 } // namespace openMVG
@@ -9,32 +9,105 @@
 #ifndef OPENMVG_SFM_PIPELINES_LOCALIZATION_SFM_LOCALIZER_STO_DB_HPP
 #define OPENMVG_SFM_PIPELINES_LOCALIZATION_SFM_LOCALIZER_STO_DB_HPP
 
+#include <cstdint>
+#include <set>
+#include <string>
 #include <vector>
 
+#include "openMVG/geometry/pose3.hpp"
+#include "openMVG/matching/indMatch.hpp"
+#include "openMVG/matching/matcher_type.hpp"
 #include "openMVG/matching/regions_matcher.hpp"
 #include "openMVG/sfm/pipelines/localization/SfM_Localizer.hpp"
+#include "openMVG/sfm/sfm_landmark.hpp"
 #include "openMVG/types.hpp"
 
 namespace openMVG { namespace cameras { struct IntrinsicBase; } }
 namespace openMVG { namespace features { class Regions; } }
-namespace openMVG { namespace geometry { class Pose3; } }
 namespace openMVG { namespace sfm { struct Regions_Provider; } }
 namespace openMVG { namespace sfm { struct SfM_Data; } }
 
 namespace openMVG {
 namespace sfm {
 
+/// Reduction of the localization database size
+struct Landmark_Pruning_Options
+{
+  /// Number of representative descriptors kept per landmark
+  ///  (greedy k-centers seeded by the medoid of its observation descriptors).
+  /// 0: all the observation descriptors are kept.
+  uint32_t max_descriptors_per_landmark = 0;
+  /// Keep only a covisibility-greedy subset of landmarks that sees every view
+  ///  at least min_landmarks_per_view times (or all its landmarks if it has fewer).
+  /// 0: all the landmarks are kept.
+  uint32_t min_landmarks_per_view = 0;
+};
+
+/// Select max_count representative descriptors among some regions:
+///  the medoid, then greedily the descriptor that is the farthest from the
+///  already selected ones (k-centers).
+/// Return the indexes of the selected regions (all of them if max_count is 0
+///  or if there are at most max_count regions).
+std::vector<size_t> SelectRepresentativeDescriptors
+(
+  const features::Regions & regions,
+  const size_t max_count
+);
+
+/// Select a subset of landmarks that sees every view at least min_landmarks_per_view
+///  times (or as many times as possible), with the greedy set cover heuristic:
+///  the landmark that covers the most still uncovered views is selected first.
+std::set<IndexT> SelectCoveringLandmarks
+(
+  const Landmarks & landmarks,
+  const uint32_t min_landmarks_per_view
+);
+
+/// Pose prior used to guide the 2D-3D matching of a query image
+///  (i.e. the pose of the previous frame of a video sequence)
+struct Localization_Prior
+{
+  /// Prior pose of the query image
+  geometry::Pose3 pose;
+  /// Camera used to project the landmarks in the query image
+  const cameras::IntrinsicBase * intrinsics = nullptr;
+  /// Radius (pixels) of the image-local window searched around each projected landmark
+  double search_radius = 40.0;
+  /// Distance ratio between the best and the second best query regions of a window
+  double distance_ratio = 0.8;
+  /// Number of scene views, the closest to the prior pose, whose landmarks are matched
+  ///  (covisibility prefilter). 0: all the landmarks of the database are matched.
+  uint32_t neighbor_view_count = 10;
+  /// Minimal number of guided 2D-3D matches (else the global matching is used)
+  uint32_t min_matches = 30;
+};
+
 // Implementation of a naive method:
 // - init the database of descriptor from the structure and the observations.
 // - create a large array with all the used descriptors and init a Matcher with it
 // - to localize an input image compare its regions to the database and robust estimate
 //   the pose from found 2d-3D correspondences
+// The database can be saved once built and reloaded without being rebuilt:
+// - the descriptors are stored in a binary regions container (memory mapped on load),
+// - the matcher structure (FLANN kd-tree or HNSW graph) is reloaded instead of built.
+// For sequential queries, a pose prior allows to match only the landmarks seen
+//  by the scene views close to the prior pose and by the prior camera frustum,
+//  in a small window around their projection.
 
 class SfM_Localization_Single_3DTrackObservation_Database : public SfM_Localizer
 {
 public:
 
-  SfM_Localization_Single_3DTrackObservation_Database();
+  /**
+  * @param[in] matcher_type the matcher used to find the 2D-3D correspondences
+  *  (ANN_L2 and HNSW_L2 structures can be saved and reloaded)
+  * @param[in] pruning_options the landmarks and descriptors kept by Init
+  */
+  explicit SfM_Localization_Single_3DTrackObservation_Database
+  (
+    matching::EMatcherType matcher_type = matching::ANN_L2,
+    const Landmark_Pruning_Options & pruning_options = Landmark_Pruning_Options()
+  );
 
   /**
   * @brief Build the retrieval database (3D points descriptors)
@@ -49,6 +122,37 @@ public:
     const Regions_Provider & regions_provider
   ) override;
 
+  /**
+  * @brief Save the database built by Init
+  *  (filename, filename.regions and filename.matcher files)
+  *
+  * @param[in] filename the database index file
+  * @return True if the database has been saved
+  */
+  bool Save(const std::string & filename) const;
+
+  /**
+  * @brief Load a database saved by Save instead of building it.
+  *  The database must have been built from the same scene landmarks, with the
+  *  matcher type and the pruning options of this localizer (else it must be rebuilt).
+  *
+  * @param[in] sfm_data the SfM scene that has been used to build the database
+  * @param[in] regions_type the regions type of the database
+  * @param[in] filename the database index file
+  * @return True if the database has been loaded (false if it does not match)
+  */
+  bool Load
+  (
+    const SfM_Data & sfm_data,
+    const features::Regions & regions_type,
+    const std::string & filename
+  );
+
+  /// Number of descriptors of the database
+  size_t DescriptorCount() const { return index_to_landmark_id_.size(); }
+  /// Landmark id of a database descriptor
+  IndexT LandmarkId(const uint32_t descriptor_index) const { return index_to_landmark_id_[descriptor_index]; }
+
   /**
   * @brief Try to localize an image in the database
   *
@@ -70,13 +174,80 @@ public:
     Image_Localizer_Match_Data * resection_data_ptr = nullptr
   ) const override;
 
+  /**
+  * @brief Try to localize an image in the database thanks to a pose prior:
+  *  - the landmarks seen by the scene views close to the prior pose and visible
+  *    from the prior pose are projected in the image,
+  *  - each landmark is matched to the query regions close to its projection,
+  *  - if the guided matching or the resection fails, the global matching is used.
+  *
+  * @param[in] solver_type the type of absolute pose solver to use
+  * @param[in] image_size the w,h image size
+  * @param[in] optional_intrinsics camera intrinsic if known (else nullptr)
+  * @param[in] query_regions the image regions (type must be the same as the database)
+  * @param[in] prior the pose prior and its guided matching parameters
+  * @param[out] pose found pose
+  * @param[out] resection_data matching data (2D-3D and inliers; optional)
+  * @return True if a putative pose has been estimated
+  */
+  bool Localize
+  (
+    const resection::SolverType & solver_type,
+    const Pair & image_size,
+    const cameras::IntrinsicBase * optional_intrinsics,
+    const features::Regions & query_regions,
+    const Localization_Prior & prior,
+    geometry::Pose3 & pose,
+    Image_Localizer_Match_Data * resection_data_ptr = nullptr
+  ) const;
+
+  /**
+  * @brief Find the 2D-3D matches of the landmarks projected close to the query regions
+  *  (the landmarks observed by the scene views close to the prior pose)
+  *
+  * @param[in] image_size the w,h image size
+  * @param[in] query_regions the image regions (type must be the same as the database)
+  * @param[in] prior the pose prior and its guided matching parameters
+  * @return the matches (database descriptor index, query region index)
+  */
+  matching::IndMatches GuidedMatch
+  (
+    const Pair & image_size,
+    const features::Regions & query_regions,
+    const Localization_Prior & prior
+  ) const;
+
 private:
+  /// Robust estimation of the pose from putative 2D-3D matches
+  ///  (database descriptor index, query region index)
+  bool LocalizeFromMatches
+  (
+    const resection::SolverType & solver_type,
+    const Pair & image_size,
+    const cameras::IntrinsicBase * optional_intrinsics,
+    const features::Regions & query_regions,
+    const matching::IndMatches & putative_matches,
+    geometry::Pose3 & pose,
+    Image_Localizer_Match_Data * resection_data_ptr
+  ) const;
+
+  /// Index the database descriptors of each landmark and the landmarks of each view
+  void InitLandmarkDescriptorIndexes(const SfM_Data & sfm_data);
+
+  /// The matcher type used to find the 2D-3D correspondences
+  matching::EMatcherType matcher_type_;
+  /// The landmarks and descriptors kept by Init
+  Landmark_Pruning_Options pruning_options_;
   // Reference to the scene
   const SfM_Data * sfm_data_;
   /// Association of a regions to a landmark observation
   std::unique_ptr<features::Regions> landmark_observations_descriptors_;
   /// Association of a track observation to a track Id (used for retrieval)
   std::vector<IndexT> index_to_landmark_id_;
+  /// Database descriptors of each landmark (used for the prior-guided matching)
+  Hash_Map<IndexT, std::vector<uint32_t>> landmark_descriptor_indexes_;
+  /// Database landmarks observed by each posed scene view (used for the prior-guided matching)
+  Hash_Map<IndexT, std::vector<IndexT>> view_landmark_ids_;
   /// A matching interface to find matches between 2D descriptor matches
   ///  and 3D points observation descriptors
   std::unique_ptr<matching::RegionsMatcher> matching_interface_;
@@ -0,0 +1,316 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/geometry/pose3.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/sfm/pipelines/localization/SfM_Localizer_Single_3DTrackObservation_Database.hpp"
+#include "openMVG/sfm/pipelines/pipelines_test.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+
+#include "testing/testing.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::sfm;
+
+// Regions whose descriptors differ only by their first component
+SIFT_Regions Make_Regions(const std::vector<int> & first_components)
+{
+  SIFT_Regions regions;
+  for (const int value : first_components)
+  {
+    SIFT_Regions::DescriptorT desc;
+    desc.fill(0);
+    desc[0] = value;
+    regions.Descriptors().push_back(desc);
+    regions.Features().emplace_back(0.f, 0.f, 1.f, 0.f);
+  }
+  return regions;
+}
+
+TEST(Landmark_Pruning, RepresentativeDescriptors_All)
+{
+  const SIFT_Regions regions = Make_Regions({0, 10, 12});
+  // No selection: max_count is 0 or not smaller than the region count
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 0) == std::vector<size_t>({0, 1, 2}));
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 3) == std::vector<size_t>({0, 1, 2}));
+}
+
+TEST(Landmark_Pruning, RepresentativeDescriptors_MedoidKCenters)
+{
+  // Sums of the distances to the other descriptors: 136, 106, 104, 106, 364
+  const SIFT_Regions regions = Make_Regions({0, 10, 12, 14, 100});
+
+  // The medoid (12) first
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 1) == std::vector<size_t>({2}));
+  // then the farthest descriptor from the selected ones (100, then 0)
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 2) == std::vector<size_t>({2, 4}));
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 3) == std::vector<size_t>({2, 4, 0}));
+}
+
+TEST(Landmark_Pruning, RepresentativeDescriptors_Duplicates)
+{
+  // Duplicated descriptors are selected once
+  const SIFT_Regions regions = Make_Regions({7, 7, 7, 7});
+  EXPECT_TRUE(SelectRepresentativeDescriptors(regions, 2) == std::vector<size_t>({0}));
+}
+
+TEST(Landmark_Pruning, CoveringLandmarks)
+{
+  // 20 landmarks seen by 2 consecutive views of a ring of 4 views (10 landmarks per view),
+  //  a landmark seen only by the view 4 and a landmark without valid observations
+  Landmarks landmarks;
+  const IndexT nb_view = 4, nb_landmark = 20;
+  for (IndexT i = 0; i < nb_landmark; ++i)
+  {
+    landmarks[i].obs[i % nb_view] = Observation(Vec2::Zero(), i);
+    landmarks[i].obs[(i + 1) % nb_view] = Observation(Vec2::Zero(), i);
+  }
+  landmarks[nb_landmark].obs[4] = Observation(Vec2::Zero(), 0);
+  landmarks[nb_landmark + 1].obs[0] = Observation();
+
+  const uint32_t min_landmarks_per_view = 3;
+  const std::set<IndexT> selected = SelectCoveringLandmarks(landmarks, min_landmarks_per_view);
+
+  // Every view sees min_landmarks_per_view selected landmarks (or all its landmarks)
+  std::map<IndexT, uint32_t> view_landmark_count;
+  for (const IndexT landmark_id : selected)
+  {
+    for (const auto & observation : landmarks.at(landmark_id).obs)
+    {
+      if (observation.second.id_feat != UndefinedIndexT)
+        ++view_landmark_count[observation.first];
+    }
+  }
+  for (IndexT view_id = 0; view_id < nb_view; ++view_id)
+  {
+    EXPECT_TRUE(view_landmark_count[view_id] >= min_landmarks_per_view);
+  }
+  EXPECT_EQ(1, view_landmark_count[4]);
+  EXPECT_EQ(0, selected.count(nb_landmark + 1));
+
+  // Each ring landmark covers 2 views: 6 of them are enough
+  EXPECT_TRUE(selected.size() <= 7);
+}
+
+// Regions provider filled with in memory regions
+struct Synthetic_Regions_Provider : public Regions_Provider
+{
+  Synthetic_Regions_Provider()
+  {
+    region_type_.reset(new SIFT_Regions);
+  }
+
+  void add(const IndexT view_id, std::shared_ptr<Regions> regions)
+  {
+    cache_[view_id] = regions;
+  }
+};
+
+// Synthetic ring scene whose landmarks are described by a random descriptor,
+//  observed with a small noise by each view
+struct Synthetic_Localization_Scene
+{
+  NViewDataSet dataset;
+  SfM_Data sfm_data;
+  std::vector<SIFT_Regions::DescriptorT> landmark_descriptors;
+  std::mt19937 rng;
+
+  Synthetic_Localization_Scene(const int nb_view, const int nb_point)
+    : dataset(Seeded_Ring(nb_view, nb_point)),
+      landmark_descriptors(nb_point)
+  {
+    sfm_data = getInputScene(dataset, nViewDatasetConfigurator(), cameras::PINHOLE_CAMERA);
+    std::uniform_int_distribution<int> value_distrib(0, 255);
+    for (auto & desc : landmark_descriptors)
+      for (int i = 0; i < desc.size(); ++i)
+        desc[i] = value_distrib(rng);
+  }
+
+  // The ring scene does not depend on the tests run before
+  //  (its points are drawn with std::rand)
+  static NViewDataSet Seeded_Ring(const int nb_view, const int nb_point)
+  {
+    std::srand(1);
+    return NRealisticCamerasRing(nb_view, nb_point);
+  }
+
+  // The regions of a view: the region j is the noisy descriptor of the landmark j
+  std::shared_ptr<SIFT_Regions> View_Regions(const int view_id)
+  {
+    std::uniform_int_distribution<int> noise_distrib(-2, 2);
+    std::shared_ptr<SIFT_Regions> regions = std::make_shared<SIFT_Regions>();
+    for (Mat2X::Index j = 0; j < dataset._x[view_id].cols(); ++j)
+    {
+      SIFT_Regions::DescriptorT desc;
+      for (int i = 0; i < desc.size(); ++i)
+        desc[i] = std::min(255, std::max(0, landmark_descriptors[j][i] + noise_distrib(rng)));
+      regions->Descriptors().push_back(desc);
+      regions->Features().emplace_back(dataset._x[view_id](0, j), dataset._x[view_id](1, j), 1.f, 0.f);
+    }
+    return regions;
+  }
+
+  // The landmarks projected in the image of a view
+  std::set<IndexT> Visible_Landmarks(const int view_id) const
+  {
+    const cameras::IntrinsicBase * intrinsics = sfm_data.GetIntrinsics().at(0).get();
+    std::set<IndexT> visible_landmarks;
+    for (Mat2X::Index j = 0; j < dataset._x[view_id].cols(); ++j)
+    {
+      const Vec2 x = dataset._x[view_id].col(j);
+      if (x(0) >= 0.0 && x(1) >= 0.0 && x(0) < intrinsics->w() && x(1) < intrinsics->h())
+        visible_landmarks.insert(j);
+    }
+    return visible_landmarks;
+  }
+};
+
+TEST(Localization_Prior, SameMatchesAndPoseAsGlobal)
+{
+  const int nb_view = 8, nb_point = 200;
+  Synthetic_Localization_Scene scene(nb_view, nb_point);
+  Synthetic_Regions_Provider regions_provider;
+  for (int view_id = 0; view_id < nb_view; ++view_id)
+    regions_provider.add(view_id, scene.View_Regions(view_id));
+
+  Landmark_Pruning_Options pruning_options;
+  pruning_options.max_descriptors_per_landmark = 1;
+  SfM_Localization_Single_3DTrackObservation_Database localizer(matching::ANN_L2, pruning_options);
+  EXPECT_TRUE(localizer.Init(scene.sfm_data, regions_provider));
+
+  // Query: a new noisy observation of the view 0 regions
+  const int query_view = 0;
+  const std::shared_ptr<SIFT_Regions> query_regions = scene.View_Regions(query_view);
+  const cameras::IntrinsicBase * intrinsics = scene.sfm_data.GetIntrinsics().at(0).get();
+  const Pair image_size(intrinsics->w(), intrinsics->h());
+  const geometry::Pose3 & gt_pose = scene.sfm_data.GetPoses().at(query_view);
+
+  // Global matching
+  geometry::Pose3 global_pose;
+  Image_Localizer_Match_Data global_data;
+  EXPECT_TRUE(localizer.Localize(resection::SolverType::P3P_KE_CVPR17, image_size,
+    intrinsics, *query_regions, global_pose, &global_data));
+  EXPECT_EQ(nb_point, global_data.pt2D.cols());
+
+  // Prior-guided matching from a perturbed pose: all the regions in the image
+  //  are matched to their landmark in a window around their projection
+  Localization_Prior prior;
+  prior.pose = geometry::Pose3(
+    Eigen::AngleAxisd(D2R(0.2), Vec3::UnitY()).toRotationMatrix() * gt_pose.rotation(),
+    gt_pose.center() + Vec3(0.002, -0.002, 0.002));
+  prior.intrinsics = intrinsics;
+  prior.search_radius = 20.0;
+
+  const matching::IndMatches guided_matches =
+    localizer.GuidedMatch(image_size, *query_regions, prior);
+  EXPECT_EQ(scene.Visible_Landmarks(query_view).size(), guided_matches.size());
+  for (const auto & match : guided_matches)
+  {
+    EXPECT_EQ(match.j_, localizer.LandmarkId(match.i_));
+  }
+
+  geometry::Pose3 guided_pose;
+  Image_Localizer_Match_Data guided_data;
+  EXPECT_TRUE(localizer.Localize(resection::SolverType::P3P_KE_CVPR17, image_size,
+    intrinsics, *query_regions, prior, guided_pose, &guided_data));
+  EXPECT_NEAR(0.0, (guided_pose.center() - global_pose.center()).norm(), 1e-6);
+  EXPECT_NEAR(0.0, (guided_pose.rotation() - global_pose.rotation()).norm(), 1e-6);
+  EXPECT_NEAR(0.0, (guided_pose.center() - gt_pose.center()).norm(), 1e-3);
+  EXPECT_NEAR(0.0, (guided_pose.rotation() - gt_pose.rotation()).norm(), 1e-3);
+}
+
+TEST(Localization_Prior, NeighborViewLandmarks)
+{
+  // The first half of the landmarks is observed only by the views 0, 1 and 7,
+  //  the second half only by the opposite views 3, 4 and 5
+  const int nb_view = 8, nb_point = 200;
+  Synthetic_Localization_Scene scene(nb_view, nb_point);
+  for (auto & landmark : scene.sfm_data.structure)
+  {
+    const std::set<IndexT> observing_views =
+      landmark.first < nb_point / 2 ? std::set<IndexT>({0, 1, 7}) : std::set<IndexT>({3, 4, 5});
+    for (auto obs_it = landmark.second.obs.begin(); obs_it != landmark.second.obs.end();)
+    {
+      if (observing_views.count(obs_it->first) == 0)
+        obs_it = landmark.second.obs.erase(obs_it);
+      else
+        ++obs_it;
+    }
+  }
+  Synthetic_Regions_Provider regions_provider;
+  for (int view_id = 0; view_id < nb_view; ++view_id)
+    regions_provider.add(view_id, scene.View_Regions(view_id));
+
+  SfM_Localization_Single_3DTrackObservation_Database localizer;
+  EXPECT_TRUE(localizer.Init(scene.sfm_data, regions_provider));
+
+  const std::set<IndexT> visible_landmarks = scene.Visible_Landmarks(0);
+  const std::shared_ptr<SIFT_Regions> query_regions = scene.View_Regions(0);
+  const cameras::IntrinsicBase * intrinsics = scene.sfm_data.GetIntrinsics().at(0).get();
+  const Pair image_size(intrinsics->w(), intrinsics->h());
+  Localization_Prior prior;
+  prior.pose = scene.sfm_data.GetPoses().at(0);
+  prior.intrinsics = intrinsics;
+
+  // All the visible landmarks are matched
+  prior.neighbor_view_count = 0;
+  EXPECT_EQ(visible_landmarks.size(), localizer.GuidedMatch(image_size, *query_regions, prior).size());
+
+  // Only the landmarks of the 3 views closest to the prior are matched
+  prior.neighbor_view_count = 3;
+  const matching::IndMatches guided_matches =
+    localizer.GuidedMatch(image_size, *query_regions, prior);
+  EXPECT_EQ(std::count_if(visible_landmarks.cbegin(), visible_landmarks.cend(),
+    [&](const IndexT landmark_id) { return landmark_id < nb_point / 2; }),
+    guided_matches.size());
+  for (const auto & match : guided_matches)
+  {
+    EXPECT_TRUE(localizer.LandmarkId(match.i_) < nb_point / 2);
+  }
+}
+
+TEST(Localization_Database, CorruptedDescriptorCount)
+{
+  const int nb_view = 4, nb_point = 50;
+  Synthetic_Localization_Scene scene(nb_view, nb_point);
+  Synthetic_Regions_Provider regions_provider;
+  for (int view_id = 0; view_id < nb_view; ++view_id)
+    regions_provider.add(view_id, scene.View_Regions(view_id));
+
+  SfM_Localization_Single_3DTrackObservation_Database localizer(matching::ANN_L2);
+  EXPECT_TRUE(localizer.Init(scene.sfm_data, regions_provider));
+  EXPECT_TRUE(localizer.Save("localization_database.bin"));
+  {
+    SfM_Localization_Single_3DTrackObservation_Database loaded_localizer(matching::ANN_L2);
+    EXPECT_TRUE(loaded_localizer.Load(scene.sfm_data, SIFT_Regions(), "localization_database.bin"));
+  }
+
+  // A descriptor count that does not fit in the file is rejected
+  //  before the landmark ids are allocated
+  {
+    std::fstream file("localization_database.bin",
+      std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t descriptor_count = std::numeric_limits<uint64_t>::max() / 8;
+    file.seekp(16); // offset of descriptor_count in the database header
+    file.write(reinterpret_cast<const char*>(&descriptor_count), sizeof(descriptor_count));
+  }
+  SfM_Localization_Single_3DTrackObservation_Database loaded_localizer(matching::ANN_L2);
+  EXPECT_FALSE(loaded_localizer.Load(scene.sfm_data, SIFT_Regions(), "localization_database.bin"));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
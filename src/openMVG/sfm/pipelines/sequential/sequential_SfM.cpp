@@ -17,17 +17,21 @@
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_BA.hpp"
 #include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_incremental.hpp"
 #include "openMVG/sfm/sfm_data_filters.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/stl/stl.hpp"
+#include "openMVG/system/timer.hpp"
 
 #include "third_party/histogram/histogram.hpp"
 #include "third_party/htmlDoc/htmlDoc.hpp"
 #include "third_party/progress/progress.hpp"
 
 #include <ceres/types.h>
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <utility>
 
 #ifdef _MSC_VER
@@ -41,6 +45,45 @@ using namespace openMVG::cameras;
 using namespace openMVG::geometry;
 using namespace openMVG::matching;
 
+namespace {
+
+/// Mean pixel residual of the scene observations
+double MeanResidual(const SfM_Data & sfm_data)
+{
+  double residual_sum = 0.0;
+  size_t observation_count = 0;
+  for (const auto & landmark_entry : sfm_data.GetLandmarks())
+  {
+    for (const auto & observation : landmark_entry.second.obs)
+    {
+      const View * view = sfm_data.GetViews().at(observation.first).get();
+      const IntrinsicBase * intrinsic = sfm_data.GetIntrinsics().at(view->id_intrinsic).get();
+      residual_sum += intrinsic->residual(
+        sfm_data.GetPoseOrDie(view)(landmark_entry.second.X), observation.second.x).norm();
+      ++observation_count;
+    }
+  }
+  return (observation_count > 0) ? residual_sum / observation_count : 0.0;
+}
+
+} // namespace
+
+struct SequentialSfMReconstructionEngine::Resection_Candidate
+{
+  IndexT view_index = UndefinedIndexT;
+  /// Number of 2D-3D matches (0 if the view does not see the structure)
+  size_t match_count = 0;
+  /// Tell if a pose has been found and refined
+  bool b_resection = false;
+  /// Tell if the pose has been found (before refinement)
+  bool b_robust_resection = false;
+  geometry::Pose3 pose;
+  /// The camera of the view (a new one if it had no intrinsic)
+  std::shared_ptr<cameras::IntrinsicBase> intrinsic;
+  bool b_new_intrinsic = false;
+  Image_Localizer_Match_Data resection_data;
+};
+
 SequentialSfMReconstructionEngine::SequentialSfMReconstructionEngine(
   const SfM_Data & sfm_data,
   const std::string & soutDirectory,
@@ -172,14 +215,34 @@ bool SequentialSfMReconstructionEngine::Process() {
   // - group of images will be selected and resection + scene completion will be tried
   size_t resectionGroupIndex = 0;
   std::vector<uint32_t> vec_possible_resection_indexes;
+  // Local bundle adjustment state and BA statistics
+  unsigned int group_count_since_full_ba = 0;
+  double full_ba_mean_residual = MeanResidual(sfm_data_);
+  double local_ba_time = 0.0, full_ba_time = 0.0;
+  size_t local_ba_count = 0, full_ba_count = 0;
   while (FindImagesWithPossibleResection(vec_possible_resection_indexes))
   {
     bool bImageAdded = false;
-    // Add images to the 3D reconstruction
-    for (const auto & iter : vec_possible_resection_indexes)
+    // Robust pose estimation of the candidate views against the current structure
+    std::vector<Resection_Candidate> resection_candidates(vec_possible_resection_indexes.size());
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(resection_candidates.size()); ++i)
     {
-      bImageAdded |= Resection(iter);
-      set_remaining_view_id_.erase(iter);
+      ComputeResection(vec_possible_resection_indexes[i], resection_candidates[i]);
+    }
+    // Add images to the 3D reconstruction (in the candidate order, so the
+    //  result does not depend on the number of threads)
+    std::set<IndexT> added_view_ids;
+    for (const Resection_Candidate & candidate : resection_candidates)
+    {
+      if (AddResection(candidate))
+      {
+        bImageAdded = true;
+        added_view_ids.insert(candidate.view_index);
+      }
+      set_remaining_view_id_.erase(candidate.view_index);
     }
 
     if (bImageAdded)
@@ -189,12 +252,42 @@ bool SequentialSfMReconstructionEngine::Process() {
       os << std::setw(8) << std::setfill('0') << resectionGroupIndex << "_Resection";
       Save(sfm_data_, stlplus::create_filespec(sOut_directory_, os.str(), ".ply"), ESfM_Data(ALL));
 
-      // Perform BA until all point are under the given precision
-      do
+      // Local BA around the new views, unless a full BA is due
+      bool bFullBA = (local_ba_full_period_ == 0)
+        || (++group_count_since_full_ba >= local_ba_full_period_);
+      if (!bFullBA)
       {
-        BundleAdjustment();
+        openMVG::system::Timer ba_timer;
+        do
+        {
+          LocalBundleAdjustment(added_view_ids);
+          ++local_ba_count;
+        }
+        while (badTrackRejector(4.0, 50));
+        local_ba_time += ba_timer.elapsed();
+        // Drift check: the residual must stay close to the full BA one
+        const double mean_residual = MeanResidual(sfm_data_);
+        if (mean_residual > local_ba_drift_ratio_ * full_ba_mean_residual)
+        {
+          std::cout << "Local BA drift (mean residual: " << mean_residual
+            << ", last full BA: " << full_ba_mean_residual << "): run a full BA." << std::endl;
+          bFullBA = true;
+        }
+      }
+      if (bFullBA)
+      {
+        openMVG::system::Timer ba_timer;
+        // Perform BA until all point are under the given precision
+        do
+        {
+          BundleAdjustment();
+          ++full_ba_count;
+        }
+        while (badTrackRejector(4.0, 50));
+        full_ba_time += ba_timer.elapsed();
+        full_ba_mean_residual = MeanResidual(sfm_data_);
+        group_count_since_full_ba = 0;
       }
-      while (badTrackRejector(4.0, 50));
       eraseUnstablePosesAndObservations(sfm_data_);
     }
     ++resectionGroupIndex;
@@ -212,6 +305,9 @@ bool SequentialSfMReconstructionEngine::Process() {
     << "-- #Camera calibrated: " << sfm_data_.GetPoses().size()
     << " from " << sfm_data_.GetViews().size() << " input images.\n"
     << "-- #Tracks, #3D points: " << sfm_data_.GetLandmarks().size() << "\n"
+    << "-- Mean residual (pixels): " << MeanResidual(sfm_data_) << "\n"
+    << "-- Bundle adjustment time (s): full " << full_ba_time << " (#" << full_ba_count << ")"
+    << ", local " << local_ba_time << " (#" << local_ba_count << ")\n"
     << "-------------------------------" << "\n";
 
   Histogram<double> h;
@@ -354,8 +450,8 @@ bool SequentialSfMReconstructionEngine::InitLandmarkTracks()
     std::cout << "\n" << "Track filtering" << std::endl;
     tracksBuilder.Filter();
     std::cout << "\n" << "Track export to internal struct" << std::endl;
-    //-- Build tracks with STL compliant type :
-    tracksBuilder.ExportToSTL(map_tracks_);
+    //-- Build tracks with a contiguous storage and a per view index :
+    tracksBuilder.ExportToFlat(map_tracks_);
 
     std::cout << "\n" << "Track stats" << std::endl;
     {
@@ -384,9 +480,7 @@ bool SequentialSfMReconstructionEngine::InitLandmarkTracks()
       std::cout << osTrack.str();
     }
   }
-  // Initialize the shared track visibility helper
-  shared_track_visibility_helper_.reset(new openMVG::tracks::SharedTrackVisibilityHelper(map_tracks_));
-  return map_tracks_.size() > 0;
+  return !map_tracks_.Empty();
 }
 
 bool SequentialSfMReconstructionEngine::AutomaticInitialPairChoice(Pair & initial_pair) const
@@ -448,7 +542,7 @@ bool SequentialSfMReconstructionEngine::AutomaticInitialPairChoice(Pair & initia
         if (cam_I && cam_J)
         {
           openMVG::tracks::STLMAPTracks map_tracksCommon;
-          shared_track_visibility_helper_->GetTracksInImages({I, J}, map_tracksCommon);
+          map_tracks_.GetTracksInImages({I, J}, map_tracksCommon);
 
           // Copy points correspondences to arrays for relative pose estimation
           const size_t n = map_tracksCommon.size();
@@ -564,7 +658,7 @@ bool SequentialSfMReconstructionEngine::MakeInitialPair3D(const Pair & current_p
   // b. Get common features between the two view
   // use the track to have a more dense match correspondence set
   openMVG::tracks::STLMAPTracks map_tracksCommon;
-  shared_track_visibility_helper_->GetTracksInImages({I, J}, map_tracksCommon);
+  map_tracks_.GetTracksInImages({I, J}, map_tracksCommon);
 
   //-- Copy point to arrays
   const size_t n = map_tracksCommon.size();
@@ -841,12 +935,6 @@ bool SequentialSfMReconstructionEngine::FindImagesWithPossibleResection(
   if (set_remaining_view_id_.empty() || sfm_data_.GetLandmarks().empty())
     return false;
 
-  // Collect tracksIds
-  std::set<uint32_t> reconstructed_trackId;
-  std::transform(sfm_data_.GetLandmarks().cbegin(), sfm_data_.GetLandmarks().cend(),
-    std::inserter(reconstructed_trackId, reconstructed_trackId.begin()),
-    stl::RetrieveKey());
-
   Pair_Vec vec_putative; // ImageId, NbPutativeCommonPoint
 #ifdef OPENMVG_USE_OPENMP
   #pragma omp parallel
@@ -861,33 +949,34 @@ bool SequentialSfMReconstructionEngine::FindImagesWithPossibleResection(
       const uint32_t viewId = *iter;
 
       // Compute 2D - 3D possible content
-      openMVG::tracks::STLMAPTracks map_tracksCommon;
-      shared_track_visibility_helper_->GetTracksInImages({viewId}, map_tracksCommon);
+      const auto view_tracks = map_tracks_.TracksInView(viewId);
 
-      if (!map_tracksCommon.empty())
+      if (!view_tracks.empty())
       {
-        std::set<uint32_t> set_tracksIds;
-        tracks::TracksUtilsMap::GetTracksIdVector(map_tracksCommon, &set_tracksIds);
-
         // Count the common possible putative point
         //  with the already 3D reconstructed trackId
-        std::vector<uint32_t> vec_trackIdForResection;
-        std::set_intersection(set_tracksIds.cbegin(), set_tracksIds.cend(),
-          reconstructed_trackId.cbegin(), reconstructed_trackId.cend(),
-          std::back_inserter(vec_trackIdForResection));
+        uint32_t nb_trackIdForResection = 0;
+        for (const auto & view_track : view_tracks)
+        {
+          nb_trackIdForResection +=
+            sfm_data_.GetLandmarks().count(map_tracks_.TrackId(view_track.first));
+        }
 
 #ifdef OPENMVG_USE_OPENMP
         #pragma omp critical
 #endif
         {
-          vec_putative.emplace_back(viewId, vec_trackIdForResection.size());
+          vec_putative.emplace_back(viewId, nb_trackIdForResection);
         }
       }
     }
   }
 
   // Sort by the number of matches to the 3D scene.
-  std::sort(vec_putative.begin(), vec_putative.end(), sort_pair_second<uint32_t, uint32_t, std::greater<uint32_t>>());
+  // The views are listed concurrently: the ties are sorted by view id, so the
+  //  resection order does not depend on the number of threads.
+  std::sort(vec_putative.begin(), vec_putative.end());
+  std::stable_sort(vec_putative.begin(), vec_putative.end(), sort_pair_second<uint32_t, uint32_t, std::greater<uint32_t>>());
 
   // If the list is empty or if the list contains images with no correspdences
   // -> (no resection will be possible)
@@ -926,55 +1015,57 @@ bool SequentialSfMReconstructionEngine::FindImagesWithPossibleResection(
  * G. Triangulate new possible 2D tracks
  */
 bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
+{
+  Resection_Candidate candidate;
+  ComputeResection(viewIndex, candidate);
+  return AddResection(candidate);
+}
+
+bool SequentialSfMReconstructionEngine::ComputeResection
+(
+  const uint32_t viewIndex,
+  Resection_Candidate & candidate
+) const
 {
   using namespace tracks;
 
+  candidate.view_index = viewIndex;
+
   // A. Compute 2D/3D matches
-  // A1. list tracks ids used by the view
-  openMVG::tracks::STLMAPTracks map_tracksCommon;
-  shared_track_visibility_helper_->GetTracksInImages({viewIndex}, map_tracksCommon);
-  std::set<uint32_t> set_tracksIds;
-  TracksUtilsMap::GetTracksIdVector(map_tracksCommon, &set_tracksIds);
+  // A1. list tracks ids used by the view (sorted by track index, so by increasing track id)
+  const auto view_tracks = map_tracks_.TracksInView(viewIndex);
 
   // A2. intersects the track list with the reconstructed
-  std::set<uint32_t> reconstructed_trackId;
-  std::transform(sfm_data_.GetLandmarks().cbegin(), sfm_data_.GetLandmarks().cend(),
-    std::inserter(reconstructed_trackId, reconstructed_trackId.begin()),
-    stl::RetrieveKey());
-
   // Get the ids of the already reconstructed tracks
+  //  and the featId associated to these tracks.
+  // These 2D/3D associations will be used for the resection.
   std::set<uint32_t> set_trackIdForResection;
-  std::set_intersection(set_tracksIds.cbegin(), set_tracksIds.cend(),
-    reconstructed_trackId.cbegin(), reconstructed_trackId.cend(),
-    std::inserter(set_trackIdForResection, set_trackIdForResection.begin()));
+  std::vector<uint32_t> vec_featIdForResection;
+  for (const auto & view_track : view_tracks)
+  {
+    const uint32_t trackId = map_tracks_.TrackId(view_track.first);
+    if (sfm_data_.GetLandmarks().count(trackId) != 0)
+    {
+      set_trackIdForResection.insert(set_trackIdForResection.end(), trackId);
+      vec_featIdForResection.push_back(view_track.second);
+    }
+  }
 
   if (set_trackIdForResection.empty())
   {
     // No match. The image has no connection with already reconstructed points.
-    std::cout << std::endl
-      << "-------------------------------" << "\n"
-      << "-- Resection of camera index: " << viewIndex << "\n"
-      << "-- Resection status: " << "FAILED" << "\n"
-      << "-------------------------------" << std::endl;
     return false;
   }
-
-  // Get back featId associated to a tracksID already reconstructed.
-  // These 2D/3D associations will be used for the resection.
-  std::vector<uint32_t> vec_featIdForResection;
-  TracksUtilsMap::GetFeatIndexPerViewAndTrackId(map_tracksCommon,
-    set_trackIdForResection,
-    viewIndex,
-    &vec_featIdForResection);
+  candidate.match_count = set_trackIdForResection.size();
 
   // Localize the image inside the SfM reconstruction
-  Image_Localizer_Match_Data resection_data;
+  Image_Localizer_Match_Data & resection_data = candidate.resection_data;
   resection_data.pt2D.resize(2, set_trackIdForResection.size());
   resection_data.pt3D.resize(3, set_trackIdForResection.size());
 
   // B. Look if the intrinsic data is known or not
   const View * view_I = sfm_data_.GetViews().at(viewIndex).get();
-  std::shared_ptr<cameras::IntrinsicBase> optional_intrinsic;
+  std::shared_ptr<cameras::IntrinsicBase> & optional_intrinsic = candidate.intrinsic;
   if (sfm_data_.GetIntrinsics().count(view_I->id_intrinsic))
   {
     optional_intrinsic = sfm_data_.GetIntrinsics().at(view_I->id_intrinsic);
@@ -997,11 +1088,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
   }
 
   // C. Do the resectioning: compute the camera pose
-  std::cout << std::endl
-    << "-------------------------------" << std::endl
-    << "-- Robust Resection of view: " << viewIndex << std::endl;
-
-  geometry::Pose3 pose;
+  geometry::Pose3 & pose = candidate.pose;
   const bool bResection = sfm::SfM_Localizer::Localize
   (
     optional_intrinsic ? resection::SolverType::P3P_NORDBERG_ECCV18 : resection::SolverType::DLT_6POINTS,
@@ -1011,29 +1098,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
     pose
   );
   resection_data.pt2D = std::move(pt2D_original); // restore original image domain points
-
-  if (!sLogging_file_.empty())
-  {
-    using namespace htmlDocument;
-    std::ostringstream os;
-    os << "Resection of Image index: <" << viewIndex << "> image: "
-      << view_I->s_Img_path <<"<br> \n";
-    html_doc_stream_->pushInfo(htmlMarkup("h1",os.str()));
-
-    os.str("");
-    os << std::endl
-      << "-------------------------------" << "<br>"
-      << "-- Robust Resection of camera index: <" << viewIndex << "> image: "
-      <<  view_I->s_Img_path <<"<br>"
-      << "-- Threshold: " << resection_data.error_max << "<br>"
-      << "-- Resection status: " << (bResection ? "OK" : "FAILED") << "<br>"
-      << "-- Nb points used for Resection: " << vec_featIdForResection.size() << "<br>"
-      << "-- Nb points validated by robust estimation: " << resection_data.vec_inliers.size() << "<br>"
-      << "-- % points validated: "
-      << resection_data.vec_inliers.size()/static_cast<float>(vec_featIdForResection.size()) << "<br>"
-      << "-------------------------------" << "<br>";
-    html_doc_stream_->pushInfo(os.str());
-  }
+  candidate.b_robust_resection = bResection;
 
   if (!bResection)
     return false;
@@ -1042,6 +1107,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
   // We use a local scene with only the 3D points and the new camera.
   {
     const bool b_new_intrinsic = (optional_intrinsic == nullptr);
+    candidate.b_new_intrinsic = b_new_intrinsic;
     // A valid pose has been found (try to refine it):
     // If no valid intrinsic as input:
     //  init a new one from the projection matrix decomposition
@@ -1097,7 +1163,64 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
     {
       return false;
     }
+  }
+  candidate.b_resection = true;
+  return true;
+}
+
+bool SequentialSfMReconstructionEngine::AddResection
+(
+  const Resection_Candidate & candidate
+)
+{
+  const uint32_t viewIndex = candidate.view_index;
+  const View * view_I = sfm_data_.GetViews().at(viewIndex).get();
+  const Image_Localizer_Match_Data & resection_data = candidate.resection_data;
+
+  if (candidate.match_count == 0)
+  {
+    // No match. The image has no connection with already reconstructed points.
+    std::cout << std::endl
+      << "-------------------------------" << "\n"
+      << "-- Resection of camera index: " << viewIndex << "\n"
+      << "-- Resection status: " << "FAILED" << "\n"
+      << "-------------------------------" << std::endl;
+    return false;
+  }
+
+  std::cout << std::endl
+    << "-------------------------------" << std::endl
+    << "-- Robust Resection of view: " << viewIndex << std::endl;
+  const bool bResection = candidate.b_robust_resection;
+  if (!sLogging_file_.empty())
+  {
+    using namespace htmlDocument;
+    std::ostringstream os;
+    os << "Resection of Image index: <" << viewIndex << "> image: "
+      << view_I->s_Img_path <<"<br> \n";
+    html_doc_stream_->pushInfo(htmlMarkup("h1",os.str()));
 
+    os.str("");
+    os << std::endl
+      << "-------------------------------" << "<br>"
+      << "-- Robust Resection of camera index: <" << viewIndex << "> image: "
+      <<  view_I->s_Img_path <<"<br>"
+      << "-- Threshold: " << resection_data.error_max << "<br>"
+      << "-- Resection status: " << (bResection ? "OK" : "FAILED") << "<br>"
+      << "-- Nb points used for Resection: " << candidate.match_count << "<br>"
+      << "-- Nb points validated by robust estimation: " << resection_data.vec_inliers.size() << "<br>"
+      << "-- % points validated: "
+      << resection_data.vec_inliers.size()/static_cast<float>(candidate.match_count) << "<br>"
+      << "-------------------------------" << "<br>";
+    html_doc_stream_->pushInfo(os.str());
+  }
+
+  if (!candidate.b_resection)
+    return false;
+
+  {
+    const geometry::Pose3 & pose = candidate.pose;
+    const bool b_new_intrinsic = candidate.b_new_intrinsic;
     // E. Update the global scene with:
     // - the new found camera pose
     sfm_data_.poses[view_I->id_pose] = pose;
@@ -1119,7 +1242,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
         new_intrinsic_id = (*existing_intrinsicId.rbegin())+1;
       }
       sfm_data_.views.at(viewIndex)->id_intrinsic = new_intrinsic_id;
-      sfm_data_.intrinsics[new_intrinsic_id] = optional_intrinsic;
+      sfm_data_.intrinsics[new_intrinsic_id] = candidate.intrinsic;
     }
   }
 
@@ -1136,14 +1259,17 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
     // Vector of all already reconstructed views
     const std::set<IndexT> valid_views = Get_Valid_Views(sfm_data_);
 
+    // List the tracks of the view
+    const auto view_tracks = map_tracks_.TracksInView(I);
+
     // Go through each track and look if we must add new view observations or new 3D points
-    for (const std::pair<uint32_t, tracks::submapTrack>& trackIt : map_tracksCommon)
+    for (const auto & view_track : view_tracks)
     {
-      const uint32_t trackId = trackIt.first;
-      const tracks::submapTrack & track = trackIt.second;
+      const uint32_t trackId = map_tracks_.TrackId(view_track.first);
+      const uint32_t featId_I = view_track.second;
 
-      // List the potential view observations of the track
-      const tracks::submapTrack & allViews_of_track = map_tracks_[trackId];
+      // List the potential view observations of the track {ImageId, FeatureId}
+      const auto allViews_of_track = map_tracks_.Track(view_track.first);
 
       // List to save the new view observations that must be added to the track
       std::set<IndexT> new_track_observations_valid_views;
@@ -1157,7 +1283,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
       else
       {
         // Go through the views that observe this track & look if a successful triangulation can be done
-        for (const std::pair<IndexT, IndexT>& trackViewIt : allViews_of_track)
+        for (const auto & trackViewIt : allViews_of_track)
         {
           const IndexT & J = trackViewIt.first;
           // If view is valid try triangulation
@@ -1173,10 +1299,10 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
               const View * view_J = sfm_data_.GetViews().at(J).get();
               const IntrinsicBase * cam_J = sfm_data_.GetIntrinsics().at(view_J->id_intrinsic).get();
               const Pose3 pose_J = sfm_data_.GetPoseOrDie(view_J);
-              const Vec2 xJ = features_provider_->feats_per_view.at(J)[allViews_of_track.at(J)].coords().cast<double>();
+              const Vec2 xJ = features_provider_->feats_per_view.at(J)[trackViewIt.second].coords().cast<double>();
 
               // Position of the point in view I
-              const Vec2 xI = features_provider_->feats_per_view.at(I)[track.at(I)].coords().cast<double>();
+              const Vec2 xI = features_provider_->feats_per_view.at(I)[featId_I].coords().cast<double>();
 
               // Try to triangulate a 3D point from J view
               // A new 3D point must be added
@@ -1238,7 +1364,9 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
           const View * view_J = sfm_data_.GetViews().at(J).get();
           const IntrinsicBase * cam_J = sfm_data_.GetIntrinsics().at(view_J->id_intrinsic).get();
           const Pose3 pose_J = sfm_data_.GetPoseOrDie(view_J);
-          const Vec2 xJ = features_provider_->feats_per_view.at(J)[allViews_of_track.at(J)].coords().cast<double>();
+          uint32_t featId_J;
+          map_tracks_.FindFeature(view_track.first, J, featId_J);
+          const Vec2 xJ = features_provider_->feats_per_view.at(J)[featId_J].coords().cast<double>();
           const Vec2 xJ_ud = cam_J->get_ud_pixel(xJ);
 
           const Vec2 residual = cam_J->residual(pose_J(landmark.X), xJ);
@@ -1246,7 +1374,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
               && residual.norm() < std::max(4.0, map_ACThreshold_.at(J))
              )
           {
-            landmark.obs[J] = Observation(xJ, allViews_of_track.at(J));
+            landmark.obs[J] = Observation(xJ, featId_J);
           }
         }
       }
@@ -1273,7 +1401,12 @@ bool SequentialSfMReconstructionEngine::BundleAdjustment()
   {
     options.linear_solver_type_ = ceres::DENSE_SCHUR;
   }
-  Bundle_Adjustment_Ceres bundle_adjustment_obj(options);
+  // The Ceres problem is kept between the calls:
+  //  only the new (or removed) observations, views and landmarks are updated.
+  if (!bundle_adjustment_)
+    bundle_adjustment_.reset(new Bundle_Adjustment_Ceres_Incremental(options));
+  else
+    bundle_adjustment_->ceres_options() = options;
   const Optimize_Options ba_refine_options
     ( ReconstructionEngine::intrinsic_refinement_options_,
       Extrinsic_Parameter_Type::ADJUST_ALL, // Adjust camera motion
@@ -1281,7 +1414,121 @@ bool SequentialSfMReconstructionEngine::BundleAdjustment()
       Control_Point_Parameter(),
       this->b_use_motion_prior_
     );
-  return bundle_adjustment_obj.Adjust(sfm_data_, ba_refine_options);
+  return bundle_adjustment_->Adjust(sfm_data_, ba_refine_options);
+}
+
+/// Local bundle adjustment:
+/// - the local views are the given views and their most covisible reconstructed views,
+/// - the landmarks seen by the local views are refined,
+/// - the other views observing these landmarks constrain the problem with a constant pose,
+/// - the intrinsics are held constant.
+bool SequentialSfMReconstructionEngine::LocalBundleAdjustment
+(
+  const std::set<IndexT> & view_ids
+)
+{
+  // Count the landmarks shared by the given views and the other reconstructed views
+  std::map<IndexT, size_t> covisibility;
+  for (const auto & landmark_entry : sfm_data_.GetLandmarks())
+  {
+    const Observations & obs = landmark_entry.second.obs;
+    const bool b_seen = std::any_of(obs.cbegin(), obs.cend(),
+      [&](const Observations::value_type & observation)
+      { return view_ids.count(observation.first) != 0; });
+    if (!b_seen)
+      continue;
+    for (const auto & observation : obs)
+    {
+      if (view_ids.count(observation.first) == 0)
+        ++covisibility[observation.first];
+    }
+  }
+  // Keep the most covisible views (ties are broken by view id)
+  std::vector<std::pair<size_t, IndexT>> covisible_views;
+  for (const auto & covisible_view : covisibility)
+    covisible_views.emplace_back(covisible_view.second, covisible_view.first);
+  std::sort(covisible_views.begin(), covisible_views.end(),
+    [](const std::pair<size_t, IndexT> & a, const std::pair<size_t, IndexT> & b)
+    { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+  std::set<IndexT> local_view_ids = view_ids;
+  for (size_t i = 0; i < std::min<size_t>(covisible_views.size(), local_ba_covisible_view_count_); ++i)
+    local_view_ids.insert(covisible_views[i].second);
+
+  // Local scene: the landmarks seen by the local views and all their observing views
+  SfM_Data local_scene;
+  for (const auto & landmark_entry : sfm_data_.GetLandmarks())
+  {
+    const Observations & obs = landmark_entry.second.obs;
+    const bool b_local = std::any_of(obs.cbegin(), obs.cend(),
+      [&](const Observations::value_type & observation)
+      { return local_view_ids.count(observation.first) != 0; });
+    if (!b_local)
+      continue;
+    local_scene.structure.insert(landmark_entry);
+    for (const auto & observation : obs)
+    {
+      if (local_scene.views.count(observation.first) == 0)
+      {
+        const std::shared_ptr<View> & view = sfm_data_.views.at(observation.first);
+        local_scene.views[view->id_view] = view;
+        local_scene.poses[view->id_pose] = sfm_data_.poses.at(view->id_pose);
+        // The intrinsics are shared with the global scene
+        //  (held constant: only the full BA refines them)
+        local_scene.intrinsics[view->id_intrinsic] = sfm_data_.intrinsics.at(view->id_intrinsic);
+      }
+    }
+  }
+
+  Bundle_Adjustment_Ceres::BA_Ceres_options options;
+  options.linear_solver_type_ = ceres::DENSE_SCHUR;
+  if ( local_scene.GetPoses().size() > 100 &&
+      (ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::SUITE_SPARSE) ||
+       ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::CX_SPARSE) ||
+       ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::EIGEN_SPARSE))
+      )
+  {
+    options.preconditioner_type_ = ceres::JACOBI;
+    options.linear_solver_type_ = ceres::SPARSE_SCHUR;
+  }
+  Bundle_Adjustment_Ceres bundle_adjustment_obj(options);
+  Optimize_Options ba_refine_options
+    ( Intrinsic_Parameter_Type::NONE,       // Intrinsics are held constant
+      Extrinsic_Parameter_Type::ADJUST_ALL, // Adjust camera motion
+      Structure_Parameter_Type::ADJUST_ALL  // Adjust scene structure
+    );
+  // Hold the boundary poses as constant
+  for (const auto & view_entry : local_scene.views)
+  {
+    if (local_view_ids.count(view_entry.first) == 0)
+      ba_refine_options.constant_poses.insert(view_entry.second->id_pose);
+  }
+  for (const auto & view_entry : local_scene.views)
+  {
+    if (local_view_ids.count(view_entry.first) != 0)
+      ba_refine_options.constant_poses.erase(view_entry.second->id_pose);
+  }
+
+  if (options.bVerbose_)
+  {
+    std::cout << "Local BA: #views " << local_view_ids.size()
+      << " (#constant poses " << ba_refine_options.constant_poses.size() << ")"
+      << ", #landmarks " << local_scene.structure.size() << std::endl;
+  }
+
+  if (!bundle_adjustment_obj.Adjust(local_scene, ba_refine_options))
+    return false;
+
+  // Update the global scene
+  for (const auto & pose_entry : local_scene.poses)
+  {
+    if (ba_refine_options.constant_poses.count(pose_entry.first) == 0)
+      sfm_data_.poses[pose_entry.first] = pose_entry.second;
+  }
+  for (const auto & landmark_entry : local_scene.structure)
+  {
+    sfm_data_.structure.at(landmark_entry.first).X = landmark_entry.second.X;
+  }
+  return true;
 }
 
 /**
@@ -9,6 +9,7 @@
 #ifndef OPENMVG_SFM_LOCALIZATION_SEQUENTIAL_SFM_HPP
 #define OPENMVG_SFM_LOCALIZATION_SEQUENTIAL_SFM_HPP
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@ namespace { template <typename T> class Histogram; }
 namespace openMVG {
 namespace sfm {
 
+class Bundle_Adjustment_Ceres_Incremental;
 struct Features_Provider;
 struct Matches_Provider;
 
@@ -82,6 +84,29 @@ public:
     triangulation_method_ = method;
   }
 
+  /**
+   * Use a local bundle adjustment after each resection group:
+   *  the new views, their most covisible views and the landmarks they see are
+   *  refined, the other views observing these landmarks and the intrinsics are
+   *  held as constant.
+   * A full bundle adjustment is still run every full_ba_period resection groups,
+   *  or when the mean residual grows more than drift_ratio times the one of the
+   *  last full bundle adjustment.
+   *
+   * full_ba_period == 0: full bundle adjustment after each group (default)
+   */
+  void SetLocalBundleAdjustment
+  (
+    const unsigned int full_ba_period,
+    const unsigned int covisible_view_count = 10,
+    const double drift_ratio = 1.5
+  )
+  {
+    local_ba_full_period_ = full_ba_period;
+    local_ba_covisible_view_count_ = covisible_view_count;
+    local_ba_drift_ratio_ = drift_ratio;
+  }
+
 protected:
 
 
@@ -96,9 +121,22 @@ protected:
   /// Add a single Image to the scene and triangulate new possible tracks.
   bool Resection(const uint32_t imageIndex);
 
+  /// Robust pose of a candidate view (computed against the current structure)
+  struct Resection_Candidate;
+
+  /// Compute and refine the pose of a view from its 2D-3D matches.
+  /// The scene is not modified (can be run concurrently for several views).
+  bool ComputeResection(const uint32_t imageIndex, Resection_Candidate & candidate) const;
+
+  /// Add a resected view to the scene (pose, intrinsic) and triangulate new possible tracks.
+  bool AddResection(const Resection_Candidate & candidate);
+
   /// Bundle adjustment to refine Structure; Motion and Intrinsics
   bool BundleAdjustment();
 
+  /// Bundle adjustment of the given views, their most covisible views and their landmarks
+  bool LocalBundleAdjustment(const std::set<IndexT> & view_ids);
+
   /// Discard track with too large residual error
   bool badTrackRejector(double dPrecision, size_t count = 0);
 
@@ -119,16 +157,23 @@ protected:
   Matches_Provider  * matches_provider_;
 
   // Temporary data
-  openMVG::tracks::STLMAPTracks map_tracks_; // putative landmark tracks (visibility per 3D point)
-
-  // Helper to compute if some image have some track in common
-  std::unique_ptr<openMVG::tracks::SharedTrackVisibilityHelper> shared_track_visibility_helper_;
+  // Putative landmark tracks (visibility per 3D point)
+  //  stored contiguously with a per view index to list the tracks observed by an image
+  openMVG::tracks::FlatTracks map_tracks_;
 
   Hash_Map<IndexT, double> map_ACThreshold_; // Per camera confidence (A contrario estimated threshold error)
 
   std::set<uint32_t> set_remaining_view_id_;     // Remaining camera index that can be used for resection
 
   ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
+
+  // Local bundle adjustment parameters (see SetLocalBundleAdjustment)
+  unsigned int local_ba_full_period_ = 0;
+  unsigned int local_ba_covisible_view_count_ = 10;
+  double local_ba_drift_ratio_ = 1.5;
+
+  // Persistent bundle adjustment problem (reused by the successive BundleAdjustment calls)
+  std::unique_ptr<Bundle_Adjustment_Ceres_Incremental> bundle_adjustment_;
 };
 
 } // namespace sfm
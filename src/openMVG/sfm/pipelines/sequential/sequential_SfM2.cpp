@@ -14,6 +14,7 @@
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_BA.hpp"
 #include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_incremental.hpp"
 #include "openMVG/sfm/sfm_data_filters.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/sfm/sfm_data_triangulation.hpp"
@@ -520,7 +521,12 @@ bool SequentialSfMReconstructionEngine2::BundleAdjustment()
   {
     options.linear_solver_type_ = ceres::DENSE_SCHUR;
   }
-  Bundle_Adjustment_Ceres bundle_adjustment_obj(options);
+  // The Ceres problem is kept between the calls:
+  //  only the new (or removed) observations, views and landmarks are updated.
+  if (!bundle_adjustment_)
+    bundle_adjustment_.reset(new Bundle_Adjustment_Ceres_Incremental(options));
+  else
+    bundle_adjustment_->ceres_options() = options;
   const Optimize_Options ba_refine_options
     ( ReconstructionEngine::intrinsic_refinement_options_,
       Extrinsic_Parameter_Type::ADJUST_ALL, // Adjust camera motion
@@ -528,7 +534,7 @@ bool SequentialSfMReconstructionEngine2::BundleAdjustment()
       Control_Point_Parameter(),
       this->b_use_motion_prior_
     );
-  return bundle_adjustment_obj.Adjust(sfm_data_, ba_refine_options);
+  return bundle_adjustment_->Adjust(sfm_data_, ba_refine_options);
 }
 
 } // namespace sfm
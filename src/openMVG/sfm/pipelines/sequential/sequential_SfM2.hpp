@@ -9,6 +9,7 @@
 #ifndef OPENMVG_SFM_LOCALIZATION_SEQUENTIAL2_SFM_HPP
 #define OPENMVG_SFM_LOCALIZATION_SEQUENTIAL2_SFM_HPP
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -23,6 +24,7 @@ namespace htmlDocument { class htmlDocumentStream; }
 namespace openMVG {
 namespace sfm {
 
+class Bundle_Adjustment_Ceres_Incremental;
 struct Features_Provider;
 struct Matches_Provider;
 class SfMSceneInitializer;
@@ -104,6 +106,9 @@ private:
 
   /// 2View triangulation method used in the robust triangulation engine
   ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
+
+  /// Persistent bundle adjustment problem (reused by the successive BundleAdjustment calls)
+  std::unique_ptr<Bundle_Adjustment_Ceres_Incremental> bundle_adjustment_;
 };
 
 } // namespace sfm
@@ -23,15 +23,32 @@
 
 #include "testing/testing.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <map>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
 
 using namespace openMVG;
 using namespace openMVG::cameras;
 using namespace openMVG::geometry;
 using namespace openMVG::sfm;
 
+// Sequential engine that exposes its local bundle adjustment
+class Local_BA_Engine : public SequentialSfMReconstructionEngine
+{
+public:
+  using SequentialSfMReconstructionEngine::SequentialSfMReconstructionEngine;
+  using SequentialSfMReconstructionEngine::LocalBundleAdjustment;
+
+  SfM_Data & Scene() { return sfm_data_; }
+};
 
 // Test a scene where all the camera intrinsics are known
 TEST(SEQUENTIAL_SFM, Known_Intrinsics) {
@@ -39,6 +56,8 @@ TEST(SEQUENTIAL_SFM, Known_Intrinsics) {
   const int nviews = 6;
   const int npoints = 32;
   const nViewDatasetConfigurator config;
+  // The scene does not depend on the tests run before (drawn with std::rand)
+  std::srand(1);
   const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
 
   // Translate the input dataset to a SfM_Data scene
@@ -92,6 +111,8 @@ TEST(SEQUENTIAL_SFM, Partially_Known_Intrinsics) {
   const int nviews = 6;
   const int npoints = 32;
   const nViewDatasetConfigurator config;
+  // The scene does not depend on the tests run before (drawn with std::rand)
+  std::srand(1);
   const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
 
   // Translate the input dataset to a SfM_Data scene
@@ -148,6 +169,221 @@ TEST(SEQUENTIAL_SFM, Partially_Known_Intrinsics) {
   EXPECT_TRUE( IsTracksOneCC(sfmEngine.Get_SfM_Data()));
 }
 
+// Local bundle adjustment of a perturbed view of a reconstructed scene:
+// - the boundary poses and the intrinsics are held constant,
+// - the residual is close to the one of a full bundle adjustment.
+TEST(SEQUENTIAL_SFM, Local_BundleAdjustment) {
+
+  const int nviews = 6;
+  const int npoints = 32;
+  const nViewDatasetConfigurator config;
+  // The scene does not depend on the tests run before (drawn with std::rand)
+  std::srand(1);
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  // Translate the input dataset to a SfM_Data scene
+  const SfM_Data sfm_data = getInputScene(d, config, PINHOLE_CAMERA);
+
+  // Remove poses and structure
+  SfM_Data sfm_data_2 = sfm_data;
+  sfm_data_2.poses.clear();
+  sfm_data_2.structure.clear();
+
+  Local_BA_Engine sfmEngine(sfm_data_2, "./");
+
+  // Configure the features_provider & the matches_provider from the synthetic dataset
+  std::shared_ptr<Features_Provider> feats_provider =
+    std::make_shared<Synthetic_Features_Provider>();
+  // Add a tiny noise in 2D observations to make data more realistic
+  std::normal_distribution<double> distribution(0.0,0.5);
+  dynamic_cast<Synthetic_Features_Provider*>(feats_provider.get())->load(d,distribution);
+
+  std::shared_ptr<Matches_Provider> matches_provider =
+    std::make_shared<Synthetic_Matches_Provider>();
+  dynamic_cast<Synthetic_Matches_Provider*>(matches_provider.get())->load(d);
+
+  // Configure data provider (Features and Matches)
+  sfmEngine.SetFeaturesProvider(feats_provider.get());
+  sfmEngine.SetMatchesProvider(matches_provider.get());
+
+  // Configure reconstruction parameters (intrinsic parameters are held constant)
+  sfmEngine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+
+  // Will use view ids (0,1) as the initial pair
+  sfmEngine.setInitialPair({sfm_data_2.GetViews().at(0)->id_view,
+                            sfm_data_2.GetViews().at(1)->id_view});
+
+  EXPECT_TRUE (sfmEngine.Process());
+  EXPECT_TRUE( sfmEngine.Get_SfM_Data().GetPoses().size() == nviews);
+
+  // Perturb the pose of the last view
+  SfM_Data & scene = sfmEngine.Scene();
+  const IndexT moved_pose_id = scene.GetViews().at(nviews - 1)->id_pose;
+  const Pose3 reconstructed_pose = scene.poses.at(moved_pose_id);
+  scene.poses[moved_pose_id] = Pose3(
+    Eigen::AngleAxisd(D2R(1.0), Vec3::UnitY()).toRotationMatrix() * reconstructed_pose.rotation(),
+    reconstructed_pose.center() + Vec3(0.05, -0.05, 0.05));
+  const Poses perturbed_poses = scene.poses;
+  const Landmarks perturbed_structure = scene.structure;
+  std::map<IndexT, std::vector<double>> intrinsic_params;
+  for (const auto & intrinsic : scene.GetIntrinsics())
+    intrinsic_params[intrinsic.first] = intrinsic.second->getParams();
+
+  // Local BA of the perturbed view only (no covisible view is added):
+  //  the intrinsics must stay constant even if the engine refines them
+  sfmEngine.SetLocalBundleAdjustment(1, 0);
+  sfmEngine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::ADJUST_ALL);
+  EXPECT_TRUE(sfmEngine.LocalBundleAdjustment({static_cast<IndexT>(nviews - 1)}));
+
+  // The boundary poses are unchanged, the perturbed one is refined
+  for (const auto & pose : perturbed_poses)
+  {
+    if (pose.first == moved_pose_id)
+      continue;
+    EXPECT_TRUE(pose.second.rotation() == scene.poses.at(pose.first).rotation());
+    EXPECT_TRUE(pose.second.center() == scene.poses.at(pose.first).center());
+  }
+  EXPECT_NEAR(0.0,
+    (scene.poses.at(moved_pose_id).center() - reconstructed_pose.center()).norm(), 1e-2);
+  for (const auto & intrinsic : scene.GetIntrinsics())
+    EXPECT_TRUE(intrinsic_params.at(intrinsic.first) == intrinsic.second->getParams());
+
+  // Full BA of the same perturbed scene (intrinsics held constant)
+  SfM_Data full_ba_scene = scene;
+  full_ba_scene.poses = perturbed_poses;
+  full_ba_scene.structure = perturbed_structure;
+  Bundle_Adjustment_Ceres bundle_adjustment_obj;
+  EXPECT_TRUE(bundle_adjustment_obj.Adjust(full_ba_scene,
+    Optimize_Options(
+      cameras::Intrinsic_Parameter_Type::NONE,
+      Extrinsic_Parameter_Type::ADJUST_ALL,
+      Structure_Parameter_Type::ADJUST_ALL)));
+
+  const double local_ba_residual = RMSE(scene);
+  const double full_ba_residual = RMSE(full_ba_scene);
+  std::cout << "RMSE residual (local BA): " << local_ba_residual
+    << ", (full BA): " << full_ba_residual << std::endl;
+  EXPECT_NEAR(full_ba_residual, local_ba_residual, 0.05);
+}
+
+#ifdef OPENMVG_USE_OPENMP
+// Sequential reconstruction of a synthetic scene (2D observations with a tiny noise)
+bool Sequential_Reconstruction
+(
+  const NViewDataSet & d,
+  const nViewDatasetConfigurator & config,
+  SfM_Data & reconstruction
+)
+{
+  SfM_Data sfm_data = getInputScene(d, config, PINHOLE_CAMERA);
+  sfm_data.poses.clear();
+  sfm_data.structure.clear();
+
+  SequentialSfMReconstructionEngine sfmEngine(sfm_data, "./");
+
+  std::shared_ptr<Features_Provider> feats_provider =
+    std::make_shared<Synthetic_Features_Provider>();
+  std::normal_distribution<double> distribution(0.0, 0.5);
+  dynamic_cast<Synthetic_Features_Provider*>(feats_provider.get())->load(d,distribution);
+
+  std::shared_ptr<Matches_Provider> matches_provider =
+    std::make_shared<Synthetic_Matches_Provider>();
+  dynamic_cast<Synthetic_Matches_Provider*>(matches_provider.get())->load(d);
+
+  sfmEngine.SetFeaturesProvider(feats_provider.get());
+  sfmEngine.SetMatchesProvider(matches_provider.get());
+  sfmEngine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+  sfmEngine.setInitialPair({sfm_data.GetViews().at(0)->id_view,
+                            sfm_data.GetViews().at(1)->id_view});
+
+  if (!sfmEngine.Process())
+    return false;
+  reconstruction = sfmEngine.Get_SfM_Data();
+  return true;
+}
+
+// Residual of each observation (in landmark and view order)
+std::vector<double> Observation_Residuals(const SfM_Data & sfm_data)
+{
+  std::vector<double> residuals;
+  for (const auto & landmark : sfm_data.GetLandmarks())
+  {
+    for (const auto & observation : landmark.second.obs)
+    {
+      const View * view = sfm_data.GetViews().at(observation.first).get();
+      const IntrinsicBase * intrinsic = sfm_data.GetIntrinsics().at(view->id_intrinsic).get();
+      residuals.push_back(intrinsic->residual(
+        sfm_data.GetPoseOrDie(view)(landmark.second.X), observation.second.x).norm());
+    }
+  }
+  return residuals;
+}
+
+// The reconstruction does not depend on the number of threads
+//  (the candidate views are resected in parallel, then added in a fixed order).
+// Same poses, landmarks and observations; the values are compared up to the
+//  rounding of the bundle adjustment (a multithreaded Ceres sums its per thread
+//  costs in an order that depends on the number of threads).
+TEST(SEQUENTIAL_SFM, Same_Reconstruction_For_Any_Thread_Count) {
+
+  const int nviews = 12;
+  const int npoints = 64;
+  const nViewDatasetConfigurator config;
+  // The scene does not depend on the tests run before (drawn with std::rand)
+  std::srand(1);
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  const int max_thread_count = omp_get_max_threads();
+  SfM_Data sfm_data_1, sfm_data_n;
+  omp_set_num_threads(1);
+  EXPECT_TRUE(Sequential_Reconstruction(d, config, sfm_data_1));
+  omp_set_num_threads(std::max(4, max_thread_count));
+  EXPECT_TRUE(Sequential_Reconstruction(d, config, sfm_data_n));
+  omp_set_num_threads(max_thread_count);
+
+  // Same poses
+  EXPECT_EQ(nviews, sfm_data_1.GetPoses().size());
+  EXPECT_EQ(sfm_data_1.GetPoses().size(), sfm_data_n.GetPoses().size());
+  for (const auto & pose : sfm_data_1.GetPoses())
+  {
+    EXPECT_TRUE(sfm_data_n.GetPoses().count(pose.first) == 1);
+    if (sfm_data_n.GetPoses().count(pose.first) == 0)
+      continue;
+    EXPECT_MATRIX_NEAR(pose.second.rotation(),
+      sfm_data_n.GetPoses().at(pose.first).rotation(), 1e-8);
+    EXPECT_MATRIX_NEAR(pose.second.center(),
+      sfm_data_n.GetPoses().at(pose.first).center(), 1e-8);
+  }
+
+  // Same structure
+  EXPECT_EQ(sfm_data_1.GetLandmarks().size(), sfm_data_n.GetLandmarks().size());
+  for (const auto & landmark : sfm_data_1.GetLandmarks())
+  {
+    EXPECT_TRUE(sfm_data_n.GetLandmarks().count(landmark.first) == 1);
+    if (sfm_data_n.GetLandmarks().count(landmark.first) == 0)
+      continue;
+    const Landmark & landmark_n = sfm_data_n.GetLandmarks().at(landmark.first);
+    EXPECT_MATRIX_NEAR(landmark.second.X, landmark_n.X, 1e-8);
+    EXPECT_EQ(landmark.second.obs.size(), landmark_n.obs.size());
+    for (const auto & observation : landmark.second.obs)
+    {
+      EXPECT_TRUE(landmark_n.obs.count(observation.first) == 1);
+      if (landmark_n.obs.count(observation.first) == 0)
+        continue;
+      EXPECT_EQ(observation.second.id_feat, landmark_n.obs.at(observation.first).id_feat);
+    }
+  }
+
+  // Same residuals
+  const std::vector<double> residuals_1 = Observation_Residuals(sfm_data_1);
+  const std::vector<double> residuals_n = Observation_Residuals(sfm_data_n);
+  EXPECT_EQ(residuals_1.size(), residuals_n.size());
+  for (size_t i = 0; i < std::min(residuals_1.size(), residuals_n.size()); ++i)
+    EXPECT_NEAR(residuals_1[i], residuals_n[i], 1e-8);
+  EXPECT_NEAR(RMSE(sfm_data_1), RMSE(sfm_data_n), 1e-8);
+}
+#endif
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -13,6 +13,7 @@
 
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/types.hpp"
 
@@ -35,13 +36,36 @@ struct Matches_Provider
     {
       return false;
     }
+    const Views & views = sfm_data.GetViews();
+    // Indexed matches file: read only the pairs defined in SfM_Data
+    if (matching::IsPairWiseMatchesStreamFile(matchesfile))
+    {
+      pairWise_matches_.clear();
+      matching::PairWiseMatchesStreamReader reader;
+      if (!reader.Open(matchesfile)) {
+        std::cerr<< "Unable to read the matches file:" << matchesfile << std::endl;
+        return false;
+      }
+      for (size_t i = 0; i < reader.PairCount(); ++i)
+      {
+        const Pair & pair = reader.GetPair(i);
+        if (views.find(pair.first) != views.end() &&
+          views.find(pair.second) != views.end())
+        {
+          if (!reader.Read(pair, pairWise_matches_[pair])) {
+            std::cerr<< "Unable to read the matches file:" << matchesfile << std::endl;
+            return false;
+          }
+        }
+      }
+      return true;
+    }
     if (!matching::Load(pairWise_matches_, matchesfile)) {
       std::cerr<< "Unable to read the matches file:" << matchesfile << std::endl;
       return false;
     }
     // Filter to keep only the one defined in SfM_Data
     {
-      const Views & views = sfm_data.GetViews();
       matching::PairWiseMatches matches_saved;
       for (matching::PairWiseMatches::const_iterator iter = pairWise_matches_.begin();
         iter != pairWise_matches_.end();
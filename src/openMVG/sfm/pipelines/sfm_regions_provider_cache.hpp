@@ -13,8 +13,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <list>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 
@@ -23,6 +27,9 @@ namespace sfm {
 
 /// Regions provider Cache
 /// Store only a given count of regions in memory
+/// - regions are loaded on demand, concurrent requests for other views are not
+///   blocked by a disk access,
+/// - the least recently used regions are evicted first.
 struct Regions_Provider_Cache : public Regions_Provider
 {
 public:
@@ -37,34 +44,48 @@ public:
 
   std::shared_ptr<features::Regions> get(const IndexT x) const override
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Wait if the ressource is being loaded by another thread
+    loading_condition_.wait(lock, [&]{ return loading_.count(x) == 0; });
+
     auto it = cache_.find(x);
-    std::shared_ptr<features::Regions> ret;
+    if (it != end(cache_))
+    {
+      touch(x);
+      return it->second;
+    }
 
-    if (it == end(cache_))
+    // Load the ressource link to this ID
+    //  (the lock is released so other requests are not blocked by the disk access)
+    loading_.insert(x);
+    lock.unlock();
+
+    const std::string id =
+      stlplus::create_filespec(feat_directory_, map_id_string_.at(x));
+    const std::string featFile = id + ".feat";
+    const std::string descFile = id + ".desc";
+    std::shared_ptr<features::Regions> ret(region_type_->EmptyClone());
+    const bool bLoaded = ret->Load(featFile, descFile);
+
+    lock.lock();
+    loading_.erase(x);
+    if (bLoaded)
     {
-      // Load the ressource link to this ID
-      const std::string id =
-        stlplus::create_filespec(feat_directory_, map_id_string_.at(x));
-      const std::string featFile = id + ".feat";
-      const std::string descFile = id + ".desc";
-      ret.reset(region_type_->EmptyClone());
-      if (ret->Load(featFile, descFile))
-      {
-        cache_[x] = ret;
-      }
-      // else -> Invalid ressource -> an empty smart poiter is returned
+      cache_[x] = ret;
+      touch(x);
     }
     else
     {
-      ret = it->second;
+      ret.reset(); // Invalid ressource -> an empty smart pointer is returned
     }
     // If the cache is too large:
-    //  - try to prune elements that are no longer used
+    //  - try to prune the least recently used elements that are no longer used
     if (size() > max_cache_size_)
     {
-      prune(true); // Prune only one cached object
+      prune(size() - max_cache_size_);
     }
+    lock.unlock();
+    loading_condition_.notify_all();
     return ret;
   }
 
@@ -96,6 +117,12 @@ public:
 private:
 
   mutable std::mutex mutex_; // To deal with multithread concurrent access
+  mutable std::condition_variable loading_condition_; // Signal the end of a regions loading
+  mutable std::set<openMVG::IndexT> loading_; // View ids for which the regions are being loaded
+
+  // Least recently used ordering of the cached view ids (most recent first)
+  mutable std::list<openMVG::IndexT> lru_;
+  mutable Hash_Map<openMVG::IndexT, std::list<openMVG::IndexT>::iterator> lru_position_;
 
   std::string feat_directory_; // The regions file directory
   std::map<openMVG::IndexT, std::string> map_id_string_; // association of the view id & its basename
@@ -103,21 +130,39 @@ private:
 
 private:
 
+  /// @brief Mark a cached element as the most recently used one
+  void touch(const openMVG::IndexT x) const
+  {
+    auto it = lru_position_.find(x);
+    if (it != lru_position_.end())
+    {
+      lru_.splice(lru_.begin(), lru_, it->second);
+    }
+    else
+    {
+      lru_.push_front(x);
+      lru_position_[x] = lru_.begin();
+    }
+  }
+
   /// @brief Prune smart_ptr that are only referenced into the cache (not longer used externally)
+  ///  The least recently used elements are pruned first.
+  /// @param max_count the maximal number of elements to remove
   /// @return the number of removed elements
-  std::size_t prune(bool bPruneOnlyOne = false) const
+  std::size_t prune(const std::size_t max_count) const
   {
     std::size_t count = 0;
-    for (auto it = begin(cache_); it != end(cache_);)
+    for (auto it = lru_.rbegin(); it != lru_.rend() && count < max_count;)
     {
-      if (it->second.use_count() == 1)
+      const openMVG::IndexT x = *it;
+      auto it_cache = cache_.find(x);
+      if (it_cache == end(cache_) || it_cache->second.use_count() == 1)
       {
-        cache_.erase(it++);
+        if (it_cache != end(cache_))
+          cache_.erase(it_cache);
+        lru_position_.erase(x);
+        it = std::list<openMVG::IndexT>::reverse_iterator(lru_.erase(std::next(it).base()));
         ++count;
-        if (bPruneOnlyOne)
-        {
-          break;
-        }
       }
       else
       {
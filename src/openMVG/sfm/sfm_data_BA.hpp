@@ -9,7 +9,10 @@
 #ifndef OPENMVG_SFM_SFM_DATA_BA_HPP
 #define OPENMVG_SFM_SFM_DATA_BA_HPP
 
+#include <set>
+
 #include "openMVG/cameras/Camera_Common.hpp"
+#include "openMVG/types.hpp"
 
 namespace openMVG {
 namespace sfm {
@@ -57,6 +60,9 @@ struct Optimize_Options
 
   bool local_opt;
 
+  // Poses held as constant whatever extrinsics_opt (i.e. the boundary of a local BA)
+  std::set<IndexT> constant_poses;
+
   Optimize_Options
   (
     const cameras::Intrinsic_Parameter_Type intrinsics = cameras::Intrinsic_Parameter_Type::ADJUST_ALL,
@@ -21,6 +21,7 @@
 //- Robust estimation - LMeds (since no threshold can be defined)
 #include "openMVG/robust_estimation/robust_estimator_LMeds.hpp"
 #include "openMVG/sfm/sfm_data_BA_ceres_camera_functor.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_camera_functor_analytic.hpp"
 #include "openMVG/sfm/sfm_data_transform.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/types.hpp"
@@ -82,9 +83,31 @@ ceres::CostFunction * IntrinsicsToCostFunction
 (
   IntrinsicBase * intrinsic,
   const Vec2 & observation,
-  const double weight
+  const double weight,
+  const bool b_analytic_derivatives
 )
 {
+  if (b_analytic_derivatives)
+  {
+    switch (intrinsic->getType())
+    {
+      case PINHOLE_CAMERA:
+        return ResidualErrorAnalytic_Pinhole_Intrinsic::Create(observation, weight);
+      case PINHOLE_CAMERA_RADIAL1:
+        return ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K1::Create(observation, weight);
+      case PINHOLE_CAMERA_RADIAL3:
+        return ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3::Create(observation, weight);
+      case PINHOLE_CAMERA_BROWN:
+        return ResidualErrorAnalytic_Pinhole_Intrinsic_Brown_T2::Create(observation, weight);
+      case PINHOLE_CAMERA_FISHEYE:
+        return ResidualErrorAnalytic_Pinhole_Intrinsic_Fisheye::Create(observation, weight);
+      case CAMERA_SPHERICAL:
+        return ResidualErrorAnalytic_Intrinsic_Spherical::Create(intrinsic, observation, weight);
+      default:
+        return {};
+    }
+  }
+
   switch (intrinsic->getType())
   {
     case PINHOLE_CAMERA:
@@ -112,7 +135,8 @@ Bundle_Adjustment_Ceres::BA_Ceres_options::BA_Ceres_options
 : bVerbose_(bVerbose),
   nb_threads_(1),
   parameter_tolerance_(1e-8), //~= numeric_limits<float>::epsilon()
-  bUse_loss_function_(true)
+  bUse_loss_function_(true),
+  bUse_analytic_derivatives_(false)
 {
   #ifdef OPENMVG_USE_OPENMP
     nb_threads_ = omp_get_max_threads();
@@ -257,7 +281,8 @@ bool Bundle_Adjustment_Ceres::Adjust
 
     double * parameter_block = &map_poses.at(indexPose)[0];
     problem.AddParameterBlock(parameter_block, 6);
-    if (options.extrinsics_opt == Extrinsic_Parameter_Type::NONE)
+    if (options.extrinsics_opt == Extrinsic_Parameter_Type::NONE
+        || options.constant_poses.count(indexPose) != 0)
     {
       // set the whole parameter block as constant for best performance
       problem.SetParameterBlockConstant(parameter_block);
@@ -346,7 +371,9 @@ bool Bundle_Adjustment_Ceres::Adjust
       // image location and compares the reprojection against the observation.
       ceres::CostFunction* cost_function =
         IntrinsicsToCostFunction(sfm_data.intrinsics.at(view->id_intrinsic).get(),
-                                 obs_it.second.x);
+                                 obs_it.second.x,
+                                 0.0,
+                                 ceres_options_.bUse_analytic_derivatives_);
 
       if (cost_function)
       {
@@ -396,7 +423,8 @@ bool Bundle_Adjustment_Ceres::Adjust
           IntrinsicsToCostFunction(
             sfm_data.intrinsics.at(view->id_intrinsic).get(),
             obs_it.second.x,
-            options.control_point_opt.weight);
+            options.control_point_opt.weight,
+            ceres_options_.bUse_analytic_derivatives_);
 
         if (cost_function)
         {
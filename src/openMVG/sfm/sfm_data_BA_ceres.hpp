@@ -21,11 +21,14 @@ namespace sfm {
 
 /// Create the appropriate cost functor according the provided input camera intrinsic model
 /// Can be residual cost functor can be weighetd if desired (default 0.0 means no weight).
+/// The Jacobians are computed by automatic differentiation or by hand-derived
+///  analytic expressions (b_analytic_derivatives).
 ceres::CostFunction * IntrinsicsToCostFunction
 (
   cameras::IntrinsicBase * intrinsic,
   const Vec2 & observation,
-  const double weight = 0.0
+  const double weight = 0.0,
+  const bool b_analytic_derivatives = false
 );
 
 class Bundle_Adjustment_Ceres : public Bundle_Adjustment
@@ -41,6 +44,7 @@ class Bundle_Adjustment_Ceres : public Bundle_Adjustment
     int sparse_linear_algebra_library_type_;
     double parameter_tolerance_;
     bool bUse_loss_function_;
+    bool bUse_analytic_derivatives_; // Use the analytic Jacobians instead of AutoDiff
 
     BA_Ceres_options(const bool bVerbose = true, bool bmultithreaded = true);
   };
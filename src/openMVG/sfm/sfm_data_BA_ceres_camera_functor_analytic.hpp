@@ -0,0 +1,529 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SFM_SFM_DATA_BA_CERES_CAMERA_FUNCTOR_ANALYTIC_HPP
+#define OPENMVG_SFM_SFM_DATA_BA_CERES_CAMERA_FUNCTOR_ANALYTIC_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <ceres/ceres.h>
+#include <ceres/rotation.h>
+
+#include "openMVG/cameras/Camera_Intrinsics.hpp"
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+
+//--
+//- Define ceres CostFunction with analytic derivatives for each OpenMVG camera model
+//- (same residuals and parameter blocks as the AutoDiff functors of
+//-  sfm_data_BA_ceres_camera_functor.hpp, without the Jet arithmetic overhead)
+//--
+
+namespace openMVG {
+namespace sfm {
+
+namespace analytic {
+
+/**
+ * @brief Transform a 3D point by a camera pose [R;t] (angle axis rotation)
+ *  and compute the Jacobians of the transformed point.
+ *
+ * @param[in] cam_extrinsics: [rX,rY,rZ,tx,ty,tz]
+ * @param[in] pos_3dpoint: the 3D point X
+ * @param[out] transformed_point: P = R(w) X + t
+ * @param[out] dP_dw: Jacobian of P with respect to the angle axis w (if not null)
+ * @param[out] R: the rotation matrix (dP/dX = R, dP/dt = Identity)
+ */
+inline void TransformPoint
+(
+  const double * const cam_extrinsics,
+  const double * const pos_3dpoint,
+  Vec3 & transformed_point,
+  Mat3 * dP_dw,
+  Mat3 & R
+)
+{
+  ceres::AngleAxisToRotationMatrix(cam_extrinsics, R.data());
+  const Vec3 rotated_point = R * Eigen::Map<const Vec3>(pos_3dpoint);
+  transformed_point = rotated_point + Eigen::Map<const Vec3>(&cam_extrinsics[3]);
+
+  if (dP_dw)
+  {
+    // dP/dw = - [R X]_x J_l(w), with J_l the left Jacobian of SO(3)
+    const Eigen::Map<const Vec3> w(cam_extrinsics);
+    const double theta2 = w.squaredNorm();
+    Mat3 W;
+    W <<  0.0, -w(2),  w(1),
+         w(2),   0.0, -w(0),
+        -w(1),  w(0),   0.0;
+    Mat3 J_l;
+    if (theta2 > std::numeric_limits<double>::epsilon())
+    {
+      const double theta = std::sqrt(theta2);
+      J_l = Mat3::Identity()
+        + ((1.0 - std::cos(theta)) / theta2) * W
+        + ((theta - std::sin(theta)) / (theta2 * theta)) * (W * W);
+    }
+    else
+    {
+      // First order Taylor expansion
+      J_l = Mat3::Identity() + 0.5 * W;
+    }
+    Mat3 RX_x;
+    RX_x <<            0.0, -rotated_point(2),  rotated_point(1),
+          rotated_point(2),               0.0, -rotated_point(0),
+         -rotated_point(1),  rotated_point(0),               0.0;
+    *dP_dw = - RX_x * J_l;
+  }
+}
+
+/**
+ * @brief Generic pinhole reprojection residual with analytic derivatives.
+ *
+ * residual = principal_point + focal * disto(P.hnormalized()) - observation
+ *
+ * The Distortion policy provides:
+ *  - num_params: the count of distortion parameters (after [focal, ppx, ppy]),
+ *  - Apply(params, u, v, distorted, d_duv, d_dparams):
+ *    the distorted point, its 2x2 Jacobian with respect to (u,v)
+ *    and its 2 x num_params Jacobian with respect to the distortion parameters.
+ *
+ *  Data parameter blocks are the following <2, 3 + num_params, 6, 3>
+ *  - 2 => dimension of the residuals,
+ *  - 3 + num_params => the intrinsic data block [focal, principal point x, principal point y, disto...],
+ *  - 6 => the camera extrinsic data block (camera orientation and position) [R;t],
+ *         - rotation(angle axis), and translation [rX,rY,rZ,tx,ty,tz].
+ *  - 3 => a 3D point data block.
+ */
+template <typename Distortion>
+class ResidualErrorAnalytic_Pinhole
+  : public ceres::SizedCostFunction<2, 3 + Distortion::num_params, 6, 3>
+{
+public:
+  static constexpr int num_intrinsics = 3 + Distortion::num_params;
+
+  explicit ResidualErrorAnalytic_Pinhole
+  (
+    const Vec2 & observation,
+    const double weight = 0.0
+  ):
+    m_pos_2dpoint{observation(0), observation(1)},
+    m_weight(weight == 0.0 ? 1.0 : weight)
+  {
+  }
+
+  bool Evaluate
+  (
+    double const* const* parameters,
+    double* out_residuals,
+    double** jacobians
+  ) const override
+  {
+    const double * cam_intrinsics = parameters[0];
+    const double * cam_extrinsics = parameters[1];
+    const double * pos_3dpoint = parameters[2];
+
+    const bool b_jacobians = jacobians &&
+      (jacobians[0] || jacobians[1] || jacobians[2]);
+
+    //--
+    // Apply external parameters (Pose)
+    //--
+    Vec3 transformed_point;
+    Mat3 R, dP_dw;
+    TransformPoint(cam_extrinsics, pos_3dpoint, transformed_point,
+      (jacobians && jacobians[1]) ? &dP_dw : nullptr, R);
+
+    // Transform the point from homogeneous to euclidean (undistorted point)
+    const double inv_z = 1.0 / transformed_point(2);
+    const double u = transformed_point(0) * inv_z;
+    const double v = transformed_point(1) * inv_z;
+
+    //--
+    // Apply intrinsic parameters
+    //--
+    const double focal = cam_intrinsics[0];
+    const double principal_point_x = cam_intrinsics[1];
+    const double principal_point_y = cam_intrinsics[2];
+
+    Vec2 distorted;
+    Eigen::Matrix<double, 2, 2, Eigen::RowMajor> d_duv;
+    Eigen::Matrix<double, 2, Distortion::num_params == 0 ? 1 : Distortion::num_params> d_dparams;
+    Distortion::Apply(&cam_intrinsics[3], u, v, distorted,
+      b_jacobians ? d_duv.data() : nullptr,
+      (jacobians && jacobians[0]) ? d_dparams.data() : nullptr);
+
+    out_residuals[0] = m_weight * (principal_point_x + distorted(0) * focal - m_pos_2dpoint[0]);
+    out_residuals[1] = m_weight * (principal_point_y + distorted(1) * focal - m_pos_2dpoint[1]);
+
+    if (!b_jacobians)
+      return true;
+
+    if (jacobians[0])
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, num_intrinsics, Eigen::RowMajor>>
+        J_intrinsics(jacobians[0]);
+      J_intrinsics.template leftCols<3>() <<
+        distorted(0), 1.0, 0.0,
+        distorted(1), 0.0, 1.0;
+      for (int i = 0; i < Distortion::num_params; ++i)
+        J_intrinsics.col(3 + i) = focal * d_dparams.col(i);
+      J_intrinsics *= m_weight;
+    }
+
+    // Jacobian of the residual with respect to the transformed point
+    Eigen::Matrix<double, 2, 3> d_dP;
+    d_dP << inv_z, 0.0, -u * inv_z,
+            0.0, inv_z, -v * inv_z;
+    d_dP = (m_weight * focal) * (d_duv * d_dP);
+
+    if (jacobians[1])
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 6, Eigen::RowMajor>> J_extrinsics(jacobians[1]);
+      J_extrinsics.leftCols<3>() = d_dP * dP_dw;
+      J_extrinsics.rightCols<3>() = d_dP;
+    }
+    if (jacobians[2])
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 3, Eigen::RowMajor>> J_point(jacobians[2]);
+      J_point = d_dP * R;
+    }
+    return true;
+  }
+
+  static ceres::CostFunction* Create
+  (
+    const Vec2 & observation,
+    const double weight = 0.0
+  )
+  {
+    return new ResidualErrorAnalytic_Pinhole<Distortion>(observation, weight);
+  }
+
+private:
+  const double m_pos_2dpoint[2]; // The 2D observation
+  const double m_weight;
+};
+
+/// Distortion policy: no distortion
+struct Distortion_None
+{
+  static constexpr int num_params = 0;
+
+  static void Apply
+  (
+    const double * /*params*/,
+    const double u, const double v,
+    Vec2 & distorted,
+    double * d_duv,
+    double * /*d_dparams*/
+  )
+  {
+    distorted << u, v;
+    if (d_duv)
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv).setIdentity();
+    }
+  }
+};
+
+/// Distortion policy: radial distortion (k1)
+struct Distortion_Radial_K1
+{
+  static constexpr int num_params = 1;
+
+  static void Apply
+  (
+    const double * params,
+    const double u, const double v,
+    Vec2 & distorted,
+    double * d_duv,
+    double * d_dparams
+  )
+  {
+    const double k1 = params[0];
+    const double r2 = u * u + v * v;
+    const double r_coeff = 1.0 + k1 * r2;
+    distorted << u * r_coeff, v * r_coeff;
+    if (d_duv)
+    {
+      // d(r_coeff)/d(r2) = k1
+      const double two_dcoeff = 2.0 * k1;
+      Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv) <<
+        r_coeff + two_dcoeff * u * u, two_dcoeff * u * v,
+        two_dcoeff * u * v, r_coeff + two_dcoeff * v * v;
+    }
+    if (d_dparams)
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 1>>(d_dparams) << u * r2, v * r2;
+    }
+  }
+};
+
+/// Distortion policy: radial distortion (k1, k2, k3)
+struct Distortion_Radial_K3
+{
+  static constexpr int num_params = 3;
+
+  static void Apply
+  (
+    const double * params,
+    const double u, const double v,
+    Vec2 & distorted,
+    double * d_duv,
+    double * d_dparams
+  )
+  {
+    const double k1 = params[0], k2 = params[1], k3 = params[2];
+    const double r2 = u * u + v * v;
+    const double r4 = r2 * r2;
+    const double r6 = r4 * r2;
+    const double r_coeff = 1.0 + k1 * r2 + k2 * r4 + k3 * r6;
+    distorted << u * r_coeff, v * r_coeff;
+    if (d_duv)
+    {
+      const double two_dcoeff = 2.0 * (k1 + 2.0 * k2 * r2 + 3.0 * k3 * r4);
+      Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv) <<
+        r_coeff + two_dcoeff * u * u, two_dcoeff * u * v,
+        two_dcoeff * u * v, r_coeff + two_dcoeff * v * v;
+    }
+    if (d_dparams)
+    {
+      // Column major storage (2 x num_params)
+      Eigen::Map<Eigen::Matrix<double, 2, 3>>(d_dparams) <<
+        u * r2, u * r4, u * r6,
+        v * r2, v * r4, v * r6;
+    }
+  }
+};
+
+/// Distortion policy: radial (k1, k2, k3) and tangential (t1, t2) distortion
+struct Distortion_Brown_T2
+{
+  static constexpr int num_params = 5;
+
+  static void Apply
+  (
+    const double * params,
+    const double u, const double v,
+    Vec2 & distorted,
+    double * d_duv,
+    double * d_dparams
+  )
+  {
+    const double k1 = params[0], k2 = params[1], k3 = params[2];
+    const double t1 = params[3], t2 = params[4];
+    const double r2 = u * u + v * v;
+    const double r4 = r2 * r2;
+    const double r6 = r4 * r2;
+    const double r_coeff = 1.0 + k1 * r2 + k2 * r4 + k3 * r6;
+    const double t_x = t2 * (r2 + 2.0 * u * u) + 2.0 * t1 * u * v;
+    const double t_y = t1 * (r2 + 2.0 * v * v) + 2.0 * t2 * u * v;
+    distorted << u * r_coeff + t_x, v * r_coeff + t_y;
+    if (d_duv)
+    {
+      const double two_dcoeff = 2.0 * (k1 + 2.0 * k2 * r2 + 3.0 * k3 * r4);
+      Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv) <<
+        r_coeff + two_dcoeff * u * u + 6.0 * t2 * u + 2.0 * t1 * v,
+        two_dcoeff * u * v + 2.0 * t2 * v + 2.0 * t1 * u,
+        two_dcoeff * u * v + 2.0 * t1 * u + 2.0 * t2 * v,
+        r_coeff + two_dcoeff * v * v + 6.0 * t1 * v + 2.0 * t2 * u;
+    }
+    if (d_dparams)
+    {
+      // Column major storage (2 x num_params)
+      Eigen::Map<Eigen::Matrix<double, 2, 5>>(d_dparams) <<
+        u * r2, u * r4, u * r6, 2.0 * u * v, r2 + 2.0 * u * u,
+        v * r2, v * r4, v * r6, r2 + 2.0 * v * v, 2.0 * u * v;
+    }
+  }
+};
+
+/// Distortion policy: fisheye distortion (k1, k2, k3, k4)
+struct Distortion_Fisheye
+{
+  static constexpr int num_params = 4;
+
+  static void Apply
+  (
+    const double * params,
+    const double u, const double v,
+    Vec2 & distorted,
+    double * d_duv,
+    double * d_dparams
+  )
+  {
+    const double k1 = params[0], k2 = params[1], k3 = params[2], k4 = params[3];
+    const double r2 = u * u + v * v;
+    const double r = std::sqrt(r2);
+    if (r <= 1e-8)
+    {
+      // Same constant approximation as the AutoDiff functor
+      distorted << u, v;
+      if (d_duv)
+        Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv).setIdentity();
+      if (d_dparams)
+        Eigen::Map<Eigen::Matrix<double, 2, 4>>(d_dparams).setZero();
+      return;
+    }
+    const double
+      theta = std::atan(r),
+      theta2 = theta*theta,
+      theta3 = theta2*theta,
+      theta4 = theta2*theta2,
+      theta5 = theta4*theta,
+      theta6 = theta3*theta3,
+      theta7 = theta6*theta,
+      theta8 = theta4*theta4,
+      theta9 = theta8*theta;
+    const double theta_dist = theta + k1*theta3 + k2*theta5 + k3*theta7 + k4*theta9;
+    const double inv_r = 1.0 / r;
+    const double cdist = theta_dist * inv_r;
+    distorted << u * cdist, v * cdist;
+    if (d_duv)
+    {
+      // d(cdist)/dr = (d(theta_dist)/d(theta) * d(theta)/dr * r - theta_dist) / r^2
+      const double dtheta_dist =
+        1.0 + 3.0*k1*theta2 + 5.0*k2*theta4 + 7.0*k3*theta6 + 9.0*k4*theta8;
+      const double dcdist_dr = (dtheta_dist / (1.0 + r2) - cdist) * inv_r;
+      // dr/du = u / r, dr/dv = v / r
+      const double dcoeff = dcdist_dr * inv_r;
+      Eigen::Map<Eigen::Matrix<double, 2, 2, Eigen::RowMajor>>(d_duv) <<
+        cdist + dcoeff * u * u, dcoeff * u * v,
+        dcoeff * u * v, cdist + dcoeff * v * v;
+    }
+    if (d_dparams)
+    {
+      const double u_r = u * inv_r, v_r = v * inv_r;
+      // Column major storage (2 x num_params)
+      Eigen::Map<Eigen::Matrix<double, 2, 4>>(d_dparams) <<
+        u_r * theta3, u_r * theta5, u_r * theta7, u_r * theta9,
+        v_r * theta3, v_r * theta5, v_r * theta7, v_r * theta9;
+    }
+  }
+};
+
+} // namespace analytic
+
+/// Analytic derivatives counterpart of ResidualErrorFunctor_Pinhole_Intrinsic
+using ResidualErrorAnalytic_Pinhole_Intrinsic =
+  analytic::ResidualErrorAnalytic_Pinhole<analytic::Distortion_None>;
+/// Analytic derivatives counterpart of ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K1
+using ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K1 =
+  analytic::ResidualErrorAnalytic_Pinhole<analytic::Distortion_Radial_K1>;
+/// Analytic derivatives counterpart of ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K3
+using ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3 =
+  analytic::ResidualErrorAnalytic_Pinhole<analytic::Distortion_Radial_K3>;
+/// Analytic derivatives counterpart of ResidualErrorFunctor_Pinhole_Intrinsic_Brown_T2
+using ResidualErrorAnalytic_Pinhole_Intrinsic_Brown_T2 =
+  analytic::ResidualErrorAnalytic_Pinhole<analytic::Distortion_Brown_T2>;
+/// Analytic derivatives counterpart of ResidualErrorFunctor_Pinhole_Intrinsic_Fisheye
+using ResidualErrorAnalytic_Pinhole_Intrinsic_Fisheye =
+  analytic::ResidualErrorAnalytic_Pinhole<analytic::Distortion_Fisheye>;
+
+/**
+ * @brief Analytic derivatives counterpart of ResidualErrorFunctor_Intrinsic_Spherical
+ *
+ *  Data parameter blocks are the following <2,6,3>
+ *  - 2 => dimension of the residuals,
+ *  - 6 => the camera extrinsic data block (camera orientation and position) [R;t],
+ *         - rotation(angle axis), and translation [rX,rY,rZ,tx,ty,tz].
+ *  - 3 => a 3D point data block.
+ */
+class ResidualErrorAnalytic_Intrinsic_Spherical
+  : public ceres::SizedCostFunction<2, 6, 3>
+{
+public:
+  ResidualErrorAnalytic_Intrinsic_Spherical
+  (
+    const Vec2 & observation,
+    const uint32_t imageSize_w,
+    const uint32_t imageSize_h,
+    const double weight = 0.0
+  ):
+    m_pos_2dpoint{observation(0), observation(1)},
+    m_imageSize{imageSize_w, imageSize_h},
+    m_weight(weight == 0.0 ? 1.0 : weight)
+  {
+  }
+
+  bool Evaluate
+  (
+    double const* const* parameters,
+    double* out_residuals,
+    double** jacobians
+  ) const override
+  {
+    const double * cam_extrinsics = parameters[0];
+    const double * pos_3dpoint = parameters[1];
+
+    Vec3 P;
+    Mat3 R, dP_dw;
+    analytic::TransformPoint(cam_extrinsics, pos_3dpoint, P,
+      (jacobians && jacobians[0]) ? &dP_dw : nullptr, R);
+
+    // Transform the coord in is Image space
+    const double rho2 = P(0) * P(0) + P(2) * P(2);
+    const double rho = std::sqrt(rho2);
+    const double lon = std::atan2(P(0), P(2)); // Horizontal normalization of the  X-Z component
+    const double lat = std::atan2(-P(1), rho); // Tilt angle
+
+    const double size = std::max(m_imageSize[0], m_imageSize[1]);
+    const double scale = size / (2 * M_PI);
+    out_residuals[0] = m_weight *
+      (lon * scale - 0.5 + m_imageSize[0] / 2.0 - m_pos_2dpoint[0]);
+    out_residuals[1] = m_weight *
+      (- lat * scale - 0.5 + m_imageSize[1] / 2.0 - m_pos_2dpoint[1]);
+
+    if (!jacobians || (!jacobians[0] && !jacobians[1]))
+      return true;
+
+    // Jacobian of (lon, -lat) with respect to the transformed point
+    const double norm2 = rho2 + P(1) * P(1);
+    Eigen::Matrix<double, 2, 3> d_dP;
+    d_dP << P(2) / rho2, 0.0, -P(0) / rho2,
+            -P(1) * P(0) / (norm2 * rho), rho / norm2, -P(1) * P(2) / (norm2 * rho);
+    d_dP *= m_weight * scale;
+
+    if (jacobians[0])
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 6, Eigen::RowMajor>> J_extrinsics(jacobians[0]);
+      J_extrinsics.leftCols<3>() = d_dP * dP_dw;
+      J_extrinsics.rightCols<3>() = d_dP;
+    }
+    if (jacobians[1])
+    {
+      Eigen::Map<Eigen::Matrix<double, 2, 3, Eigen::RowMajor>> J_point(jacobians[1]);
+      J_point = d_dP * R;
+    }
+    return true;
+  }
+
+  static ceres::CostFunction* Create
+  (
+    const cameras::IntrinsicBase * cameraInterface,
+    const Vec2 & observation,
+    const double weight = 0.0
+  )
+  {
+    return new ResidualErrorAnalytic_Intrinsic_Spherical(
+      observation, cameraInterface->w(), cameraInterface->h(), weight);
+  }
+
+private:
+  const double m_pos_2dpoint[2]; // The 2D observation
+  const size_t m_imageSize[2]; // The image width and height
+  const double m_weight;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // OPENMVG_SFM_SFM_DATA_BA_CERES_CAMERA_FUNCTOR_ANALYTIC_HPP
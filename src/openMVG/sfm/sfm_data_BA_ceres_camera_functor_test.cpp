@@ -0,0 +1,246 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+//-----------------
+// Test summary:
+//-----------------
+// - Evaluate the AutoDiff and the analytic derivatives cost functions
+//   of each camera model on random configurations
+// - Check that the residuals and the Jacobians are the same
+//-----------------
+
+#include "openMVG/sfm/sfm_data_BA_ceres_camera_functor.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres_camera_functor_analytic.hpp"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::cameras;
+using namespace openMVG::sfm;
+
+namespace {
+
+/// Random camera configuration: [intrinsics], [R;t], X (X is in front of the camera)
+struct Configuration
+{
+  std::vector<double> intrinsics;
+  std::vector<double> extrinsics;
+  std::vector<double> point;
+  Vec2 observation;
+};
+
+Configuration RandomConfiguration
+(
+  std::mt19937 & random_generator,
+  const std::vector<double> & distortion,
+  const double rotation_magnitude = 0.5
+)
+{
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  Configuration configuration;
+  configuration.intrinsics = {1000.0 + 200.0 * unit(random_generator),
+                              500.0 + 50.0 * unit(random_generator),
+                              400.0 + 50.0 * unit(random_generator)};
+  for (const double coefficient : distortion)
+    configuration.intrinsics.push_back(coefficient * (1.0 + 0.5 * unit(random_generator)));
+  configuration.extrinsics = {rotation_magnitude * unit(random_generator),
+                              rotation_magnitude * unit(random_generator),
+                              rotation_magnitude * unit(random_generator),
+                              unit(random_generator),
+                              unit(random_generator),
+                              unit(random_generator)};
+  // Choose the point in the camera frame, then express it in the world frame
+  const Vec3 camera_point(unit(random_generator), unit(random_generator), 5.0 + unit(random_generator));
+  Mat3 R;
+  ceres::AngleAxisToRotationMatrix(&configuration.extrinsics[0], R.data());
+  const Vec3 X = R.transpose() *
+    (camera_point - Eigen::Map<const Vec3>(&configuration.extrinsics[3]));
+  configuration.point = {X(0), X(1), X(2)};
+  configuration.observation << 500.0 + 300.0 * unit(random_generator),
+                               400.0 + 300.0 * unit(random_generator);
+  return configuration;
+}
+
+/// Evaluate two cost functions on the same parameter blocks and compare
+///  their residuals and Jacobians (relative tolerance)
+bool SameEvaluation
+(
+  const ceres::CostFunction & reference,
+  const ceres::CostFunction & tested,
+  const std::vector<double *> & parameter_blocks,
+  const double tolerance
+)
+{
+  const std::vector<int32_t> & block_sizes = reference.parameter_block_sizes();
+  if (block_sizes != tested.parameter_block_sizes() ||
+      reference.num_residuals() != tested.num_residuals() ||
+      block_sizes.size() != parameter_blocks.size())
+  {
+    return false;
+  }
+
+  const int num_residuals = reference.num_residuals();
+  std::vector<double> residuals[2];
+  std::vector<std::vector<double>> jacobians_values[2];
+  std::vector<double *> jacobians[2];
+  for (int i : {0, 1})
+  {
+    residuals[i].resize(num_residuals);
+    for (const int32_t block_size : block_sizes)
+      jacobians_values[i].emplace_back(num_residuals * block_size);
+    for (auto & jacobian : jacobians_values[i])
+      jacobians[i].push_back(jacobian.data());
+  }
+
+  if (!reference.Evaluate(parameter_blocks.data(), residuals[0].data(), jacobians[0].data()) ||
+      !tested.Evaluate(parameter_blocks.data(), residuals[1].data(), jacobians[1].data()))
+  {
+    return false;
+  }
+
+  const auto is_near = [tolerance](const double a, const double b)
+  {
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+  };
+  for (int r = 0; r < num_residuals; ++r)
+  {
+    if (!is_near(residuals[0][r], residuals[1][r]))
+    {
+      std::cerr << "Residual " << r << " mismatch: "
+        << residuals[0][r] << " vs " << residuals[1][r] << std::endl;
+      return false;
+    }
+  }
+  // Jacobian blocks are compared up to their magnitude
+  //  (some entries are the result of cancellations)
+  for (size_t block = 0; block < block_sizes.size(); ++block)
+  {
+    const std::vector<double> & reference_jacobian = jacobians_values[0][block];
+    const std::vector<double> & tested_jacobian = jacobians_values[1][block];
+    double magnitude = 1.0;
+    for (const double value : reference_jacobian)
+      magnitude = std::max(magnitude, std::abs(value));
+    for (size_t k = 0; k < reference_jacobian.size(); ++k)
+    {
+      if (std::abs(reference_jacobian[k] - tested_jacobian[k]) > tolerance * magnitude)
+      {
+        std::cerr << "Jacobian (block " << block << ", " << k << ") mismatch: "
+          << reference_jacobian[k] << " vs " << tested_jacobian[k] << std::endl;
+        return false;
+      }
+    }
+  }
+  // Residual only evaluation must give the same residuals
+  std::vector<double> residuals_only(num_residuals);
+  if (!tested.Evaluate(parameter_blocks.data(), residuals_only.data(), nullptr))
+    return false;
+  for (int r = 0; r < num_residuals; ++r)
+  {
+    if (!is_near(residuals[0][r], residuals_only[r]))
+      return false;
+  }
+  return true;
+}
+
+/// Compare the AutoDiff and the analytic cost functions of a pinhole camera model
+template <typename AutoDiffFunctor, typename AnalyticCostFunction>
+bool ComparePinholeModel
+(
+  const std::vector<double> & distortion,
+  const double weight,
+  const double rotation_magnitude = 0.5
+)
+{
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  for (int i = 0; i < 100; ++i)
+  {
+    Configuration configuration =
+      RandomConfiguration(random_generator, distortion, rotation_magnitude);
+    std::unique_ptr<ceres::CostFunction> autodiff_cost(
+      AutoDiffFunctor::Create(configuration.observation, weight));
+    std::unique_ptr<ceres::CostFunction> analytic_cost(
+      AnalyticCostFunction::Create(configuration.observation, weight));
+    const std::vector<double *> parameter_blocks =
+      {&configuration.intrinsics[0], &configuration.extrinsics[0], &configuration.point[0]};
+    if (!SameEvaluation(*autodiff_cost, *analytic_cost, parameter_blocks, 1e-9))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Pinhole) {
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic,
+    ResidualErrorAnalytic_Pinhole_Intrinsic>({}, 0.0)));
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic,
+    ResidualErrorAnalytic_Pinhole_Intrinsic>({}, 3.0)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Pinhole_Radial_K1) {
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K1,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K1>({-0.1}, 0.0)));
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K1,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K1>({-0.1}, 3.0)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Pinhole_Radial_K3) {
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K3,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3>({-0.1, 0.05, -0.01}, 0.0)));
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K3,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3>({-0.1, 0.05, -0.01}, 3.0)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Pinhole_Brown_T2) {
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Brown_T2,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Brown_T2>({-0.1, 0.05, -0.01, 0.001, -0.002}, 0.0)));
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Brown_T2,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Brown_T2>({-0.1, 0.05, -0.01, 0.001, -0.002}, 3.0)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Pinhole_Fisheye) {
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Fisheye,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Fisheye>({-0.01, 0.005, -0.001, 0.0005}, 0.0)));
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Fisheye,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Fisheye>({-0.01, 0.005, -0.001, 0.0005}, 3.0)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Small_Rotation) {
+  // Near identity rotations use a Taylor expansion of the rotation Jacobian
+  EXPECT_TRUE((ComparePinholeModel<ResidualErrorFunctor_Pinhole_Intrinsic_Radial_K3,
+    ResidualErrorAnalytic_Pinhole_Intrinsic_Radial_K3>({-0.1, 0.05, -0.01}, 0.0, 1e-10)));
+}
+
+TEST(BA_CERES_CAMERA_FUNCTOR, Analytic_Spherical) {
+  const Intrinsic_Spherical intrinsic(4000, 2000);
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  for (int i = 0; i < 100; ++i)
+  {
+    Configuration configuration = RandomConfiguration(random_generator, {});
+    for (const double weight : {0.0, 3.0})
+    {
+      std::unique_ptr<ceres::CostFunction> autodiff_cost(
+        ResidualErrorFunctor_Intrinsic_Spherical::Create(&intrinsic, configuration.observation, weight));
+      std::unique_ptr<ceres::CostFunction> analytic_cost(
+        ResidualErrorAnalytic_Intrinsic_Spherical::Create(&intrinsic, configuration.observation, weight));
+      EXPECT_TRUE(SameEvaluation(*autodiff_cost, *analytic_cost,
+        {&configuration.extrinsics[0], &configuration.point[0]}, 1e-9));
+    }
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
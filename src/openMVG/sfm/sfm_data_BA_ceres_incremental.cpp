@@ -0,0 +1,511 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/sfm_data_BA_ceres_incremental.hpp"
+
+#include "ceres/problem.h"
+#include "ceres/solver.h"
+#include "openMVG/cameras/Camera_Intrinsics.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/types.hpp"
+
+#include <ceres/local_parameterization.h>
+#include <ceres/loss_function.h>
+#include <ceres/rotation.h>
+#include <ceres/types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace openMVG {
+namespace sfm {
+
+using namespace openMVG::cameras;
+using namespace openMVG::geometry;
+
+struct Bundle_Adjustment_Ceres_Incremental::Incremental_Problem
+{
+  /// A residual block of a landmark observation {landmark id, view id}
+  struct Residual
+  {
+    ceres::ResidualBlockId id;
+    IndexT id_pose;
+    IndexT id_intrinsic;
+    Vec2 x;
+  };
+
+  Incremental_Problem
+  (
+    const Optimize_Options & options,
+    const bool b_use_loss_function,
+    const bool b_analytic_derivatives
+  ):
+    intrinsics_opt(options.intrinsics_opt),
+    extrinsics_opt(options.extrinsics_opt),
+    b_use_loss_function(b_use_loss_function),
+    b_analytic_derivatives(b_analytic_derivatives),
+    // Set a LossFunction to be less penalized by false measurements
+    loss_function(b_use_loss_function ? new ceres::CauchyLoss(4.0) : nullptr),
+    problem(ProblemOptions())
+  {}
+
+  static ceres::Problem::Options ProblemOptions()
+  {
+    ceres::Problem::Options problem_options;
+    // The loss function is shared by all the residual blocks
+    problem_options.loss_function_ownership = ceres::DO_NOT_TAKE_OWNERSHIP;
+    // Residual blocks are removed at each outlier rejection
+    problem_options.enable_fast_removal = true;
+    return problem_options;
+  }
+
+  /// Tell if the parameter blocks have been configured for these options
+  bool IsCompatible
+  (
+    const Optimize_Options & options,
+    const bool b_use_loss_function,
+    const bool b_analytic_derivatives
+  ) const
+  {
+    return intrinsics_opt == options.intrinsics_opt
+      && extrinsics_opt == options.extrinsics_opt
+      && this->b_use_loss_function == b_use_loss_function
+      && this->b_analytic_derivatives == b_analytic_derivatives;
+  }
+
+  // The options used to create the parameter blocks (subset parametrizations)
+  //  and the residual blocks
+  const Intrinsic_Parameter_Type intrinsics_opt;
+  const Extrinsic_Parameter_Type extrinsics_opt;
+  const bool b_use_loss_function;
+  const bool b_analytic_derivatives;
+
+  // Must outlive the problem
+  std::unique_ptr<ceres::LossFunction> loss_function;
+  ceres::Problem problem;
+
+  // Data wrapper for refinement (stable addresses: the parameter blocks)
+  Hash_Map<IndexT, std::vector<double>> map_intrinsics;
+  Hash_Map<IndexT, std::vector<double>> map_poses;
+  Hash_Map<IndexT, Vec3> map_landmarks;
+  Hash_Map<Pair, Residual> map_residuals;
+};
+
+Bundle_Adjustment_Ceres_Incremental::Bundle_Adjustment_Ceres_Incremental
+(
+  const Bundle_Adjustment_Ceres::BA_Ceres_options & options
+)
+: ceres_options_(options)
+{}
+
+Bundle_Adjustment_Ceres_Incremental::~Bundle_Adjustment_Ceres_Incremental() = default;
+
+Bundle_Adjustment_Ceres::BA_Ceres_options &
+Bundle_Adjustment_Ceres_Incremental::ceres_options()
+{
+  return ceres_options_;
+}
+
+void Bundle_Adjustment_Ceres_Incremental::Reset()
+{
+  problem_.reset();
+}
+
+bool Bundle_Adjustment_Ceres_Incremental::Adjust
+(
+  SfM_Data & sfm_data,     // the SfM scene to refine
+  const Optimize_Options & options
+)
+{
+  last_update_ = Update_Statistics();
+
+  if (options.use_motion_priors_opt || options.control_point_opt.bUse_control_points)
+  {
+    // Not handled incrementally (the scene can be moved by the prior registration)
+    Reset();
+    Bundle_Adjustment_Ceres bundle_adjustment_obj(ceres_options_);
+    return bundle_adjustment_obj.Adjust(sfm_data, options);
+  }
+
+  if (problem_ && !problem_->IsCompatible(options,
+        ceres_options_.bUse_loss_function_, ceres_options_.bUse_analytic_derivatives_))
+  {
+    Reset();
+  }
+  if (!problem_)
+  {
+    problem_.reset(new Incremental_Problem(options,
+      ceres_options_.bUse_loss_function_, ceres_options_.bUse_analytic_derivatives_));
+  }
+  Incremental_Problem & incremental_problem = *problem_;
+  ceres::Problem & problem = incremental_problem.problem;
+
+  //----------
+  // Remove the residual blocks of the observations that have been removed or changed
+  //----------
+  for (auto residual_it = incremental_problem.map_residuals.begin();
+       residual_it != incremental_problem.map_residuals.end();)
+  {
+    bool b_valid = false;
+    const Incremental_Problem::Residual & residual = residual_it->second;
+    const auto landmark_it = sfm_data.structure.find(residual_it->first.first);
+    if (landmark_it != sfm_data.structure.end())
+    {
+      const auto obs_it = landmark_it->second.obs.find(residual_it->first.second);
+      if (obs_it != landmark_it->second.obs.end())
+      {
+        const View * view = sfm_data.views.at(obs_it->first).get();
+        b_valid = obs_it->second.x == residual.x
+          && view->id_pose == residual.id_pose
+          && view->id_intrinsic == residual.id_intrinsic
+          && sfm_data.poses.count(view->id_pose) != 0
+          && sfm_data.intrinsics.count(view->id_intrinsic) != 0;
+      }
+    }
+    if (b_valid)
+    {
+      ++residual_it;
+    }
+    else
+    {
+      problem.RemoveResidualBlock(residual.id);
+      residual_it = incremental_problem.map_residuals.erase(residual_it);
+      ++last_update_.removed_residuals;
+    }
+  }
+
+  //----------
+  // Remove the parameter blocks of the removed poses, intrinsics and landmarks
+  //----------
+  for (auto pose_it = incremental_problem.map_poses.begin();
+       pose_it != incremental_problem.map_poses.end();)
+  {
+    if (sfm_data.poses.count(pose_it->first) == 0)
+    {
+      problem.RemoveParameterBlock(&pose_it->second[0]);
+      pose_it = incremental_problem.map_poses.erase(pose_it);
+    }
+    else
+      ++pose_it;
+  }
+  for (auto intrinsic_it = incremental_problem.map_intrinsics.begin();
+       intrinsic_it != incremental_problem.map_intrinsics.end();)
+  {
+    if (sfm_data.intrinsics.count(intrinsic_it->first) == 0)
+    {
+      if (!intrinsic_it->second.empty())
+        problem.RemoveParameterBlock(&intrinsic_it->second[0]);
+      intrinsic_it = incremental_problem.map_intrinsics.erase(intrinsic_it);
+    }
+    else
+      ++intrinsic_it;
+  }
+  for (auto landmark_it = incremental_problem.map_landmarks.begin();
+       landmark_it != incremental_problem.map_landmarks.end();)
+  {
+    if (sfm_data.structure.count(landmark_it->first) == 0)
+    {
+      problem.RemoveParameterBlock(landmark_it->second.data());
+      landmark_it = incremental_problem.map_landmarks.erase(landmark_it);
+    }
+    else
+      ++landmark_it;
+  }
+
+  //----------
+  // Add the new parameter blocks and update the values of the existing ones
+  //----------
+
+  // Poses data & subparametrization
+  for (const auto & pose_it : sfm_data.poses)
+  {
+    const IndexT indexPose = pose_it.first;
+
+    const Pose3 & pose = pose_it.second;
+    const Mat3 R = pose.rotation();
+    const Vec3 t = pose.translation();
+
+    double angleAxis[3];
+    ceres::RotationMatrixToAngleAxis((const double*)R.data(), angleAxis);
+
+    auto map_pose_it = incremental_problem.map_poses.find(indexPose);
+    const bool b_new_pose = (map_pose_it == incremental_problem.map_poses.end());
+    if (b_new_pose)
+    {
+      map_pose_it = incremental_problem.map_poses.insert({indexPose, std::vector<double>(6)}).first;
+    }
+    // angleAxis + translation (updated in place: the parameter block address is kept)
+    std::vector<double> & pose_parameters = map_pose_it->second;
+    std::copy(angleAxis, angleAxis + 3, pose_parameters.begin());
+    std::copy(t.data(), t.data() + 3, pose_parameters.begin() + 3);
+
+    double * parameter_block = &pose_parameters[0];
+    if (b_new_pose)
+    {
+      problem.AddParameterBlock(parameter_block, 6);
+      std::vector<int> vec_constant_extrinsic;
+      // If we adjust only the translation, we must set ROTATION as constant
+      if (options.extrinsics_opt == Extrinsic_Parameter_Type::ADJUST_TRANSLATION)
+      {
+        // Subset rotation parametrization
+        vec_constant_extrinsic.insert(vec_constant_extrinsic.end(), {0,1,2});
+      }
+      // If we adjust only the rotation, we must set TRANSLATION as constant
+      if (options.extrinsics_opt == Extrinsic_Parameter_Type::ADJUST_ROTATION)
+      {
+        // Subset translation parametrization
+        vec_constant_extrinsic.insert(vec_constant_extrinsic.end(), {3,4,5});
+      }
+      if (!vec_constant_extrinsic.empty())
+      {
+        ceres::SubsetParameterization *subset_parameterization =
+          new ceres::SubsetParameterization(6, vec_constant_extrinsic);
+        problem.SetParameterization(parameter_block, subset_parameterization);
+      }
+    }
+    if (options.extrinsics_opt == Extrinsic_Parameter_Type::NONE
+        || options.constant_poses.count(indexPose) != 0)
+    {
+      problem.SetParameterBlockConstant(parameter_block);
+    }
+    else
+    {
+      problem.SetParameterBlockVariable(parameter_block);
+    }
+  }
+
+  // Intrinsics data & subparametrization
+  for (const auto & intrinsic_it : sfm_data.intrinsics)
+  {
+    const IndexT indexCam = intrinsic_it.first;
+
+    if (!isValid(intrinsic_it.second->getType()))
+    {
+      std::cerr << "Unsupported camera type." << std::endl;
+      continue;
+    }
+
+    const std::vector<double> intrinsic_parameters = intrinsic_it.second->getParams();
+    auto map_intrinsic_it = incremental_problem.map_intrinsics.find(indexCam);
+    if (map_intrinsic_it != incremental_problem.map_intrinsics.end())
+    {
+      if (map_intrinsic_it->second.size() != intrinsic_parameters.size())
+      {
+        // The camera model has changed, the problem must be rebuilt
+        Reset();
+        return Adjust(sfm_data, options);
+      }
+      // Update the values in place (the parameter block address is kept)
+      std::copy(intrinsic_parameters.cbegin(), intrinsic_parameters.cend(),
+        map_intrinsic_it->second.begin());
+      if (!map_intrinsic_it->second.empty())
+      {
+        if (options.intrinsics_opt == Intrinsic_Parameter_Type::NONE)
+          problem.SetParameterBlockConstant(&map_intrinsic_it->second[0]);
+        else
+          problem.SetParameterBlockVariable(&map_intrinsic_it->second[0]);
+      }
+      continue;
+    }
+
+    std::vector<double> & parameters =
+      incremental_problem.map_intrinsics.insert({indexCam, intrinsic_parameters}).first->second;
+    if (!parameters.empty())
+    {
+      double * parameter_block = &parameters[0];
+      problem.AddParameterBlock(parameter_block, parameters.size());
+      if (options.intrinsics_opt == Intrinsic_Parameter_Type::NONE)
+      {
+        // set the whole parameter block as constant for best performance
+        problem.SetParameterBlockConstant(parameter_block);
+      }
+      else
+      {
+        const std::vector<int> vec_constant_intrinsic =
+          intrinsic_it.second->subsetParameterization(options.intrinsics_opt);
+        if (!vec_constant_intrinsic.empty())
+        {
+          ceres::SubsetParameterization *subset_parameterization =
+            new ceres::SubsetParameterization(
+              parameters.size(), vec_constant_intrinsic);
+          problem.SetParameterization(parameter_block, subset_parameterization);
+        }
+      }
+    }
+  }
+
+  // Landmarks and their observations
+  for (const auto & structure_landmark_it : sfm_data.structure)
+  {
+    const IndexT indexLandmark = structure_landmark_it.first;
+    auto map_landmark_it = incremental_problem.map_landmarks.find(indexLandmark);
+    const bool b_new_landmark = (map_landmark_it == incremental_problem.map_landmarks.end());
+    if (b_new_landmark)
+    {
+      map_landmark_it =
+        incremental_problem.map_landmarks.insert({indexLandmark, structure_landmark_it.second.X}).first;
+    }
+    else
+    {
+      map_landmark_it->second = structure_landmark_it.second.X;
+    }
+    double * parameter_block = map_landmark_it->second.data();
+    if (b_new_landmark)
+    {
+      problem.AddParameterBlock(parameter_block, 3);
+    }
+    if (options.structure_opt == Structure_Parameter_Type::NONE)
+      problem.SetParameterBlockConstant(parameter_block);
+    else
+      problem.SetParameterBlockVariable(parameter_block);
+
+    for (const auto & obs_it : structure_landmark_it.second.obs)
+    {
+      const Pair residual_key(indexLandmark, obs_it.first);
+      if (incremental_problem.map_residuals.count(residual_key) != 0)
+      {
+        ++last_update_.reused_residuals;
+        continue;
+      }
+
+      // Build the residual block corresponding to the track observation:
+      //  the cost function refers to the observation copy kept by the problem
+      //  (the scene observations can be moved or erased between two calls)
+      const View * view = sfm_data.views.at(obs_it.first).get();
+      Incremental_Problem::Residual & residual =
+        incremental_problem.map_residuals.insert({residual_key,
+          {nullptr, view->id_pose, view->id_intrinsic, obs_it.second.x}}).first->second;
+      ceres::CostFunction* cost_function =
+        IntrinsicsToCostFunction(sfm_data.intrinsics.at(view->id_intrinsic).get(),
+                                 residual.x,
+                                 0.0,
+                                 ceres_options_.bUse_analytic_derivatives_);
+      if (!cost_function)
+      {
+        std::cerr << "Cannot create a CostFunction for this camera model." << std::endl;
+        Reset();
+        return false;
+      }
+
+      std::vector<double> & intrinsic_parameters =
+        incremental_problem.map_intrinsics.at(view->id_intrinsic);
+      double * pose_parameters = &incremental_problem.map_poses.at(view->id_pose)[0];
+      residual.id = intrinsic_parameters.empty() ?
+        problem.AddResidualBlock(cost_function,
+          incremental_problem.loss_function.get(),
+          pose_parameters,
+          parameter_block) :
+        problem.AddResidualBlock(cost_function,
+          incremental_problem.loss_function.get(),
+          &intrinsic_parameters[0],
+          pose_parameters,
+          parameter_block);
+      ++last_update_.added_residuals;
+    }
+  }
+
+  // Configure a BA engine and run it
+  ceres::Solver::Options ceres_config_options;
+  ceres_config_options.max_num_iterations = 500;
+  ceres_config_options.preconditioner_type =
+    static_cast<ceres::PreconditionerType>(ceres_options_.preconditioner_type_);
+  ceres_config_options.linear_solver_type =
+    static_cast<ceres::LinearSolverType>(ceres_options_.linear_solver_type_);
+  ceres_config_options.sparse_linear_algebra_library_type =
+    static_cast<ceres::SparseLinearAlgebraLibraryType>(ceres_options_.sparse_linear_algebra_library_type_);
+  ceres_config_options.minimizer_progress_to_stdout = ceres_options_.bVerbose_;
+  ceres_config_options.logging_type = ceres::SILENT;//SILENT;PER_MINIMIZER_ITERATION
+  ceres_config_options.num_threads = ceres_options_.nb_threads_;
+#if CERES_VERSION_MAJOR < 2
+  ceres_config_options.num_linear_solver_threads = ceres_options_.nb_threads_;
+#endif
+  ceres_config_options.parameter_tolerance = ceres_options_.parameter_tolerance_;
+  // No Schur ordering is given: Ceres computes a stable one from the problem order
+  //  (an ordering given as parameter block addresses would make the result
+  //  depend on the memory layout)
+
+  // Solve BA
+  ceres::Solver::Summary summary;
+  ceres::Solve(ceres_config_options, &problem, &summary);
+  if (ceres_options_.bCeres_summary_)
+    std::cout << summary.FullReport() << std::endl;
+
+  // If no error, get back refined parameters
+  if (!summary.IsSolutionUsable())
+  {
+    if (ceres_options_.bVerbose_)
+      std::cout << "Bundle Adjustment failed." << std::endl;
+    return false;
+  }
+
+  if (ceres_options_.bVerbose_)
+  {
+    // Display statistics about the minimization
+    std::cout << std::endl
+      << "Incremental Bundle Adjustment statistics (approximated RMSE):\n"
+      << " #views: " << sfm_data.views.size() << "\n"
+      << " #poses: " << sfm_data.poses.size() << "\n"
+      << " #intrinsics: " << sfm_data.intrinsics.size() << "\n"
+      << " #tracks: " << sfm_data.structure.size() << "\n"
+      << " #residuals: " << summary.num_residuals << "\n"
+      << " #residual blocks added: " << last_update_.added_residuals
+      << ", removed: " << last_update_.removed_residuals
+      << ", reused: " << last_update_.reused_residuals << "\n"
+      << " Initial RMSE: " << std::sqrt( summary.initial_cost / summary.num_residuals) << "\n"
+      << " Final RMSE: " << std::sqrt( summary.final_cost / summary.num_residuals) << "\n"
+      << " Time (s): " << summary.total_time_in_seconds << "\n"
+      << " num_successful_steps : " << summary.num_successful_steps << "\n"
+      << " num_unsuccessful_steps : " << summary.num_unsuccessful_steps << "\n"
+      << std::endl;
+  }
+
+  // Update camera poses with refined data
+  if (options.extrinsics_opt != Extrinsic_Parameter_Type::NONE)
+  {
+    for (auto & pose_it : sfm_data.poses)
+    {
+      const IndexT indexPose = pose_it.first;
+      if (options.constant_poses.count(indexPose) != 0)
+        continue;
+
+      const std::vector<double> & pose_parameters = incremental_problem.map_poses.at(indexPose);
+      Mat3 R_refined;
+      ceres::AngleAxisToRotationMatrix(&pose_parameters[0], R_refined.data());
+      Vec3 t_refined(pose_parameters[3], pose_parameters[4], pose_parameters[5]);
+      // Update the pose
+      Pose3 & pose = pose_it.second;
+      pose = Pose3(R_refined, -R_refined.transpose() * t_refined);
+    }
+  }
+
+  // Update camera intrinsics with refined data
+  if (options.intrinsics_opt != Intrinsic_Parameter_Type::NONE)
+  {
+    for (auto & intrinsic_it : sfm_data.intrinsics)
+    {
+      const auto map_intrinsic_it = incremental_problem.map_intrinsics.find(intrinsic_it.first);
+      if (map_intrinsic_it != incremental_problem.map_intrinsics.end())
+        intrinsic_it.second->updateFromParams(map_intrinsic_it->second);
+    }
+  }
+
+  // Update the structure with refined data
+  if (options.structure_opt != Structure_Parameter_Type::NONE)
+  {
+    for (auto & structure_landmark_it : sfm_data.structure)
+    {
+      structure_landmark_it.second.X = incremental_problem.map_landmarks.at(structure_landmark_it.first);
+    }
+  }
+  return true;
+}
+
+} // namespace sfm
+} // namespace openMVG
@@ -0,0 +1,82 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SFM_SFM_DATA_BA_CERES_INCREMENTAL_HPP
+#define OPENMVG_SFM_SFM_DATA_BA_CERES_INCREMENTAL_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "openMVG/sfm/sfm_data_BA.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+
+namespace openMVG { namespace sfm { struct SfM_Data; } }
+
+namespace openMVG {
+namespace sfm {
+
+/**
+* @brief Bundle Adjustment that keeps its Ceres problem alive across the Adjust calls.
+*
+* It is designed for the incremental pipelines that refine a growing scene:
+*  - the residual blocks of the observations that did not change are reused,
+*  - only the residual blocks of the new (or removed) observations are added (or removed),
+*  - the parameter blocks of the new (or removed) poses, intrinsics and landmarks
+*    are added (or removed).
+* The parameter values are read from the scene at each call, so the scene can be
+*  modified between two calls (new resections, outlier rejection, local BA...).
+*
+* The motion priors and the ground control points are not handled incrementally:
+*  these calls are forwarded to a one-shot Bundle_Adjustment_Ceres.
+*/
+class Bundle_Adjustment_Ceres_Incremental : public Bundle_Adjustment
+{
+  public:
+
+  /// Residual blocks updates of the last Adjust call
+  struct Update_Statistics
+  {
+    std::size_t added_residuals = 0;
+    std::size_t removed_residuals = 0;
+    std::size_t reused_residuals = 0;
+  };
+
+  explicit Bundle_Adjustment_Ceres_Incremental
+  (
+    const Bundle_Adjustment_Ceres::BA_Ceres_options & options =
+      Bundle_Adjustment_Ceres::BA_Ceres_options()
+  );
+
+  ~Bundle_Adjustment_Ceres_Incremental() override;
+
+  Bundle_Adjustment_Ceres::BA_Ceres_options & ceres_options();
+
+  bool Adjust
+  (
+    // the SfM scene to refine
+    sfm::SfM_Data & sfm_data,
+    // tell which parameter needs to be adjusted
+    const Optimize_Options & options
+  ) override;
+
+  /// Release the persistent problem (the next Adjust call rebuilds it)
+  void Reset();
+
+  const Update_Statistics & LastUpdate() const { return last_update_; }
+
+  private:
+    Bundle_Adjustment_Ceres::BA_Ceres_options ceres_options_;
+    struct Incremental_Problem;
+    std::unique_ptr<Incremental_Problem> problem_;
+    Update_Statistics last_update_;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // OPENMVG_SFM_SFM_DATA_BA_CERES_INCREMENTAL_HPP
@@ -184,6 +184,147 @@ TEST(BUNDLE_ADJUSTMENT, EffectiveMinimization_Pinhole_Intrinsic_Fisheye) {
   EXPECT_TRUE( dResidual_before > dResidual_after);
 }
 
+TEST(BUNDLE_ADJUSTMENT, IncrementalMinimization_Pinhole) {
+
+  const int nviews = 4;
+  const int npoints = 12;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  // Translate the input dataset to a SfM_Data scene
+  const SfM_Data sfm_data_full = getInputScene(d, config, PINHOLE_CAMERA);
+
+  // Start with a partial scene: the last view is not yet reconstructed
+  SfM_Data sfm_data = sfm_data_full;
+  const IndexT last_view = nviews - 1;
+  sfm_data.poses.erase(last_view);
+  for (auto & landmark_it : sfm_data.structure)
+    landmark_it.second.obs.erase(last_view);
+
+  const Optimize_Options ba_refine_options(
+    Intrinsic_Parameter_Type::ADJUST_ALL,
+    Extrinsic_Parameter_Type::ADJUST_ALL,
+    Structure_Parameter_Type::ADJUST_ALL);
+
+  Bundle_Adjustment_Ceres_Incremental ba_object(
+    Bundle_Adjustment_Ceres::BA_Ceres_options(true, false));
+
+  const double dResidual_before = RMSE(sfm_data);
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+  EXPECT_TRUE( dResidual_before > RMSE(sfm_data) );
+  EXPECT_EQ( (nviews - 1) * npoints, ba_object.LastUpdate().added_residuals );
+  EXPECT_EQ( 0, ba_object.LastUpdate().reused_residuals );
+
+  // Add the last view (pose & observations): only its residuals must be added
+  sfm_data.poses[last_view] = sfm_data_full.poses.at(last_view);
+  for (auto & landmark_it : sfm_data.structure)
+    landmark_it.second.obs[last_view] =
+      sfm_data_full.structure.at(landmark_it.first).obs.at(last_view);
+
+  const double dResidual_extended = RMSE(sfm_data);
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+  EXPECT_TRUE( dResidual_extended > RMSE(sfm_data) );
+  EXPECT_EQ( npoints, ba_object.LastUpdate().added_residuals );
+  EXPECT_EQ( 0, ba_object.LastUpdate().removed_residuals );
+  EXPECT_EQ( (nviews - 1) * npoints, ba_object.LastUpdate().reused_residuals );
+
+  // Remove a landmark: its residuals must be removed, the others reused
+  sfm_data.structure.erase(0);
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+  EXPECT_EQ( 0, ba_object.LastUpdate().added_residuals );
+  EXPECT_EQ( nviews, ba_object.LastUpdate().removed_residuals );
+  EXPECT_EQ( nviews * (npoints - 1), ba_object.LastUpdate().reused_residuals );
+
+  // The incremental refinement must reach the same accuracy as a one-shot refinement
+  SfM_Data sfm_data_one_shot = sfm_data;
+  Bundle_Adjustment_Ceres(Bundle_Adjustment_Ceres::BA_Ceres_options(true, false))
+    .Adjust(sfm_data_one_shot, ba_refine_options);
+  EXPECT_NEAR( RMSE(sfm_data_one_shot), RMSE(sfm_data), 1e-6 );
+}
+
+// One intrinsic per view: the intrinsic of a view that is not yet reconstructed
+//  is in the problem before having any residual
+TEST(BUNDLE_ADJUSTMENT, IncrementalMinimization_Pinhole_IntrinsicPerView) {
+
+  const int nviews = 4;
+  const int npoints = 12;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  // Translate the input dataset to a SfM_Data scene
+  SfM_Data sfm_data_full = getInputScene(d, config, PINHOLE_CAMERA);
+  for (int i = 0; i < nviews; ++i)
+  {
+    sfm_data_full.intrinsics[i] =
+      std::shared_ptr<IntrinsicBase>(sfm_data_full.intrinsics.at(0)->clone());
+    sfm_data_full.views.at(i)->id_intrinsic = i;
+  }
+
+  // Start with a partial scene: the last view is not yet reconstructed
+  SfM_Data sfm_data = sfm_data_full;
+  const IndexT last_view = nviews - 1;
+  sfm_data.poses.erase(last_view);
+  for (auto & landmark_it : sfm_data.structure)
+    landmark_it.second.obs.erase(last_view);
+
+  const Optimize_Options ba_refine_options(
+    Intrinsic_Parameter_Type::ADJUST_ALL,
+    Extrinsic_Parameter_Type::ADJUST_ALL,
+    Structure_Parameter_Type::ADJUST_ALL);
+
+  Bundle_Adjustment_Ceres_Incremental ba_object(
+    Bundle_Adjustment_Ceres::BA_Ceres_options(true, false));
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+
+  // The last view gets its first residuals
+  sfm_data.poses[last_view] = sfm_data_full.poses.at(last_view);
+  for (auto & landmark_it : sfm_data.structure)
+    landmark_it.second.obs[last_view] =
+      sfm_data_full.structure.at(landmark_it.first).obs.at(last_view);
+
+  const double dResidual_extended = RMSE(sfm_data);
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+  EXPECT_TRUE( dResidual_extended > RMSE(sfm_data) );
+  EXPECT_EQ( npoints, ba_object.LastUpdate().added_residuals );
+  EXPECT_TRUE( ba_object.Adjust(sfm_data, ba_refine_options) );
+}
+
+TEST(BUNDLE_ADJUSTMENT, EffectiveMinimization_AnalyticDerivatives) {
+
+  const int nviews = 3;
+  const int npoints = 6;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  for (const EINTRINSIC eintrinsic :
+    {PINHOLE_CAMERA, PINHOLE_CAMERA_RADIAL1, PINHOLE_CAMERA_RADIAL3,
+     PINHOLE_CAMERA_BROWN, PINHOLE_CAMERA_FISHEYE})
+  {
+    // Translate the input dataset to a SfM_Data scene
+    SfM_Data sfm_data = getInputScene(d, config, eintrinsic);
+    SfM_Data sfm_data_autodiff = sfm_data;
+
+    const double dResidual_before = RMSE(sfm_data);
+
+    const Optimize_Options ba_refine_options(
+      Intrinsic_Parameter_Type::ADJUST_ALL,
+      Extrinsic_Parameter_Type::ADJUST_ALL,
+      Structure_Parameter_Type::ADJUST_ALL);
+
+    Bundle_Adjustment_Ceres::BA_Ceres_options options(true, false);
+    options.bUse_analytic_derivatives_ = true;
+    EXPECT_TRUE( Bundle_Adjustment_Ceres(options).Adjust(sfm_data, ba_refine_options) );
+
+    const double dResidual_after = RMSE(sfm_data);
+    EXPECT_TRUE( dResidual_before > dResidual_after);
+
+    // Same minimum as the AutoDiff cost functions
+    options.bUse_analytic_derivatives_ = false;
+    EXPECT_TRUE( Bundle_Adjustment_Ceres(options).Adjust(sfm_data_autodiff, ba_refine_options) );
+    EXPECT_NEAR( RMSE(sfm_data_autodiff), dResidual_after, 1e-4 );
+  }
+}
+
 //-- Test with GCP - Camera position once BA done must be the same as the GT
 TEST(BUNDLE_ADJUSTMENT, EffectiveMinimization_Pinhole_GCP) {
 
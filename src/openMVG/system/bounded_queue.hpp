@@ -0,0 +1,101 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
+#define OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace openMVG
+{
+namespace system
+{
+
+/**
+* @brief Bounded, blocking, multi-producer/multi-consumer queue.
+* It connects the stages of a pipeline: the producers are blocked while the
+*  queue is full, the consumers while it is empty.
+* Once closed, the pending values can still be popped.
+*/
+template <typename T>
+class Bounded_Queue
+{
+  public:
+
+    explicit Bounded_Queue( std::size_t capacity )
+      : capacity_( std::max<std::size_t>( 1, capacity ) )
+    {}
+
+    Bounded_Queue( const Bounded_Queue & ) = delete;
+    Bounded_Queue & operator=( const Bounded_Queue & ) = delete;
+
+    /**
+    * @brief Push a value (wait while the queue is full).
+    * @return false if the queue is closed (the value is not pushed)
+    */
+    bool push( T && value )
+    {
+      std::unique_lock<std::mutex> lock( mutex_ );
+      not_full_.wait( lock, [&]{ return queue_.size() < capacity_ || closed_; } );
+      if ( closed_ )
+        return false;
+      queue_.push_back( std::move( value ) );
+      not_empty_.notify_one();
+      return true;
+    }
+
+    /**
+    * @brief Pop a value (wait while the queue is empty).
+    * @return false once the queue is closed and empty
+    */
+    bool pop( T & value )
+    {
+      std::unique_lock<std::mutex> lock( mutex_ );
+      not_empty_.wait( lock, [&]{ return !queue_.empty() || closed_; } );
+      if ( queue_.empty() )
+        return false;
+      value = std::move( queue_.front() );
+      queue_.pop_front();
+      not_full_.notify_one();
+      return true;
+    }
+
+    /**
+    * @brief No more values will be pushed (the pending values can still be popped).
+    */
+    void close()
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      closed_ = true;
+      not_empty_.notify_all();
+      not_full_.notify_all();
+    }
+
+    /// Number of values waiting in the queue
+    std::size_t size() const
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      return queue_.size();
+    }
+
+  private:
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_, not_full_;
+    std::deque<T> queue_;
+    bool closed_ = false;
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
@@ -0,0 +1,77 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/bounded_queue.hpp"
+
+#include "testing/testing.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace openMVG::system;
+
+TEST(Bounded_Queue, close)
+{
+  Bounded_Queue<int> queue(2);
+  EXPECT_TRUE( queue.push(1) );
+  EXPECT_TRUE( queue.push(2) );
+  EXPECT_EQ( 2, queue.size() );
+  queue.close();
+  // No more push once closed, but the pending values can be popped
+  EXPECT_FALSE( queue.push(3) );
+  int value = 0;
+  EXPECT_TRUE( queue.pop(value) );
+  EXPECT_EQ( 1, value );
+  EXPECT_TRUE( queue.pop(value) );
+  EXPECT_EQ( 2, value );
+  EXPECT_FALSE( queue.pop(value) );
+}
+
+TEST(Bounded_Queue, producers_consumers)
+{
+  const int nb_producer = 4, nb_consumer = 3, nb_value_per_producer = 1000;
+  Bounded_Queue<int> queue(8);
+  std::atomic<long long> sum(0);
+  std::atomic<int> count(0);
+
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < nb_consumer; ++i)
+  {
+    consumers.emplace_back([&]
+    {
+      int value;
+      while (queue.pop(value))
+      {
+        sum += value;
+        ++count;
+      }
+    });
+  }
+  std::vector<std::thread> producers;
+  for (int i = 0; i < nb_producer; ++i)
+  {
+    producers.emplace_back([&]
+    {
+      for (int v = 1; v <= nb_value_per_producer; ++v)
+        queue.push(int(v));
+    });
+  }
+  for (auto & producer : producers)
+    producer.join();
+  queue.close();
+  for (auto & consumer : consumers)
+    consumer.join();
+
+  EXPECT_EQ( nb_producer * nb_value_per_producer, count );
+  EXPECT_EQ( nb_producer * nb_value_per_producer * (nb_value_per_producer + 1) / 2, sum );
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -0,0 +1,67 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SYSTEM_MAPPED_FILE_HPP
+#define OPENMVG_SYSTEM_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace openMVG
+{
+namespace system
+{
+
+/**
+* @brief Read-only memory mapping of a whole file.
+* The mapping is released when the object is destroyed.
+*/
+class Mapped_File
+{
+  public:
+
+    Mapped_File() = default;
+    ~Mapped_File();
+
+    Mapped_File(const Mapped_File &) = delete;
+    Mapped_File & operator=(const Mapped_File &) = delete;
+
+    /**
+    * @brief Map the given file in memory (read-only).
+    * @param filename Path of the file to map
+    * @return true if the file has been mapped
+    */
+    bool open(const std::string & filename);
+
+    /**
+    * @brief Release the mapping (if any).
+    */
+    void close();
+
+    /// Return true if a file is currently mapped
+    bool is_open() const { return data_ != nullptr; }
+
+    /// Return the first byte of the mapped file
+    const char * data() const { return data_; }
+
+    /// Return the size in bytes of the mapped file
+    std::size_t size() const { return size_; }
+
+  private:
+    const char * data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void * file_handle_ = nullptr;
+    void * mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // OPENMVG_SYSTEM_MAPPED_FILE_HPP
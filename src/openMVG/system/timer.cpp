@@ -27,13 +27,13 @@ void Timer::reset()
 double Timer::elapsed() const
 {
   const auto end_ = std::chrono::high_resolution_clock::now();
-  return std::chrono::duration_cast<std::chrono::seconds>(end_ - start_).count();
+  return std::chrono::duration<double>(end_ - start_).count();
 }
 
 double Timer::elapsedMs() const
 {
   const auto end_ = std::chrono::high_resolution_clock::now();
-  return std::chrono::duration_cast<std::chrono::milliseconds>(end_ - start_).count();
+  return std::chrono::duration<double, std::milli>(end_ - start_).count();
 }
 
 std::ostream& operator << (std::ostream& str, const Timer& t)
@@ -49,6 +49,10 @@
 #include "openMVG/tracks/flat_pair_map.hpp"
 #include "openMVG/tracks/union_find.hpp"
 
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace openMVG  {
 
 namespace tracks  {
@@ -59,6 +63,253 @@ using submapTrack = std::map<uint32_t, uint32_t>;
 // A track is a collection of {trackId, submapTrack}
 using STLMAPTracks = std::map<uint32_t, submapTrack>;
 
+namespace internal {
+
+/// Sort an array using all the available threads:
+///  - the array is split in as many chunks as threads, each chunk is sorted,
+///  - the sorted chunks are merged two by two.
+template <typename T>
+void ParallelSort(std::vector<T> & values)
+{
+#ifdef OPENMVG_USE_OPENMP
+  const size_t chunk_count = std::min<size_t>(omp_get_max_threads(), values.size() / 1024 + 1);
+#else
+  const size_t chunk_count = 1;
+#endif
+  std::vector<size_t> bounds(chunk_count + 1);
+  for (size_t i = 0; i <= chunk_count; ++i)
+    bounds[i] = values.size() * i / chunk_count;
+
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < static_cast<int>(chunk_count); ++i)
+    std::sort(values.begin() + bounds[i], values.begin() + bounds[i + 1]);
+
+  for (size_t step = 1; step < chunk_count; step *= 2)
+  {
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < static_cast<int>(chunk_count - step); i += static_cast<int>(2 * step))
+    {
+      std::inplace_merge(
+        values.begin() + bounds[i],
+        values.begin() + bounds[i + step],
+        values.begin() + bounds[std::min(i + 2 * step, chunk_count)]);
+    }
+  }
+}
+
+} // namespace internal
+
+/// Contiguous (CSR like) storage of a set of tracks.
+/// - the track ids are sorted increasingly,
+/// - the observations {ImageId,FeatureId} of the i-th track are stored in the range
+///   [offsets_[i], offsets_[i+1]) of a single packed array (sorted by ImageId),
+/// - a per view inverted index lists the {track index, FeatureId} observed by each view.
+/// Compared to STLMAPTracks it avoids the per node allocations of the std::map
+///  and allows the retrieval of the tracks observed by a view without a full scan.
+class FlatTracks
+{
+public:
+  /// {ImageId, FeatureId}
+  using Observation = std::pair<uint32_t, uint32_t>;
+  /// {track index, FeatureId}
+  using ViewObservation = std::pair<uint32_t, uint32_t>;
+
+  /// Lightweight range over a contiguous array
+  template <typename T>
+  struct Range
+  {
+    const T * begin_;
+    const T * end_;
+    const T * begin() const { return begin_; }
+    const T * end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    const T & operator[](size_t i) const { return begin_[i]; }
+  };
+
+  /// Observation of a track used to build the container: {TrackId, {ImageId, FeatureId}}
+  using TrackObservation = std::pair<uint32_t, Observation>;
+
+  FlatTracks() = default;
+
+  explicit FlatTracks(const STLMAPTracks & map_tracks)
+  {
+    std::vector<TrackObservation> track_observations;
+    for (const auto & track_it : map_tracks)
+      for (const auto & obs_it : track_it.second)
+        track_observations.emplace_back(track_it.first, obs_it);
+    Build(std::move(track_observations));
+  }
+
+  /// Build the container from a list of track observations (in any order)
+  void Build(std::vector<TrackObservation> && track_observations)
+  {
+    Clear();
+    internal::ParallelSort(track_observations);
+
+    // Tracks and their observations
+    observations_.reserve(track_observations.size());
+    for (const auto & track_obs : track_observations)
+    {
+      if (track_ids_.empty() || track_ids_.back() != track_obs.first)
+      {
+        track_ids_.push_back(track_obs.first);
+        offsets_.push_back(static_cast<uint32_t>(observations_.size()));
+      }
+      observations_.push_back(track_obs.second);
+    }
+    offsets_.push_back(static_cast<uint32_t>(observations_.size()));
+    track_observations.clear();
+
+    // Per view inverted index (counting sort by ImageId)
+    for (const auto & obs : observations_)
+      view_ids_.push_back(obs.first);
+    std::sort(view_ids_.begin(), view_ids_.end());
+    view_ids_.erase(std::unique(view_ids_.begin(), view_ids_.end()), view_ids_.end());
+
+    view_offsets_.assign(view_ids_.size() + 1, 0);
+    for (const auto & obs : observations_)
+      ++view_offsets_[ViewIndex(obs.first) + 1];
+    for (size_t i = 1; i < view_offsets_.size(); ++i)
+      view_offsets_[i] += view_offsets_[i - 1];
+
+    view_observations_.resize(observations_.size());
+    std::vector<uint32_t> insert_position(view_offsets_.begin(), view_offsets_.end() - 1);
+    for (uint32_t track_index = 0; track_index < track_ids_.size(); ++track_index)
+    {
+      for (uint32_t k = offsets_[track_index]; k < offsets_[track_index + 1]; ++k)
+      {
+        const Observation & obs = observations_[k];
+        view_observations_[insert_position[ViewIndex(obs.first)]++] = {track_index, obs.second};
+      }
+    }
+  }
+
+  void Clear()
+  {
+    track_ids_.clear();
+    offsets_.clear();
+    observations_.clear();
+    view_ids_.clear();
+    view_offsets_.clear();
+    view_observations_.clear();
+  }
+
+  /// Return the number of tracks
+  size_t NbTracks() const { return track_ids_.size(); }
+  bool Empty() const { return track_ids_.empty(); }
+
+  /// Return the TrackId of the track at the given index
+  uint32_t TrackId(size_t track_index) const { return track_ids_[track_index]; }
+
+  /// Return the observations {ImageId, FeatureId} of the track at the given index
+  Range<Observation> Track(size_t track_index) const
+  {
+    return {observations_.data() + offsets_[track_index],
+            observations_.data() + offsets_[track_index + 1]};
+  }
+
+  /// Find the index of a track from its TrackId
+  bool FindTrack(uint32_t track_id, size_t & track_index) const
+  {
+    const auto it = std::lower_bound(track_ids_.cbegin(), track_ids_.cend(), track_id);
+    if (it == track_ids_.cend() || *it != track_id)
+      return false;
+    track_index = std::distance(track_ids_.cbegin(), it);
+    return true;
+  }
+
+  /// Find the FeatureId observed by a view in a track
+  bool FindFeature(size_t track_index, uint32_t view_id, uint32_t & feat_id) const
+  {
+    const Range<Observation> track = Track(track_index);
+    const auto it = std::lower_bound(track.begin(), track.end(), view_id,
+      [](const Observation & obs, uint32_t id) { return obs.first < id; });
+    if (it == track.end() || it->first != view_id)
+      return false;
+    feat_id = it->second;
+    return true;
+  }
+
+  /// Return the {track index, FeatureId} observed by a view (sorted by track index)
+  Range<ViewObservation> TracksInView(uint32_t view_id) const
+  {
+    const auto it = std::lower_bound(view_ids_.cbegin(), view_ids_.cend(), view_id);
+    if (it == view_ids_.cend() || *it != view_id)
+      return {nullptr, nullptr};
+    const size_t i = std::distance(view_ids_.cbegin(), it);
+    return {view_observations_.data() + view_offsets_[i],
+            view_observations_.data() + view_offsets_[i + 1]};
+  }
+
+  /// Return the ImageIds observed by the tracks (sorted increasingly)
+  const std::vector<uint32_t> & ViewIds() const { return view_ids_; }
+
+  /**
+   * @brief Find the shared tracks between some images ids.
+   *
+   * @param[in] image_ids: images id to consider
+   * @param[out] tracks: tracks shared by the input images id (restricted to these images)
+   */
+  bool GetTracksInImages
+  (
+    const std::set<uint32_t> & image_ids,
+    STLMAPTracks & tracks
+  ) const
+  {
+    tracks.clear();
+    if (image_ids.empty())
+      return false;
+
+    // Go along the tracks seen by the first view and check the other views visibility
+    for (const ViewObservation & view_obs : TracksInView(*image_ids.cbegin()))
+    {
+      submapTrack track;
+      for (const uint32_t image_id : image_ids)
+      {
+        uint32_t feat_id;
+        if (!FindFeature(view_obs.first, image_id, feat_id))
+          break;
+        track[image_id] = feat_id;
+      }
+      if (track.size() == image_ids.size())
+        tracks[TrackId(view_obs.first)] = std::move(track);
+    }
+    return !tracks.empty();
+  }
+
+  /// Export the tracks as a map (see TracksBuilder::ExportToSTL)
+  void ExportToSTL(STLMAPTracks & map_tracks) const
+  {
+    map_tracks.clear();
+    for (size_t i = 0; i < NbTracks(); ++i)
+    {
+      const Range<Observation> track = Track(i);
+      map_tracks[TrackId(i)].insert(track.begin(), track.end());
+    }
+  }
+
+private:
+  size_t ViewIndex(uint32_t view_id) const
+  {
+    return std::distance(view_ids_.cbegin(),
+      std::lower_bound(view_ids_.cbegin(), view_ids_.cend(), view_id));
+  }
+
+  // Tracks
+  std::vector<uint32_t> track_ids_;       // TrackId of each track (sorted)
+  std::vector<uint32_t> offsets_;         // Start of each track observations (NbTracks + 1)
+  std::vector<Observation> observations_; // Packed {ImageId, FeatureId}
+  // Per view inverted index
+  std::vector<uint32_t> view_ids_;        // Observed ImageIds (sorted)
+  std::vector<uint32_t> view_offsets_;    // Start of each view observations (#views + 1)
+  std::vector<ViewObservation> view_observations_; // Packed {track index, FeatureId}
+};
+
 struct TracksBuilder
 {
   using indexedFeaturePair = std::pair<uint32_t, uint32_t>;
@@ -71,95 +322,124 @@ struct TracksBuilder
   {
     // 1. We need to know how much single set we will have.
     //   i.e each set is made of a tuple : (imageIndex, featureIndex)
-    std::set<indexedFeaturePair> allFeatures;
-    // For each couple of images list the used features
-    for ( const auto & iter : map_pair_wise_matches )
-    {
-      const auto & I = iter.first.first;
-      const auto & J = iter.first.second;
-      const std::vector<matching::IndMatch> & vec_FilteredMatches = iter.second;
-
-      // Retrieve all shared features and add them to a set
-      for ( const auto & cur_filtered_match : vec_FilteredMatches )
-      {
-        allFeatures.emplace(I,cur_filtered_match.i_);
-        allFeatures.emplace(J,cur_filtered_match.j_);
-      }
-    }
-
     // 2. Build the 'flat' representation where a tuple (the node)
     //  is attached to a unique index.
-    map_node_to_index.reserve(allFeatures.size());
-    uint32_t cpt = 0;
-    for (const auto & feat : allFeatures)
-    {
-      map_node_to_index.emplace_back(feat, cpt);
-      ++cpt;
-    }
-    // Sort the flat_pair_map
-    map_node_to_index.sort();
-    // Clean some memory
-    allFeatures.clear();
+    InitNodes(ListNodes(map_pair_wise_matches));
 
     // 3. Add the node and the pairwise correpondences in the UF tree.
-    uf_tree.InitSets(map_node_to_index.size());
+    ConcurrentUnionFind concurrent_uf_tree(map_node_to_index.size());
 
     // 4. Union of the matched features corresponding UF tree sets
-    for ( const auto & iter : map_pair_wise_matches )
+    UnionMatches(map_pair_wise_matches, concurrent_uf_tree);
+
+    // 5. Export the forest to the UF tree
+    InitUFTree(concurrent_uf_tree);
+  }
+
+  /// Build tracks for a series of pairWise matches provided by chunks
+  ///  (only one chunk of matches is kept in memory at a time).
+  /// \param chunk_count The number of chunks
+  /// \param load_chunk Function that fills the pairwise matches of the i-th chunk
+  ///  (each chunk is loaded twice)
+  /// \return false if a chunk cannot be loaded
+  bool Build
+  (
+    const size_t chunk_count,
+    const std::function<bool(size_t, matching::PairWiseMatches &)> & load_chunk
+  )
+  {
+    // 1. List the nodes (merge the sorted nodes of each chunk)
+    std::vector<indexedFeaturePair> allFeatures;
+    for (size_t i = 0; i < chunk_count; ++i)
     {
-      const auto & I = iter.first.first;
-      const auto & J = iter.first.second;
-      const std::vector<matching::IndMatch> & vec_FilteredMatches = iter.second;
-      for (const matching::IndMatch & match : vec_FilteredMatches)
-      {
-        const indexedFeaturePair pairI(I, match.i_);
-        const indexedFeaturePair pairJ(J, match.j_);
-        // Link feature correspondences to the corresponding containing sets.
-        uf_tree.Union(map_node_to_index[pairI], map_node_to_index[pairJ]);
-      }
+      matching::PairWiseMatches chunk;
+      if (!load_chunk(i, chunk))
+        return false;
+      const std::vector<indexedFeaturePair> chunk_features = ListNodes(chunk);
+      std::vector<indexedFeaturePair> merged_features;
+      merged_features.reserve(allFeatures.size() + chunk_features.size());
+      std::set_union(
+        allFeatures.cbegin(), allFeatures.cend(),
+        chunk_features.cbegin(), chunk_features.cend(),
+        std::back_inserter(merged_features));
+      allFeatures.swap(merged_features);
+    }
+    // 2. Build the 'flat' representation
+    InitNodes(std::move(allFeatures));
+
+    // 3. & 4. Union of the matched features, chunk by chunk
+    ConcurrentUnionFind concurrent_uf_tree(map_node_to_index.size());
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+      matching::PairWiseMatches chunk;
+      if (!load_chunk(i, chunk))
+        return false;
+      UnionMatches(chunk, concurrent_uf_tree);
     }
+
+    // 5. Export the forest to the UF tree
+    InitUFTree(concurrent_uf_tree);
+    return true;
   }
 
   /// Remove bad tracks (too short or track with ids collision)
   bool Filter(size_t nLengthSupTo = 2)
   {
-    // Build the Track observations & mark tracks that have id collision:
-    std::map<uint32_t, std::set<uint32_t>> tracks; // {track_id, {image_id, image_id, ...}}
-    std::set<uint32_t> problematic_track_id; // {track_id, ...}
+    const int node_count = static_cast<int>(map_node_to_index.size());
+
+    // For each node retrieve its track id from the UF tree
+    //  (FindRoot does not compress the paths: the tree is only read here)
+    std::vector<uint32_t> track_ids(node_count);
+    // Build the Track observations: {track_id, image_id}
+    std::vector<std::pair<uint32_t, uint32_t>> track_observations(node_count);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < node_count; ++k)
+    {
+      track_ids[k] = uf_tree.FindRoot(k);
+      track_observations[k] = {track_ids[k], map_node_to_index[k].first.first};
+    }
+    internal::ParallelSort(track_observations);
 
-    // For each node retrieve its track id from the UF tree and add the node to the track
+    // Mark tracks that have id collision or too few observations:
     // - if an image id is observed multiple time, then mark the track as invalid
     //   - a track cannot list many times the same image index
-    for (uint32_t k = 0; k < map_node_to_index.size(); ++k)
+    std::vector<uint8_t> problematic_track_id(node_count, 0);
+    for (size_t begin = 0, end = 0; begin < track_observations.size(); begin = end)
     {
-      const uint32_t & track_id = uf_tree.Find(k);
-      const auto & feat = map_node_to_index[k];
-
-      // Augment the track and mark if invalid (an image can only be listed once)
-      if (tracks[track_id].insert(feat.first.first).second == false)
+      const uint32_t track_id = track_observations[begin].first;
+      bool bInvalid = false;
+      for (end = begin + 1;
+           end < track_observations.size() && track_observations[end].first == track_id;
+           ++end)
       {
-        problematic_track_id.insert(track_id); // invalid
+        bInvalid |= (track_observations[end].second == track_observations[end - 1].second);
       }
-    }
-
-    // Reject tracks that have too few observations
-    for (const auto & val : tracks)
-    {
-      if (val.second.size() < nLengthSupTo)
+      // Reject tracks that have too few observations
+      if (bInvalid || end - begin < nLengthSupTo)
       {
-        problematic_track_id.insert(val.first);
+        problematic_track_id[track_id] = 1;
       }
     }
 
-    // Reset the marked invalid track ids in the UF Tree
-    for (uint32_t & root_index : uf_tree.m_cc_parent)
+    // Link each node to its root (the UF tree is then compressed)
+    //  and reset the marked invalid track ids in the UF Tree
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < node_count; ++k)
     {
-      if (problematic_track_id.count(root_index) > 0)
-      {
-        // reset selected root
-        uf_tree.m_cc_size[root_index] = 1;
-        root_index = std::numeric_limits<uint32_t>::max();
-      }
+      const uint32_t root_index = track_ids[k];
+      uf_tree.m_cc_parent[k] = problematic_track_id[root_index]
+        ? std::numeric_limits<uint32_t>::max()
+        : root_index;
+    }
+    for (int k = 0; k < node_count; ++k)
+    {
+      // reset selected root
+      if (problematic_track_id[k])
+        uf_tree.m_cc_size[k] = 1;
     }
     return false;
   }
@@ -167,10 +447,18 @@ struct TracksBuilder
   /// Return the number of connected set in the UnionFind structure (tree forest)
   size_t NbTracks() const
   {
-    std::set<uint32_t> parent_id(uf_tree.m_cc_parent.begin(), uf_tree.m_cc_parent.end());
-    // Erase the "special marker" that depicted rejected tracks
-    parent_id.erase(std::numeric_limits<uint32_t>::max());
-    return parent_id.size();
+    // The UF tree is compressed: count the roots
+    //  (the "special marker" that depicted rejected tracks is never a root)
+    const int node_count = static_cast<int>(uf_tree.m_cc_parent.size());
+    int track_count = 0;
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static) reduction(+:track_count)
+#endif
+    for (int k = 0; k < node_count; ++k)
+    {
+      track_count += (uf_tree.m_cc_parent[k] == static_cast<uint32_t>(k));
+    }
+    return track_count;
   }
 
   /// Export tracks as a map (each entry is a sequence of imageId and featureIndex):
@@ -194,6 +482,164 @@ struct TracksBuilder
       }
     }
   }
+
+  /// Export tracks to a contiguous track container
+  void ExportToFlat(FlatTracks & tracks)
+  {
+    const int node_count = static_cast<int>(map_node_to_index.size());
+    // Rejected nodes are marked with an invalid track id and removed afterward
+    const uint32_t invalid_track_id = std::numeric_limits<uint32_t>::max();
+    std::vector<FlatTracks::TrackObservation> track_observations(node_count);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < node_count; ++k)
+    {
+      const auto & feat = map_node_to_index[k];
+      const uint32_t & track_id = uf_tree.m_cc_parent[k];
+      if
+      (
+        // ensure never add rejected elements (track marked as invalid)
+        track_id != std::numeric_limits<uint32_t>::max()
+        // ensure never add 1-length track element (it's not a track)
+        && uf_tree.m_cc_size[track_id] > 1
+      )
+      {
+        track_observations[k] = {track_id, feat.first};
+      }
+      else
+      {
+        track_observations[k].first = invalid_track_id;
+      }
+    }
+    track_observations.erase(
+      std::remove_if(track_observations.begin(), track_observations.end(),
+        [&](const FlatTracks::TrackObservation & obs) { return obs.first == invalid_track_id; }),
+      track_observations.end());
+    tracks.Build(std::move(track_observations));
+  }
+
+private:
+
+  /// List the pairs of a pairwise matches container (to allow a parallel traversal)
+  ///  and the position of their matches in a flat array
+  static void ListPairs
+  (
+    const matching::PairWiseMatches & map_pair_wise_matches,
+    std::vector<matching::PairWiseMatches::const_iterator> & pairs,
+    std::vector<size_t> & match_offsets
+  )
+  {
+    pairs.clear();
+    pairs.reserve(map_pair_wise_matches.size());
+    match_offsets.assign(1, 0);
+    for (auto iter = map_pair_wise_matches.cbegin(); iter != map_pair_wise_matches.cend(); ++iter)
+    {
+      pairs.push_back(iter);
+      match_offsets.push_back(match_offsets.back() + iter->second.size());
+    }
+  }
+
+  /// Return the sorted list of the (imageIndex, featureIndex) tuples used by the matches
+  static std::vector<indexedFeaturePair> ListNodes
+  (
+    const matching::PairWiseMatches & map_pair_wise_matches
+  )
+  {
+    std::vector<matching::PairWiseMatches::const_iterator> pairs;
+    std::vector<size_t> match_offsets;
+    ListPairs(map_pair_wise_matches, pairs, match_offsets);
+
+    std::vector<indexedFeaturePair> allFeatures(2 * match_offsets.back());
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(pairs.size()); ++i)
+    {
+      const auto & I = pairs[i]->first.first;
+      const auto & J = pairs[i]->first.second;
+      const std::vector<matching::IndMatch> & vec_FilteredMatches = pairs[i]->second;
+
+      // Retrieve all shared features
+      size_t cpt = 2 * match_offsets[i];
+      for ( const auto & cur_filtered_match : vec_FilteredMatches )
+      {
+        allFeatures[cpt++] = {I, cur_filtered_match.i_};
+        allFeatures[cpt++] = {J, cur_filtered_match.j_};
+      }
+    }
+    // Sort and remove the duplicates (a feature can be matched in many pairs)
+    internal::ParallelSort(allFeatures);
+    allFeatures.erase(std::unique(allFeatures.begin(), allFeatures.end()), allFeatures.end());
+    return allFeatures;
+  }
+
+  /// Attach each node (sorted tuple) to a unique index
+  void InitNodes(std::vector<indexedFeaturePair> && allFeatures)
+  {
+    // The nodes are already sorted, the flat_pair_map does not need to be sorted
+    map_node_to_index.clear();
+    map_node_to_index.reserve(allFeatures.size());
+    uint32_t cpt = 0;
+    for (const auto & feat : allFeatures)
+    {
+      map_node_to_index.emplace_back(feat, cpt);
+      ++cpt;
+    }
+    // Clean some memory
+    allFeatures.clear();
+    allFeatures.shrink_to_fit();
+  }
+
+  /// Union of the matched features corresponding UF tree sets
+  void UnionMatches
+  (
+    const matching::PairWiseMatches & map_pair_wise_matches,
+    ConcurrentUnionFind & concurrent_uf_tree
+  )
+  {
+    std::vector<matching::PairWiseMatches::const_iterator> pairs;
+    std::vector<size_t> match_offsets;
+    ListPairs(map_pair_wise_matches, pairs, match_offsets);
+
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(pairs.size()); ++i)
+    {
+      const auto & I = pairs[i]->first.first;
+      const auto & J = pairs[i]->first.second;
+      const std::vector<matching::IndMatch> & vec_FilteredMatches = pairs[i]->second;
+      for (const matching::IndMatch & match : vec_FilteredMatches)
+      {
+        const indexedFeaturePair pairI(I, match.i_);
+        const indexedFeaturePair pairJ(J, match.j_);
+        // Link feature correspondences to the corresponding containing sets.
+        // (concurrent lookups are safe: the flat_pair_map is not modified anymore)
+        concurrent_uf_tree.Union(map_node_to_index[pairI], map_node_to_index[pairJ]);
+      }
+    }
+  }
+
+  /// Export the forest to the UF tree (compressed: each node is linked to its root)
+  void InitUFTree(ConcurrentUnionFind & concurrent_uf_tree)
+  {
+    const int node_count = static_cast<int>(map_node_to_index.size());
+    uf_tree.m_cc_parent.resize(node_count);
+    uf_tree.m_cc_rank.assign(node_count, 0);
+    uf_tree.m_cc_size.assign(node_count, 0);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < node_count; ++k)
+    {
+      uf_tree.m_cc_parent[k] = concurrent_uf_tree.Find(k);
+    }
+    for (const uint32_t root_index : uf_tree.m_cc_parent)
+    {
+      ++uf_tree.m_cc_size[root_index];
+    }
+  }
 };
 
 // This structure help to store the track visibility per view.
@@ -397,6 +843,29 @@ struct TracksUtilsMap
     }
   }
 
+  /// Return the occurrence of tracks length.
+  static void TracksLength
+  (
+    const FlatTracks & tracks,
+    std::map<uint32_t, uint32_t> & map_Occurence_TrackLength
+  )
+  {
+    for (size_t i = 0; i < tracks.NbTracks(); ++i)
+    {
+      ++map_Occurence_TrackLength[tracks.Track(i).size()];
+    }
+  }
+
+  /// Return a set containing the image Id considered in the tracks container.
+  static void ImageIdInTracks
+  (
+    const FlatTracks & tracks,
+    std::set<uint32_t> & set_imagesId
+  )
+  {
+    set_imagesId.insert(tracks.ViewIds().cbegin(), tracks.ViewIds().cend());
+  }
+
   /// Return a set containing the image Id considered in the tracks container.
   static void ImageIdInTracks
   (
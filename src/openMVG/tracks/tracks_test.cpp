@@ -12,6 +12,7 @@
 #include "CppUnitLite/TestHarness.h"
 #include "testing/testing.h"
 
+#include <iterator>
 #include <vector>
 #include <utility>
 
@@ -143,6 +144,34 @@ TEST(Tracks, Conflict) {
 }
 
 
+TEST(Tracks, Filter_NotCompressedTree) {
+
+  //A    B    C
+  //0 -> 0 -> 0
+  //1 -> 1 -> 6
+  //2 -> 3
+  // + a union of the last two tracks done after the build
+  //   (the UF tree is no longer compressed, the merged track lists A two times)
+
+  PairWiseMatches map_pairwisematches;
+  map_pairwisematches[ {0,1} ] = {IndMatch(0,0), IndMatch(1,1), IndMatch(2,3)};
+  map_pairwisematches[ {1,2} ] = {IndMatch(0,0), IndMatch(1,6)};
+
+  TracksBuilder trackBuilder;
+  trackBuilder.Build( map_pairwisematches );
+  trackBuilder.uf_tree.Union(
+    trackBuilder.map_node_to_index[{0,2}], trackBuilder.map_node_to_index[{2,6}]);
+
+  CHECK_EQUAL(2, trackBuilder.NbTracks());
+  trackBuilder.Filter();
+  CHECK_EQUAL(1, trackBuilder.NbTracks());
+
+  STLMAPTracks map_tracks;
+  trackBuilder.ExportToSTL(map_tracks);
+  CHECK_EQUAL(1, map_tracks.size());
+  CHECK(map_tracks.cbegin()->second == submapTrack({{0,0},{1,0},{2,0}}));
+}
+
 TEST(Tracks, TracksInImages) {
 
   //
@@ -211,6 +240,107 @@ TEST(Tracks, TracksInImages) {
   }
 }
 
+TEST(Tracks, BuildByChunks) {
+
+  //  A   B   C   D
+  //  0 -> 0 -> 0
+  //  1 -> 1 -> 6 -> 2
+  //  2 -> 3
+  PairWiseMatches map_pairwisematches;
+  map_pairwisematches[{0,1}] = {{0,0}, {1,1}, {2,3}};
+  map_pairwisematches[{1,2}] = {{0,0}, {1,6}};
+  map_pairwisematches[{2,3}] = {{6,2}};
+
+  TracksBuilder trackBuilder;
+  trackBuilder.Build(map_pairwisematches);
+  STLMAPTracks map_tracks;
+  trackBuilder.ExportToSTL(map_tracks);
+
+  // Provide the pairs one by one
+  TracksBuilder chunkTrackBuilder;
+  EXPECT_TRUE(chunkTrackBuilder.Build(map_pairwisematches.size(),
+    [&](size_t i, PairWiseMatches & chunk)
+    {
+      auto it = map_pairwisematches.cbegin();
+      std::advance(it, i);
+      chunk.insert(*it);
+      return true;
+    }));
+  STLMAPTracks map_chunk_tracks;
+  chunkTrackBuilder.ExportToSTL(map_chunk_tracks);
+
+  EXPECT_EQ(3, map_tracks.size());
+  CHECK(map_tracks == map_chunk_tracks);
+
+  // A chunk loading failure is reported
+  EXPECT_FALSE(chunkTrackBuilder.Build(2,
+    [](size_t i, PairWiseMatches &) { return i == 0; }));
+}
+
+TEST(Tracks, FlatTracks) {
+
+  //
+  //  A   B   C
+  //  0 -> 0 -> 0
+  //  1 -> 1 -> 6
+  //  2 -> 3
+  //
+  PairWiseMatches map_pairwisematches;
+  map_pairwisematches[{0,1}] = {{0,0}, {1,1}, {2,3}};
+  map_pairwisematches[{1,2}] = {{0,0}, {1,6}};
+
+  TracksBuilder trackBuilder;
+  trackBuilder.Build( map_pairwisematches );
+
+  FlatTracks flat_tracks;
+  trackBuilder.ExportToFlat(flat_tracks);
+  STLMAPTracks map_tracks;
+  trackBuilder.ExportToSTL(map_tracks);
+
+  EXPECT_EQ(3, flat_tracks.NbTracks());
+
+  // The flat container must store the same tracks as the map container
+  STLMAPTracks map_tracks_from_flat;
+  flat_tracks.ExportToSTL(map_tracks_from_flat);
+  EXPECT_TRUE(map_tracks == map_tracks_from_flat);
+  EXPECT_TRUE(FlatTracks(map_tracks).NbTracks() == flat_tracks.NbTracks());
+
+  // Per view inverted index
+  EXPECT_EQ(3, flat_tracks.TracksInView(0).size());
+  EXPECT_EQ(3, flat_tracks.TracksInView(1).size());
+  EXPECT_EQ(2, flat_tracks.TracksInView(2).size());
+  EXPECT_TRUE(flat_tracks.TracksInView(99).empty());
+
+  for (const auto & view_obs : flat_tracks.TracksInView(2))
+  {
+    uint32_t feat_id;
+    EXPECT_TRUE(flat_tracks.FindFeature(view_obs.first, 2, feat_id));
+    EXPECT_EQ(view_obs.second, feat_id);
+    size_t track_index;
+    EXPECT_TRUE(flat_tracks.FindTrack(flat_tracks.TrackId(view_obs.first), track_index));
+    EXPECT_EQ(view_obs.first, track_index);
+  }
+
+  // Shared tracks (same results as the SharedTrackVisibilityHelper)
+  SharedTrackVisibilityHelper shared_track_visibility_helper(map_tracks);
+  for (const std::set<uint32_t> & image_ids :
+    std::vector<std::set<uint32_t>>{{0}, {1}, {2}, {0,1}, {0,2}, {0,1,2}, {99}, {0,99}})
+  {
+    STLMAPTracks tracks_flat, tracks_map;
+    EXPECT_EQ(shared_track_visibility_helper.GetTracksInImages(image_ids, tracks_map),
+              flat_tracks.GetTracksInImages(image_ids, tracks_flat));
+    EXPECT_TRUE(tracks_map == tracks_flat);
+  }
+
+  std::set<uint32_t> image_ids;
+  TracksUtilsMap::ImageIdInTracks(flat_tracks, image_ids);
+  EXPECT_EQ(3, image_ids.size());
+  std::map<uint32_t, uint32_t> track_length_occurence;
+  TracksUtilsMap::TracksLength(flat_tracks, track_length_occurence);
+  EXPECT_EQ(1, track_length_occurence[2]);
+  EXPECT_EQ(2, track_length_occurence[3]);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
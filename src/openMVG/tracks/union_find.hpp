@@ -9,7 +9,9 @@
 #ifndef OPENMVG_TRACKS_UNION_FIND_DISJOINT_SET_HPP
 #define OPENMVG_TRACKS_UNION_FIND_DISJOINT_SET_HPP
 
+#include <atomic>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 namespace openMVG  {
@@ -71,6 +73,18 @@ struct UnionFind
      return m_cc_parent[i];
   }
 
+  // Return the representative set id of I nth component without path compression
+  //  (the tree is not modified: it can be called concurrently)
+  unsigned int FindRoot
+  (
+    unsigned int i
+  ) const
+  {
+    while (m_cc_parent[i] != i)
+      i = m_cc_parent[i];
+    return i;
+  }
+
   // Replace sets containing I and J with their union
   void Union
   (
@@ -103,6 +117,84 @@ struct UnionFind
   }
 };
 
+// Concurrent Union-Find/Disjoint-Set data structure
+//--
+// Lock-free variant of the UnionFind structure that supports concurrent
+//  Find and Union calls from many threads:
+// - the parents are stored as atomic values,
+// - Find performs path halving by compare and exchange,
+// - Union links the root with the largest index to the root with the smallest index
+//   (no rank is required and no cycle can be created).
+// Once all the unions are done, the representative of a set is its smallest node index.
+//--
+struct ConcurrentUnionFind
+{
+  // Parent 'pointer tree' where each node holds a reference to its parent node
+  std::vector<std::atomic<unsigned int>> m_cc_parent;
+
+  // Init the UF structure with num_cc nodes
+  explicit ConcurrentUnionFind
+  (
+    const unsigned int num_cc
+  ): m_cc_parent(num_cc)
+  {
+    for (unsigned int i = 0; i < num_cc; ++i)
+      m_cc_parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  // Return the number of nodes that have been initialized in the UF tree
+  unsigned int GetNumNodes() const
+  {
+    return static_cast<unsigned int>(m_cc_parent.size());
+  }
+
+  // Return the representative set id of I nth component
+  unsigned int Find
+  (
+    unsigned int i
+  )
+  {
+    while (true)
+    {
+      unsigned int parent = m_cc_parent[i].load(std::memory_order_relaxed);
+      if (parent == i)
+        return i;
+      const unsigned int grand_parent = m_cc_parent[parent].load(std::memory_order_relaxed);
+      if (parent != grand_parent)
+      {
+        // Path halving: try to link i to its grand parent
+        m_cc_parent[i].compare_exchange_weak(parent, grand_parent, std::memory_order_relaxed);
+      }
+      i = grand_parent;
+    }
+  }
+
+  // Replace sets containing I and J with their union
+  void Union
+  (
+    unsigned int i,
+    unsigned int j
+  )
+  {
+    while (true)
+    {
+      i = Find(i);
+      j = Find(j);
+      if (i == j)
+      { // Already in the same set. Nothing to do
+        return;
+      }
+      // Always attach the root with the largest index to the other one
+      if (i < j)
+        std::swap(i, j);
+      unsigned int expected = i;
+      // The link succeeds only if i is still a root, else retry from the new roots
+      if (m_cc_parent[i].compare_exchange_strong(expected, j, std::memory_order_relaxed))
+        return;
+    }
+  }
+};
+
 } // namespace openMVG
 
 #endif // OPENMVG_TRACKS_UNION_FIND_DISJOINT_SET_HPP
@@ -107,6 +107,33 @@ TEST(Tracks, four_cc) {
   EXPECT_EQ(4, parent_id.size());
 }
 
+TEST(Tracks, concurrent_union_find) {
+
+  // Create two chains of connections (even and odd nodes)
+  //  and link them concurrently in a shuffled order
+  const int node_count = 10000;
+  ConcurrentUnionFind uf_tree(node_count);
+  EXPECT_EQ(node_count, uf_tree.GetNumNodes());
+
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for (int i = 0; i < node_count - 2; ++i)
+  {
+    const int k = (i * 7919) % (node_count - 2); // visit the links in a "random" order
+    uf_tree.Union(k + 2, k);
+  }
+
+  // The representative of a set is its smallest node index
+  std::set<unsigned int> parent_id;
+  for (int i = 0; i < node_count; ++i)
+  {
+    EXPECT_EQ(i % 2, uf_tree.Find(i));
+    parent_id.insert(uf_tree.Find(i));
+  }
+  EXPECT_EQ(2, parent_id.size());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
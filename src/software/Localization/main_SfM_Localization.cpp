@@ -15,6 +15,7 @@
 #include <openMVG/image/image_io.hpp>
 #include <software/SfM/SfMPlyHelper.hpp>
 
+#include <openMVG/system/bounded_queue.hpp>
 #include <openMVG/system/timer.hpp>
 #include "openMVG/stl/stl.hpp"
 
@@ -27,7 +28,19 @@ using namespace openMVG::sfm;
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 #ifdef OPENMVG_USE_OPENMP
 #include <omp.h>
@@ -44,6 +57,279 @@ std::string FindCommonRootDir(const std::string & dir1, const std::string & dir2
   return dir1.substr(0,i);
 }
 
+// Status of a localization query
+enum class EQueryStatus
+{
+  SKIPPED,       // the query cannot be processed (no view is added)
+  NOT_LOCALIZED, // the query view is added without pose
+  LOCALIZED      // the query view is added with its pose
+};
+
+// Read a query image and compute its regions
+//  (or load them if they have already been computed)
+bool DescribeQueryImage
+(
+  const std::string & sImage_filename,
+  const std::string & sMatchesOutDir,
+  features::Image_describer & image_describer,
+  const features::Regions & regions_type,
+  std::unique_ptr<features::Regions> & query_regions,
+  Pair & image_size
+)
+{
+  // Test if the image format is supported:
+  if (openMVG::image::GetFormat(sImage_filename.c_str()) == openMVG::image::Unknown)
+  {
+    std::cerr << sImage_filename << " : unknown image file format." << std::endl;
+    return false;
+  }
+
+  query_regions.reset(regions_type.EmptyClone());
+  image::Image<unsigned char> imageGray;
+  // Try to open image
+  if (!image::ReadImage(sImage_filename.c_str(), &imageGray))
+  {
+    std::cerr << "Cannot open the input provided image : " << sImage_filename << std::endl;
+    return false;
+  }
+  image_size = {imageGray.Width(), imageGray.Height()};
+
+  const std::string
+    sFeat = stlplus::create_filespec(sMatchesOutDir, stlplus::basename_part(sImage_filename.c_str()), "feat"),
+    sDesc = stlplus::create_filespec(sMatchesOutDir, stlplus::basename_part(sImage_filename.c_str()), "desc");
+
+  // Compute features and descriptors and save them if they don't exist yet
+  if (!stlplus::file_exists(sFeat) || !stlplus::file_exists(sDesc))
+  {
+    image_describer.Describe(imageGray, query_regions);
+    image_describer.Save(query_regions.get(), sFeat, sDesc);
+    std::cout << "#regions detected in query image: " << query_regions->RegionCount() << std::endl;
+  }
+  else // load already existing regions
+  {
+    query_regions->Load(sFeat,sDesc);
+  }
+  return true;
+}
+
+// Localize a query image in the database and refine its pose
+//  (and its intrinsic if it is unknown)
+// An optional pose prior guides the 2D-3D matching.
+EQueryStatus LocalizeQueryImage
+(
+  const sfm::SfM_Localization_Single_3DTrackObservation_Database & localizer,
+  const bool bUseSingleIntrinsics,
+  const std::shared_ptr<cameras::IntrinsicBase> & single_intrinsic,
+  const cameras::EINTRINSIC user_camera_model,
+  const double dMaxResidualError,
+  const std::string & image_name,
+  const features::Regions & query_regions,
+  const Pair & image_size,
+  geometry::Pose3 & pose,
+  std::shared_ptr<cameras::IntrinsicBase> & optional_intrinsic,
+  const sfm::Localization_Prior * prior = nullptr
+)
+{
+  const unsigned int width = image_size.first, height = image_size.second;
+  optional_intrinsic.reset();
+  if (bUseSingleIntrinsics)
+  {
+    if (!single_intrinsic)
+    {
+      std::cerr << "You choose the single intrinsic mode but the sfm_data scene,"
+        <<" have too few or too much intrinsics."
+        << std::endl;
+      return EQueryStatus::SKIPPED;
+    }
+    optional_intrinsic = single_intrinsic;
+    if (width != optional_intrinsic->w() || optional_intrinsic->h() != height)
+    {
+      std::cout << "The provided image does not have the same size as the camera model you want to use." << std::endl;
+      return EQueryStatus::SKIPPED;
+    }
+  }
+  if (optional_intrinsic)
+  {
+    std::cout << "- use known intrinsics." << std::endl;
+  }
+  else
+  {
+    std::cout << "- use Unknown intrinsics for the resection. A new camera (intrinsic) will be created." << std::endl;
+
+    // Since the spherical image is only defined by its image size we can initialize its camera model.
+    // This way the resection will be performed with valid bearing vector
+    if (user_camera_model == cameras::CAMERA_SPHERICAL)
+    {
+      optional_intrinsic = std::make_shared<cameras::Intrinsic_Spherical>(width, height);
+    }
+  }
+
+  sfm::Image_Localizer_Match_Data matching_data;
+  matching_data.error_max = dMaxResidualError;
+
+  // Try to localize the image in the database thanks to its regions
+  const resection::SolverType solver_type = optional_intrinsic ?
+    resection::SolverType::P3P_NORDBERG_ECCV18 : resection::SolverType::DLT_6POINTS;
+  const bool bLocalized = prior ?
+    localizer.Localize(solver_type, {width, height}, optional_intrinsic.get(),
+      query_regions, *prior, pose, &matching_data) :
+    localizer.Localize(solver_type, {width, height}, optional_intrinsic.get(),
+      query_regions, pose, &matching_data);
+  if (!bLocalized)
+  {
+    std::cerr << "Cannot locate the image " << image_name << std::endl;
+    return EQueryStatus::NOT_LOCALIZED;
+  }
+
+  const bool b_new_intrinsic = (optional_intrinsic == nullptr);
+  // A valid pose has been found (try to refine it):
+  // If not intrinsic as input:
+  // init a new one from the projection matrix decomposition
+  // Else use the existing one and consider as static.
+  if (b_new_intrinsic)
+  {
+    // setup a default camera model from the found projection matrix
+    Mat3 K, R;
+    Vec3 t;
+    KRt_From_P(matching_data.projection_matrix, &K, &R, &t);
+
+    const double focal = (K(0,0) + K(1,1))/2.0;
+    const Vec2 principal_point(K(0,2), K(1,2));
+
+    switch (user_camera_model)
+    {
+      case cameras::PINHOLE_CAMERA:
+        optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic>(width, height,focal, principal_point(0), principal_point(1));
+      break;
+      case cameras::PINHOLE_CAMERA_RADIAL1:
+        optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Radial_K1>(width, height,focal, principal_point(0), principal_point(1));
+      break;
+      case cameras::PINHOLE_CAMERA_RADIAL3:
+        optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Radial_K3>(width, height,focal, principal_point(0), principal_point(1));
+      break;
+      case cameras::PINHOLE_CAMERA_BROWN:
+        optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Brown_T2>(width, height,focal, principal_point(0), principal_point(1));
+      break;
+      case cameras::PINHOLE_CAMERA_FISHEYE:
+        optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Fisheye>(width, height,focal, principal_point(0), principal_point(1));
+      break;
+      case cameras::CAMERA_SPHERICAL:
+        std::cerr << "The spherical camera cannot be created there. Resection of a spherical camera must be done with an existing camera model." << std::endl;
+      break;
+      default:
+        std::cerr << "Error: unknown camera model: " << static_cast<int>(user_camera_model) << std::endl;
+    }
+  }
+  if (optional_intrinsic && sfm::SfM_Localizer::RefinePose(
+    optional_intrinsic.get(),
+    pose, matching_data,
+    true, b_new_intrinsic))
+  {
+    return EQueryStatus::LOCALIZED;
+  }
+  std::cerr << "Refining pose for the image " << image_name << " failed." << std::endl;
+  return EQueryStatus::NOT_LOCALIZED;
+}
+
+// Add a processed query image to the scene (not thread safe)
+void AddQueryView
+(
+  SfM_Data & sfm_data,
+  const std::string & image_name,
+  const Pair & image_size,
+  const EQueryStatus status,
+  const geometry::Pose3 & pose,
+  const std::shared_ptr<cameras::IntrinsicBase> & intrinsic,
+  const bool bUseSingleIntrinsics,
+  std::vector<Vec3> & vec_found_poses
+)
+{
+  Views & views = sfm_data.views;
+  View v(image_name, views.size(), views.size(), views.size(), image_size.first, image_size.second);
+  if (status == EQueryStatus::LOCALIZED)
+  {
+    vec_found_poses.push_back(pose.center());
+
+    // Add the computed intrinsic to the sfm_container
+    if (!bUseSingleIntrinsics)
+      sfm_data.intrinsics[v.id_intrinsic] = intrinsic;
+    else // Make the view using the existing intrinsic id
+      v.id_intrinsic = sfm_data.GetViews().begin()->second->id_intrinsic;
+    // Add the computed pose to the sfm_container
+    sfm_data.poses[v.id_pose] = pose;
+  }
+  else
+  {
+    v.id_intrinsic = UndefinedIndexT;
+    v.id_pose = UndefinedIndexT;
+  }
+  // Add the view to the sfm_container
+  views[v.id_view] = std::make_shared<View>(v);
+}
+
+// Return the p-th percentile (p in [0,1]) of some values
+double Percentile(std::vector<double> values, const double p)
+{
+  if (values.empty())
+    return 0.0;
+  // nearest rank method
+  const size_t rank = (p <= 0.0) ? 0 :
+    std::min(values.size(), static_cast<size_t>(std::ceil(p * values.size()))) - 1;
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+// Display the latency percentiles and the sustained throughput of the service
+void ReportServiceStatistics
+(
+  const std::vector<double> & latencies_ms,
+  const size_t localized_count,
+  const double elapsed_s
+)
+{
+  std::cout << "\n-- Localization service statistics --\n"
+    << " #queries: " << latencies_ms.size() << " (localized: " << localized_count << ")\n"
+    << " latency (ms): p50 " << Percentile(latencies_ms, 0.5)
+    << ", p90 " << Percentile(latencies_ms, 0.9)
+    << ", p99 " << Percentile(latencies_ms, 0.99)
+    << ", max " << Percentile(latencies_ms, 1.0) << "\n"
+    << " sustained throughput: "
+    << (elapsed_s > 0.0 ? latencies_ms.size() / elapsed_s : 0.0) << " queries/s"
+    << std::endl;
+}
+
+// Compare the localization with a pruned database to the one with the full database
+void ReportPruningEvaluation
+(
+  const std::vector<double> & pruned_latencies_ms,
+  const std::vector<double> & full_latencies_ms,
+  const size_t pruned_localized_count,
+  const size_t full_localized_count,
+  const size_t both_localized_count,
+  const size_t pruned_descriptor_count,
+  const size_t full_descriptor_count
+)
+{
+  std::cout << "\n-- Localization database pruning evaluation --\n"
+    << " #queries: " << pruned_latencies_ms.size() << "\n"
+    << " #descriptors: pruned " << pruned_descriptor_count
+    << ", full " << full_descriptor_count
+    << " (size reduced by a factor "
+    << (pruned_descriptor_count > 0 ? double(full_descriptor_count) / pruned_descriptor_count : 0.0)
+    << ")\n"
+    << " #localized: pruned " << pruned_localized_count
+    << ", full " << full_localized_count << "\n"
+    << " recall (relative to the full database): "
+    << (full_localized_count > 0 ? double(both_localized_count) / full_localized_count : 0.0) << "\n"
+    << " pruned latency (ms): p50 " << Percentile(pruned_latencies_ms, 0.5)
+    << ", p90 " << Percentile(pruned_latencies_ms, 0.9)
+    << ", max " << Percentile(pruned_latencies_ms, 1.0) << "\n"
+    << " full latency (ms): p50 " << Percentile(full_latencies_ms, 0.5)
+    << ", p90 " << Percentile(full_latencies_ms, 0.9)
+    << ", max " << Percentile(full_latencies_ms, 1.0)
+    << std::endl;
+}
+
 // ----------------------------------------------------
 // Multiple Images localization from an existing reconstruction
 // ----------------------------------------------------
@@ -67,6 +353,16 @@ int main(int argc, char **argv)
   int i_User_camera_model = cameras::PINHOLE_CAMERA_RADIAL3;
   bool bUseSingleIntrinsics = false;
   bool bExportStructure = false;
+  std::string sLocalizationDatabase;
+  std::string sDatabaseMatcher = "ANNL2";
+  std::string sServiceMode;
+  unsigned int ui_service_threads = std::max(2u, std::thread::hardware_concurrency());
+  double dWatchTimeout = 10.0;
+  sfm::Landmark_Pruning_Options pruning_options;
+  bool bEvaluatePruning = false;
+  bool bPriorGuided = false;
+  double dPriorSearchRadius = 40.0;
+  uint32_t ui_prior_neighbor_views = 10;
 
 #ifdef OPENMVG_USE_OPENMP
   int iNumThreads = 0;
@@ -81,6 +377,17 @@ int main(int argc, char **argv)
   cmd.add( make_option('c', i_User_camera_model, "camera_model") );
   cmd.add( make_switch('s', "single_intrinsics"));
   cmd.add( make_switch('e', "export_structure"));
+  cmd.add( make_option('l', sLocalizationDatabase, "localization_database"));
+  cmd.add( make_option('M', sDatabaseMatcher, "database_matcher"));
+  cmd.add( make_option('S', sServiceMode, "service_mode"));
+  cmd.add( make_option('t', ui_service_threads, "service_threads"));
+  cmd.add( make_option('w', dWatchTimeout, "watch_timeout"));
+  cmd.add( make_option('k', pruning_options.max_descriptors_per_landmark, "landmark_descriptors"));
+  cmd.add( make_option('v', pruning_options.min_landmarks_per_view, "view_coverage"));
+  cmd.add( make_switch('E', "evaluate_pruning"));
+  cmd.add( make_switch('P', "prior_guided"));
+  cmd.add( make_option('R', dPriorSearchRadius, "prior_search_radius"));
+  cmd.add( make_option('N', ui_prior_neighbor_views, "prior_neighbor_views"));
 
 #ifdef OPENMVG_USE_OPENMP
   cmd.add( make_option('n', iNumThreads, "numThreads") );
@@ -115,6 +422,35 @@ int main(int argc, char **argv)
       << "\t 4: Pinhole radial 3 + tangential 2\n"
       << "\t 5: Pinhole fisheye\n"
       << "\t 7: Spherical camera\n"
+    << "[-l|--localization_database] path to a localization database file:\n"
+    << "  if the file exists the database is loaded (no rebuild),\n"
+    << "  else (or if it was built from another scene, matcher or pruning options)\n"
+    << "  the database is built and saved to this file.\n"
+    << "[-M|--database_matcher] matcher used by the database:\n"
+    << "\t ANNL2: L2 Approximate Nearest Neighbor matching (default)\n"
+    << "\t HNSWL2: L2 Approximate Matching with Hierarchical Navigable Small World graphs\n"
+    << "[-S|--service_mode] localize a stream of query images with a concurrent\n"
+    << "  pipeline (image description, database matching and resection):\n"
+    << "\t stdin: read the query image names (relative to query_image_dir) from stdin,\n"
+    << "\t watch: localize the images added to the query_image_dir directory.\n"
+    << "  The latency percentiles and the sustained queries/s are reported.\n"
+    << "[-t|--service_threads] number of pipeline threads of the service mode\n"
+    << "  (default: the number of hardware threads)\n"
+    << "[-w|--watch_timeout] watch mode: stop after X seconds without new image\n"
+    << "  (default 10, 0 to never stop)\n"
+    << "[-k|--landmark_descriptors] database pruning: keep at most K representative\n"
+    << "  descriptors per landmark (medoid + k-centers) (default 0: keep them all)\n"
+    << "[-v|--view_coverage] database pruning: keep only a subset of landmarks\n"
+    << "  that sees every view at least V times (default 0: keep them all)\n"
+    << "[-E|--evaluate_pruning] (switch) also localize the query images with the full\n"
+    << "  database and report the recall and latency of the pruned database\n"
+    << "[-P|--prior_guided] (switch) the query images are an image sequence: they are\n"
+    << "  localized in order and the previous pose guides the 2D-3D matching\n"
+    << "  (fall back to the global matching on failure)\n"
+    << "[-R|--prior_search_radius] prior guided mode: radius (pixels) of the window\n"
+    << "  searched around each projected landmark (default 40)\n"
+    << "[-N|--prior_neighbor_views] prior guided mode: only the landmarks of the N\n"
+    << "  scene views closest to the prior pose are matched (default 10, 0: all)\n"
 #ifdef OPENMVG_USE_OPENMP
     << "[-n|--numThreads] number of thread(s)\n"
 #endif
@@ -151,6 +487,8 @@ int main(int argc, char **argv)
 
   bUseSingleIntrinsics = cmd.used('s');
   bExportStructure = cmd.used('e');
+  bEvaluatePruning = cmd.used('E');
+  bPriorGuided = cmd.used('P');
   // ---------------
   // Initialization
   // ---------------
@@ -193,13 +531,30 @@ int main(int argc, char **argv)
     return EXIT_FAILURE;
   }
 
-  // Show the progress on the command line:
-  C_Progress_display progress;
+  if (!sServiceMode.empty() && sServiceMode != "stdin" && sServiceMode != "watch")
+  {
+    std::cerr << "Invalid service mode: " << sServiceMode << std::endl;
+    return EXIT_FAILURE;
+  }
+  if ((bEvaluatePruning || bPriorGuided) && !sServiceMode.empty())
+  {
+    std::cerr << "The pruning evaluation and the prior guided mode are not available in service mode." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!sServiceMode.empty() && !stlplus::folder_exists(sQueryDir))
+  {
+    std::cerr << "The service mode requires a query image directory." << std::endl;
+    return EXIT_FAILURE;
+  }
 
-  // Load the SfM_Data region's views
-  std::shared_ptr<Regions_Provider> regions_provider = std::make_shared<Regions_Provider>();
-  if (!regions_provider->load(sfm_data, sMatchesDir, regions_type, &progress)) {
-    std::cerr << std::endl << "Invalid regions." << std::endl;
+  matching::EMatcherType database_matcher_type = matching::ANN_L2;
+  if (sDatabaseMatcher == "HNSWL2")
+  {
+    database_matcher_type = matching::HNSW_L2;
+  }
+  else if (sDatabaseMatcher != "ANNL2")
+  {
+    std::cerr << "Invalid database matcher: " << sDatabaseMatcher << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -233,13 +588,51 @@ int main(int argc, char **argv)
 
   std::vector<Vec3> vec_found_poses;
 
-  sfm::SfM_Localization_Single_3DTrackObservation_Database localizer;
-  if (!localizer.Init(sfm_data, *regions_provider.get()))
+  sfm::SfM_Localization_Single_3DTrackObservation_Database localizer(database_matcher_type, pruning_options);
+  // Unpruned database used as reference by the pruning evaluation
+  sfm::SfM_Localization_Single_3DTrackObservation_Database full_localizer(database_matcher_type);
+  bool bLoadDatabase = !sLocalizationDatabase.empty() && stlplus::is_file(sLocalizationDatabase);
+  if (bLoadDatabase)
+  {
+    // Reload a prebuilt database (rebuilt if it does not match the scene or the options)
+    bLoadDatabase = localizer.Load(sfm_data, *regions_type, sLocalizationDatabase);
+    if (!bLoadDatabase)
+    {
+      std::cerr << "Cannot load the localization database: " << sLocalizationDatabase
+        << ", it is rebuilt." << std::endl;
+    }
+  }
+  if (!bLoadDatabase || bEvaluatePruning)
   {
-    std::cerr << "Cannot initialize the SfM localizer" << std::endl;
+    // Show the progress on the command line:
+    C_Progress_display progress;
+
+    // Load the SfM_Data region's views
+    std::shared_ptr<Regions_Provider> regions_provider = std::make_shared<Regions_Provider>();
+    if (!regions_provider->load(sfm_data, sMatchesDir, regions_type, &progress)) {
+      std::cerr << std::endl << "Invalid regions." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!bLoadDatabase)
+    {
+      if (!localizer.Init(sfm_data, *regions_provider.get()))
+      {
+        std::cerr << "Cannot initialize the SfM localizer" << std::endl;
+      }
+      if (!sLocalizationDatabase.empty() && !localizer.Save(sLocalizationDatabase))
+      {
+        std::cerr << "Cannot save the localization database: " << sLocalizationDatabase << std::endl;
+      }
+    }
+    if (bEvaluatePruning && !full_localizer.Init(sfm_data, *regions_provider.get()))
+    {
+      std::cerr << "Cannot initialize the reference SfM localizer" << std::endl;
+      return EXIT_FAILURE;
+    }
+    // Since we have copied interesting data, release some memory
+    regions_provider.reset();
   }
-  // Since we have copied interesting data, release some memory
-  regions_provider.reset();
 
   // list images from sfm_data in a vector
   std::vector<std::string> vec_image_original (sfm_data.GetViews().size());
@@ -287,193 +680,290 @@ int main(int argc, char **argv)
     sfm_data.s_root_path = common_root_dir;
   }
 
-  // references
-  Views & views = sfm_data.views;
-  Poses & poses = sfm_data.poses;
-  Intrinsics & intrinsics = sfm_data.intrinsics;
-
   int total_num_images = 0;
 
-#ifdef OPENMVG_USE_OPENMP
-  const unsigned int nb_max_thread = (iNumThreads == 0) ? 0 : omp_get_max_threads();
-    omp_set_num_threads(nb_max_thread);
-    #pragma omp parallel for schedule(dynamic)
-#endif
-  for (int i = 0; i < static_cast<int>(vec_image_new.size()); ++i)
+  // The intrinsic shared by the query images (single intrinsic mode)
+  std::shared_ptr<cameras::IntrinsicBase> single_intrinsic;
+  if (bUseSingleIntrinsics && sfm_data.GetIntrinsics().size() == 1)
   {
-    std::vector<std::string>::const_iterator iter_image = vec_image_new.begin();
-    std::advance(iter_image, i);
+    single_intrinsic = sfm_data.GetIntrinsics().begin()->second;
+  }
+  const cameras::EINTRINSIC user_camera_model = cameras::EINTRINSIC(i_User_camera_model);
 
+  // Pruning evaluation
+  std::vector<double> pruned_latencies_ms, full_latencies_ms;
+  size_t pruned_localized_count = 0, full_localized_count = 0, both_localized_count = 0;
 
-    // Test if the image format is supported:
-    if (openMVG::image::GetFormat((*iter_image).c_str()) == openMVG::image::Unknown)
-    {
-      std::cerr << *iter_image << " : unknown image file format." << std::endl;
-      continue;
-    }
+  // Prior guided mode: the last found pose and camera
+  std::unique_ptr<sfm::Localization_Prior> prior;
+  std::shared_ptr<cameras::IntrinsicBase> prior_intrinsic;
+  std::vector<double> prior_latencies_ms;
 
-    std::cout << "SfM::localization => try with image: " << *iter_image << std::endl;
-    std::unique_ptr<Regions> query_regions(regions_type->EmptyClone());
-    image::Image<unsigned char> imageGray;
+  if (sServiceMode.empty())
+  {
+#ifdef OPENMVG_USE_OPENMP
+    const unsigned int nb_max_thread = (iNumThreads == 0) ? 0 : omp_get_max_threads();
+    omp_set_num_threads(nb_max_thread);
+    // The prior guided mode localizes the image sequence in order
+    #pragma omp parallel for schedule(dynamic) if(!bPriorGuided)
+#endif
+    for (int i = 0; i < static_cast<int>(vec_image_new.size()); ++i)
     {
-      const std::string sView_filename = stlplus::create_filespec(sQueryDir, *iter_image);
-      // Try to open image
-      if (!image::ReadImage(sView_filename.c_str(), &imageGray))
+      const std::string & image_name = vec_image_new[i];
+
+      std::cout << "SfM::localization => try with image: " << image_name << std::endl;
+      std::unique_ptr<Regions> query_regions;
+      Pair image_size;
+      if (!DescribeQueryImage(stlplus::create_filespec(sQueryDir, image_name), sMatchesOutDir,
+            *image_describer, *regions_type, query_regions, image_size))
       {
-        std::cerr << "Cannot open the input provided image : " << *iter_image << std::endl;
         continue;
       }
 
-      const std::string
-        sFeat = stlplus::create_filespec(sMatchesOutDir, stlplus::basename_part(sView_filename.c_str()), "feat"),
-        sDesc = stlplus::create_filespec(sMatchesOutDir, stlplus::basename_part(sView_filename.c_str()), "desc");
-
-      // Compute features and descriptors and save them if they don't exist yet
-      if (!stlplus::file_exists(sFeat) || !stlplus::file_exists(sDesc))
+      geometry::Pose3 pose;
+      std::shared_ptr<cameras::IntrinsicBase> optional_intrinsic;
+      system::Timer timer;
+      const EQueryStatus status = LocalizeQueryImage(
+        localizer, bUseSingleIntrinsics, single_intrinsic, user_camera_model, dMaxResidualError,
+        image_name, *query_regions, image_size, pose, optional_intrinsic, prior.get());
+      const double pruned_latency_ms = timer.elapsedMs();
+      if (status == EQueryStatus::SKIPPED)
       {
-        image_describer->Describe(imageGray, query_regions);
-        image_describer->Save(query_regions.get(), sFeat, sDesc);
-        std::cout << "#regions detected in query image: " << query_regions->RegionCount() << std::endl;
+        continue;
       }
-      else // load already existing regions
+      EQueryStatus full_status = EQueryStatus::SKIPPED;
+      double full_latency_ms = 0.0;
+      if (bEvaluatePruning)
       {
-        query_regions->Load(sFeat,sDesc);
+        geometry::Pose3 full_pose;
+        std::shared_ptr<cameras::IntrinsicBase> full_intrinsic;
+        timer.reset();
+        full_status = LocalizeQueryImage(
+          full_localizer, bUseSingleIntrinsics, single_intrinsic, user_camera_model, dMaxResidualError,
+          image_name, *query_regions, image_size, full_pose, full_intrinsic, prior.get());
+        full_latency_ms = timer.elapsedMs();
       }
-    }
-
-    std::shared_ptr<cameras::IntrinsicBase> optional_intrinsic;
-    if (bUseSingleIntrinsics)
-    {
-      if (sfm_data.GetIntrinsics().size() != 1)
+      if (bPriorGuided)
       {
-        std::cerr << "You choose the single intrinsic mode but the sfm_data scene,"
-          <<" have too few or too much intrinsics."
-          << std::endl;
-        continue;
+        prior_latencies_ms.push_back(pruned_latency_ms);
+        std::cout << "Localization time: " << pruned_latency_ms << " ms" << std::endl;
+        if (status == EQueryStatus::LOCALIZED)
+        {
+          // The found pose is the prior of the next image
+          prior_intrinsic = optional_intrinsic;
+          prior.reset(new sfm::Localization_Prior);
+          prior->pose = pose;
+          prior->intrinsics = prior_intrinsic.get();
+          prior->search_radius = dPriorSearchRadius;
+          prior->neighbor_view_count = ui_prior_neighbor_views;
+        }
       }
-      optional_intrinsic = sfm_data.GetIntrinsics().at(0);
-      if (imageGray.Width() != optional_intrinsic->w() || optional_intrinsic->h() != imageGray.Height())
+#ifdef OPENMVG_USE_OPENMP
+      #pragma omp critical
+#endif
       {
-        std::cout << "The provided image does not have the same size as the camera model you want to use." << std::endl;
-        continue;
+        if (bEvaluatePruning)
+        {
+          pruned_latencies_ms.push_back(pruned_latency_ms);
+          full_latencies_ms.push_back(full_latency_ms);
+          const bool pruned_localized = (status == EQueryStatus::LOCALIZED);
+          const bool full_localized = (full_status == EQueryStatus::LOCALIZED);
+          pruned_localized_count += pruned_localized ? 1 : 0;
+          full_localized_count += full_localized ? 1 : 0;
+          both_localized_count += (pruned_localized && full_localized) ? 1 : 0;
+        }
+        total_num_images++;
+        AddQueryView(sfm_data, image_name, image_size, status, pose, optional_intrinsic,
+          bUseSingleIntrinsics, vec_found_poses);
       }
     }
-    if (optional_intrinsic)
-    {
-      std::cout << "- use known intrinsics." << std::endl;
-    }
-    else
+  }
+  else
+  {
+    //-- Service mode: a concurrent pipeline over the shared read-only database
+    // - a source thread submits the query images (stdin or directory watch),
+    // - description threads compute the query regions,
+    // - localization threads match the regions to the database and resect the pose.
+    using Clock = std::chrono::steady_clock;
+    struct Localization_Query
     {
-      std::cout << "- use Unknown intrinsics for the resection. A new camera (intrinsic) will be created." << std::endl;
+      std::string image_name;
+      Clock::time_point submit_time;
+      std::unique_ptr<Regions> regions;
+      Pair image_size;
+    };
 
-      // Since the spherical image is only defined by its image size we can initialize its camera model.
-      // This way the resection will be performed with valid bearing vector
-      if (openMVG::cameras::EINTRINSIC(i_User_camera_model) == cameras::CAMERA_SPHERICAL)
+#ifdef OPENMVG_USE_OPENMP
+    // The concurrency comes from the pipeline stages
+    omp_set_num_threads(1);
+#endif
+    const unsigned int nb_describer = std::max(1u, ui_service_threads / 2);
+    const unsigned int nb_localizer = std::max(1u, ui_service_threads - nb_describer);
+    system::Bounded_Queue<Localization_Query> submitted_queries(2 * nb_describer);
+    system::Bounded_Queue<Localization_Query> described_queries(2 * nb_localizer);
+
+    std::mutex result_mutex;
+    std::vector<double> latencies_ms;
+    size_t localized_count = 0;
+    bool bStarted = false;
+    Clock::time_point first_submit_time, last_result_time;
+
+    // Record a processed query (result_mutex must be locked)
+    const auto record_query = [&](const Localization_Query & query, const char * result)
+    {
+      last_result_time = Clock::now();
+      const double latency_ms =
+        std::chrono::duration<double, std::milli>(last_result_time - query.submit_time).count();
+      latencies_ms.push_back(latency_ms);
+      std::cout << "SfM::localization => " << query.image_name << ": " << result
+        << " (" << latency_ms << " ms)" << std::endl;
+      if (latencies_ms.size() % 100 == 0)
       {
-        optional_intrinsic = std::make_shared<cameras::Intrinsic_Spherical>(imageGray.Width(), imageGray.Height());
+        ReportServiceStatistics(latencies_ms, localized_count,
+          std::chrono::duration<double>(last_result_time - first_submit_time).count());
       }
-    }
-
-    geometry::Pose3 pose;
-    sfm::Image_Localizer_Match_Data matching_data;
-    matching_data.error_max = dMaxResidualError;
-
-    bool bSuccessfulLocalization = false;
+    };
 
-    // Try to localize the image in the database thanks to its regions
-    if (!localizer.Localize(
-      optional_intrinsic ? resection::SolverType::P3P_NORDBERG_ECCV18 : resection::SolverType::DLT_6POINTS,
-      {imageGray.Width(), imageGray.Height()},
-      optional_intrinsic.get(),
-      *(query_regions.get()),
-      pose,
-      &matching_data))
+    std::vector<std::thread> describers;
+    for (unsigned int i = 0; i < nb_describer; ++i)
     {
-      std::cerr << "Cannot locate the image " << *iter_image << std::endl;
-      bSuccessfulLocalization = false;
+      describers.emplace_back([&]
+      {
+        Localization_Query query;
+        while (submitted_queries.pop(query))
+        {
+          if (!DescribeQueryImage(stlplus::create_filespec(sQueryDir, query.image_name), sMatchesOutDir,
+                *image_describer, *regions_type, query.regions, query.image_size))
+          {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            record_query(query, "cannot be described");
+            continue;
+          }
+          described_queries.push(std::move(query));
+        }
+      });
     }
-    else
+
+    std::vector<std::thread> localizers;
+    for (unsigned int i = 0; i < nb_localizer; ++i)
     {
-      const bool b_new_intrinsic = (optional_intrinsic == nullptr);
-      // A valid pose has been found (try to refine it):
-      // If not intrinsic as input:
-      // init a new one from the projection matrix decomposition
-      // Else use the existing one and consider as static.
-      if (b_new_intrinsic)
+      localizers.emplace_back([&]
       {
-        // setup a default camera model from the found projection matrix
-        Mat3 K, R;
-        Vec3 t;
-        KRt_From_P(matching_data.projection_matrix, &K, &R, &t);
-
-        const double focal = (K(0,0) + K(1,1))/2.0;
-        const Vec2 principal_point(K(0,2), K(1,2));
+        Localization_Query query;
+        while (described_queries.pop(query))
+        {
+          geometry::Pose3 pose;
+          std::shared_ptr<cameras::IntrinsicBase> optional_intrinsic;
+          const EQueryStatus status = LocalizeQueryImage(
+            localizer, bUseSingleIntrinsics, single_intrinsic, user_camera_model, dMaxResidualError,
+            query.image_name, *query.regions, query.image_size, pose, optional_intrinsic);
+
+          std::lock_guard<std::mutex> lock(result_mutex);
+          if (status != EQueryStatus::SKIPPED)
+          {
+            total_num_images++;
+            AddQueryView(sfm_data, query.image_name, query.image_size, status, pose, optional_intrinsic,
+              bUseSingleIntrinsics, vec_found_poses);
+          }
+          if (status == EQueryStatus::LOCALIZED)
+            ++localized_count;
+          record_query(query,
+            status == EQueryStatus::LOCALIZED ? "localized" :
+            (status == EQueryStatus::NOT_LOCALIZED ? "not localized" : "skipped"));
+        }
+      });
+    }
 
-        switch (openMVG::cameras::EINTRINSIC(i_User_camera_model))
+    // Submit a query image to the pipeline
+    const auto submit = [&](const std::string & image_name)
+    {
+      Localization_Query query;
+      query.image_name = image_name;
+      query.submit_time = Clock::now();
+      {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        if (!bStarted)
         {
-          case cameras::PINHOLE_CAMERA:
-            optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic>(imageGray.Width(), imageGray.Height(),focal, principal_point(0), principal_point(1));
-          break;
-          case cameras::PINHOLE_CAMERA_RADIAL1:
-            optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Radial_K1>(imageGray.Width(), imageGray.Height(),focal, principal_point(0), principal_point(1));
-          break;
-          case cameras::PINHOLE_CAMERA_RADIAL3:
-            optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Radial_K3>(imageGray.Width(), imageGray.Height(),focal, principal_point(0), principal_point(1));
-          break;
-          case cameras::PINHOLE_CAMERA_BROWN:
-            optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Brown_T2>(imageGray.Width(), imageGray.Height(),focal, principal_point(0), principal_point(1));
-          break;
-          case cameras::PINHOLE_CAMERA_FISHEYE:
-            optional_intrinsic = std::make_shared<cameras::Pinhole_Intrinsic_Fisheye>(imageGray.Width(), imageGray.Height(),focal, principal_point(0), principal_point(1));
-          break;
-          case cameras::CAMERA_SPHERICAL:
-            std::cerr << "The spherical camera cannot be created there. Resection of a spherical camera must be done with an existing camera model." << std::endl;
-          break;
-          default:
-            std::cerr << "Error: unknown camera model: " << static_cast<int>(i_User_camera_model) << std::endl;
+          bStarted = true;
+          first_submit_time = query.submit_time;
         }
       }
-      if (optional_intrinsic && sfm::SfM_Localizer::RefinePose(
-        optional_intrinsic.get(),
-        pose, matching_data,
-        true, b_new_intrinsic))
+      submitted_queries.push(std::move(query));
+    };
+
+    std::cout << "Localization service started (" << nb_describer << " description thread(s), "
+      << nb_localizer << " localization thread(s))" << std::endl;
+    if (sServiceMode == "stdin")
+    {
+      std::string image_name;
+      while (std::getline(std::cin, image_name))
       {
-        bSuccessfulLocalization = true;
+        if (!image_name.empty())
+          submit(image_name);
       }
-      else
+    }
+    else // watch
+    {
+      // The images of the reconstruction and the already submitted ones are ignored.
+      // A new file is submitted once its size is stable between two polls.
+      // The timeout counts from the last submitted image (a pending file that
+      //  stays empty or keeps changing does not keep the service alive).
+      std::set<std::string> known_images(vec_image_original.cbegin(), vec_image_original.cend());
+      std::map<std::string, size_t> pending_images;
+      Clock::time_point last_activity = Clock::now();
+      while (dWatchTimeout <= 0.0 ||
+             std::chrono::duration<double>(Clock::now() - last_activity).count() < dWatchTimeout)
       {
-        std::cerr << "Refining pose for the image " << *iter_image << " failed." << std::endl;
+        for (const std::string & image_name : stlplus::folder_files(sQueryDir))
+        {
+          if (known_images.count(image_name) ||
+              openMVG::image::GetFormat(image_name.c_str()) == openMVG::image::Unknown)
+            continue;
+          const size_t file_size =
+            stlplus::file_size(stlplus::create_filespec(sQueryDir, image_name));
+          const auto pending_it = pending_images.find(image_name);
+          if (pending_it != pending_images.end() && pending_it->second == file_size && file_size > 0)
+          {
+            pending_images.erase(pending_it);
+            known_images.insert(image_name);
+            submit(image_name);
+            last_activity = Clock::now();
+          }
+          else
+          {
+            pending_images[image_name] = file_size;
+          }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
       }
-
     }
-#ifdef OPENMVG_USE_OPENMP
-    #pragma omp critical
-#endif
-    {
-      total_num_images++;
 
-      View v(*iter_image, views.size(), views.size(), views.size(), imageGray.Width(), imageGray.Height());
-      if (bSuccessfulLocalization)
-      {
-        vec_found_poses.push_back(pose.center());
+    // Drain the pipeline
+    submitted_queries.close();
+    for (std::thread & describer : describers)
+      describer.join();
+    described_queries.close();
+    for (std::thread & localizer_thread : localizers)
+      localizer_thread.join();
 
-        // Add the computed intrinsic to the sfm_container
-        if (!bUseSingleIntrinsics)
-          intrinsics[v.id_intrinsic] = optional_intrinsic;
-        else // Make the view using the existing intrinsic id
-          v.id_intrinsic = sfm_data.GetViews().begin()->second->id_intrinsic;
-        // Add the computed pose to the sfm_container
-        poses[v.id_pose] = pose;
+    ReportServiceStatistics(latencies_ms, localized_count,
+      bStarted ? std::chrono::duration<double>(last_result_time - first_submit_time).count() : 0.0);
+  }
 
-      }
-      else
-      {
-        v.id_intrinsic = UndefinedIndexT;
-        v.id_pose = UndefinedIndexT;
-      }
-      // Add the view to the sfm_container
-      views[v.id_view] = std::make_shared<View>(v);
-    }
+  if (bPriorGuided)
+  {
+    std::cout << "\n-- Prior guided localization --\n"
+      << " #images: " << prior_latencies_ms.size() << "\n"
+      << " latency (ms): p50 " << Percentile(prior_latencies_ms, 0.5)
+      << ", p90 " << Percentile(prior_latencies_ms, 0.9)
+      << ", max " << Percentile(prior_latencies_ms, 1.0) << std::endl;
+  }
+
+  if (bEvaluatePruning)
+  {
+    ReportPruningEvaluation(pruned_latencies_ms, full_latencies_ms,
+      pruned_localized_count, full_localized_count, both_localized_count,
+      localizer.DescriptorCount(), full_localizer.DescriptorCount());
   }
 
   GroupSharedIntrinsics(sfm_data);
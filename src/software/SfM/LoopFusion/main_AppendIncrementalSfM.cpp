@@ -64,19 +64,14 @@ public:
         structure.clear();
 
         // Fill sfm_data with the computed tracks (no 3D yet)
-        STLMAPTracks & map_selectedTracks = map_tracks_;
-        IndexT idx(0);
-        for (STLMAPTracks::const_iterator itTracks = map_selectedTracks.begin();
-             itTracks != map_selectedTracks.end();
-             ++itTracks, ++idx)
+        for (IndexT idx = 0; idx < map_tracks_.NbTracks(); ++idx)
         {
-            const submapTrack & track = itTracks->second;
             structure[idx] = Landmark();
             Observations & obs = structure.at(idx).obs;
-            for (submapTrack::const_iterator it = track.begin(); it != track.end(); ++it)
+            for (const auto & it : map_tracks_.Track(idx))
             {
-                const size_t imaIndex = it->first;
-                const size_t featIndex = it->second;
+                const size_t imaIndex = it.first;
+                const size_t featIndex = it.second;
                 const PointFeature & pt = features_provider_->feats_per_view.at(imaIndex)[featIndex];
                 obs[imaIndex] = Observation(pt.coords().cast<double>(), featIndex);
             }
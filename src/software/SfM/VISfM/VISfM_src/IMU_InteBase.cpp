@@ -4,4 +4,74 @@
 
 #include "IMU_InteBase.hpp"
 
-double openMVG::sfm::IMU_Dataset::sum_st_ = 0.;
\ No newline at end of file
+#include "openMVG/system/mapped_file.hpp"
+
+#include <cstring>
+
+double openMVG::sfm::IMU_Dataset::sum_st_ = 0.;
+
+namespace openMVG
+{
+    namespace sfm
+    {
+        static_assert( sizeof(Vec3) == 3 * sizeof(double), "Vec3 must be tightly packed to be streamed" );
+
+        bool IsIMUDatasetBinaryFile( const std::string& filename )
+        {
+            std::ifstream stream( filename.c_str(), std::ios::in | std::ios::binary );
+            if( !stream.is_open() )
+                return false;
+            char magic[sizeof(IMU_DATASET_BINARY_MAGIC)];
+            stream.read( magic, sizeof(magic) );
+            return stream.good()
+                && std::memcmp( magic, IMU_DATASET_BINARY_MAGIC, sizeof(magic) ) == 0;
+        }
+
+        bool IMU_Dataset::LoadBinary( const std::string& filename )
+        {
+            system::Mapped_File mapped_file;
+            if( !mapped_file.open( filename ) || mapped_file.size() < sizeof(IMU_Dataset_Binary_Header) )
+                return false;
+
+            IMU_Dataset_Binary_Header header;
+            std::memcpy( &header, mapped_file.data(), sizeof(header) );
+            if( std::memcmp( header.magic, IMU_DATASET_BINARY_MAGIC, sizeof(header.magic) ) != 0
+                || header.version != IMU_DATASET_BINARY_VERSION
+                || mapped_file.size() != sizeof(header) + header.sample_count * 7 * sizeof(double) )
+            {
+                std::cerr << "Invalid imu binary file: " << filename << std::endl;
+                return false;
+            }
+
+            const size_t count = header.sample_count;
+            const char* data = mapped_file.data() + sizeof(header);
+            vec_times.resize( count );
+            vec_acc.resize( count );
+            vec_gyr.resize( count );
+            std::memcpy( vec_times.data(), data, count * sizeof(double) );
+            data += count * sizeof(double);
+            std::memcpy( vec_acc.data(), data, count * sizeof(Vec3) );
+            data += count * sizeof(Vec3);
+            std::memcpy( vec_gyr.data(), data, count * sizeof(Vec3) );
+            return true;
+        }
+
+        bool IMU_Dataset::SaveBinary( const std::string& filename ) const
+        {
+            std::ofstream stream( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+            if( !stream.is_open() )
+                return false;
+
+            IMU_Dataset_Binary_Header header;
+            std::memset( &header, 0, sizeof(header) );
+            std::memcpy( header.magic, IMU_DATASET_BINARY_MAGIC, sizeof(header.magic) );
+            header.version = IMU_DATASET_BINARY_VERSION;
+            header.sample_count = vec_times.size();
+            stream.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+            stream.write( reinterpret_cast<const char*>(vec_times.data()), vec_times.size() * sizeof(double) );
+            stream.write( reinterpret_cast<const char*>(vec_acc.data()), vec_acc.size() * sizeof(Vec3) );
+            stream.write( reinterpret_cast<const char*>(vec_gyr.data()), vec_gyr.size() * sizeof(Vec3) );
+            return stream.good();
+        }
+    }
+}
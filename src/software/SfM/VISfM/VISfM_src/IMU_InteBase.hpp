@@ -5,7 +5,11 @@
 #ifndef OPENMVG_IMU_INTEBASE_HPP
 #define OPENMVG_IMU_INTEBASE_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <stdexcept>
+#include <tuple>
 #include <Eigen/Core>
 //#include <eigen3/Eigen/Core>
 #include <vector>
@@ -60,13 +64,15 @@ namespace openMVG
                 std::string line;
                 getline(csvInput_, line);
 
-                std::istringstream readStr( line );
-                std::string part;
-
+                // Parse the fields in place (no per field string copy)
+                const char* field = line.c_str();
                 for( int i= 0;i<7;++i  )
                 {
-                    getline( readStr, part, split_ );
-                    data_[i] = std::strtod( part.c_str(), nullptr );
+                    char* field_end = nullptr;
+                    data_[i] = std::strtod( field, &field_end );
+                    field = field_end;
+                    while( *field != '\0' && *field != split_ ) ++field;
+                    if( *field == split_ ) ++field;
                 }
 
                 if( imuFileType_ == IMU_File_Type::EuRoc )
@@ -105,11 +111,97 @@ namespace openMVG
             char split_;
         };
 
+        /// Packed binary IMU dataset (see IMU_Dataset::SaveBinary):
+        ///  - an IMU_Dataset_Binary_Header,
+        ///  - sample_count timestamps (double, second * 1000),
+        ///  - sample_count accelerometer samples (3 double each),
+        ///  - sample_count gyroscope samples (3 double each).
+        /// The arrays are stored one after the other (structure of arrays) so the
+        ///  file can be memory mapped and copied in a few block copies.
+        /// Values are stored in the host byte order.
+        struct IMU_Dataset_Binary_Header
+        {
+            char magic[8];         // IMU_DATASET_BINARY_MAGIC
+            uint32_t version;      // IMU_DATASET_BINARY_VERSION
+            uint32_t reserved;
+            uint64_t sample_count;
+        };
+
+        static const char IMU_DATASET_BINARY_MAGIC[8] = {'O', 'M', 'V', 'G', 'I', 'M', 'U', '\0'};
+        static const uint32_t IMU_DATASET_BINARY_VERSION = 1;
+
+        /// Return true if the file is a packed binary IMU dataset
+        bool IsIMUDatasetBinaryFile( const std::string& filename );
+
+        /// IMU measurements of a time interval [t0, t1] without copy:
+        ///  the samples strictly inside the interval are referenced in the dataset,
+        ///  only the (optional) samples interpolated at t0 and t1 are stored.
+        class IMU_Measure_Span
+        {
+        public:
+            IMU_Measure_Span() = default;
+
+            /// Span over count contiguous samples
+            IMU_Measure_Span( const double* times, const Vec3* accs, const Vec3* gyrs, const size_t count, const bool good = true )
+                    :times_(times), accs_(accs), gyrs_(gyrs), count_(count), good_(good)
+            {}
+
+            /// false if the interval is not covered by the dataset
+            bool good() const { return good_; }
+
+            size_t size() const { return has_front_ + count_ + has_back_; }
+
+            double time( size_t i ) const
+            {
+                if( has_front_ && i == 0 ) return front_time_;
+                i -= has_front_;
+                return i < count_ ? times_[i] : back_time_;
+            }
+
+            const Vec3& acc( size_t i ) const
+            {
+                if( has_front_ && i == 0 ) return front_acc_;
+                i -= has_front_;
+                return i < count_ ? accs_[i] : back_acc_;
+            }
+
+            const Vec3& gyr( size_t i ) const
+            {
+                if( has_front_ && i == 0 ) return front_gyr_;
+                i -= has_front_;
+                return i < count_ ? gyrs_[i] : back_gyr_;
+            }
+
+        private:
+            friend class IMU_Dataset;
+
+            const double* times_ = nullptr;
+            const Vec3* accs_ = nullptr;
+            const Vec3* gyrs_ = nullptr;
+            size_t count_ = 0;
+            bool good_ = false;
+
+            // Samples interpolated at the interval boundaries
+            bool has_front_ = false;
+            bool has_back_ = false;
+            double front_time_ = 0.;
+            double back_time_ = 0.;
+            Vec3 front_acc_, front_gyr_;
+            Vec3 back_acc_, back_gyr_;
+        };
+
         class IMU_Dataset
         {
         public:
             explicit IMU_Dataset( const std::string&IMU_file_path, const std::string& simu_file_type )
             {
+                if( IsIMUDatasetBinaryFile( IMU_file_path ) )
+                {
+                    if( !LoadBinary( IMU_file_path ) )
+                        throw std::runtime_error( "Error imu binary file: " + IMU_file_path );
+                    return;
+                }
+
                 IMU_File_Type imu_file_type;
                 if( simu_file_type == std::string( "Mate20Pro" ) || simu_file_type == std::string( "Simu" ) )
                 {
@@ -152,6 +244,12 @@ namespace openMVG
 
             }
 
+            /// Load a packed binary IMU dataset (timestamps are already converted)
+            bool LoadBinary( const std::string& filename );
+
+            /// Save the dataset as a packed binary IMU dataset
+            bool SaveBinary( const std::string& filename ) const;
+
             void corect_time(const double _time)
             {
                 std::cout << "vec_times.back() = "  << vec_times.back() << std::endl;
@@ -272,79 +370,64 @@ namespace openMVG
                     return std::make_tuple( true, vec_times_part, vec_acc_part, vec_gyr_part );
             }
 */
-            std::tuple< bool, std::vector<double>, std::vector<Vec3>, std::vector<Vec3> > GetMeasure(const double _t0, const double _t1)
+            /// Return the measurements of [_t0, _t1] without copying the dataset samples:
+            ///  the boundaries are found by binary search and only the samples at _t0
+            ///  and _t1 are interpolated.
+            /// The span is valid as long as the dataset is not modified.
+            IMU_Measure_Span GetMeasureSpan(const double _t0, const double _t1) const
             {
-                std::vector<Vec3> vec_acc_part;
-                std::vector<Vec3> vec_gyr_part;
-                std::vector<double> vec_times_part;
-//                std::cout << "vec_times[0] = " << vec_times[0] << std::endl;
-//                std::cout << "vec_times.back() = " << vec_times.back() << std::endl;
-//                std::cout << "_t0 = " << _t0 << std::endl;
-//                std::cout << "_t1 = " << _t1 << std::endl << std::endl << std::endl;
-                if( _t0 == _t1 )
-                    return std::make_tuple( false, vec_times_part, vec_acc_part, vec_gyr_part );
+                IMU_Measure_Span span;
+                if( _t0 == _t1 || vec_times.empty() )
+                    return span;
                 if( vec_times[0] > _t1 || vec_times.back() < _t0 )
-                    return std::make_tuple( false, vec_times_part, vec_acc_part, vec_gyr_part );
+                    return span;
 
-                {
-                    auto index_t0 = std::lower_bound(vec_times.begin(), vec_times.end(), _t0);
-                    auto index_t1 = std::lower_bound(vec_times.begin(), vec_times.end(), _t1);
-
-                    auto index = index_t0 - vec_times.begin();
-                    auto index_end = index_t1 - vec_times.begin();
-//                    std::cout << "index = " << index << std::endl;
-//                    std::cout << "index_end = " << index_end << std::endl;
-                    {
-                        if( vec_times[index] > _t0 && index > 0 )
-                        {
-                            double k1, k2;
-                            k1 = static_cast<double>( _t0 - vec_times[index-1] )/static_cast<double>( vec_times[index] - vec_times[index-1] );
-                            k2 = static_cast<double>( vec_times[index] - _t0 )/static_cast<double>( vec_times[index] - vec_times[index-1] );
-                            Vec3 acc0 = vec_acc[index-1];
-                            Vec3 acc1 = vec_acc[index];
-                            Vec3 gyr0 = vec_gyr[index-1];
-                            Vec3 gyr1 = vec_gyr[index];
-
-                            Vec3 acc_cur = k1 * acc0 + k2 * acc1;
-                            Vec3 gyr_cur = k1 * gyr0 + k2 * gyr1;
-
-                            vec_acc_part.push_back( acc_cur );
-                            vec_gyr_part.push_back( gyr_cur );
-                            vec_times_part.push_back( _t0 );
-                        }
+                const size_t index = std::lower_bound(vec_times.begin(), vec_times.end(), _t0) - vec_times.begin();
+                const size_t index_end = std::lower_bound(vec_times.begin(), vec_times.end(), _t1) - vec_times.begin();
 
-                        for(  ;index < index_end; ++index )
-                        {
-                            vec_acc_part.push_back( vec_acc[index] );
-                            vec_gyr_part.push_back( vec_gyr[index] );
-                            vec_times_part.push_back( vec_times[index] );
-                        }
+                if( vec_times[index] > _t0 && index > 0 )
+                {
+                    const double k1 = ( _t0 - vec_times[index-1] )/( vec_times[index] - vec_times[index-1] );
+                    const double k2 = ( vec_times[index] - _t0 )/( vec_times[index] - vec_times[index-1] );
+                    span.has_front_ = true;
+                    span.front_time_ = _t0;
+                    span.front_acc_ = k1 * vec_acc[index-1] + k2 * vec_acc[index];
+                    span.front_gyr_ = k1 * vec_gyr[index-1] + k2 * vec_gyr[index];
+                }
 
-                        if( vec_times[index_end] > _t1 )
-                        {
-                            double k1, k2;
-                            k1 = static_cast<double>( _t1 - vec_times[index-1] )/static_cast<double>( vec_times[index] - vec_times[index-1] );
-                            k2 = static_cast<double>( vec_times[index] - _t1 )/static_cast<double>( vec_times[index] - vec_times[index-1] );
-                            Vec3 acc0 = vec_acc[index-1];
-                            Vec3 acc1 = vec_acc[index];
-                            Vec3 gyr0 = vec_gyr[index-1];
-                            Vec3 gyr1 = vec_gyr[index];
-
-                            Vec3 acc_cur = k1 * acc0 + k2 * acc1;
-                            Vec3 gyr_cur = k1 * gyr0 + k2 * gyr1;
-
-                            vec_acc_part.push_back( acc_cur );
-                            vec_gyr_part.push_back( gyr_cur );
-                            vec_times_part.push_back( _t1 );
-                        }
-                    }
+                span.times_ = vec_times.data() + index;
+                span.accs_ = vec_acc.data() + index;
+                span.gyrs_ = vec_gyr.data() + index;
+                span.count_ = index_end - index;
 
+                if( index_end < vec_times.size() && vec_times[index_end] > _t1 )
+                {
+                    const double k1 = ( _t1 - vec_times[index_end-1] )/( vec_times[index_end] - vec_times[index_end-1] );
+                    const double k2 = ( vec_times[index_end] - _t1 )/( vec_times[index_end] - vec_times[index_end-1] );
+                    span.has_back_ = true;
+                    span.back_time_ = _t1;
+                    span.back_acc_ = k1 * vec_acc[index_end-1] + k2 * vec_acc[index_end];
+                    span.back_gyr_ = k1 * vec_gyr[index_end-1] + k2 * vec_gyr[index_end];
                 }
 
-//                if( index == vec_times.size() && vec_times[index-1] < _t1 )
-//                    return std::make_tuple( false, vec_times_part, vec_acc_part, vec_gyr_part );
-//                else
-                return std::make_tuple( true, vec_times_part, vec_acc_part, vec_gyr_part );
+                span.good_ = true;
+                return span;
+            }
+
+            /// Return a copy of the measurements of [_t0, _t1] (see GetMeasureSpan)
+            std::tuple< bool, std::vector<double>, std::vector<Vec3>, std::vector<Vec3> > GetMeasure(const double _t0, const double _t1) const
+            {
+                const IMU_Measure_Span span = GetMeasureSpan(_t0, _t1);
+                std::vector<double> vec_times_part(span.size());
+                std::vector<Vec3> vec_acc_part(span.size());
+                std::vector<Vec3> vec_gyr_part(span.size());
+                for( size_t i = 0; i < span.size(); ++i )
+                {
+                    vec_times_part[i] = span.time(i);
+                    vec_acc_part[i] = span.acc(i);
+                    vec_gyr_part[i] = span.gyr(i);
+                }
+                return std::make_tuple( span.good(), vec_times_part, vec_acc_part, vec_gyr_part );
             }
 
             // TODO xinli change to map
@@ -377,6 +460,32 @@ namespace openMVG
             O_BG = 12
         };
 
+        /// How the preintegration of an interval was brought to the current bias
+        enum class IMU_Preintegration_Update : int
+        {
+            FirstOrder  = 0, // deltas corrected with the stored jacobian
+            Repropagate = 1, // buffered samples propagated again
+            Integrate   = 2  // samples read from the dataset and integrated
+        };
+
+        /// Counters of the preintegration updates (cache hits are the FirstOrder updates)
+        struct IMU_Preintegration_Stats
+        {
+            size_t first_order = 0;
+            size_t repropagate = 0;
+            size_t integrate = 0;
+
+            void Add( const IMU_Preintegration_Update update )
+            {
+                switch( update )
+                {
+                    case IMU_Preintegration_Update::FirstOrder: ++first_order; break;
+                    case IMU_Preintegration_Update::Repropagate: ++repropagate; break;
+                    case IMU_Preintegration_Update::Integrate: ++integrate; break;
+                }
+            }
+        };
+
         class IMU_InteBase
         {
         public:
@@ -408,10 +517,20 @@ namespace openMVG
 
             void integrate( const std::vector< Vec3 >& _accs, const std::vector<Vec3>& _gyrs, const std::vector<double>& _times_T, bool good_falg = true )
             {
+                integrate( IMU_Measure_Span( _times_T.data(), _accs.data(), _gyrs.data(), _times_T.size(), good_falg ) );
+            }
+
+            void integrate( const IMU_Measure_Span& _measures )
+            {
+                const bool good_falg = _measures.good();
 //                std::cout << "_accs.size() = " << _accs.size() << std::endl;
 //                std::cout << "good_falg = " << good_falg
 //                << std::endl;
                 good_to_opti_ = good_falg;
+                integrated_ = true;
+                measures_good_ = good_falg;
+                propagated_ba_ = deltas_ba_ = linearized_ba_;
+                propagated_bg_ = deltas_bg_ = linearized_bg_;
                 dt_buf_.clear();
                 acc_buf_.clear();
                 gyr_buf_.clear();
@@ -424,21 +543,21 @@ namespace openMVG
                     covariance.setIdentity();
                 double last_t = static_cast<double>(t0_);
                 last_t /= 1000.;
-                if(!good_falg) return;
-                linearized_acc_ = _accs[0];
-                linearized_gyr_ = _gyrs[0];
-                acc_0_ = _accs[0];
-                gyr_0_ = _gyrs[0];
-                for( size_t index = 1; index < _times_T.size(); ++index )
+                if(!good_falg || _measures.size() == 0) return;
+                linearized_acc_ = _measures.acc(0);
+                linearized_gyr_ = _measures.gyr(0);
+                acc_0_ = _measures.acc(0);
+                gyr_0_ = _measures.gyr(0);
+                for( size_t index = 1; index < _measures.size(); ++index )
                 {
-                    double time = static_cast<double>(_times_T[index]);
+                    double time = _measures.time(index);
                     time /= 1000.;
                     double dt = time - last_t;
                     last_t = time;
-                    propagate(dt, _accs[index], _gyrs[index]);
+                    propagate(dt, _measures.acc(index), _measures.gyr(index));
                     dt_buf_.push_back(dt);
-                    acc_buf_.push_back(_accs[index]);
-                    gyr_buf_.push_back(_accs[index]);
+                    acc_buf_.push_back(_measures.acc(index));
+                    gyr_buf_.push_back(_measures.gyr(index));
                 }
             }
 
@@ -457,6 +576,43 @@ namespace openMVG
                     covariance.setIdentity();
                 for (int i = 0; i < static_cast<int>(dt_buf_.size()); i++)
                     propagate(dt_buf_[i], acc_buf_[i], gyr_buf_[i]);
+                propagated_ba_ = deltas_ba_ = linearized_ba_;
+                propagated_bg_ = deltas_bg_ = linearized_bg_;
+            }
+
+            /// Bring the preintegrated deltas to the current bias linearization point
+            ///  (linearized_ba_, linearized_bg_, i.e. the bias estimated by the last BA):
+            ///  - the samples are integrated if the time interval changed,
+            ///  - the buffered samples are propagated again if the bias moved by more
+            ///    than the thresholds since their last propagation,
+            ///  - else the deltas are corrected at first order with the stored jacobian
+            ///    (as evaluate does for the bias changes during an optimization).
+            IMU_Preintegration_Update update( const IMU_Dataset& dataset, const double acc_bias_threshold, const double gyr_bias_threshold )
+            {
+                if( !integrated_ )
+                {
+                    integrate( dataset.GetMeasureSpan(t0_, t1_) );
+                    return IMU_Preintegration_Update::Integrate;
+                }
+                good_to_opti_ = measures_good_;
+                if( !measures_good_ )
+                    return IMU_Preintegration_Update::FirstOrder;
+
+                if( (linearized_ba_ - propagated_ba_).norm() > acc_bias_threshold ||
+                    (linearized_bg_ - propagated_bg_).norm() > gyr_bias_threshold )
+                {
+                    repropagate( linearized_ba_, linearized_bg_ );
+                    return IMU_Preintegration_Update::Repropagate;
+                }
+
+                const Eigen::Vector3d dba = linearized_ba_ - deltas_ba_;
+                const Eigen::Vector3d dbg = linearized_bg_ - deltas_bg_;
+                delta_q_ = delta_q_ * Utility::deltaQ(jacobian.block<3, 3>(O_R, O_BG) * dbg);
+                delta_v_ += jacobian.block<3, 3>(O_V, O_BA) * dba + jacobian.block<3, 3>(O_V, O_BG) * dbg;
+                delta_p_ += jacobian.block<3, 3>(O_P, O_BA) * dba + jacobian.block<3, 3>(O_P, O_BG) * dbg;
+                deltas_ba_ = linearized_ba_;
+                deltas_bg_ = linearized_bg_;
+                return IMU_Preintegration_Update::FirstOrder;
             }
 
             void propagate(const double dt, const Eigen::Vector3d& acc_1, const Eigen::Vector3d& gyro_1)
@@ -604,6 +760,7 @@ namespace openMVG
 
             void change_time(const double _t0, const double _t1)
             {
+                integrated_ = false;
                 t0_ = _t0;
                 t1_ = _t1;
                 sum_dt_ = (static_cast<double>(t1_) - static_cast<double>(t0_)) / 1000.;
@@ -638,6 +795,12 @@ namespace openMVG
 
             Eigen::Matrix<double, 15, 15> jacobian, covariance;
             Eigen::Matrix<double, 18, 18> noise;
+
+            // Preintegration cache (see update)
+            bool integrated_ = false;     // the deltas were integrated for [t0_, t1_]
+            bool measures_good_ = false;  // the dataset covers [t0_, t1_]
+            Vec3 propagated_ba_, propagated_bg_; // bias of the last propagation of the samples
+            Vec3 deltas_ba_, deltas_bg_;         // bias of the deltas (after the first-order corrections)
         };
     }
 }
@@ -1027,13 +1027,8 @@ namespace sfm{
             {
                 double t0 = id_imubase.second.t0_;
                 double t1 = id_imubase.second.t1_;
-                std::vector< double > times;
-                std::vector<Vec3> accs;
-                std::vector<Vec3> gyrs;
-                bool good_flag;
-
-                std::tie( good_flag, times, accs, gyrs ) = sfm_data_.imu_dataset->GetMeasure(t0, t1);
-                id_imubase.second.integrate(accs, gyrs, times, good_flag);
+                const IMU_Measure_Span measures = sfm_data_.imu_dataset->GetMeasureSpan(t0, t1);
+                id_imubase.second.integrate(measures);
             }
         }
 
@@ -1701,18 +1696,8 @@ namespace sfm{
     {
         for( auto & id_imubase:sfm_data_.imus )
         {
-            double t0 = id_imubase.second.t0_;
-            double t1 = id_imubase.second.t1_;
-            std::vector< double > times;
-            std::vector<Vec3> accs;
-            std::vector<Vec3> gyrs;
-            bool good_flag;
-
-//            std::cout << "start GetMeasure" << std::endl;
-            std::tie( good_flag, times, accs, gyrs ) = sfm_data_.imu_dataset->GetMeasure(t0, t1);
-//            std::cout << "start integrate" << std::endl;
-//            std::cout << "t0 = " << t0 << " t1 = " << t1 << std::endl;
-            id_imubase.second.integrate(accs, gyrs, times, good_flag);
+            imu_preintegration_stats_.Add(
+                id_imubase.second.update( *sfm_data_.imu_dataset, imu_acc_bias_threshold_, imu_gyr_bias_threshold_ ) );
         }
     }
 
@@ -1720,18 +1705,8 @@ namespace sfm{
     {
         for( auto & id_imubase:local_scene.imus )
         {
-            double t0 = id_imubase.second.t0_;
-            double t1 = id_imubase.second.t1_;
-            std::vector< double > times;
-            std::vector<Vec3> accs;
-            std::vector<Vec3> gyrs;
-            bool good_flag;
-
-//            std::cout << "start GetMeasure" << std::endl;
-            std::tie( good_flag, times, accs, gyrs ) = sfm_data_.imu_dataset->GetMeasure(t0, t1);
-//            std::cout << "start integrate" << std::endl;
-//            std::cout << "t0 = " << t0 << " t1 = " << t1 << std::endl;
-            id_imubase.second.integrate(accs, gyrs, times, good_flag);
+            imu_preintegration_stats_.Add(
+                id_imubase.second.update( *sfm_data_.imu_dataset, imu_acc_bias_threshold_, imu_gyr_bias_threshold_ ) );
         }
     }
 
@@ -1857,14 +1832,10 @@ namespace sfm{
                         double t1 = sfm_data_.timestamps.at( it_speed_next->first );
                         IMU_InteBase imubase(t0, t1);
 
-                        std::vector< double > times;
-                        std::vector<Vec3> accs;
-                        std::vector<Vec3> gyrs;
-                        bool good_flag;
-                        std::tie( good_flag, times, accs, gyrs ) = sfm_data_.imu_dataset->GetMeasure(t0, t1);
-                        imubase.integrate(accs, gyrs, times, good_flag);
+                        const IMU_Measure_Span measures = sfm_data_.imu_dataset->GetMeasureSpan(t0, t1);
+                        imubase.integrate(measures);
 
-                        if( !good_flag )
+                        if( !measures.good() )
                         {
                             Mat3 Rwi = sfm_data_.poses.at( it_speed->first ).rotation().transpose();
                             it_speed->second.speed_ = it_speed_next->second.speed_ - Rwi*imubase.delta_v_;
@@ -1884,14 +1855,10 @@ namespace sfm{
                             double t1 = sfm_data_.timestamps.at( it_speed->first );
                             IMU_InteBase imubase(t0, t1);
 
-                            std::vector< double > times;
-                            std::vector<Vec3> accs;
-                            std::vector<Vec3> gyrs;
-                            bool good_flag;
-                            std::tie( good_flag, times, accs, gyrs ) = sfm_data_.imu_dataset->GetMeasure(t0, t1);
-                            imubase.integrate(accs, gyrs, times, good_flag);
+                            const IMU_Measure_Span measures = sfm_data_.imu_dataset->GetMeasureSpan(t0, t1);
+                            imubase.integrate(measures);
 
-                            if( !good_flag )
+                            if( !measures.good() )
                             {
                                 Mat3 Rwi = sfm_data_.poses.at( it_speed_prev->first ).rotation().transpose();
                                 it_speed->second.speed_ = it_speed_prev->second.speed_ + Rwi*imubase.delta_v_;
@@ -65,6 +65,8 @@ public:
     void RefineGravity( Eigen::VectorXd& speeds_scale, Eigen::Vector3d& correct_g );
 
     bool VI_align( bool only_align = false );
+    /// Bring the preintegrations to the current bias estimates
+    ///  (see IMU_InteBase::update for the reuse of the previous integration)
     void update_imu_inte();
     void update_imu_time();
 
@@ -111,6 +113,19 @@ public:
         triangulation_method_ = method;
     }
 
+    /// Bias changes (norm) above which the IMU samples are propagated again,
+    ///  below them the preintegrations are corrected at first order
+    void SetIMUBiasRepropagationThresholds( const double acc_bias_threshold, const double gyr_bias_threshold )
+    {
+        imu_acc_bias_threshold_ = acc_bias_threshold;
+        imu_gyr_bias_threshold_ = gyr_bias_threshold;
+    }
+
+    const IMU_Preintegration_Stats& GetIMUPreintegrationStats() const
+    {
+        return imu_preintegration_stats_;
+    }
+
     std::string output_result_file_;
     std::string output_log_file_;
 
@@ -195,6 +210,11 @@ private:
     std::set<uint32_t> set_remaining_view_id_vi_init_;     // Remaining camera index that can be used for resection
 
     ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
+
+    // IMU preintegration reuse
+    double imu_acc_bias_threshold_ = 0.1;
+    double imu_gyr_bias_threshold_ = 0.01;
+    IMU_Preintegration_Stats imu_preintegration_stats_;
 };
 
 } // namespace sfm
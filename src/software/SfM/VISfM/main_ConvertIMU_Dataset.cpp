@@ -0,0 +1,75 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Convert an IMU csv file (EuRoc or Mate20Pro format) to a packed binary IMU
+//  dataset that can be given to the VISfM tools instead of the csv file.
+
+#include "openMVG/system/timer.hpp"
+
+#include "VISfM_src/IMU_InteBase.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace openMVG;
+using namespace openMVG::sfm;
+
+int main(int argc, char **argv)
+{
+    CmdLine cmd;
+
+    std::string sSfM_IMU_Filename;
+    std::string sSfM_IMU_FileType = "Mate20Pro";
+    std::string sOutFile;
+
+    cmd.add( make_option('u', sSfM_IMU_Filename, "imu_file") );
+    cmd.add( make_option('I', sSfM_IMU_FileType, "imu_filetype") );
+    cmd.add( make_option('o', sOutFile, "output_file") );
+
+    try {
+        if (argc == 1) throw std::string("Invalid parameter.");
+        cmd.process(argc, argv);
+    } catch (const std::string& s) {
+        std::cerr << "Usage: " << argv[0] << '\n'
+                  << "[-u|--imu_file] path to the IMU csv file\n"
+                  << "[-o|--output_file] path of the binary IMU dataset\n"
+                  << "\n[Optional]\n"
+                  << "[-I|--imu_filetype] IMU csv file format: Mate20Pro (default), Simu or EuRoc\n"
+                  << std::endl;
+
+        std::cerr << s << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (sSfM_IMU_Filename.empty() || sOutFile.empty())
+    {
+        std::cerr << "Invalid input or output filename." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    system::Timer timer;
+    try {
+        const IMU_Dataset imu_dataset(sSfM_IMU_Filename, sSfM_IMU_FileType);
+        std::cout << "#IMU samples: " << imu_dataset.vec_times.size() << "\n"
+                  << "Loaded in (s): " << timer.elapsed() << std::endl;
+
+        if (!imu_dataset.SaveBinary(sOutFile))
+        {
+            std::cerr << "Cannot save the binary IMU dataset: " << sOutFile << std::endl;
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
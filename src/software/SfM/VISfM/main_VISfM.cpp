@@ -536,6 +536,12 @@ int main(int argc, char **argv)
 
                 std::cout << std::endl << " Total Ac-Sfm took (s): " << timer.elapsed() << std::endl;
 
+                const IMU_Preintegration_Stats& imu_stats = visfmEngine.GetIMUPreintegrationStats();
+                std::cout << "IMU preintegration updates:\n"
+                          << " first order (cache hit): " << imu_stats.first_order << "\n"
+                          << " repropagation: " << imu_stats.repropagate << "\n"
+                          << " integration: " << imu_stats.integrate << std::endl;
+
                 std::cout << "init ex\n";
                 PrintExtric(sfMData);
                 std::cout << "after oti" << std::endl;
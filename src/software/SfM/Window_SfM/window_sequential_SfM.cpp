@@ -86,6 +86,7 @@ using namespace openMVG::matching;
         // Initial pair Essential Matrix and [R|t] estimation.
         if (!MakeInitialPair3D(initial_pair_))
             return false;
+        UpdateLocalSceneIndex(initial_pair_.first);
 
         //Save(sfm_data_, stlplus::create_filespec(sOut_directory_, "initialPair", ".bin"), ESfM_Data(ALL));
 
@@ -100,7 +101,11 @@ using namespace openMVG::matching;
             sfm_data_.add_viewId_cur.clear();
             for (const auto & iter : vec_possible_resection_indexes)
             {
-                bImageAdded |= Resection(iter);
+                if (Resection(iter))
+                {
+                    bImageAdded = true;
+                    UpdateLocalSceneIndex(iter);
+                }
                 set_remaining_view_id_.erase(iter);
                 sfm_data_.add_viewId_cur.insert(iter);
             }
@@ -221,6 +226,8 @@ using namespace openMVG::matching;
     ) {
         //  collect all views that is close to current views		
 		for (auto& viewId : add_viewId_cur){
+			if (sfm_data_.poses.count(viewId) == 0)
+				continue; // resection failed
 			{
 				auto pose_it = sfm_data_.poses.find(viewId);
 				int i = 0;
@@ -244,38 +251,60 @@ using namespace openMVG::matching;
 			}
 		}
 
-        //  add views to local_scene
+        //  add views to local_scene (views and intrinsics are shared with the global scene)
 		for (auto viewId : local_scene_viewId) {
-			const View* view_I = sfm_data_.GetViews().at(viewId).get();
-			local_scene.views.insert(*sfm_data_.GetViews().find(view_I->id_view));
+			const auto view_it = sfm_data_.GetViews().find(viewId);
+			const View* view_I = view_it->second.get();
+			local_scene.views.insert(*view_it);
 			local_scene.intrinsics.insert(*sfm_data_.GetIntrinsics().find(view_I->id_intrinsic));
 			local_scene.poses.insert(*sfm_data_.GetPoses().find(view_I->id_pose));
 			assert(view_I->id_view == view_I->id_pose);
 		}
 
-		//std::cout << "local_scene_viewId.size() = " << local_scene_viewId.size() << std::endl;
-
-		for (auto& structure_landmark_it : sfm_data_.structure) {
-			const Observations& obs = structure_landmark_it.second.obs;
-			Observations local_obs;
-			bool f_use_landmark = false;
-			for (const auto& obs_it : obs) {
-				const View* view = sfm_data_.views.at(obs_it.first).get();
-				if (local_scene_viewId.count(view->id_view) == 1)
-				{
-					local_obs[obs_it.first] = obs_it.second;
-					f_use_landmark = true;
+		//  add the landmarks observed by the local views (restricted to their local observations)
+		for (auto viewId : local_scene_viewId) {
+			const auto index_it = view_landmarks_.find(viewId);
+			if (index_it == view_landmarks_.end())
+				continue;
+			std::set<IndexT>& view_landmarks = index_it->second;
+			for (auto landmark_id_it = view_landmarks.begin(); landmark_id_it != view_landmarks.end();) {
+				const auto landmark_it = sfm_data_.structure.find(*landmark_id_it);
+				if (landmark_it == sfm_data_.structure.end() ||
+					landmark_it->second.obs.count(viewId) == 0) {
+					// removed by the outlier rejection
+					landmark_id_it = view_landmarks.erase(landmark_id_it);
+					continue;
+				}
+				++landmark_id_it;
+				if (local_scene.structure.count(landmark_it->first) != 0)
+					continue; // already added from another local view
+
+				Landmark& local_landmark = local_scene.structure[landmark_it->first];
+				local_landmark.X = landmark_it->second.X;
+				for (const auto& obs_it : landmark_it->second.obs) {
+					if (local_scene_viewId.count(obs_it.first) == 1)
+						local_landmark.obs.insert(obs_it);
 				}
-			}
-			if (f_use_landmark) {
-				local_scene.structure[structure_landmark_it.first].obs = std::move(local_obs);
-				local_scene.structure[structure_landmark_it.first].X = sfm_data_.structure[structure_landmark_it.first].X;
 			}
 		}
 
         return true;
 	}
 
+    void WindowSequentialSfMReconstructionEngine::UpdateLocalSceneIndex(IndexT viewId)
+    {
+        const auto view_tracks = map_tracks_.TracksInView(viewId);
+        for (const auto & view_track : view_tracks)
+        {
+            const IndexT trackId = map_tracks_.TrackId(view_track.first);
+            const auto landmark_it = sfm_data_.structure.find(trackId);
+            if (landmark_it == sfm_data_.structure.end())
+                continue;
+            for (const auto & obs_it : landmark_it->second.obs)
+                view_landmarks_[obs_it.first].insert(trackId);
+        }
+    }
+
     bool WindowSequentialSfMReconstructionEngine::BundleAdjustmentWindows(SfM_Data &sfm_data)
     {
         Bundle_Adjustment_Ceres::BA_Ceres_options options;
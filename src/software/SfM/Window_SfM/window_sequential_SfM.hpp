@@ -40,9 +40,22 @@ public:
 
     bool BundleAdjustmentWindows(SfM_Data& sfm_data);
 
+    /// Register in the view->landmark index the landmarks observed by a view
+    ///  (and the views that observe them: new triangulations add observations
+    ///  to already reconstructed views)
+    void UpdateLocalSceneIndex(IndexT viewId);
+
     bool badTrackRejectorWindow( SfM_Data& sfm_data, double dPrecision, size_t count = 0);
 
     double ComputeResidualsHistogram(Histogram<double> * histo);
+
+protected:
+
+    // Landmarks observed by each reconstructed view, maintained incrementally
+    //  after each resection so a local scene is built from the local views only.
+    // Landmarks or observations removed by the outlier rejection are pruned
+    //  lazily when the local scene is created.
+    Hash_Map<IndexT, std::set<IndexT>> view_landmarks_;
 };
 
 }
@@ -69,6 +69,8 @@ int main(int argc, char **argv)
   std::string sImage_Describer_Method = "SIFT";
   bool bForce = false;
   std::string sFeaturePreset = "";
+  bool bBinaryRegions = false;
+  int iMaxImageDimension = 0;
 #ifdef OPENMVG_USE_OPENMP
   int iNumThreads = 0;
 #endif
@@ -81,6 +83,8 @@ int main(int argc, char **argv)
   cmd.add( make_option('u', bUpRight, "upright") );
   cmd.add( make_option('f', bForce, "force") );
   cmd.add( make_option('p', sFeaturePreset, "describerPreset") );
+  cmd.add( make_option('b', bBinaryRegions, "binary_regions") );
+  cmd.add( make_option('d', iMaxImageDimension, "max_image_dimension") );
 
 #ifdef OPENMVG_USE_OPENMP
   cmd.add( make_option('n', iNumThreads, "numThreads") );
@@ -107,6 +111,12 @@ int main(int argc, char **argv)
       << "   NORMAL (default),\n"
       << "   HIGH,\n"
       << "   ULTRA: !!Can take long time!!\n"
+      << "[-b|--binary_regions] Export features and descriptors in a single\n"
+      << "  binary (memory mappable) .feat file instead of the .feat/.desc pair 0 or 1\n"
+      << "[-d|--max_image_dimension] Describe the images at a reduced resolution\n"
+      << "  (downscaled by 2, 4 or 8 to fit this dimension) and decoded in gray\n"
+      << "  (JPEG images are reduced while decoding). The regions are expressed\n"
+      << "  in the full resolution image frame. 0 (default): full resolution\n"
 #ifdef OPENMVG_USE_OPENMP
       << "[-n|--numThreads] number of parallel computations\n"
 #endif
@@ -124,6 +134,8 @@ int main(int argc, char **argv)
             << "--upright " << bUpRight << std::endl
             << "--describerPreset " << (sFeaturePreset.empty() ? "NORMAL" : sFeaturePreset) << std::endl
             << "--force " << bForce << std::endl
+            << "--binary_regions " << bBinaryRegions << std::endl
+            << "--max_image_dimension " << iMaxImageDimension << std::endl
 #ifdef OPENMVG_USE_OPENMP
             << "--numThreads " << iNumThreads << std::endl
 #endif
@@ -274,9 +286,29 @@ int main(int argc, char **argv)
         sDesc = stlplus::create_filespec(sOutDir, stlplus::basename_part(sView_filename), "desc");
 
       // If features or descriptors file are missing, compute them
-      if (!preemptive_exit && (bForce || !stlplus::file_exists(sFeat) || !stlplus::file_exists(sDesc)))
+      // (a binary regions file holds both the features and the descriptors)
+      const bool bRegionsExist = bBinaryRegions ?
+        isRegionsBinFile(sFeat) :
+        (stlplus::file_exists(sFeat) && stlplus::file_exists(sDesc));
+      if (!preemptive_exit && (bForce || !bRegionsExist))
       {
-        if (!ReadImage(sView_filename.c_str(), &imageGray))
+        // Optionally decode the image at a reduced resolution
+        int scale_denom = 1;
+        if (iMaxImageDimension > 0)
+        {
+          ImageHeader imageHeader;
+          imageHeader.width = view->ui_width;
+          imageHeader.height = view->ui_height;
+          scale_denom = ReducedScaleDenom(imageHeader, iMaxImageDimension);
+        }
+        const auto readImage = [&](const std::string & filename, Image<unsigned char> * image)
+        {
+          return iMaxImageDimension > 0 ?
+            ReadImageReduced(filename.c_str(), scale_denom, image) :
+            ReadImage(filename.c_str(), image);
+        };
+
+        if (!readImage(sView_filename, &imageGray))
           continue;
 
         //
@@ -295,7 +327,7 @@ int main(int argc, char **argv)
         // Try to read the local mask
         if (stlplus::file_exists(mask_filename_local))
         {
-          if (!ReadImage(mask_filename_local.c_str(), &imageMask))
+          if (!readImage(mask_filename_local, &imageMask))
           {
             std::cerr << "Invalid mask: " << mask_filename_local << std::endl
                       << "Stopping feature extraction." << std::endl;
@@ -311,7 +343,7 @@ int main(int argc, char **argv)
           // Try to read the global mask
           if (stlplus::file_exists(mask__filename_global))
           {
-            if (!ReadImage(mask__filename_global.c_str(), &imageMask))
+            if (!readImage(mask__filename_global, &imageMask))
             {
               std::cerr << "Invalid mask: " << mask__filename_global << std::endl
                         << "Stopping feature extraction." << std::endl;
@@ -326,7 +358,14 @@ int main(int argc, char **argv)
 
         // Compute features and descriptors and export them to files
         auto regions = image_describer->Describe(imageGray, mask);
-        if (regions && !image_describer->Save(regions.get(), sFeat, sDesc)) {
+        // Express the regions in the full resolution image frame
+        if (regions && scale_denom > 1)
+          regions->Rescale(static_cast<float>(scale_denom));
+        const bool bSaved = !regions ||
+          (bBinaryRegions ?
+            regions->SaveBinary(sFeat) :
+            image_describer->Save(regions.get(), sFeat, sDesc));
+        if (!bSaved) {
           std::cerr << "Cannot save regions for images: " << sView_filename << std::endl
                     << "Stopping feature extraction." << std::endl;
           preemptive_exit = true;
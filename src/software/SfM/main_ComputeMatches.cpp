@@ -13,6 +13,7 @@
 #include "openMVG/features/feature.hpp"
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 #include "openMVG/matching_image_collection/Matcher_Regions.hpp"
 #include "openMVG/matching_image_collection/Cascade_Hashing_Matcher_Regions.hpp"
 #include "openMVG/matching_image_collection/GeometricFilter.hpp"
@@ -25,6 +26,9 @@
 #include "openMVG/matching_image_collection/Eo_Robust.hpp"
 #include "openMVG/matching_image_collection/H_ACRobust.hpp"
 #include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/matching_image_collection/Pipelined_GeometricFilter.hpp"
+#include "openMVG/matching_image_collection/Retrieval_Pair_Builder.hpp"
+#include "openMVG/matching_image_collection/Tiled_Matcher.hpp"
 #include "openMVG/matching/pairwiseAdjacencyDisplay.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
@@ -34,10 +38,20 @@
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
 
 using namespace openMVG;
 using namespace openMVG::matching;
@@ -59,9 +73,103 @@ enum EPairMode
 {
   PAIR_EXHAUSTIVE = 0,
   PAIR_CONTIGUOUS = 1,
-  PAIR_FROM_FILE  = 2
+  PAIR_FROM_FILE  = 2,
+  PAIR_RETRIEVAL  = 3
 };
 
+/// Geometric filtering of the putative matches:
+/// - kept in memory (putative matches file that is not an indexed one),
+/// - or read pair by pair from an indexed putative matches file by the filtering
+///   threads (the putative matches are then not all kept in memory).
+/// Return false if the putative matches cannot be read.
+template <typename GeometryFunctor>
+bool Geometric_Filtering
+(
+  ImageCollectionGeometricFilter & filter,
+  const GeometryFunctor & functor,
+  const PairWiseMatches & putative_matches,
+  const PairWiseMatchesStreamReader & putative_reader,
+  const bool b_guided_matching,
+  const double d_distance_ratio,
+  C_Progress * progress
+)
+{
+  if (!putative_matches.empty())
+  {
+    filter.Robust_model_estimation(functor, putative_matches,
+      b_guided_matching, d_distance_ratio, progress);
+    return true;
+  }
+
+  // The pair count comes from the validated index table of the file
+  //  (see PairWiseMatchesStreamReader::Open)
+  const size_t pair_count = putative_reader.PairCount();
+  if (pair_count > static_cast<size_t>(std::numeric_limits<int>::max()))
+  {
+    std::cerr << "Too many putative pairs: " << pair_count << std::endl;
+    return false;
+  }
+
+  // Filter the pairs by decreasing putative match count
+  //  (the most expensive robust estimations start first)
+  std::vector<size_t> pair_order(pair_count);
+  std::iota(pair_order.begin(), pair_order.end(), 0);
+  std::stable_sort(pair_order.begin(), pair_order.end(),
+    [&putative_reader](const size_t a, const size_t b)
+    {
+      return putative_reader.MatchCount(putative_reader.GetPair(a))
+        > putative_reader.MatchCount(putative_reader.GetPair(b));
+    });
+
+  return filter.Robust_model_estimation(functor, pair_count,
+    [&putative_reader, &pair_order](const size_t i, Pair & pair, IndMatches & buffer)
+      -> const IndMatches *
+    {
+      pair = putative_reader.GetPair(pair_order[i]);
+      return putative_reader.Read(pair, buffer) ? &buffer : nullptr;
+    },
+    b_guided_matching, d_distance_ratio, progress);
+}
+
+/// Pipelined putative matching and geometric filtering:
+/// the putative matches of each pair are saved and queued for the geometric filter
+/// as soon as they are computed.
+template <typename GeometryFunctor>
+bool Pipelined_Matching
+(
+  const Matcher & collection_matcher,
+  const std::shared_ptr<Regions_Provider> & regions_provider,
+  const Pair_Set & pairs,
+  const ImageCollectionGeometricFilter & filter,
+  const GeometryFunctor & functor,
+  const bool b_guided_matching,
+  const double d_distance_ratio,
+  const size_t queue_size,
+  const unsigned int worker_count,
+  PairWiseMatchesStreamWriter & putative_writer,
+  typename Pipelined_GeometricFilter<GeometryFunctor>::Pair_Acceptance pair_acceptance,
+  Pair_Set & putative_pairs,
+  PairWiseMatches & geometric_matches,
+  C_Progress * progress
+)
+{
+  std::atomic<bool> bValid(true);
+  Pipelined_GeometricFilter<GeometryFunctor> pipeline(
+    filter, functor, b_guided_matching, d_distance_ratio,
+    queue_size, worker_count,
+    [&](const Pair & pair, const IndMatches & matches)
+    {
+      if (!putative_writer.Write(pair, matches))
+        bValid = false;
+    },
+    pair_acceptance);
+  collection_matcher.Match(regions_provider, pairs, pipeline, progress);
+  pipeline.Finish();
+  putative_pairs = pipeline.Get_putative_pairs();
+  geometric_matches = pipeline.Get_geometric_matches();
+  return bValid;
+}
+
 /// Compute corresponding features between a series of views:
 /// - Load view images description (regions: features & descriptors)
 /// - Compute putative local feature matches (descriptors matching)
@@ -82,6 +190,9 @@ int main(int argc, char **argv)
   bool bGuided_matching = false;
   int imax_iteration = 2048;
   unsigned int ui_max_cache_size = 0;
+  unsigned int ui_pipeline_queue_size = 0;
+  unsigned int ui_pipeline_worker_count = 0;
+  unsigned int ui_retrieval_neighbors = 0;
 
   //required
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
@@ -96,6 +207,9 @@ int main(int argc, char **argv)
   cmd.add( make_option('m', bGuided_matching, "guided_matching") );
   cmd.add( make_option('I', imax_iteration, "max_iteration") );
   cmd.add( make_option('c', ui_max_cache_size, "cache_size") );
+  cmd.add( make_option('p', ui_pipeline_queue_size, "pipeline_queue_size") );
+  cmd.add( make_option('w', ui_pipeline_worker_count, "pipeline_worker_count") );
+  cmd.add( make_option('R', ui_retrieval_neighbors, "retrieval_neighbors") );
 
 
   try {
@@ -122,6 +236,10 @@ int main(int argc, char **argv)
       << "   2: will match 0 with (1,2), 1 with (2,3), ...\n"
       << "   3: will match 0 with (1,2,3), 1 with (2,3,4), ...\n"
       << "[-l]--pair_list] file\n"
+      << "[-R|--retrieval_neighbors] K\n"
+      << "  (image retrieval matching)\n"
+      << "   match each view with its K most similar views\n"
+      << "   (vocabulary tree of the view descriptors).\n"
       << "[-n|--nearest_matching_method]\n"
       << "  AUTO: auto choice from regions type,\n"
       << "  For Scalar based regions descriptor:\n"
@@ -138,7 +256,17 @@ int main(int argc, char **argv)
       << "  use the found model to improve the pairwise correspondences.\n"
       << "[-c|--cache_size]\n"
       << "  Use a regions cache (only cache_size regions will be stored in memory)\n"
-      << "  If not used, all regions will be load in memory."
+      << "  The pairs are then matched by tiles of views that fit in the cache.\n"
+      << "  If not used, all regions will be load in memory.\n"
+      << "[-p|--pipeline_queue_size]\n"
+      << "  Filter the putative matches of a pair as soon as they are computed\n"
+      << "  (putative matching and geometric filtering overlap,\n"
+      << "   at most pipeline_queue_size putative pairs are kept in memory).\n"
+      << "  If not used (0), all the putative matches are computed first.\n"
+      << "[-w|--pipeline_worker_count]\n"
+      << "  Number of geometric filtering threads of the pipeline\n"
+      << "  (they run alongside the putative matching threads).\n"
+      << "  If not used (0), the number of OpenMP threads is used."
       << std::endl;
 
       std::cerr << s << std::endl;
@@ -155,9 +283,12 @@ int main(int argc, char **argv)
             << "--geometric_model " << sGeometricModel << "\n"
             << "--video_mode_matching " << iMatchingVideoMode << "\n"
             << "--pair_list " << sPredefinedPairList << "\n"
+            << "--retrieval_neighbors " << ui_retrieval_neighbors << "\n"
             << "--nearest_matching_method " << sNearestMatchingMethod << "\n"
             << "--guided_matching " << bGuided_matching << "\n"
-            << "--cache_size " << ((ui_max_cache_size == 0) ? "unlimited" : std::to_string(ui_max_cache_size)) << std::endl;
+            << "--cache_size " << ((ui_max_cache_size == 0) ? "unlimited" : std::to_string(ui_max_cache_size)) << "\n"
+            << "--pipeline_queue_size " << ui_pipeline_queue_size << "\n"
+            << "--pipeline_worker_count " << ui_pipeline_worker_count << std::endl;
 
   EPairMode ePairmode = (iMatchingVideoMode == -1 ) ? PAIR_EXHAUSTIVE : PAIR_CONTIGUOUS;
 
@@ -169,6 +300,14 @@ int main(int argc, char **argv)
     }
   }
 
+  if (ui_retrieval_neighbors > 0) {
+    if (iMatchingVideoMode > 0 || sPredefinedPairList.length()) {
+      std::cerr << "\nIncompatible options: --retrieval_neighbors and --videoModeMatching or --pairList" << std::endl;
+      return EXIT_FAILURE;
+    }
+    ePairmode = PAIR_RETRIEVAL;
+  }
+
   if (sMatchesDirectory.empty() || !stlplus::is_folder(sMatchesDirectory))  {
     std::cerr << "\nIt is an invalid output directory" << std::endl;
     return EXIT_FAILURE;
@@ -261,6 +400,9 @@ int main(int argc, char **argv)
     return EXIT_FAILURE;
   }
 
+  // Putative matches: read on demand from an indexed matches file,
+  //  or kept in memory if they are loaded from another matches file format
+  PairWiseMatchesStreamReader putative_reader;
   PairWiseMatches map_PutativesMatches;
 
   // Build some alias from SfM_Data Views data:
@@ -281,6 +423,13 @@ int main(int argc, char **argv)
     }
   }
 
+  // Pairs that have putative matches
+  Pair_Set putative_pairs;
+  // Geometric matches (computed with the putative matches in pipelined mode)
+  PairWiseMatches map_GeometricMatches;
+  bool bPipelined = false;
+  const double d_distance_ratio = 0.6;
+
   std::cout << std::endl << " - PUTATIVE MATCHES - " << std::endl;
   // If the matches already exists, reload them
   if (!bForce
@@ -288,14 +437,27 @@ int main(int argc, char **argv)
         || stlplus::file_exists(sMatchesDirectory + "/matches.putative.bin"))
   )
   {
-    if (!(Load(map_PutativesMatches, sMatchesDirectory + "/matches.putative.bin") ||
-          Load(map_PutativesMatches, sMatchesDirectory + "/matches.putative.txt")) )
+    if (IsPairWiseMatchesStreamFile(sMatchesDirectory + "/matches.putative.bin"))
     {
-      std::cerr << "Cannot load input matches file";
-      return EXIT_FAILURE;
+      if (!putative_reader.Open(sMatchesDirectory + "/matches.putative.bin"))
+      {
+        std::cerr << "Cannot load input matches file";
+        return EXIT_FAILURE;
+      }
+      putative_pairs = putative_reader.GetPairs();
+    }
+    else
+    {
+      if (!(Load(map_PutativesMatches, sMatchesDirectory + "/matches.putative.bin") ||
+            Load(map_PutativesMatches, sMatchesDirectory + "/matches.putative.txt")) )
+      {
+        std::cerr << "Cannot load input matches file";
+        return EXIT_FAILURE;
+      }
+      putative_pairs = getPairs(map_PutativesMatches);
     }
     std::cout << "\t PREVIOUS RESULTS LOADED;"
-      << " #pair: " << map_PutativesMatches.size() << std::endl;
+      << " #pair: " << putative_pairs.size() << std::endl;
   }
   else // Compute the putative matches
   {
@@ -305,6 +467,7 @@ int main(int argc, char **argv)
       case PAIR_EXHAUSTIVE: std::cout << "exhaustive pairwise matching" << std::endl; break;
       case PAIR_CONTIGUOUS: std::cout << "sequence pairwise matching" << std::endl; break;
       case PAIR_FROM_FILE:  std::cout << "user defined pairwise matching" << std::endl; break;
+      case PAIR_RETRIEVAL:  std::cout << "image retrieval pairwise matching" << std::endl; break;
     }
 
     // Allocate the right Matcher according the Matching requested method
@@ -364,6 +527,21 @@ int main(int argc, char **argv)
       std::cerr << "Invalid Nearest Neighbor method: " << sNearestMatchingMethod << std::endl;
       return EXIT_FAILURE;
     }
+    if (ui_max_cache_size > 0)
+    {
+      // Out-of-core matching: match the pairs by tiles that fit in the regions cache
+      collectionMatcher.reset(
+        new Tiled_Matcher(std::move(collectionMatcher), ui_max_cache_size));
+    }
+    bPipelined = ui_pipeline_queue_size > 0;
+    if (ui_pipeline_worker_count == 0)
+    {
+#ifdef OPENMVG_USE_OPENMP
+      ui_pipeline_worker_count = omp_get_max_threads();
+#else
+      ui_pipeline_worker_count = std::max(1u, std::thread::hardware_concurrency());
+#endif
+    }
     // Perform the matching
     system::Timer timer;
     {
@@ -379,32 +557,128 @@ int main(int argc, char **argv)
               return EXIT_FAILURE;
           }
           break;
+        case PAIR_RETRIEVAL:
+        {
+          std::vector<IndexT> view_ids;
+          view_ids.reserve(sfm_data.GetViews().size());
+          for (const auto & view : sfm_data.GetViews())
+            view_ids.push_back(view.first);
+          pairs = retrievalPairs(*regions_provider, view_ids, ui_retrieval_neighbors,
+            Retrieval_Options(), &progress);
+          if (pairs.empty())
+          {
+            std::cerr << "Cannot compute the image retrieval pairs." << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+        break;
       }
-      // Photometric matching of putative pairs
-      collectionMatcher->Match(regions_provider, pairs, map_PutativesMatches, &progress);
       //---------------------------------------
-      //-- Export putative matches
+      //-- Export putative matches (streamed as soon as a pair is matched)
       //---------------------------------------
-      if (!Save(map_PutativesMatches, std::string(sMatchesDirectory + "/matches.putative.bin")))
+      PairWiseMatchesStreamWriter putative_writer;
+      if (!putative_writer.Open(sMatchesDirectory + "/matches.putative.bin"))
+      {
+        std::cerr
+          << "Cannot save computed matches in: "
+          << std::string(sMatchesDirectory + "/matches.putative.bin");
+        return EXIT_FAILURE;
+      }
+      bool bValid = true;
+      if (bPipelined)
+      {
+        // Photometric matching of putative pairs and geometric filtering
+        std::cout << "Pipelined putative matching and geometric filtering" << std::endl;
+        const ImageCollectionGeometricFilter filter(&sfm_data, regions_provider);
+        switch (eGeometricModelToCompute)
+        {
+          case HOMOGRAPHY_MATRIX:
+          {
+            const bool bGeometric_only_guided_matching = true;
+            bValid = Pipelined_Matching(*collectionMatcher, regions_provider, pairs, filter,
+              GeometricFilter_HMatrix_AC(4.0, imax_iteration),
+              bGuided_matching, bGeometric_only_guided_matching ? -1.0 : d_distance_ratio,
+              ui_pipeline_queue_size, ui_pipeline_worker_count, putative_writer, nullptr,
+              putative_pairs, map_GeometricMatches, &progress);
+          }
+          break;
+          case FUNDAMENTAL_MATRIX:
+            bValid = Pipelined_Matching(*collectionMatcher, regions_provider, pairs, filter,
+              GeometricFilter_FMatrix_AC(4.0, imax_iteration),
+              bGuided_matching, d_distance_ratio,
+              ui_pipeline_queue_size, ui_pipeline_worker_count, putative_writer, nullptr,
+              putative_pairs, map_GeometricMatches, &progress);
+          break;
+          case ESSENTIAL_MATRIX:
+            bValid = Pipelined_Matching(*collectionMatcher, regions_provider, pairs, filter,
+              GeometricFilter_EMatrix_AC(4.0, imax_iteration),
+              bGuided_matching, d_distance_ratio,
+              ui_pipeline_queue_size, ui_pipeline_worker_count, putative_writer,
+              //-- Perform an additional check to remove pairs with poor overlap
+              [](const IndMatches & putative_matches, const IndMatches & geometric_matches)
+              {
+                const float ratio = geometric_matches.size() / static_cast<float>(putative_matches.size());
+                return !(geometric_matches.size() < 50 || ratio < .3f);
+              },
+              putative_pairs, map_GeometricMatches, &progress);
+          break;
+          case ESSENTIAL_MATRIX_ANGULAR:
+            bValid = Pipelined_Matching(*collectionMatcher, regions_provider, pairs, filter,
+              GeometricFilter_ESphericalMatrix_AC_Angular(4.0, imax_iteration),
+              bGuided_matching, 0.6,
+              ui_pipeline_queue_size, ui_pipeline_worker_count, putative_writer, nullptr,
+              putative_pairs, map_GeometricMatches, &progress);
+          break;
+          case ESSENTIAL_MATRIX_ORTHO:
+            bValid = Pipelined_Matching(*collectionMatcher, regions_provider, pairs, filter,
+              GeometricFilter_EOMatrix_RA(2.0, imax_iteration),
+              bGuided_matching, d_distance_ratio,
+              ui_pipeline_queue_size, ui_pipeline_worker_count, putative_writer, nullptr,
+              putative_pairs, map_GeometricMatches, &progress);
+          break;
+        }
+      }
+      else
+      {
+        // Photometric matching of putative pairs
+        //  (the putative matches are only written to the file)
+        collectionMatcher->Match(regions_provider, pairs, putative_writer, &progress);
+      }
+      if (!bValid || !putative_writer.Close())
       {
         std::cerr
           << "Cannot save computed matches in: "
           << std::string(sMatchesDirectory + "/matches.putative.bin");
         return EXIT_FAILURE;
       }
+      if (!putative_reader.Open(sMatchesDirectory + "/matches.putative.bin"))
+      {
+        std::cerr << "Cannot load the computed matches" << std::endl;
+        return EXIT_FAILURE;
+      }
+      putative_pairs = putative_reader.GetPairs();
     }
     std::cout << "Task (Regions Matching) done in (s): " << timer.elapsed() << std::endl;
   }
   //-- export putative matches Adjacency matrix
-  PairWiseMatchingToAdjacencyMatrixSVG(vec_fileNames.size(),
-    map_PutativesMatches,
-    stlplus::create_filespec(sMatchesDirectory, "PutativeAdjacencyMatrix", "svg"));
+  if (map_PutativesMatches.empty())
+  {
+    PairWiseMatchingToAdjacencyMatrixSVG(vec_fileNames.size(),
+      putative_reader,
+      stlplus::create_filespec(sMatchesDirectory, "PutativeAdjacencyMatrix", "svg"));
+  }
+  else
+  {
+    PairWiseMatchingToAdjacencyMatrixSVG(vec_fileNames.size(),
+      map_PutativesMatches,
+      stlplus::create_filespec(sMatchesDirectory, "PutativeAdjacencyMatrix", "svg"));
+  }
   //-- export view pair graph once putative graph matches have been computed
   {
     std::set<IndexT> set_ViewIds;
     std::transform(sfm_data.GetViews().begin(), sfm_data.GetViews().end(),
       std::inserter(set_ViewIds, set_ViewIds.begin()), stl::RetrieveKey());
-    graph::indexedGraph putativeGraph(set_ViewIds, getPairs(map_PutativesMatches));
+    graph::indexedGraph putativeGraph(set_ViewIds, putative_pairs);
     graph::exportToGraphvizData(
       stlplus::create_filespec(sMatchesDirectory, "putative_matches"),
       putativeGraph);
@@ -422,77 +696,87 @@ int main(int argc, char **argv)
   if (filter_ptr)
   {
     system::Timer timer;
-    const double d_distance_ratio = 0.6;
 
-    PairWiseMatches map_GeometricMatches;
-    switch (eGeometricModelToCompute)
+    // In pipelined mode the geometric matches are already computed
+    if (!bPipelined)
     {
-      case HOMOGRAPHY_MATRIX:
+      bool bValid = true;
+      switch (eGeometricModelToCompute)
       {
-        const bool bGeometric_only_guided_matching = true;
-        filter_ptr->Robust_model_estimation(
-          GeometricFilter_HMatrix_AC(4.0, imax_iteration),
-          map_PutativesMatches, bGuided_matching,
-          bGeometric_only_guided_matching ? -1.0 : d_distance_ratio, &progress);
-        map_GeometricMatches = filter_ptr->Get_geometric_matches();
-      }
-      break;
-      case FUNDAMENTAL_MATRIX:
-      {
-        filter_ptr->Robust_model_estimation(
-          GeometricFilter_FMatrix_AC(4.0, imax_iteration),
-          map_PutativesMatches, bGuided_matching, d_distance_ratio, &progress);
-        map_GeometricMatches = filter_ptr->Get_geometric_matches();
-      }
-      break;
-      case ESSENTIAL_MATRIX:
-      {
-        filter_ptr->Robust_model_estimation(
-          GeometricFilter_EMatrix_AC(4.0, imax_iteration),
-          map_PutativesMatches, bGuided_matching, d_distance_ratio, &progress);
-        map_GeometricMatches = filter_ptr->Get_geometric_matches();
-
-        //-- Perform an additional check to remove pairs with poor overlap
-        std::vector<PairWiseMatches::key_type> vec_toRemove;
-        for (const auto & pairwisematches_it : map_GeometricMatches)
+        case HOMOGRAPHY_MATRIX:
+        {
+          const bool bGeometric_only_guided_matching = true;
+          bValid = Geometric_Filtering(*filter_ptr,
+            GeometricFilter_HMatrix_AC(4.0, imax_iteration),
+            map_PutativesMatches, putative_reader, bGuided_matching,
+            bGeometric_only_guided_matching ? -1.0 : d_distance_ratio, &progress);
+          map_GeometricMatches = filter_ptr->Get_geometric_matches();
+        }
+        break;
+        case FUNDAMENTAL_MATRIX:
         {
-          const size_t putativePhotometricCount = map_PutativesMatches.find(pairwisematches_it.first)->second.size();
-          const size_t putativeGeometricCount = pairwisematches_it.second.size();
-          const float ratio = putativeGeometricCount / static_cast<float>(putativePhotometricCount);
-          if (putativeGeometricCount < 50 || ratio < .3f)  {
-            // the pair will be removed
-            vec_toRemove.push_back(pairwisematches_it.first);
+          bValid = Geometric_Filtering(*filter_ptr,
+            GeometricFilter_FMatrix_AC(4.0, imax_iteration),
+            map_PutativesMatches, putative_reader, bGuided_matching, d_distance_ratio, &progress);
+          map_GeometricMatches = filter_ptr->Get_geometric_matches();
+        }
+        break;
+        case ESSENTIAL_MATRIX:
+        {
+          bValid = Geometric_Filtering(*filter_ptr,
+            GeometricFilter_EMatrix_AC(4.0, imax_iteration),
+            map_PutativesMatches, putative_reader, bGuided_matching, d_distance_ratio, &progress);
+          map_GeometricMatches = filter_ptr->Get_geometric_matches();
+
+          //-- Perform an additional check to remove pairs with poor overlap
+          std::vector<PairWiseMatches::key_type> vec_toRemove;
+          for (const auto & pairwisematches_it : map_GeometricMatches)
+          {
+            const size_t putativePhotometricCount = map_PutativesMatches.empty() ?
+              putative_reader.MatchCount(pairwisematches_it.first) :
+              map_PutativesMatches.find(pairwisematches_it.first)->second.size();
+            const size_t putativeGeometricCount = pairwisematches_it.second.size();
+            const float ratio = putativeGeometricCount / static_cast<float>(putativePhotometricCount);
+            if (putativeGeometricCount < 50 || ratio < .3f)  {
+              // the pair will be removed
+              vec_toRemove.push_back(pairwisematches_it.first);
+            }
+          }
+          //-- remove discarded pairs
+          for (const auto & pair_to_remove_it : vec_toRemove)
+          {
+            map_GeometricMatches.erase(pair_to_remove_it);
           }
         }
-        //-- remove discarded pairs
-        for (const auto & pair_to_remove_it : vec_toRemove)
+        break;
+        case ESSENTIAL_MATRIX_ANGULAR:
         {
-          map_GeometricMatches.erase(pair_to_remove_it);
+          bValid = Geometric_Filtering(*filter_ptr,
+            GeometricFilter_ESphericalMatrix_AC_Angular(4.0, imax_iteration),
+            map_PutativesMatches, putative_reader, bGuided_matching, 0.6, &progress);
+          map_GeometricMatches = filter_ptr->Get_geometric_matches();
         }
+        break;
+        case ESSENTIAL_MATRIX_ORTHO:
+        {
+          bValid = Geometric_Filtering(*filter_ptr,
+            GeometricFilter_EOMatrix_RA(2.0, imax_iteration),
+            map_PutativesMatches, putative_reader, bGuided_matching, d_distance_ratio, &progress);
+          map_GeometricMatches = filter_ptr->Get_geometric_matches();
+        }
+        break;
       }
-      break;
-      case ESSENTIAL_MATRIX_ANGULAR:
-      {
-        filter_ptr->Robust_model_estimation(
-          GeometricFilter_ESphericalMatrix_AC_Angular(4.0, imax_iteration),
-          map_PutativesMatches, bGuided_matching);
-        map_GeometricMatches = filter_ptr->Get_geometric_matches();
-      }
-      break;
-      case ESSENTIAL_MATRIX_ORTHO:
+      if (!bValid)
       {
-        filter_ptr->Robust_model_estimation(
-          GeometricFilter_EOMatrix_RA(2.0, imax_iteration),
-          map_PutativesMatches, bGuided_matching, d_distance_ratio, &progress);
-        map_GeometricMatches = filter_ptr->Get_geometric_matches();
+        std::cerr << "Cannot read the putative matches" << std::endl;
+        return EXIT_FAILURE;
       }
-      break;
     }
 
     //---------------------------------------
     //-- Export geometric filtered matches
     //---------------------------------------
-    if (!Save(map_GeometricMatches,
+    if (!SavePairWiseMatchesStream(map_GeometricMatches,
       std::string(sMatchesDirectory + "/" + sGeometricMatchesFilename)))
     {
       std::cerr
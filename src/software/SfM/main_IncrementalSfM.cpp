@@ -83,6 +83,8 @@ int main(int argc, char **argv)
   int i_User_camera_model = PINHOLE_CAMERA_RADIAL3;
   bool b_use_motion_priors = false;
   int triangulation_method = static_cast<int>(ETriangulationMethod::DEFAULT);
+  unsigned int ui_local_ba_full_period = 0;
+  unsigned int ui_local_ba_views = 10;
 
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
   cmd.add( make_option('m', sMatchesDir, "matchdir") );
@@ -94,6 +96,8 @@ int main(int argc, char **argv)
   cmd.add( make_option('f', sIntrinsic_refinement_options, "refineIntrinsics") );
   cmd.add( make_switch('P', "prior_usage") );
   cmd.add( make_option('t', triangulation_method, "triangulation_method"));
+  cmd.add( make_option('L', ui_local_ba_full_period, "local_ba"));
+  cmd.add( make_option('V', ui_local_ba_views, "local_ba_views"));
 
   try {
     if (argc == 1) throw std::string("Invalid parameter.");
@@ -132,6 +136,11 @@ int main(int argc, char **argv)
     << "\t\t" << static_cast<int>(ETriangulationMethod::L1_ANGULAR) << ": L1_ANGULAR\n"
     << "\t\t" << static_cast<int>(ETriangulationMethod::LINFINITY_ANGULAR) << ": LINFINITY_ANGULAR\n"
     << "\t\t" << static_cast<int>(ETriangulationMethod::INVERSE_DEPTH_WEIGHTED_MIDPOINT) << ": INVERSE_DEPTH_WEIGHTED_MIDPOINT\n"
+    << "[-L|--local_ba] run a full bundle adjustment every N resection groups only\n"
+    << "\t a local bundle adjustment (new views + covisible views) is used otherwise\n"
+    << "\t a full BA is also run if the local BA residual drifts\n"
+    << "\t (default 0: full bundle adjustment after each resection group)\n"
+    << "[-V|--local_ba_views] local BA: number of covisible views refined with the new views (default 10)\n"
     << std::endl;
 
     std::cerr << s << std::endl;
@@ -229,6 +238,7 @@ int main(int argc, char **argv)
   b_use_motion_priors = cmd.used('P');
   sfmEngine.Set_Use_Motion_Prior(b_use_motion_priors);
   sfmEngine.SetTriangulationMethod(static_cast<ETriangulationMethod>(triangulation_method));
+  sfmEngine.SetLocalBundleAdjustment(ui_local_ba_full_period, ui_local_ba_views);
 
   // Handle Initial pair parameter
   if (!initialPairString.first.empty() && !initialPairString.second.empty())
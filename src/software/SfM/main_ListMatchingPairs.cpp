@@ -8,6 +8,8 @@
 
 #include "openMVG/matching/matcher_brute_force.hpp"
 #include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/matching_image_collection/Retrieval_Pair_Builder.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/system/timer.hpp"
@@ -28,7 +30,8 @@ enum ePairMode
 {
   PAIR_MODE_EXHAUSTIVE = 0,
   PAIR_MODE_CONTIGUOUS = 1,
-  PAIR_MODE_NEIGHBORHOOD = 2
+  PAIR_MODE_NEIGHBORHOOD = 2,
+  PAIR_MODE_RETRIEVAL = 3
 };
 
 /// Export an adjacency matrix as a SVG file
@@ -95,6 +98,7 @@ int main(int argc, char **argv)
 
   std::string s_SfM_Data_filename;
   std::string s_out_file;
+  std::string s_matches_dir;
   int i_neighbor_count = 5;
   int i_mode(PAIR_MODE_EXHAUSTIVE);
 
@@ -104,6 +108,8 @@ int main(int argc, char **argv)
   cmd.add( make_switch('G', "gps_mode"));
   cmd.add( make_switch('V', "video_mode"));
   cmd.add( make_switch('E', "exhaustive_mode"));
+  cmd.add( make_switch('R', "retrieval_mode"));
+  cmd.add( make_option('m', s_matches_dir, "matches_dir") );
 
   try {
     if (argc == 1) throw std::string("Invalid parameter.");
@@ -113,12 +119,16 @@ int main(int argc, char **argv)
     << "[-i|--input_file] path to a SfM_Data scene\n"
     << "[-o|--output_file] the output pairlist file (i.e ./pair_list.txt)\n"
     << "optional:\n"
-    << "Matching pair modes [E/V/G]:\n"
+    << "Matching pair modes [E/V/G/R]:\n"
     << "\t[-E|--exhaustive_mode] exhaustive mode (default mode)\n"
     << "\t[-V|--video_mode] link views that belongs to contiguous poses ids\n"
     << "\t[-G|--gps_mode] use the pose center priors to link neighbor views\n"
-    << "Note: options V & G are linked the following parameter:\n"
+    << "\t[-R|--retrieval_mode] link the views that have the most similar\n"
+    << "\t  features (vocabulary tree image retrieval)\n"
+    << "Note: options V, G & R are linked the following parameter:\n"
     << "\t [-n|--neighbor_count] number of maximum neighbor\n"
+    << "Note: option R is linked the following parameter:\n"
+    << "\t [-m|--matches_dir] path to the computed features and image_describer.json\n"
     << std::endl;
 
     std::cerr << s << std::endl;
@@ -133,9 +143,12 @@ int main(int argc, char **argv)
     << "Optional parameters:" << "\n"
     << "--exhaustive_mode " << (cmd.used('E') ? "ON" : "OFF") << "\n"
     << "--video_mode " <<  (cmd.used('V') ? "ON" : "OFF") << "\n"
-    << "--gps_mode "  << (cmd.used('G') ? "ON" : "OFF") << "\n";
-  if (cmd.used('V') || cmd.used('G'))
+    << "--gps_mode "  << (cmd.used('G') ? "ON" : "OFF") << "\n"
+    << "--retrieval_mode "  << (cmd.used('R') ? "ON" : "OFF") << "\n";
+  if (cmd.used('V') || cmd.used('G') || cmd.used('R'))
     std::cout << "--neighbor_count " << i_neighbor_count << std::endl;
+  if (cmd.used('R'))
+    std::cout << "--matches_dir " << s_matches_dir << std::endl;
 
   std::cout << std::endl;
 
@@ -144,7 +157,7 @@ int main(int argc, char **argv)
   //--
 
   // pair list mode
-  if ( int(cmd.used('E')) + int(cmd.used('V')) + int(cmd.used('G')) > 1)
+  if ( int(cmd.used('E')) + int(cmd.used('V')) + int(cmd.used('G')) + int(cmd.used('R')) > 1)
   {
     std::cerr << "You can use only one matching mode." << std::endl;
     return EXIT_FAILURE;
@@ -155,6 +168,14 @@ int main(int argc, char **argv)
     i_mode = PAIR_MODE_CONTIGUOUS;
   else if (cmd.used('G'))
     i_mode = PAIR_MODE_NEIGHBORHOOD;
+  else if (cmd.used('R'))
+    i_mode = PAIR_MODE_RETRIEVAL;
+
+  if (i_mode == PAIR_MODE_RETRIEVAL && !stlplus::is_folder(s_matches_dir))
+  {
+    std::cerr << "The retrieval_mode requires a valid matches_dir." << std::endl;
+    return EXIT_FAILURE;
+  }
 
   // Input SfM_Data scene
   SfM_Data sfm_data;
@@ -191,7 +212,8 @@ int main(int argc, char **argv)
   // b. Establish a pose graph according the user chosen mode:
   //    - E => upper diagonal pairs,
   //    - V => list the N closest pose ids,
-  //    - G => list the N closest poses XYZ position.
+  //    - G => list the N closest poses XYZ position,
+  //    - R => list the N most similar views (the view graph is built directly).
   // c. Convert the pose graph edges to a view graph
   // d. Export the view graph to a file and a SVG adjacency list
   //---------------------------------------
@@ -270,14 +292,42 @@ int main(int argc, char **argv)
       }
     }
     break;
+    case PAIR_MODE_RETRIEVAL:
+    break;
     default:
       std::cerr << "Unknown pair mode." << std::endl;
       return EXIT_FAILURE;
   }
 
+  Pair_Set view_pair;
+  if (i_mode == PAIR_MODE_RETRIEVAL)
+  {
+    // Init the regions type from the image describer file
+    const std::string sImage_describer =
+      stlplus::create_filespec(s_matches_dir, "image_describer", "json");
+    std::unique_ptr<features::Regions> regions_type =
+      features::Init_region_type_from_file(sImage_describer);
+    if (!regions_type)
+    {
+      std::cerr << "Invalid: " << sImage_describer << " regions type file." << std::endl;
+      return EXIT_FAILURE;
+    }
+    C_Progress_display progress;
+    Regions_Provider regions_provider;
+    if (!regions_provider.load(sfm_data, s_matches_dir, regions_type, &progress))
+    {
+      std::cerr << std::endl << "Invalid regions." << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<IndexT> view_ids;
+    for (const auto & view_it : sfm_data.GetViews())
+      view_ids.push_back(view_it.first);
+    view_pair = matching_image_collection::retrievalPairs(
+      regions_provider, view_ids, i_neighbor_count,
+      matching_image_collection::Retrieval_Options(), &progress);
+  }
 
   // c. Convert the pose graph to a view graph
-  Pair_Set view_pair;
   for (const auto & pose_pair : pose_pairs)
   {
     const IndexT poseA = pose_pair.first;
@@ -10,6 +10,7 @@
 #include "openMVG/image/image_io.hpp"
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/matching/pairwise_matches_stream.hpp"
 #include "openMVG/matching/svg_matches.hpp"
 #include "openMVG/sfm/pipelines/sfm_features_provider.hpp"
 #include "openMVG/sfm/pipelines/sfm_matches_provider.hpp"
@@ -35,11 +36,13 @@ int main(int argc, char ** argv)
   std::string sMatchesDir;
   std::string sMatchFile;
   std::string sOutDir = "";
+  int iPairsPerChunk = 1000;
 
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
   cmd.add( make_option('d', sMatchesDir, "matchdir") );
   cmd.add( make_option('m', sMatchFile, "matchfile") );
   cmd.add( make_option('o', sOutDir, "outdir") );
+  cmd.add( make_option('c', iPairsPerChunk, "pairs_per_chunk") );
 
   try {
       if (argc == 1) throw std::string("Invalid command line parameter.");
@@ -50,6 +53,9 @@ int main(int argc, char ** argv)
       << "[-d|--matchdir path]\n"
       << "[-m|--sMatchFile filename]\n"
       << "[-o|--outdir path]\n"
+      << "\n[Optional]\n"
+      << "[-c|--pairs_per_chunk] number of pairs loaded at once\n"
+      << "  when the matches file is an indexed matches file (default 1000)\n"
       << std::endl;
 
       std::cerr << s << std::endl;
@@ -92,18 +98,54 @@ int main(int argc, char ** argv)
     return EXIT_FAILURE;
   }
 
-  // Read the matches
-  std::shared_ptr<Matches_Provider> matches_provider = std::make_shared<Matches_Provider>();
-  if (!matches_provider->load(sfm_data, sMatchFile)) {
-    std::cerr << "Invalid match file." << std::endl;
-    return EXIT_FAILURE;
-  }
-
   //---------------------------------------
   // Compute tracks from matches
   //---------------------------------------
   tracks::STLMAPTracks map_tracks;
+  if (IsPairWiseMatchesStreamFile(sMatchFile))
   {
+    // Indexed matches file: read the pairs by chunks (bounded memory)
+    PairWiseMatchesStreamReader matches_reader;
+    if (!matches_reader.Open(sMatchFile) || iPairsPerChunk <= 0) {
+      std::cerr << "Invalid match file." << std::endl;
+      return EXIT_FAILURE;
+    }
+    const size_t pairs_per_chunk = iPairsPerChunk;
+    const size_t chunk_count = (matches_reader.PairCount() + pairs_per_chunk - 1) / pairs_per_chunk;
+    const Views & views = sfm_data.GetViews();
+    tracks::TracksBuilder tracksBuilder;
+    if (!tracksBuilder.Build(chunk_count,
+      [&](size_t chunk_id, PairWiseMatches & chunk_matches)
+      {
+        if (!matches_reader.ReadRange(chunk_id * pairs_per_chunk,
+                                      (chunk_id + 1) * pairs_per_chunk, chunk_matches))
+          return false;
+        // Keep only the pairs defined in SfM_Data
+        for (auto it = chunk_matches.begin(); it != chunk_matches.end();)
+        {
+          if (views.count(it->first.first) == 0 || views.count(it->first.second) == 0)
+            it = chunk_matches.erase(it);
+          else
+            ++it;
+        }
+        return true;
+      }))
+    {
+      std::cerr << "Invalid match file." << std::endl;
+      return EXIT_FAILURE;
+    }
+    tracksBuilder.Filter();
+    tracksBuilder.ExportToSTL(map_tracks);
+  }
+  else
+  {
+    // Read the matches
+    std::shared_ptr<Matches_Provider> matches_provider = std::make_shared<Matches_Provider>();
+    if (!matches_provider->load(sfm_data, sMatchFile)) {
+      std::cerr << "Invalid match file." << std::endl;
+      return EXIT_FAILURE;
+    }
+
     const openMVG::matching::PairWiseMatches & map_Matches = matches_provider->pairWise_matches_;
     tracks::TracksBuilder tracksBuilder;
     tracksBuilder.Build(map_Matches);